@@ -6,6 +6,7 @@ import argparse
 menu = []
 active_choice = 0
 scene_serializer_lines = ""
+cooked_fields = []
 
 def find_serializable_variables(header_file_path, all_public):
     
@@ -305,8 +306,7 @@ def create_deserialization_code(Component, serializable_vars):
         ]
 
     deserialization_code += [
-        '            deserialized_entity->add_component(deserialized_component);',
-        '            deserialized_component->reprepare();',
+        '            attach_component(deserialized_entity, deserialized_component);',
         '        }',
         '    }',
         '        else'
@@ -314,6 +314,83 @@ def create_deserialization_code(Component, serializable_vars):
 
     return deserialization_code
 
+def create_cooked_deserialization_code(Component, serializable_vars):
+
+    deserialization_code = [
+        '    case ComponentType::' + Component + ':',
+        '        if (first_pass)',
+        '        {',
+        '            auto const deserialized_component = ' + Component + '::create();',
+        '            deserialized_component->guid = component.guid;',
+        '            deserialized_component->custom_name = component.custom_name;',
+        '            deserialized_pool.emplace_back(deserialized_component);',
+        '        }',
+        '        else',
+        '        {',
+        '            auto const deserialized_component = std::dynamic_pointer_cast<class ' + Component + '>(get_from_pool(component.guid));'
+    ]
+
+    # Fields are numbered in the order they are added to cooked_fields
+    field_index = 0
+    for var_type, var_name, is_checked in serializable_vars:
+
+        if is_checked == False:
+            continue
+
+        deserialization_code += [
+            '            if (auto field = file.get_field(component, ' + str(field_index) + '))',
+            '            {',
+            '                deserialized_component->' + var_name + ' = field->read<' + var_type + '>();',
+            '            }',
+        ]
+        field_index += 1
+
+    deserialization_code += [
+        '            attach_component(deserialized_entity, deserialized_component);',
+        '        }',
+        '        break;',
+        ''
+    ]
+
+    return deserialization_code
+
+def create_clone_creation_code(Component):
+
+    clone_creation_code = [
+        '    case ComponentType::' + Component + ':',
+        '        return ' + Component + '::create();',
+        ''
+    ]
+
+    return clone_creation_code
+
+def create_clone_code(Component, serializable_vars):
+
+    clone_code = [
+        '    case ComponentType::' + Component + ':',
+        '    {',
+        '        auto const& from = static_cast<class ' + Component + ' const&>(source);',
+        '        auto& to = static_cast<class ' + Component + '&>(copy);',
+        '        to.custom_name = clone_value(from.custom_name);'
+    ]
+
+    for var_type, var_name, is_checked in serializable_vars:
+
+        if is_checked == False:
+            continue
+
+        clone_code += [
+            '        to.' + var_name + ' = clone_value(from.' + var_name + ');',
+        ]
+
+    clone_code += [
+        '        break;',
+        '    }',
+        ''
+    ]
+
+    return clone_code
+
 def pick_variables(serializable_vars):
     
     menu = serializable_vars
@@ -457,6 +534,19 @@ def add_serialization(file, pick_vars, pick_files, indentation = 0):
         add_lines_at_target('// # Put new deserialization here', create_deserialization_code(Component, serializable_vars + additional_variables), -3)
         print('Succesful added deserialization for ' + Component + '!')
 
+        add_lines_at_target('// # Put new cooked deserialization here', create_cooked_deserialization_code(Component, serializable_vars + additional_variables), -4)
+
+        for var_type, var_name, is_checked in serializable_vars + additional_variables:
+            if is_checked == True:
+                cooked_fields.append((Component, var_name, var_type))
+
+        if check_includes(name, '/src/EntityCloner.cpp') == False:
+            add_lines_at_target('// # Put new header here', create_header_code(name), 0, '/src/EntityCloner.cpp')
+
+        add_lines_at_target('// # Put new clone creation here', create_clone_creation_code(Component), 0, '/src/EntityCloner.cpp')
+        add_lines_at_target('// # Put new clone here', create_clone_code(Component, serializable_vars + additional_variables), 0, '/src/EntityCloner.cpp')
+        print('Succesful added cloning for ' + Component + '!')
+
     components_to_remove = []
 
     for file in files_to_serialize:
@@ -491,6 +581,98 @@ def add_to_component_list(file):
         add_lines_at_target('// # Put new header here', create_header_code(name), 0, '/src/Editor.cpp')
 
 
+def scan_component_types():
+    # Every class deriving from Component, also the abstract and NON_SERIALIZED ones. Parents come before their kids,
+    # kids of one parent are sorted, so the ids only change when components are added or removed.
+    header_folder_path = args.engine_dir + '/src'
+    class_pattern = re.compile(r'^\s*class\s+(\w+)(\s+final)?\s*:\s*public\s+(\w+)')
+    classes = []
+
+    for root, dirs, files in os.walk(header_folder_path):
+        for file in files:
+            if file.endswith('.h'):
+                with open(os.path.join(root, file), 'r', encoding='utf-8') as f:
+                    for line in f:
+                        match = class_pattern.match(line)
+                        if match:
+                            classes.append((match.group(1), match.group(3), os.path.join(root, file).replace("\\", "/")))
+
+    component_types = []
+    parents = ['Component']
+
+    while parents != []:
+        parent = parents.pop(0)
+        for name, inherits_from, path in sorted(classes):
+            if inherits_from == parent:
+                component_types.append((name, parent, path))
+                parents.append(name)
+
+    return component_types
+
+def add_component_types():
+    component_types = scan_component_types()
+
+    remove_lines_between('// # Auto component type list start', '// # Auto component type list end', False, '/src/ComponentList.h')
+    code = [
+        '// # Auto component type list start',
+        '#define ENUMERATE_COMPONENT_TYPES \\'
+    ]
+    for name, parent, path in component_types:
+        code.append('    ENUMERATE_COMPONENT_TYPE(' + name + ', ' + parent + ') \\')
+    code.append('    // # Auto component type list end')
+    add_lines_at_target('// # Put new component type here', code, 0, '/src/ComponentList.h')
+
+    remove_lines_between('// # Auto component type headers start', '// # Auto component type headers end', False, '/src/ComponentType.cpp')
+    code = ['// # Auto component type headers start']
+    for name, parent, path in component_types:
+        code += create_header_code(path)
+    code.append('// # Auto component type headers end')
+    add_lines_at_target('// # Put new component type header here', code, 0, '/src/ComponentType.cpp')
+
+def scan_component_accesses():
+    # FIXED_UPDATE_READS(...) and FIXED_UPDATE_WRITES(...) belong to the last class declared above them
+    header_folder_path = args.engine_dir + '/src'
+    class_pattern = re.compile(r'^\s*class\s+(\w+)(\s+final)?\s*:\s*public\s+(\w+)')
+    access_pattern = re.compile(r'^\s*FIXED_UPDATE_(READS|WRITES)\((.*)\)')
+    accesses = {}
+
+    for root, dirs, files in os.walk(header_folder_path):
+        for file in files:
+            if file.endswith('.h') and file != 'ComponentAccess.h':
+                with open(os.path.join(root, file), 'r', encoding='utf-8') as f:
+                    current_class = None
+                    for line in f:
+                        match = class_pattern.match(line)
+                        if match:
+                            current_class = match.group(1)
+                            continue
+
+                        match = access_pattern.match(line)
+                        if match and current_class != None:
+                            reads, writes = accesses.setdefault(current_class, ([], []))
+                            resources = [resource.strip() for resource in match.group(2).split(',') if resource.strip() != '']
+                            (reads if match.group(1) == 'READS' else writes).extend(resources)
+
+    return accesses
+
+def add_component_accesses():
+    accesses = scan_component_accesses()
+
+    remove_lines_between('// # Auto component access list start', '// # Auto component access list end', False, '/src/ComponentList.h')
+    code = [
+        '// # Auto component access list start',
+        '#define ENUMERATE_COMPONENT_ACCESSES \\'
+    ]
+    for name in sorted(accesses):
+        reads, writes = accesses[name]
+        code.append('    ENUMERATE_COMPONENT_ACCESS(' + name + ') \\')
+        for resource in reads:
+            code.append('    ENUMERATE_COMPONENT_READ(' + name + ', ' + resource + ') \\')
+        for resource in writes:
+            code.append('    ENUMERATE_COMPONENT_WRITE(' + name + ', ' + resource + ') \\')
+    code.append('    // # Auto component access list end')
+    add_lines_at_target('// # Put new component access here', code, 0, '/src/ComponentList.h')
+
 parser = argparse.ArgumentParser(description='Engine Header Tool')
 parser.add_argument('-d', '--engine_dir', action='store', help="root directory of the engine")
 parser.add_argument('-pv', '--pick_vars', action='store_true', help='let you pick variables to serilize')
@@ -528,6 +710,33 @@ code = [
 ]
 add_lines_at_target('auto_deserialize_component', code, 4)
 
+remove_lines_between('// # Auto cooked deserialization start', '// # Put new cooked deserialization here')
+code = [
+    '    // # Auto cooked deserialization start',
+    '    switch (component.type)',
+    '    {',
+    '    default:',
+    '        std::cout << "Error. Deserialization of component " << component.name << " failed." << "\\n";',
+    '        break;',
+    '    }',
+    '    // # Put new cooked deserialization here'
+]
+add_lines_at_target('auto_deserialize_cooked_component', code, 3)
+
+remove_lines_between('// # Auto clone creation start', '// # Put new clone creation here', False, '/src/EntityCloner.cpp')
+code = [
+    '    // # Auto clone creation start',
+    '    // # Put new clone creation here'
+]
+add_lines_at_target('EntityCloner::create_component', code, 4, '/src/EntityCloner.cpp')
+
+remove_lines_between('// # Auto clone start', '// # Put new clone here', False, '/src/EntityCloner.cpp')
+code = [
+    '    // # Auto clone start',
+    '    // # Put new clone here'
+]
+add_lines_at_target('EntityCloner::copy_fields', code, 4, '/src/EntityCloner.cpp')
+
 remove_lines_between('// # Auto component list start', '// # Auto component list end', False, '/src/ComponentList.h')
 add_lines_at_target('// # Put new component here', ['    // # Auto component list start'], 0, '/src/ComponentList.h')
 add_lines_at_target('// # Put new component here', ['#define ENUMERATE_COMPONENTS \\'], 0, '/src/ComponentList.h')
@@ -539,6 +748,16 @@ for file in files_to_serialize:
 
 add_lines_at_target('// # Put new component here', ['    // # Auto component list end'], 0, '/src/ComponentList.h')
 
+add_component_types()
+add_component_accesses()
+
+remove_lines_between('// # Auto cooked fields start', '// # Put new cooked field here', False, '/src/SceneCooker.cpp')
+code = ['    // # Auto cooked fields start']
+for Component, var_name, var_type in cooked_fields:
+    code.append('    {ComponentType::' + Component + ', "' + var_name + '", "' + var_type + '"},')
+code.append('    // # Put new cooked field here')
+add_lines_at_target('constexpr auto component_fields', code, 1, '/src/SceneCooker.cpp')
+
 with open(args.engine_dir + '/src/SceneSerializer.cpp', 'w') as file:
     file.truncate(0)
     file.writelines(scene_serializer_lines)
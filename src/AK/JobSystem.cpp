@@ -0,0 +1,487 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+namespace AK
+{
+
+namespace
+{
+
+thread_local JobSystem const* t_job_system = nullptr;
+thread_local u32 t_thread_index = JobSystem::main_thread;
+
+}
+
+JobSystem::JobSystem(u32 const worker_count)
+{
+    m_threads.reserve(worker_count + 1);
+
+    for (u32 i = 0; i <= worker_count; ++i)
+    {
+        m_threads.emplace_back(std::make_unique<Thread>());
+    }
+
+    // Started once all deques exist, workers steal from each other right away
+    for (u32 i = 1; i <= worker_count; ++i)
+    {
+        m_threads[i]->thread = std::jthread([this, i](std::stop_token const& stop_token) { worker_loop(stop_token, i); });
+    }
+}
+
+JobSystem::~JobSystem()
+{
+    for (auto const& thread : m_threads)
+    {
+        thread->thread.request_stop();
+    }
+
+    // Joined one by one, jobs left in the deques are never run
+    for (auto const& thread : m_threads)
+    {
+        if (thread->thread.joinable())
+            thread->thread.join();
+    }
+}
+
+void JobSystem::initialize(u32 const worker_count)
+{
+    u32 const hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+    m_instance = std::make_shared<JobSystem>(worker_count != 0 ? worker_count : hardware_threads - 1);
+}
+
+void JobSystem::uninitialize()
+{
+    m_instance = nullptr;
+}
+
+void JobSystem::schedule(char const* name, std::function<void()> function, JobCounter* const counter, u32 const thread)
+{
+    assert(thread == any_thread || thread < m_threads.size());
+
+    if (counter != nullptr)
+        counter->fetch_add(1, std::memory_order_relaxed);
+
+    if (thread != any_thread)
+    {
+        Thread& target = *m_threads[thread];
+
+        // Counted before it's pushed, so a thread taking it right away never sees the count drop below zero
+        target.pinned_count.fetch_add(1, std::memory_order_release);
+
+        {
+            std::scoped_lock const lock(target.mutex);
+            target.pinned_jobs.emplace_back(name, std::move(function), counter);
+        }
+
+        // Only the right worker can run it, so all of them are woken up
+        if (thread != main_thread)
+        {
+            std::scoped_lock const lock(m_sleep_mutex);
+            m_work_available.notify_all();
+        }
+
+        return;
+    }
+
+    Thread& current = *m_threads[get_current_thread()];
+
+    m_stealable_count.fetch_add(1, std::memory_order_release);
+
+    {
+        std::scoped_lock const lock(current.mutex);
+        current.jobs.emplace_back(name, std::move(function), counter);
+    }
+
+    // Taking the lock makes sure a worker that just found nothing to do is already waiting
+    std::scoped_lock const lock(m_sleep_mutex);
+    m_work_available.notify_one();
+}
+
+void JobSystem::wait(JobCounter const& counter)
+{
+    u32 const index = get_current_thread();
+
+    while (counter.load(std::memory_order_acquire) > 0)
+    {
+        if (!try_run_job(index))
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::parallel_for(u32 const begin, u32 const end, u32 const grain_size, std::function<void(u32, u32)> const& function)
+{
+    if (begin >= end)
+        return;
+
+    u32 const grain = std::max(grain_size, 1u);
+
+    if (end - begin <= grain || get_worker_count() == 0)
+    {
+        function(begin, end);
+        return;
+    }
+
+    JobCounter counter = 0;
+
+    for (u32 first = begin + grain; first < end; first += std::min(grain, end - first))
+    {
+        u32 const last = first + std::min(grain, end - first);
+        schedule("parallel_for", [&function, first, last] { function(first, last); }, &counter);
+    }
+
+    function(begin, begin + grain);
+
+    wait(counter);
+}
+
+void JobSystem::run(JobGraph const& graph)
+{
+    u32 const node_count = graph.size();
+
+    if (node_count == 0)
+        return;
+
+    auto const remaining_dependencies = std::make_unique<std::atomic<u32>[]>(node_count);
+
+    for (u32 i = 0; i < node_count; ++i)
+    {
+        remaining_dependencies[i].store(graph.m_nodes[i].dependency_count, std::memory_order_relaxed);
+    }
+
+    JobCounter counter = 0;
+
+    // Dependents are scheduled before the job finishes, so the counter can't reach zero too early
+    std::function<void(u32)> schedule_node = [&](u32 const index) {
+        JobGraph::Node const& node = graph.m_nodes[index];
+
+        schedule(
+            node.name,
+            [&, index] {
+                graph.m_nodes[index].function();
+
+                for (u32 const dependent : graph.m_nodes[index].dependents)
+                {
+                    if (remaining_dependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        schedule_node(dependent);
+                }
+            },
+            &counter, node.thread);
+    };
+
+    for (u32 i = 0; i < node_count; ++i)
+    {
+        if (graph.m_nodes[i].dependency_count == 0)
+            schedule_node(i);
+    }
+
+    wait(counter);
+}
+
+void JobSystem::run_main_thread_jobs()
+{
+    assert(get_current_thread() == main_thread);
+
+    // Only the ones scheduled so far, jobs scheduling more main thread jobs can't keep this going forever
+    u32 job_count = m_threads[main_thread]->pinned_count.load(std::memory_order_acquire);
+
+    Job job = {};
+    while (job_count > 0 && try_pop_pinned(main_thread, job))
+    {
+        execute(job, main_thread);
+        job_count -= 1;
+    }
+}
+
+void JobSystem::set_profiling_hook(std::function<void(JobRecord const&)> hook)
+{
+    m_profiling_hook = std::move(hook);
+}
+
+u32 JobSystem::get_worker_count() const
+{
+    return static_cast<u32>(m_threads.size()) - 1;
+}
+
+u32 JobSystem::get_thread_count() const
+{
+    return static_cast<u32>(m_threads.size());
+}
+
+u32 JobSystem::get_current_thread() const
+{
+    return t_job_system == this ? t_thread_index : main_thread;
+}
+
+void JobSystem::worker_loop(std::stop_token const& stop_token, u32 const index)
+{
+    t_job_system = this;
+    t_thread_index = index;
+
+    Thread& self = *m_threads[index];
+
+    while (!stop_token.stop_requested())
+    {
+        if (try_run_job(index))
+            continue;
+
+        std::unique_lock lock(m_sleep_mutex);
+        m_work_available.wait(lock, stop_token, [&] {
+            return m_stealable_count.load(std::memory_order_acquire) > 0 || self.pinned_count.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+bool JobSystem::try_run_job(u32 const index)
+{
+    Job job = {};
+
+    if (try_pop_pinned(index, job) || try_pop(index, job) || try_steal(index, job))
+    {
+        execute(job, index);
+        return true;
+    }
+
+    return false;
+}
+
+bool JobSystem::try_pop_pinned(u32 const index, Job& job)
+{
+    Thread& thread = *m_threads[index];
+
+    if (thread.pinned_count.load(std::memory_order_acquire) == 0)
+        return false;
+
+    std::scoped_lock const lock(thread.mutex);
+
+    if (thread.pinned_jobs.empty())
+        return false;
+
+    job = std::move(thread.pinned_jobs.front());
+    thread.pinned_jobs.pop_front();
+    thread.pinned_count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::try_pop(u32 const index, Job& job)
+{
+    Thread& thread = *m_threads[index];
+    std::scoped_lock const lock(thread.mutex);
+
+    if (thread.jobs.empty())
+        return false;
+
+    job = std::move(thread.jobs.back());
+    thread.jobs.pop_back();
+    m_stealable_count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool JobSystem::try_steal(u32 const index, Job& job)
+{
+    u32 const thread_count = get_thread_count();
+
+    if (m_stealable_count.load(std::memory_order_acquire) == 0)
+        return false;
+
+    // Starting at the next thread, so not every thief goes for the same victim
+    for (u32 i = 1; i < thread_count; ++i)
+    {
+        Thread& victim = *m_threads[(index + i) % thread_count];
+        std::scoped_lock const lock(victim.mutex);
+
+        if (victim.jobs.empty())
+            continue;
+
+        job = std::move(victim.jobs.front());
+        victim.jobs.pop_front();
+        m_stealable_count.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+void JobSystem::execute(Job& job, u32 const index) const
+{
+    if (m_profiling_hook)
+    {
+        JobRecord record = {};
+        record.name = job.name;
+        record.thread = index;
+        record.start = std::chrono::steady_clock::now();
+
+        job.function();
+
+        record.end = std::chrono::steady_clock::now();
+        m_profiling_hook(record);
+    }
+    else
+    {
+        job.function();
+    }
+
+    // Function is released first, it might hold references that are only valid until the job counts as done
+    job.function = nullptr;
+
+    if (job.counter != nullptr)
+        job.counter->fetch_sub(1, std::memory_order_release);
+}
+
+JobStressResult JobSystem::run_stress_test(u32 const worker_count, u32 const iterations)
+{
+    JobStressResult result = {};
+    JobSystem jobs(worker_count);
+
+    std::atomic<u32> failures = 0;
+    std::atomic<u32> job_count = 0;
+    jobs.set_profiling_hook([&](JobRecord const&) { job_count.fetch_add(1, std::memory_order_relaxed); });
+
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    for (u32 iteration = 0; iteration < iterations; ++iteration)
+    {
+        // Every index is visited exactly once, also by parallel fors started inside of jobs
+        u32 constexpr outer_count = 64;
+        u32 constexpr inner_count = 256;
+        std::vector<std::atomic<u32>> visits(outer_count * inner_count);
+
+        jobs.parallel_for(0, outer_count, 4, [&](u32 const first, u32 const last) {
+            for (u32 outer = first; outer < last; ++outer)
+            {
+                jobs.parallel_for(0, inner_count, 16, [&, outer](u32 const inner_first, u32 const inner_last) {
+                    for (u32 inner = inner_first; inner < inner_last; ++inner)
+                    {
+                        visits[outer * inner_count + inner].fetch_add(1, std::memory_order_relaxed);
+                    }
+                });
+            }
+        });
+
+        for (auto const& visit : visits)
+        {
+            if (visit.load(std::memory_order_relaxed) != 1)
+                failures.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Chain of diamonds, every job checks that the jobs it depends on are done
+        u32 constexpr diamond_count = 16;
+        std::vector<std::atomic<bool>> is_done(diamond_count * 3 + 1);
+        JobGraph graph = {};
+
+        auto const add_checked = [&](u32 const thread, std::vector<u32> const& dependencies) {
+            u32 const node = graph.size();
+            graph.add(
+                "stress",
+                [&, node, thread, dependencies] {
+                    for (u32 const dependency : dependencies)
+                    {
+                        if (!is_done[dependency].load(std::memory_order_acquire))
+                            failures.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    if (thread != any_thread && jobs.get_current_thread() != thread)
+                        failures.fetch_add(1, std::memory_order_relaxed);
+
+                    is_done[node].store(true, std::memory_order_release);
+                },
+                thread);
+
+            for (u32 const dependency : dependencies)
+            {
+                graph.add_dependency(dependency, node);
+            }
+
+            return node;
+        };
+
+        u32 top = add_checked(main_thread, {});
+        for (u32 i = 0; i < diamond_count; ++i)
+        {
+            u32 const pinned_thread = worker_count > 0 ? 1 + i % worker_count : main_thread;
+            u32 const left = add_checked(any_thread, {top});
+            u32 const right = add_checked(pinned_thread, {top});
+            top = add_checked(i % 2 == 0 ? main_thread : any_thread, {left, right});
+        }
+
+        jobs.run(graph);
+
+        for (auto const& done : is_done)
+        {
+            if (!done.load(std::memory_order_relaxed))
+                failures.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    auto const end = std::chrono::high_resolution_clock::now();
+
+    result.jobs = job_count.load();
+    result.failures = failures.load();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+
+    return result;
+}
+
+std::vector<JobScalingResult> JobSystem::benchmark_scaling(u32 const max_threads, u32 const item_count)
+{
+    std::vector<JobScalingResult> results = {};
+    std::vector<float> values(item_count);
+
+    for (u32 threads = 1; threads <= std::max(max_threads, 1u); ++threads)
+    {
+        JobSystem jobs(threads - 1);
+
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        jobs.parallel_for(0, item_count, 1024, [&](u32 const first, u32 const last) {
+            for (u32 i = first; i < last; ++i)
+            {
+                float value = static_cast<float>(i);
+                for (u32 j = 0; j < 64; ++j)
+                {
+                    value = std::sin(value) + std::cos(value * 0.5f);
+                }
+
+                values[i] = value;
+            }
+        });
+
+        auto const end = std::chrono::high_resolution_clock::now();
+
+        JobScalingResult result = {};
+        result.threads = threads;
+        result.seconds = std::chrono::duration<double>(end - start).count();
+        result.speedup = results.empty() ? 1.0 : results.front().seconds / std::max(result.seconds, 1e-9);
+        results.emplace_back(result);
+    }
+
+    return results;
+}
+
+u32 JobGraph::add(char const* name, std::function<void()> function, u32 const thread)
+{
+    Node node = {};
+    node.name = name;
+    node.function = std::move(function);
+    node.thread = thread;
+    m_nodes.emplace_back(std::move(node));
+
+    return static_cast<u32>(m_nodes.size()) - 1;
+}
+
+void JobGraph::add_dependency(u32 const before, u32 const after)
+{
+    assert(before < after && after < m_nodes.size());
+
+    m_nodes[before].dependents.emplace_back(after);
+    m_nodes[after].dependency_count += 1;
+}
+
+u32 JobGraph::size() const
+{
+    return static_cast<u32>(m_nodes.size());
+}
+
+}
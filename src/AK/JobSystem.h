@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Types.h"
+
+namespace AK
+{
+
+class JobGraph;
+
+// Number of scheduled jobs that are not finished yet
+using JobCounter = std::atomic<u32>;
+
+struct JobRecord
+{
+    char const* name = nullptr;
+    u32 thread = 0;
+    std::chrono::steady_clock::time_point start = {};
+    std::chrono::steady_clock::time_point end = {};
+};
+
+struct JobStressResult
+{
+    u32 jobs = 0;
+    u32 failures = 0;
+    double seconds = 0.0;
+};
+
+struct JobScalingResult
+{
+    u32 threads = 0;
+    double seconds = 0.0;
+    double speedup = 0.0;
+};
+
+// Work stealing thread pool. Every thread has its own deque: it pushes and pops jobs at the back, other threads steal
+// from the front when they run out of work. Jobs can also be pinned to a thread, pinned jobs are never stolen.
+// Thread 0 is the thread that created the system, it runs jobs only while waiting or in run_main_thread_jobs().
+class JobSystem
+{
+public:
+    static constexpr u32 main_thread = 0;
+    static constexpr u32 any_thread = std::numeric_limits<u32>::max();
+
+    explicit JobSystem(u32 const worker_count);
+    ~JobSystem();
+
+    JobSystem(JobSystem const&) = delete;
+    void operator=(JobSystem const&) = delete;
+
+    // Zero workers means one for every hardware thread except the main one
+    static void initialize(u32 const worker_count);
+    static void uninitialize();
+
+    static std::shared_ptr<JobSystem> get_instance()
+    {
+        return m_instance;
+    }
+
+    // Thread is main_thread, a worker from 1 to get_worker_count() or any_thread. The counter, if any, is incremented
+    // now and decremented once the job is finished.
+    void schedule(char const* name, std::function<void()> function, JobCounter* const counter = nullptr, u32 const thread = any_thread);
+
+    // Runs other jobs until the counter drops to zero
+    void wait(JobCounter const& counter);
+
+    // Calls function(first, last) for consecutive ranges of at most grain_size indices and returns once all of them
+    // are done. The calling thread runs the first range itself.
+    void parallel_for(u32 const begin, u32 const end, u32 const grain_size, std::function<void(u32, u32)> const& function);
+
+    // Returns once every job of the graph is finished. Jobs pinned to the main thread run only if the main
+    // thread is the one waiting or it calls run_main_thread_jobs() in the meantime.
+    void run(JobGraph const& graph);
+
+    // Main thread only, runs the jobs pinned to it so far
+    void run_main_thread_jobs();
+
+    // Called on the thread that ran the job, right after it finished. Only change it while no jobs are running.
+    void set_profiling_hook(std::function<void(JobRecord const&)> hook);
+
+    [[nodiscard]] u32 get_worker_count() const;
+
+    // Workers and the main thread
+    [[nodiscard]] u32 get_thread_count() const;
+
+    // Threads that are not workers of this system count as the main thread
+    [[nodiscard]] u32 get_current_thread() const;
+
+    // Nested parallel fors, task graphs, main thread and pinned jobs, checking that every job ran once
+    // and where it should
+    static JobStressResult run_stress_test(u32 const worker_count, u32 const iterations);
+
+    // Same parallel for with 1 to max_threads threads
+    static std::vector<JobScalingResult> benchmark_scaling(u32 const max_threads, u32 const item_count);
+
+private:
+    struct Job
+    {
+        char const* name = nullptr;
+        std::function<void()> function = {};
+        JobCounter* counter = nullptr;
+    };
+
+    struct Thread
+    {
+        std::mutex mutex = {};
+
+        // Stealable jobs, the owner works at the back, thieves at the front
+        std::deque<Job> jobs = {};
+
+        // Jobs only this thread can run, in the order they were scheduled
+        std::deque<Job> pinned_jobs = {};
+        std::atomic<u32> pinned_count = 0;
+
+        std::jthread thread = {};
+    };
+
+    void worker_loop(std::stop_token const& stop_token, u32 const index);
+
+    // Pinned jobs first, then own jobs, then stolen ones
+    bool try_run_job(u32 const index);
+    bool try_pop_pinned(u32 const index, Job& job);
+    bool try_pop(u32 const index, Job& job);
+    bool try_steal(u32 const index, Job& job);
+
+    void execute(Job& job, u32 const index) const;
+
+    // Index 0 is the main thread, which has no std::thread of its own
+    std::vector<std::unique_ptr<Thread>> m_threads = {};
+
+    std::mutex m_sleep_mutex = {};
+    std::condition_variable_any m_work_available = {};
+    std::atomic<u32> m_stealable_count = 0;
+
+    std::function<void(JobRecord const&)> m_profiling_hook = {};
+
+    inline static std::shared_ptr<JobSystem> m_instance;
+};
+
+// Jobs with dependencies, a job starts once every job it depends on is finished. Can be run any number of times.
+class JobGraph
+{
+public:
+    u32 add(char const* name, std::function<void()> function, u32 const thread = JobSystem::any_thread);
+
+    // Jobs can only depend on jobs added before them, so the graph never has cycles
+    void add_dependency(u32 const before, u32 const after);
+
+    [[nodiscard]] u32 size() const;
+
+private:
+    struct Node
+    {
+        char const* name = nullptr;
+        std::function<void()> function = {};
+        u32 thread = JobSystem::any_thread;
+        u32 dependency_count = 0;
+        std::vector<u32> dependents = {};
+    };
+
+    std::vector<Node> m_nodes = {};
+
+    friend class JobSystem;
+};
+
+}
@@ -0,0 +1,97 @@
+#include "MappedFile.h"
+
+#if _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace AK
+{
+
+#if _WIN32
+
+std::unique_ptr<MappedFile> MappedFile::map(std::string const& file_path)
+{
+    HANDLE const file = CreateFileA(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    std::unique_ptr<MappedFile> mapped_file(new MappedFile());
+    mapped_file->m_file = file;
+
+    LARGE_INTEGER size = {};
+
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        return nullptr;
+
+    mapped_file->m_size = static_cast<size_t>(size.QuadPart);
+    mapped_file->m_mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapped_file->m_mapping == nullptr)
+        return nullptr;
+
+    mapped_file->m_data = static_cast<u8 const*>(MapViewOfFile(mapped_file->m_mapping, FILE_MAP_READ, 0, 0, 0));
+
+    if (mapped_file->m_data == nullptr)
+        return nullptr;
+
+    return mapped_file;
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+
+    if (m_mapping != nullptr)
+        CloseHandle(m_mapping);
+
+    if (m_file != nullptr)
+        CloseHandle(m_file);
+}
+
+#else
+
+std::unique_ptr<MappedFile> MappedFile::map(std::string const& file_path)
+{
+    int const file = open(file_path.c_str(), O_RDONLY);
+
+    if (file == -1)
+        return nullptr;
+
+    struct stat file_stat = {};
+
+    if (fstat(file, &file_stat) != 0 || file_stat.st_size == 0)
+    {
+        close(file);
+        return nullptr;
+    }
+
+    // NOTE: The mapping stays valid after the descriptor is closed.
+    void* const data = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+
+    if (data == MAP_FAILED)
+        return nullptr;
+
+    std::unique_ptr<MappedFile> mapped_file(new MappedFile());
+    mapped_file->m_data = static_cast<u8 const*>(data);
+    mapped_file->m_size = static_cast<size_t>(file_stat.st_size);
+    return mapped_file;
+}
+
+MappedFile::~MappedFile()
+{
+    if (m_data != nullptr)
+        munmap(const_cast<u8*>(m_data), m_size);
+}
+
+#endif
+
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Read-only view of a whole file mapped into memory, pages are read in by the OS when they are first touched
+class MappedFile
+{
+public:
+    // nullptr when the file can't be opened or is empty
+    static std::unique_ptr<MappedFile> map(std::string const& file_path);
+
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    void operator=(MappedFile const&) = delete;
+
+    [[nodiscard]] std::span<u8 const> get_data() const
+    {
+        return {m_data, m_size};
+    }
+
+private:
+    MappedFile() = default;
+
+    u8 const* m_data = nullptr;
+    size_t m_size = 0;
+
+#if _WIN32
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+#endif
+};
+
+}
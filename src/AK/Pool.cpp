@@ -0,0 +1,97 @@
+#include "Pool.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace AK
+{
+
+SlabPool::SlabPool(char const* name, u32 const block_size, u32 const alignment) : m_name(name)
+{
+    // Free blocks store the link to the next one in themselves
+    m_alignment = std::max(alignment, static_cast<u32>(alignof(FreeBlock)));
+    m_block_size = std::max(block_size, static_cast<u32>(sizeof(FreeBlock)));
+    m_block_size = (m_block_size + m_alignment - 1) / m_alignment * m_alignment;
+    m_blocks_per_slab = std::max(slab_size / m_block_size, min_blocks_per_slab);
+
+    std::scoped_lock const lock(m_pools_mutex);
+
+    if (m_last_pool != nullptr)
+        m_last_pool->m_next_pool = this;
+    else
+        m_first_pool = this;
+
+    m_last_pool = this;
+}
+
+void* SlabPool::allocate()
+{
+    std::scoped_lock const lock(m_mutex);
+
+    if (m_free_blocks == nullptr)
+        allocate_slab();
+
+    FreeBlock* const block = m_free_blocks;
+    m_free_blocks = block->next;
+
+    m_live_blocks += 1;
+    m_peak_blocks = std::max(m_peak_blocks, m_live_blocks);
+    m_allocations += 1;
+
+    return block;
+}
+
+void SlabPool::deallocate(void* block)
+{
+    assert(block != nullptr);
+
+    std::scoped_lock const lock(m_mutex);
+
+    // Last freed is the first reused, it is the most likely one to still be in the cache
+    m_free_blocks = new (block) FreeBlock {m_free_blocks};
+    m_live_blocks -= 1;
+}
+
+PoolStats SlabPool::get_stats() const
+{
+    std::scoped_lock const lock(m_mutex);
+
+    PoolStats stats = {};
+    stats.name = m_name;
+    stats.block_size = m_block_size;
+    stats.slab_count = static_cast<u32>(m_slabs.size());
+    stats.live_blocks = m_live_blocks;
+    stats.peak_blocks = m_peak_blocks;
+    stats.allocations = m_allocations;
+
+    return stats;
+}
+
+std::vector<PoolStats> SlabPool::get_all_stats()
+{
+    std::vector<PoolStats> stats = {};
+
+    std::scoped_lock const lock(m_pools_mutex);
+
+    for (SlabPool const* pool = m_first_pool; pool != nullptr; pool = pool->m_next_pool)
+    {
+        stats.emplace_back(pool->get_stats());
+    }
+
+    return stats;
+}
+
+void SlabPool::allocate_slab()
+{
+    auto const slab = static_cast<u8*>(::operator new(static_cast<std::size_t>(m_block_size) * m_blocks_per_slab,
+                                                      std::align_val_t(m_alignment)));
+    m_slabs.emplace_back(slab);
+
+    // Linked in address order, so a fresh slab is handed out front to back
+    for (u32 i = m_blocks_per_slab; i > 0; --i)
+    {
+        m_free_blocks = new (slab + static_cast<std::size_t>(i - 1) * m_block_size) FreeBlock {m_free_blocks};
+    }
+}
+
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <typeinfo>
+#include <vector>
+
+#include "Types.h"
+
+namespace AK
+{
+
+struct PoolStats
+{
+    char const* name = nullptr;
+    u32 block_size = 0;
+    u32 slab_count = 0;
+    u32 live_blocks = 0;
+    u32 peak_blocks = 0;
+    u64 allocations = 0;
+};
+
+// Blocks of one size carved out of bigger slabs. Freed blocks are reused before a new slab is allocated,
+// slabs are never given back, so objects that are created and destroyed all the time don't fragment the heap.
+class SlabPool
+{
+public:
+    SlabPool(char const* name, u32 const block_size, u32 const alignment);
+
+    SlabPool(SlabPool const&) = delete;
+    void operator=(SlabPool const&) = delete;
+
+    [[nodiscard]] void* allocate();
+    void deallocate(void* block);
+
+    [[nodiscard]] PoolStats get_stats() const;
+
+    // Of every pool, in the order they were created
+    static std::vector<PoolStats> get_all_stats();
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next = nullptr;
+    };
+
+    void allocate_slab();
+
+    // Slabs are about this big, but never hold fewer than min_blocks_per_slab blocks
+    static constexpr u32 slab_size = 64 * 1024;
+    static constexpr u32 min_blocks_per_slab = 16;
+
+    char const* m_name = nullptr;
+    u32 m_block_size = 0;
+    u32 m_alignment = 0;
+    u32 m_blocks_per_slab = 0;
+
+    mutable std::mutex m_mutex = {};
+    FreeBlock* m_free_blocks = nullptr;
+    std::vector<void*> m_slabs = {};
+
+    u32 m_live_blocks = 0;
+    u32 m_peak_blocks = 0;
+    u64 m_allocations = 0;
+
+    // Pools are linked when they are created and live until the program ends
+    SlabPool* m_next_pool = nullptr;
+    inline static std::mutex m_pools_mutex = {};
+    inline static SlabPool* m_first_pool = nullptr;
+    inline static SlabPool* m_last_pool = nullptr;
+};
+
+// Allocator giving every type its own SlabPool, named after Tag. Made for std::allocate_shared, which allocates
+// the object together with its control block, anything else than single objects goes to the global heap.
+template<typename T, typename Tag = T>
+class PoolAllocator
+{
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind
+    {
+        using other = PoolAllocator<U, Tag>;
+    };
+
+    PoolAllocator() = default;
+
+    template<typename U>
+    PoolAllocator(PoolAllocator<U, Tag> const&)
+    {
+    }
+
+    [[nodiscard]] T* allocate(std::size_t const count)
+    {
+        if (count != 1)
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(alignof(T))));
+
+        return static_cast<T*>(get_pool().allocate());
+    }
+
+    void deallocate(T* pointer, std::size_t const count)
+    {
+        if (count != 1)
+        {
+            ::operator delete(pointer, std::align_val_t(alignof(T)));
+            return;
+        }
+
+        get_pool().deallocate(pointer);
+    }
+
+    template<typename U>
+    bool operator==(PoolAllocator<U, Tag> const&) const
+    {
+        return true;
+    }
+
+private:
+    static SlabPool& get_pool()
+    {
+        // NOTE: Never destroyed, shared pointers held by other statics can still be released after main returns.
+        static SlabPool& pool = *new SlabPool(typeid(Tag).name(), sizeof(T), alignof(T));
+        return pool;
+    }
+};
+
+// std::make_shared with the object and its control block in T's pool
+template<typename T, typename... Args>
+std::shared_ptr<T> make_pooled(Args&&... args)
+{
+    return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+}
+
+}
@@ -53,3 +53,8 @@ bool BoundingBox::is_in_frustum(Frustum const& frustum) const
         && is_on_or_forward_plane(frustum.top_plane) && is_on_or_forward_plane(frustum.bottom_plane)
         && is_on_or_forward_plane(frustum.near_plane) && is_on_or_forward_plane(frustum.far_plane);
 }
+
+bool BoundingBox2D::overlaps(BoundingBox2D const& other) const
+{
+    return min.x <= other.max.x && max.x >= other.min.x && min.y <= other.max.y && max.y >= other.min.y;
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 
 #include "AK/Types.h"
@@ -33,6 +34,14 @@ struct BoundingBox
     [[nodiscard]] bool is_in_frustum(Frustum const& frustum) const;
 };
 
+struct BoundingBox2D
+{
+    glm::vec2 min = {};
+    glm::vec2 max = {};
+
+    [[nodiscard]] bool overlaps(BoundingBox2D const& other) const;
+};
+
 struct BoundingBoxShader
 {
     glm::vec3 center = {};
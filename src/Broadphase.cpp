@@ -0,0 +1,324 @@
+#include "Broadphase.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <utility>
+
+#include <glm/glm.hpp>
+
+void Broadphase::set_type(BroadphaseType const type)
+{
+    m_type = type;
+}
+
+BroadphaseType Broadphase::get_type() const
+{
+    return m_type;
+}
+
+void Broadphase::set_grid_bounds(glm::vec2 const& min, glm::vec2 const& max, u32 const cells_per_axis)
+{
+    assert(cells_per_axis > 0);
+    assert(max.x > min.x && max.y > min.y);
+
+    m_grid_min = min;
+    m_grid_max = max;
+    m_cells_per_axis = cells_per_axis;
+    m_inverse_cell_size = glm::vec2(static_cast<float>(cells_per_axis)) / (max - min);
+}
+
+void Broadphase::find_pairs(std::vector<BroadphaseProxy> const& proxies, DynamicAABBTree const& tree, std::vector<ColliderPair>& pairs)
+{
+    pairs.clear();
+
+    switch (m_type)
+    {
+    case BroadphaseType::BruteForce:
+        find_pairs_brute_force(proxies, pairs);
+        break;
+    case BroadphaseType::UniformGrid:
+        find_pairs_uniform_grid(proxies, pairs);
+        break;
+    case BroadphaseType::SweepAndPrune:
+        find_pairs_sweep_and_prune(proxies, pairs);
+        break;
+    case BroadphaseType::DynamicTree:
+        find_pairs_dynamic_tree(proxies, tree, pairs);
+        break;
+    default:
+        std::unreachable();
+    }
+
+    // Narrowphase resolves pairs in this order, keep it the same regardless of the backend
+    std::ranges::sort(pairs, [](ColliderPair const& a, ColliderPair const& b) {
+        return a.first < b.first || (a.first == b.first && a.second < b.second);
+    });
+}
+
+std::vector<BroadphaseBenchmark> Broadphase::benchmark(u32 const proxy_count, u32 const iterations)
+{
+    // Playfield grows with the count, so every proxy has about as many neighbours regardless of it
+    float const half_size = std::sqrt(static_cast<float>(proxy_count)) * 0.5f;
+
+    std::mt19937 generator(1);
+    std::uniform_real_distribution position_distribution(-half_size, half_size);
+    std::uniform_real_distribution extent_distribution(0.1f, 0.4f);
+    std::uniform_real_distribution velocity_distribution(-0.01f, 0.01f);
+
+    std::vector<BroadphaseProxy> proxies(proxy_count);
+    std::vector<glm::vec2> velocities(proxy_count);
+
+    for (u32 i = 0; i < proxy_count; ++i)
+    {
+        glm::vec2 const center = {position_distribution(generator), position_distribution(generator)};
+        glm::vec2 const extent = {extent_distribution(generator), extent_distribution(generator)};
+
+        proxies[i].bounds = {center - extent, center + extent};
+        proxies[i].is_static = i % 10 == 0;
+
+        if (!proxies[i].is_static)
+            velocities[i] = {velocity_distribution(generator), velocity_distribution(generator)};
+    }
+
+    std::vector<BroadphaseBenchmark> benchmarks = {};
+    std::vector<ColliderPair> pairs = {};
+    std::vector<i32> tree_proxies(proxy_count);
+
+    for (auto const type :
+         {BroadphaseType::BruteForce, BroadphaseType::UniformGrid, BroadphaseType::SweepAndPrune, BroadphaseType::DynamicTree})
+    {
+        // Every backend starts from the same proxies and moves them the same way
+        std::vector<BroadphaseProxy> moved_proxies = proxies;
+
+        DynamicAABBTree tree = {};
+
+        for (u32 i = 0; i < proxy_count; ++i)
+        {
+            tree_proxies[i] = tree.create_proxy(moved_proxies[i].bounds, i);
+        }
+
+        Broadphase broadphase = {};
+        broadphase.set_type(type);
+        broadphase.set_grid_bounds(glm::vec2(-half_size), glm::vec2(half_size));
+
+        BroadphaseBenchmark benchmark = {};
+        benchmark.type = type;
+        benchmark.proxies = proxy_count;
+        benchmark.iterations = std::max(iterations, 1u);
+
+        // Warm up, buffers of the backends grow to their size
+        broadphase.find_pairs(moved_proxies, tree, pairs);
+
+        for (u32 iteration = 0; iteration < benchmark.iterations; ++iteration)
+        {
+            for (u32 i = 0; i < proxy_count; ++i)
+            {
+                if (moved_proxies[i].is_static)
+                    continue;
+
+                moved_proxies[i].bounds.min += velocities[i];
+                moved_proxies[i].bounds.max += velocities[i];
+                tree.move_proxy(tree_proxies[i], moved_proxies[i].bounds);
+            }
+
+            auto const start = std::chrono::high_resolution_clock::now();
+
+            broadphase.find_pairs(moved_proxies, tree, pairs);
+
+            benchmark.seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+
+        benchmark.seconds /= benchmark.iterations;
+        benchmark.pairs = static_cast<u32>(pairs.size());
+        benchmarks.emplace_back(benchmark);
+    }
+
+    return benchmarks;
+}
+
+void Broadphase::find_pairs_brute_force(std::vector<BroadphaseProxy> const& proxies, std::vector<ColliderPair>& pairs)
+{
+    for (u32 i = 0; i < proxies.size(); ++i)
+    {
+        for (u32 j = i + 1; j < proxies.size(); ++j)
+        {
+            if (proxies[i].is_static && proxies[j].is_static)
+                continue;
+
+            if (proxies[i].bounds.overlaps(proxies[j].bounds))
+                pairs.emplace_back(i, j);
+        }
+    }
+}
+
+void Broadphase::find_pairs_uniform_grid(std::vector<BroadphaseProxy> const& proxies, std::vector<ColliderPair>& pairs)
+{
+    u32 const cell_count = m_cells_per_axis * m_cells_per_axis;
+
+    m_cell_ranges.resize(proxies.size());
+    m_cell_start.assign(cell_count + 1, 0);
+
+    // Count entries in every cell
+    for (u32 i = 0; i < proxies.size(); ++i)
+    {
+        CellRange& range = m_cell_ranges[i];
+        range.min_x = get_cell_coordinate(proxies[i].bounds.min.x, 0);
+        range.min_y = get_cell_coordinate(proxies[i].bounds.min.y, 1);
+        range.max_x = get_cell_coordinate(proxies[i].bounds.max.x, 0);
+        range.max_y = get_cell_coordinate(proxies[i].bounds.max.y, 1);
+
+        for (u32 y = range.min_y; y <= range.max_y; ++y)
+        {
+            for (u32 x = range.min_x; x <= range.max_x; ++x)
+            {
+                m_cell_start[y * m_cells_per_axis + x + 1] += 1;
+            }
+        }
+    }
+
+    for (u32 cell = 0; cell < cell_count; ++cell)
+    {
+        m_cell_start[cell + 1] += m_cell_start[cell];
+    }
+
+    // Fill the cells. Proxies are inserted in index order, so entries in a cell stay sorted.
+    m_cell_entries.resize(m_cell_start[cell_count]);
+
+    for (u32 i = 0; i < proxies.size(); ++i)
+    {
+        CellRange const& range = m_cell_ranges[i];
+
+        for (u32 y = range.min_y; y <= range.max_y; ++y)
+        {
+            for (u32 x = range.min_x; x <= range.max_x; ++x)
+            {
+                // NOTE: m_cell_start[cell] is used as a write cursor here and restored to the cell start afterwards.
+                u32 const cell = y * m_cells_per_axis + x;
+                m_cell_entries[m_cell_start[cell]] = i;
+                m_cell_start[cell] += 1;
+            }
+        }
+    }
+
+    for (u32 cell = cell_count; cell > 0; --cell)
+    {
+        m_cell_start[cell] = m_cell_start[cell - 1];
+    }
+    m_cell_start[0] = 0;
+
+    for (u32 cell = 0; cell < cell_count; ++cell)
+    {
+        u32 const cell_x = cell % m_cells_per_axis;
+        u32 const cell_y = cell / m_cells_per_axis;
+
+        for (u32 i = m_cell_start[cell]; i < m_cell_start[cell + 1]; ++i)
+        {
+            u32 const a = m_cell_entries[i];
+
+            for (u32 j = i + 1; j < m_cell_start[cell + 1]; ++j)
+            {
+                u32 const b = m_cell_entries[j];
+
+                if (proxies[a].is_static && proxies[b].is_static)
+                    continue;
+
+                // A pair sharing multiple cells is only reported from the first cell both of them occupy
+                if (cell_x != std::max(m_cell_ranges[a].min_x, m_cell_ranges[b].min_x)
+                    || cell_y != std::max(m_cell_ranges[a].min_y, m_cell_ranges[b].min_y))
+                    continue;
+
+                if (proxies[a].bounds.overlaps(proxies[b].bounds))
+                    pairs.emplace_back(a, b);
+            }
+        }
+    }
+}
+
+void Broadphase::find_pairs_sweep_and_prune(std::vector<BroadphaseProxy> const& proxies, std::vector<ColliderPair>& pairs)
+{
+    auto const is_before = [&proxies](u32 const a, u32 const b) { return proxies[a].bounds.min.x < proxies[b].bounds.min.x; };
+
+    if (m_sorted_proxies.size() != proxies.size())
+    {
+        m_sorted_proxies.resize(proxies.size());
+        std::iota(m_sorted_proxies.begin(), m_sorted_proxies.end(), 0);
+        std::ranges::sort(m_sorted_proxies, is_before);
+    }
+    else
+    {
+        // Insertion sort, the order from the previous step is almost always still valid
+        for (u32 i = 1; i < m_sorted_proxies.size(); ++i)
+        {
+            u32 const proxy = m_sorted_proxies[i];
+            u32 j = i;
+
+            while (j > 0 && is_before(proxy, m_sorted_proxies[j - 1]))
+            {
+                m_sorted_proxies[j] = m_sorted_proxies[j - 1];
+                --j;
+            }
+
+            m_sorted_proxies[j] = proxy;
+        }
+    }
+
+    for (u32 i = 0; i < m_sorted_proxies.size(); ++i)
+    {
+        u32 const a = m_sorted_proxies[i];
+        BoundingBox2D const& bounds = proxies[a].bounds;
+
+        for (u32 j = i + 1; j < m_sorted_proxies.size(); ++j)
+        {
+            u32 const b = m_sorted_proxies[j];
+
+            // Every following proxy starts even further to the right
+            if (proxies[b].bounds.min.x > bounds.max.x)
+                break;
+
+            if (proxies[a].is_static && proxies[b].is_static)
+                continue;
+
+            if (bounds.min.y <= proxies[b].bounds.max.y && bounds.max.y >= proxies[b].bounds.min.y)
+                pairs.emplace_back(std::min(a, b), std::max(a, b));
+        }
+    }
+}
+
+void Broadphase::find_pairs_dynamic_tree(std::vector<BroadphaseProxy> const& proxies, DynamicAABBTree const& tree,
+                                         std::vector<ColliderPair>& pairs)
+{
+    for (u32 i = 0; i < proxies.size(); ++i)
+    {
+        // Static proxies are found by querying with the dynamic ones
+        if (proxies[i].is_static)
+            continue;
+
+        BoundingBox2D const& bounds = proxies[i].bounds;
+
+        tree.query(bounds, [&](u32 const j) {
+            // Pairs of two dynamic proxies are reported from the smaller index only
+            if (j == i || (!proxies[j].is_static && j < i))
+                return true;
+
+            // The tree stores fattened bounds
+            if (bounds.overlaps(proxies[j].bounds))
+                pairs.emplace_back(std::min(i, j), std::max(i, j));
+
+            return true;
+        });
+    }
+}
+
+u32 Broadphase::get_cell_coordinate(float const value, u32 const axis) const
+{
+    float const cell = (value - m_grid_min[axis]) * m_inverse_cell_size[axis];
+
+    if (!(cell > 0.0f))
+        return 0;
+
+    return std::min(static_cast<u32>(cell), m_cells_per_axis - 1);
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "AK/Types.h"
+#include "Bounds.h"
+#include "DynamicAABBTree.h"
+
+enum class BroadphaseType
+{
+    BruteForce = 0,
+    UniformGrid = 1,
+    SweepAndPrune = 2,
+    DynamicTree = 3,
+};
+
+// Unordered pair of indices into the proxies passed to Broadphase::find_pairs. First is always smaller than second.
+struct ColliderPair
+{
+    u32 first = 0;
+    u32 second = 0;
+};
+
+struct BroadphaseProxy
+{
+    BoundingBox2D bounds = {};
+    bool is_static = false;
+};
+
+struct BroadphaseBenchmark
+{
+    BroadphaseType type = BroadphaseType::BruteForce;
+    u32 proxies = 0;
+    u32 pairs = 0;
+    u32 iterations = 0;
+
+    // Average of a single find_pairs()
+    double seconds = 0.0;
+};
+
+class Broadphase
+{
+public:
+    Broadphase() = default;
+
+    void set_type(BroadphaseType const type);
+    [[nodiscard]] BroadphaseType get_type() const;
+
+    // Area covered by the uniform grid. Proxies outside of it end up in the border cells.
+    void set_grid_bounds(glm::vec2 const& min, glm::vec2 const& max, u32 const cells_per_axis = 16);
+
+    // Fills pairs with every pair of proxies whose bounds overlap. Each pair is reported once, pairs are sorted
+    // by (first, second) so the order doesn't depend on the backend, and static-static pairs are never reported.
+    // The tree is only used by the DynamicTree backend, its user data has to be the index of the proxy
+    // and its fattened bounds have to contain the bounds of the proxy.
+    void find_pairs(std::vector<BroadphaseProxy> const& proxies, DynamicAABBTree const& tree, std::vector<ColliderPair>& pairs);
+
+    // Runs every backend over the same generated proxies, a tenth of them static, the rest moving a little every
+    // iteration. Independent of any scene, the proxies are always generated from the same seed.
+    static std::vector<BroadphaseBenchmark> benchmark(u32 const proxy_count, u32 const iterations);
+
+private:
+    struct CellRange
+    {
+        u32 min_x = 0;
+        u32 min_y = 0;
+        u32 max_x = 0;
+        u32 max_y = 0;
+    };
+
+    static void find_pairs_brute_force(std::vector<BroadphaseProxy> const& proxies, std::vector<ColliderPair>& pairs);
+    void find_pairs_uniform_grid(std::vector<BroadphaseProxy> const& proxies, std::vector<ColliderPair>& pairs);
+    void find_pairs_sweep_and_prune(std::vector<BroadphaseProxy> const& proxies, std::vector<ColliderPair>& pairs);
+    static void find_pairs_dynamic_tree(std::vector<BroadphaseProxy> const& proxies, DynamicAABBTree const& tree,
+                                        std::vector<ColliderPair>& pairs);
+
+    [[nodiscard]] u32 get_cell_coordinate(float const value, u32 const axis) const;
+
+    BroadphaseType m_type = BroadphaseType::SweepAndPrune;
+
+    glm::vec2 m_grid_min = {-10.0f, -10.0f};
+    glm::vec2 m_grid_max = {10.0f, 10.0f};
+    glm::vec2 m_inverse_cell_size = {0.8f, 0.8f};
+    u32 m_cells_per_axis = 16;
+
+    // Uniform grid, rebuilt every step with a counting sort so it doesn't allocate once warmed up
+    std::vector<CellRange> m_cell_ranges = {};
+    std::vector<u32> m_cell_start = {};
+    std::vector<u32> m_cell_entries = {};
+
+    // Sweep and prune, proxies sorted by min x. Kept between steps since the order barely changes.
+    std::vector<u32> m_sorted_proxies = {};
+};
@@ -20,7 +20,7 @@ std::shared_ptr<Button> Button::create()
     auto const ui_material = Material::create(ui_shader, Renderer::ui_render_order + 1);
     ui_material->casts_shadows = false;
 
-    auto button = std::make_shared<Button>(AK::Badge<Button> {}, ui_material);
+    auto button = AK::make_pooled<Button>(AK::Badge<Button> {}, ui_material);
 
     button->prepare();
 
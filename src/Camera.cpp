@@ -112,7 +112,7 @@ Frustum Camera::get_frustum()
 
 std::shared_ptr<Camera> Camera::create()
 {
-    auto camera = std::make_shared<Camera>(AK::Badge<Camera> {});
+    auto camera = AK::make_pooled<Camera>(AK::Badge<Camera> {});
 
     if (get_main_camera() == nullptr)
         set_main_camera(camera);
@@ -122,7 +122,7 @@ std::shared_ptr<Camera> Camera::create()
 
 std::shared_ptr<Camera> Camera::create(float const width, float const height, float const fov)
 {
-    auto camera = std::make_shared<Camera>(AK::Badge<Camera> {}, width, height, fov);
+    auto camera = AK::make_pooled<Camera>(AK::Badge<Camera> {}, width, height, fov);
 
     if (get_main_camera() == nullptr)
         set_main_camera(camera);
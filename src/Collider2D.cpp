@@ -7,6 +7,7 @@
 #include "Entity.h"
 #include "Globals.h"
 #include "PhysicsEngine.h"
+#include "Rigidbody2D.h"
 
 #if EDITOR
 #include "imgui_extensions.h"
@@ -15,27 +16,29 @@
 #include <glm/gtc/type_ptr.inl>
 #include <glm/gtx/quaternion.hpp>
 
+#include <algorithm>
+
 std::shared_ptr<Collider2D> Collider2D::create()
 {
-    auto collider_2d = std::make_shared<Collider2D>(AK::Badge<Collider2D> {}, 1.0f, false);
+    auto collider_2d = AK::make_pooled<Collider2D>(AK::Badge<Collider2D> {}, 1.0f, false);
     return collider_2d;
 }
 
 std::shared_ptr<Collider2D> Collider2D::create(float const radius, bool is_static)
 {
-    auto collider_2d = std::make_shared<Collider2D>(AK::Badge<Collider2D> {}, radius, is_static);
+    auto collider_2d = AK::make_pooled<Collider2D>(AK::Badge<Collider2D> {}, radius, is_static);
     return collider_2d;
 }
 
 std::shared_ptr<Collider2D> Collider2D::create(glm::vec2 const bounds_dimensions, bool is_static)
 {
-    auto collider_2d = std::make_shared<Collider2D>(AK::Badge<Collider2D> {}, bounds_dimensions, is_static);
+    auto collider_2d = AK::make_pooled<Collider2D>(AK::Badge<Collider2D> {}, bounds_dimensions, is_static);
     return collider_2d;
 }
 
 std::shared_ptr<Collider2D> Collider2D::create(float const width, float const height, bool const is_static)
 {
-    auto collider_2d = std::make_shared<Collider2D>(AK::Badge<Collider2D> {}, width, height, is_static);
+    auto collider_2d = AK::make_pooled<Collider2D>(AK::Badge<Collider2D> {}, width, height, is_static);
     return collider_2d;
 }
 
@@ -97,12 +100,22 @@ void Collider2D::draw_editor()
         ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Use EXTENTS to control collider size.");
         m_debug_drawing->set_drawing_type(DrawingType::Box);
     }
+    else if (collider_type == ColliderType2D::Capsule)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Use RADIUS and LENGTH to control collider size.");
+        m_debug_drawing->set_drawing_type(DrawingType::Box);
+    }
+    else if (collider_type == ColliderType2D::Polygon)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Use VERTICES to control collider shape.");
+        m_debug_drawing->set_drawing_type(DrawingType::Box);
+    }
 
     ImGui::Spacing();
     ImGui::Spacing();
 
     // Dropdown list
-    std::array const collider_types = {"Rectangle", "Circle"};
+    std::array const collider_types = {"Rectangle", "Circle", "Capsule", "Polygon"};
     i32 current_item_index = static_cast<i32>(collider_type);
     if (ImGui::Combo("Collider Type", &current_item_index, collider_types.data(), collider_types.size()))
     {
@@ -135,6 +148,53 @@ void Collider2D::draw_editor()
             set_extents({extents[0], extents[1]});
         }
     }
+    else if (collider_type == ColliderType2D::Capsule)
+    {
+        float const previous_radius = radius;
+        float const previous_height = height;
+        ImGui::InputFloat("Radius", &radius);
+        ImGui::InputFloat("Length", &height);
+
+        if (!AK::Math::are_nearly_equal(previous_radius, radius) || !AK::Math::are_nearly_equal(previous_height, height))
+        {
+            is_dirty = true;
+            m_is_shape_dirty = true;
+        }
+    }
+    else if (collider_type == ColliderType2D::Polygon)
+    {
+        for (u32 i = 0; i < vertices.size(); ++i)
+        {
+            ImGui::PushID(static_cast<i32>(i));
+
+            if (ImGui::InputFloat2("Vertex", glm::value_ptr(vertices[i]), "%.3f", ImGuiInputTextFlags_CharsDecimal))
+                is_dirty = true;
+
+            ImGui::SameLine();
+
+            bool const is_removed = ImGui::Button("Remove");
+
+            ImGui::PopID();
+
+            if (is_removed)
+            {
+                vertices.erase(vertices.begin() + i);
+                is_dirty = true;
+                break;
+            }
+        }
+
+        if (ImGui::Button("Add Vertex"))
+        {
+            vertices.emplace_back(0.0f, 0.0f);
+            is_dirty = true;
+        }
+
+        if (vertices.size() > ConvexShape2D::max_points)
+        {
+            ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "Only %u vertices of the convex hull are used.", ConvexShape2D::max_points);
+        }
+    }
 
     ImGui::Spacing();
     ImGui::Spacing();
@@ -143,6 +203,16 @@ void Collider2D::draw_editor()
 
     ImGui::Checkbox("Static", &is_static);
 
+    ImGui::Checkbox("Continuous", &is_continuous);
+
+    i32 layer = static_cast<i32>(collision_layer);
+    if (ImGui::SliderInt("Collision Layer", &layer, 0, static_cast<i32>(collision_layer_count) - 1))
+    {
+        collision_layer = static_cast<u32>(layer);
+    }
+
+    ImGuiEx::InputLayerMask("Collides With", &collision_mask);
+
     ImGui::Spacing();
     ImGui::Spacing();
 
@@ -153,7 +223,7 @@ void Collider2D::draw_editor()
         {
             m_debug_drawing->set_drawing_type(DrawingType::Sphere);
         }
-        else if (collider_type == ColliderType2D::Rectangle)
+        else
         {
             m_debug_drawing->set_drawing_type(DrawingType::Box);
         }
@@ -166,6 +236,13 @@ void Collider2D::draw_editor()
 void Collider2D::initialize()
 {
     Component::initialize();
+
+    // Rigidbody added earlier didn't find this collider in its initialize()
+    if (auto const rigidbody = entity->get_component<Rigidbody2D>(); rigidbody != nullptr)
+    {
+        m_rigidbody = rigidbody.get();
+    }
+
     PhysicsEngine::get_instance()->emplace_collider(std::static_pointer_cast<Collider2D>(shared_from_this()));
 
     switch (collider_type)
@@ -180,6 +257,16 @@ void Collider2D::initialize()
         m_debug_drawing_entity->transform->set_parent(entity->transform);
         break;
 
+    case ColliderType2D::Capsule:
+    case ColliderType2D::Polygon:
+    {
+        glm::vec2 const half_extents = get_local_half_extents();
+        m_debug_drawing_entity =
+            Debug::draw_debug_box({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f}, {half_extents.x * 4.0f, 0.5f, half_extents.y * 4.0f});
+        m_debug_drawing_entity->transform->set_parent(entity->transform);
+        break;
+    }
+
     default:
         std::unreachable();
     }
@@ -222,12 +309,13 @@ void Collider2D::awake()
 void Collider2D::set_collider_type(ColliderType2D new_collider_type)
 {
     collider_type = new_collider_type;
+    m_is_shape_dirty = true;
 
     if (new_collider_type == ColliderType2D::Circle)
     {
         m_debug_drawing->set_drawing_type(DrawingType::Sphere);
     }
-    else if (new_collider_type == ColliderType2D::Rectangle)
+    else
     {
         m_debug_drawing->set_drawing_type(DrawingType::Box);
     }
@@ -236,6 +324,7 @@ void Collider2D::set_collider_type(ColliderType2D new_collider_type)
 void Collider2D::set_radius_2d(float const new_radius)
 {
     radius = new_radius;
+    m_is_shape_dirty = true;
 }
 
 float Collider2D::get_radius_2d() const
@@ -247,6 +336,7 @@ void Collider2D::set_extents(glm::vec2 const extents)
 {
     width = extents.x;
     height = extents.y;
+    m_is_shape_dirty = true;
 }
 
 glm::vec2 Collider2D::get_extents() const
@@ -284,6 +374,7 @@ void Collider2D::set_bounds_dimensions_2d(float const new_width, float const new
 {
     width = new_width;
     height = new_height;
+    m_is_shape_dirty = true;
 }
 
 std::array<glm::vec2, 4> Collider2D::get_corners() const
@@ -296,61 +387,33 @@ std::array<glm::vec2, 2> Collider2D::get_axes() const
     return m_axes;
 }
 
-void Collider2D::apply_mtv(glm::vec2 const mtv) const
-{
-    glm::vec2 const new_position = AK::convert_3d_to_2d(entity->transform->get_position()) + mtv * 0.5f;
-    entity->transform->set_position(AK::convert_2d_to_3d(new_position, entity->transform->get_position().y));
-}
-
-bool Collider2D::is_inside_trigger(std::string const& guid) const
-{
-    return m_inside_trigger.contains(guid);
-}
-
-std::weak_ptr<Collider2D> Collider2D::get_inside_trigger(std::string const& guid) const
-{
-    return m_inside_trigger.at(guid);
-}
-
-std::vector<std::weak_ptr<Collider2D>> Collider2D::get_inside_trigger_vector() const
-{
-    return m_inside_trigger_vector;
-}
-
-void Collider2D::add_inside_trigger(std::string const& guid, std::shared_ptr<Collider2D> const& collider)
+BoundingBox2D Collider2D::get_bounds() const
 {
-    m_inside_trigger.emplace(guid, collider);
-    m_inside_trigger_vector.emplace_back(collider);
+    return m_bounds;
 }
 
-auto Collider2D::set_inside_trigger(std::unordered_map<std::string, std::weak_ptr<Collider2D>> const& map,
-                                    std::vector<std::weak_ptr<Collider2D>> const& vector) -> void
+ConvexShape2D const& Collider2D::get_shape() const
 {
-    m_inside_trigger = map;
-    m_inside_trigger_vector = vector;
+    return m_shape;
 }
 
-std::vector<std::weak_ptr<Collider2D>> Collider2D::get_all_overlapping_this_frame() const
+bool Collider2D::update_center_and_corners_if_needed()
 {
-    return m_overlapped_this_frame;
-}
+    if (!m_is_shape_dirty && m_transform_version == entity->transform->get_version())
+        return false;
 
-void Collider2D::add_overlapped_this_frame(std::shared_ptr<Collider2D> const& collider)
-{
-    m_overlapped_this_frame.emplace_back(collider);
-    m_overlapped_this_frame_map.emplace(collider->guid, collider);
+    update_center_and_corners();
+    return true;
 }
 
-void Collider2D::clear_overlapped_this_frame()
+void Collider2D::apply_mtv(glm::vec2 const mtv) const
 {
-    m_overlapped_this_frame.clear();
-    m_overlapped_this_frame_map.clear();
+    glm::vec2 const new_position = AK::convert_3d_to_2d(entity->transform->get_position()) + mtv * 0.5f;
+    entity->transform->set_position(AK::convert_2d_to_3d(new_position, entity->transform->get_position().y));
 }
 
 void Collider2D::physics_update()
 {
-    update_center_and_corners();
-
     if (glm::epsilonEqual(velocity, {0.0f, 0.0f}, 0.001f) != glm::bvec2(true, true))
     {
         entity->transform->set_position(entity->transform->get_position()
@@ -362,7 +425,25 @@ void Collider2D::physics_update()
 
 void Collider2D::add_force(glm::vec2 const force)
 {
+    if (m_rigidbody != nullptr)
+    {
+        m_rigidbody->add_impulse(force);
+        return;
+    }
+
     velocity += force;
+    wake_up();
+}
+
+bool Collider2D::is_asleep() const
+{
+    return m_is_asleep;
+}
+
+void Collider2D::wake_up()
+{
+    m_is_asleep = false;
+    m_still_steps = 0;
 }
 
 void Collider2D::update_center_and_corners()
@@ -372,10 +453,30 @@ void Collider2D::update_center_and_corners()
     glm::quat const rotation = entity->transform->get_rotation();
 
     compute_axes(position_2d, rotation);
+    compute_shape(position_2d, rotation);
+
+    m_center = position_2d;
+
+    // Same as the corners for rectangles and the center grown by the radius for circles
+    m_bounds = {m_shape.points[0], m_shape.points[0]};
+
+    for (u32 i = 1; i < m_shape.count; ++i)
+    {
+        m_bounds.min = glm::min(m_bounds.min, m_shape.points[i]);
+        m_bounds.max = glm::max(m_bounds.max, m_shape.points[i]);
+    }
+
+    m_bounds.min -= m_shape.radius;
+    m_bounds.max += m_shape.radius;
+
+    // Moving the debug drawing doesn't touch our own transform, so the version can be read after compute_axes()
+    m_transform_version = entity->transform->get_version();
+    m_is_shape_dirty = false;
+    m_bounds_changed = true;
 }
 
 // NOTE: Should be called everytime the position has changed.
-//       Currently we just update it every frame.
+//       Called by update_center_and_corners_if_needed() when the transform version changes.
 void Collider2D::compute_axes(glm::vec2 const& center, glm::quat const& rotation)
 {
     glm::vec2 const half_extents = {width * 0.5f, height * 0.5f};
@@ -411,5 +512,72 @@ void Collider2D::compute_axes(glm::vec2 const& center, glm::quat const& rotation
 
     // Debug drawing
     m_debug_drawing_entity->transform->set_position(AK::convert_2d_to_3d(center));
-    m_debug_drawing->set_extents({width, 0.25f, height});
+
+    if (collider_type == ColliderType2D::Capsule || collider_type == ColliderType2D::Polygon)
+    {
+        glm::vec2 const half_extents = get_local_half_extents();
+        m_debug_drawing->set_extents({half_extents.x * 2.0f, 0.25f, half_extents.y * 2.0f});
+    }
+    else
+    {
+        m_debug_drawing->set_extents({width, 0.25f, height});
+    }
+}
+
+void Collider2D::compute_shape(glm::vec2 const& center, glm::quat const& rotation)
+{
+    auto const to_world = [&](glm::vec2 const& local_point) {
+        return center + AK::convert_3d_to_2d(rotation * AK::convert_2d_to_3d(local_point));
+    };
+
+    switch (collider_type)
+    {
+    case ColliderType2D::Circle:
+        m_shape = {};
+        m_shape.points[0] = center;
+        m_shape.count = 1;
+        m_shape.radius = radius;
+        break;
+
+    case ColliderType2D::Rectangle:
+        m_shape = {};
+        std::ranges::copy(m_corners, m_shape.points.begin());
+        m_shape.count = 4;
+        break;
+
+    case ColliderType2D::Capsule:
+        m_shape = {};
+        m_shape.points[0] = to_world({0.0f, -height * 0.5f});
+        m_shape.points[1] = to_world({0.0f, height * 0.5f});
+        m_shape.count = 2;
+        m_shape.radius = radius;
+        break;
+
+    case ColliderType2D::Polygon:
+        m_shape = ConvexShape2D::make_hull(vertices);
+
+        for (u32 i = 0; i < m_shape.count; ++i)
+        {
+            m_shape.points[i] = to_world(m_shape.points[i]);
+        }
+        break;
+
+    default:
+        std::unreachable();
+    }
+}
+
+glm::vec2 Collider2D::get_local_half_extents() const
+{
+    if (collider_type == ColliderType2D::Capsule)
+        return {radius, height * 0.5f + radius};
+
+    glm::vec2 half_extents = {};
+
+    for (auto const& vertex : vertices)
+    {
+        half_extents = glm::max(half_extents, glm::abs(vertex));
+    }
+
+    return half_extents;
 }
@@ -3,13 +3,19 @@
 #include "AK/AK.h"
 #include "AK/Badge.h"
 #include "AK/Types.h"
+#include "Bounds.h"
 #include "Component.h"
+#include "DynamicAABBTree.h"
+#include "GJK.h"
 #include "glm/glm.hpp"
 
 #include <array>
-#include <unordered_map>
+#include <compare>
+#include <limits>
+#include <vector>
 
 class DebugDrawing;
+class Rigidbody2D;
 
 struct CollisionInfo
 {
@@ -17,10 +23,25 @@ struct CollisionInfo
     glm::vec2 mtv = {0, 0};
 };
 
+// Stable identifier of a collider registered in the PhysicsEngine. Slots are reused once a collider is removed,
+// the generation tells apart colliders that used the same slot.
+struct ColliderHandle
+{
+    u32 slot = std::numeric_limits<u32>::max();
+    u32 generation = 0;
+
+    auto operator<=>(ColliderHandle const&) const = default;
+};
+
+inline constexpr u32 collision_layer_count = 32;
+inline constexpr u32 all_collision_layers = 0xFFFFFFFF;
+
 enum class ColliderType2D
 {
     Rectangle = 0,
     Circle = 1,
+    Capsule = 2,
+    Polygon = 3,
 };
 
 class Collider2D final : public Component
@@ -53,8 +74,14 @@ public:
     virtual void awake() override;
     void physics_update();
 
+    // Wakes the collider up. Goes to the Rigidbody2D as an impulse if the entity has one.
     void add_force(glm::vec2 const force);
 
+    // Asleep colliders are not moved by their velocity and pairs of two asleep colliders are not tested.
+    // Contact with an awake collider, add_force() or writing to the transform wakes them up.
+    [[nodiscard]] bool is_asleep() const;
+    void wake_up();
+
     void apply_mtv(glm::vec2 const mtv) const;
 
     void set_collider_type(ColliderType2D const new_collider_type);
@@ -73,17 +100,15 @@ public:
     std::array<glm::vec2, 4> get_corners() const;
     std::array<glm::vec2, 2> get_axes() const;
 
-    // Internal functions meant to be used by the PhysicsEngine
-    bool is_inside_trigger(std::string const& guid) const;
-    std::weak_ptr<Collider2D> get_inside_trigger(std::string const& guid) const;
-    std::vector<std::weak_ptr<Collider2D>> get_inside_trigger_vector() const;
-    void add_inside_trigger(std::string const& guid, std::shared_ptr<Collider2D> const& collider);
-    void set_inside_trigger(std::unordered_map<std::string, std::weak_ptr<Collider2D>> const& map,
-                            std::vector<std::weak_ptr<Collider2D>> const& vector);
+    // World space bounds cached in update_center_and_corners()
+    BoundingBox2D get_bounds() const;
+
+    // World space shape for GJK cached in update_center_and_corners()
+    ConvexShape2D const& get_shape() const;
 
-    std::vector<std::weak_ptr<Collider2D>> get_all_overlapping_this_frame() const;
-    void add_overlapped_this_frame(std::shared_ptr<Collider2D> const& collider);
-    void clear_overlapped_this_frame();
+    // Recomputes the cached center, corners and bounds only if the transform or the shape changed since the last update.
+    // Returns true if they were recomputed.
+    bool update_center_and_corners_if_needed();
 
     void update_center_and_corners();
 
@@ -92,28 +117,69 @@ public:
     bool is_trigger = false;
     bool is_static = false;
 
+    // Circle is swept along its velocity and stopped at the first impact, so it doesn't pass through thin or small
+    // colliders at high speed. Ignored for rectangles and triggers.
+    bool is_continuous = false;
+
+    // Layer index, from 0 to collision_layer_count - 1, and the layers this collider can collide with.
+    // Both colliders of a pair have to accept each other and their layers have to collide in the PhysicsEngine's matrix.
+    u32 collision_layer = 0;
+    u32 collision_mask = all_collision_layers;
+
     ColliderType2D collider_type = ColliderType2D::Circle;
 
     float width = 1.0f; // For rectangle
-    float height = 1.0f; // For rectangle
+    float height = 1.0f; // For rectangle, distance between the cap centers for capsule
+
+    float radius = 1.0f; // For circle and capsule
 
-    float radius = 1.0f; // For circle
+    // For polygon, in local space. Their convex hull is used, at most ConvexShape2D::max_points of it.
+    std::vector<glm::vec2> vertices = {};
 
-    // FIXME: This should belong to some kind of Rigidbody component.
+    // Used only without a Rigidbody2D, which has its own.
     float drag = 0.01f;
     glm::vec2 velocity = {};
 
 private:
     void compute_axes(glm::vec2 const& center, glm::quat const& rotation);
-
-    std::array<glm::vec2, 4> m_corners = {}; // For rectangle, calculated each frame
-    std::array<glm::vec2, 2> m_axes = {}; // For rectangle, calculated each frame
-
-    std::unordered_map<std::string, std::weak_ptr<Collider2D>> m_inside_trigger = {};
-    std::vector<std::weak_ptr<Collider2D>> m_inside_trigger_vector = {};
-
-    std::vector<std::weak_ptr<Collider2D>> m_overlapped_this_frame = {};
-    std::unordered_map<std::string, std::weak_ptr<Collider2D>> m_overlapped_this_frame_map = {};
+    void compute_shape(glm::vec2 const& center, glm::quat const& rotation);
+
+    // Half size of the debug drawing box for capsules and polygons
+    glm::vec2 get_local_half_extents() const;
+
+    std::array<glm::vec2, 4> m_corners = {}; // For rectangle, calculated when the transform changes
+    std::array<glm::vec2, 2> m_axes = {}; // For rectangle, calculated when the transform changes
+    glm::vec2 m_center = {};
+    BoundingBox2D m_bounds = {};
+    ConvexShape2D m_shape = {};
+
+    u32 m_transform_version = std::numeric_limits<u32>::max();
+    bool m_is_shape_dirty = true;
+
+    // Index in PhysicsEngine's colliders, its handle and the proxy in its tree, managed by the PhysicsEngine
+    u32 m_physics_index = std::numeric_limits<u32>::max();
+    ColliderHandle m_handle = {};
+    i32 m_tree_proxy = DynamicAABBTree::null_node;
+    bool m_bounds_changed = true;
+
+    // Sleep state, managed by the PhysicsEngine. Position and transform version are the ones from the end of the last step.
+    bool m_is_asleep = false;
+    u32 m_still_steps = 0;
+    glm::vec2 m_sleep_position = {};
+    u32 m_sleep_transform_version = std::numeric_limits<u32>::max();
+
+    // Local positions at the end of the last two fixed steps, rendering interpolates between them.
+    // Pose version is the transform version the current position was recorded with.
+    glm::vec3 m_previous_local_position = {};
+    glm::vec3 m_current_local_position = {};
+    u32 m_pose_version = std::numeric_limits<u32>::max();
+
+    // Set by the Rigidbody2D on the same entity
+    Rigidbody2D* m_rigidbody = nullptr;
+
+    friend class PhysicsEngine;
+    friend class Rigidbody2D;
+    friend struct ColliderStore;
 
     std::shared_ptr<Entity> m_debug_drawing_entity = nullptr;
     std::shared_ptr<DebugDrawing> m_debug_drawing = nullptr;
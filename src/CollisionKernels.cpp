@@ -0,0 +1,936 @@
+#include "CollisionKernels.h"
+
+#include "AK/JobSystem.h"
+#include "AK/Math.h"
+#include "Collider2D.h"
+#include "Entity.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <tuple>
+
+#if COLLISION_KERNELS_SSE || COLLISION_KERNELS_AVX2
+#include <immintrin.h>
+#endif
+
+void ColliderStore::push_back()
+{
+    types.emplace_back();
+    center_x.emplace_back();
+    center_y.emplace_back();
+    position_x.emplace_back();
+    position_y.emplace_back();
+    radii.emplace_back();
+    extents.emplace_back();
+    corners_x.emplace_back();
+    corners_y.emplace_back();
+    axes.emplace_back();
+    edge_normals.emplace_back();
+    shapes.emplace_back();
+    handles.emplace_back();
+    transform_versions.emplace_back();
+}
+
+void ColliderStore::swap_remove(u32 const index)
+{
+    assert(index < size());
+
+    auto const remove = [index](auto& column) {
+        column[index] = column.back();
+        column.pop_back();
+    };
+
+    remove(types);
+    remove(center_x);
+    remove(center_y);
+    remove(position_x);
+    remove(position_y);
+    remove(radii);
+    remove(extents);
+    remove(corners_x);
+    remove(corners_y);
+    remove(axes);
+    remove(edge_normals);
+    remove(shapes);
+    remove(handles);
+    remove(transform_versions);
+}
+
+void ColliderStore::clear()
+{
+    types.clear();
+    center_x.clear();
+    center_y.clear();
+    position_x.clear();
+    position_y.clear();
+    radii.clear();
+    extents.clear();
+    corners_x.clear();
+    corners_y.clear();
+    axes.clear();
+    edge_normals.clear();
+    shapes.clear();
+    handles.clear();
+    transform_versions.clear();
+}
+
+void ColliderStore::write(u32 const index, Collider2D const& collider, glm::vec2 const& center)
+{
+    assert(index < size());
+
+    types[index] = collider.collider_type;
+    center_x[index] = center.x;
+    center_y[index] = center.y;
+
+    glm::vec2 const position = AK::convert_3d_to_2d(collider.entity->transform->get_position());
+    position_x[index] = position.x;
+    position_y[index] = position.y;
+
+    radii[index] = collider.get_radius_2d();
+    extents[index] = collider.get_extents();
+
+    std::array const corners = collider.get_corners();
+    for (u8 i = 0; i < 4; ++i)
+    {
+        corners_x[index][i] = corners[i].x;
+        corners_y[index][i] = corners[i].y;
+    }
+
+    axes[index] = collider.get_axes();
+    edge_normals[index] = {AK::Math::get_perpendicular_axis(corners, 0), AK::Math::get_perpendicular_axis(corners, 1)};
+
+    shapes[index] = collider.m_shape;
+
+    if (collider.collider_type == ColliderType2D::Circle)
+        shapes[index].points[0] = center;
+
+    handles[index] = collider.m_handle;
+
+    transform_versions[index] = collider.entity->transform->get_version();
+}
+
+u32 ColliderStore::size() const
+{
+    return static_cast<u32>(types.size());
+}
+
+void CollisionKernels::run(ColliderStore const& store, std::vector<ColliderPair> const& pairs, std::vector<NarrowphaseResult>& results,
+                           AK::JobSystem* const jobs)
+{
+    u32 const pair_count = static_cast<u32>(pairs.size());
+    u32 chunk_count = 1;
+
+    if (jobs != nullptr)
+    {
+        u32 const max_chunks = (pair_count + min_pairs_per_chunk - 1) / min_pairs_per_chunk;
+        chunk_count = std::clamp(max_chunks, 1u, jobs->get_thread_count());
+    }
+
+    if (m_chunks.size() < chunk_count)
+        m_chunks.resize(chunk_count);
+
+    std::span<ColliderPair const> const all_pairs = pairs;
+    u32 const pairs_per_chunk = (pair_count + chunk_count - 1) / chunk_count;
+
+    auto const chunk_range = [&](u32 const chunk) {
+        u32 const begin = std::min(chunk * pairs_per_chunk, pair_count);
+        u32 const end = std::min(begin + pairs_per_chunk, pair_count);
+        return all_pairs.subspan(begin, end - begin);
+    };
+
+    if (chunk_count == 1)
+    {
+        run_chunk(store, all_pairs, m_axis_cache, true, m_chunks[0]);
+    }
+    else
+    {
+        jobs->parallel_for(0, chunk_count, 1, [&](u32 const first, u32 const last) {
+            for (u32 chunk = first; chunk < last; ++chunk)
+            {
+                run_chunk(store, chunk_range(chunk), m_axis_cache, true, m_chunks[chunk]);
+            }
+        });
+    }
+
+    // Merged in chunk order, which is the order of the pairs
+    results.clear();
+    m_axis_cache.clear();
+    m_axis_early_out_count = 0;
+
+    for (u32 chunk = 0; chunk < chunk_count; ++chunk)
+    {
+        results.insert(results.end(), m_chunks[chunk].results.begin(), m_chunks[chunk].results.end());
+        m_axis_cache.insert(m_axis_cache.end(), m_chunks[chunk].axes.begin(), m_chunks[chunk].axes.end());
+        m_axis_early_out_count += m_chunks[chunk].axis_early_outs;
+    }
+
+    // Pairs that were not tested this step are dropped from the cache
+    m_convex_pair_count = static_cast<u32>(m_axis_cache.size());
+    std::ranges::sort(m_axis_cache, [](CachedAxis const& a, CachedAxis const& b) {
+        return std::tie(a.first, a.second) < std::tie(b.first, b.second);
+    });
+}
+
+u32 CollisionKernels::get_convex_pair_count() const
+{
+    return m_convex_pair_count;
+}
+
+u32 CollisionKernels::get_axis_early_out_count() const
+{
+    return m_axis_early_out_count;
+}
+
+void CollisionKernels::run_chunk(ColliderStore const& store, std::span<ColliderPair const> const pairs,
+                                 std::span<CachedAxis const> const cache, bool const is_simd, Chunk& chunk)
+{
+    chunk.results.resize(pairs.size());
+    chunk.circle_circle_pairs.clear();
+    chunk.axes.clear();
+    chunk.axis_early_outs = 0;
+
+    for (u32 i = 0; i < pairs.size(); ++i)
+    {
+        auto const [first, second] = pairs[i];
+        ColliderType2D const first_type = store.types[first];
+        ColliderType2D const second_type = store.types[second];
+
+        // Circle pairs are the most common ones and are batched across pairs, rectangles are vectorized within a pair
+        if (first_type == ColliderType2D::Circle && second_type == ColliderType2D::Circle)
+        {
+            chunk.circle_circle_pairs.emplace_back(i);
+            continue;
+        }
+
+        NarrowphaseResult& result = chunk.results[i];
+        result.mtv = {};
+
+        if (is_convex_pair(store, first, second))
+            result.is_overlapping = convex_cached(store, first, second, cache, chunk, result.mtv);
+        else
+            result.is_overlapping = compute_penetration(store, first, second, is_simd, result.mtv);
+    }
+
+    circle_circle_batch(store, pairs, chunk.circle_circle_pairs, is_simd, chunk.results);
+}
+
+bool CollisionKernels::convex_cached(ColliderStore const& store, u32 const first, u32 const second,
+                                     std::span<CachedAxis const> const cache, Chunk& chunk, glm::vec2& mtv)
+{
+    // Pairs are looked up the same way regardless of the order the broadphase reported them in
+    bool const is_flipped = store.handles[second] < store.handles[first];
+    CachedAxis cached = {store.handles[first], store.handles[second], {}};
+
+    if (is_flipped)
+        std::swap(cached.first, cached.second);
+
+    auto const it = std::ranges::lower_bound(cache, std::tie(cached.first, cached.second), {},
+                                             [](CachedAxis const& entry) { return std::tie(entry.first, entry.second); });
+
+    bool const has_cached_axis = it != cache.end() && it->first == cached.first && it->second == cached.second;
+    glm::vec2 axis = {};
+
+    if (has_cached_axis)
+        axis = is_flipped ? -it->axis : it->axis;
+
+    bool is_overlapping = false;
+
+    // Shapes moved little since the last step, so the axis that separated them then usually still does
+    if (has_cached_axis && GJK::is_separated_along(store.shapes[first], store.shapes[second], axis))
+    {
+        chunk.axis_early_outs += 1;
+    }
+    else
+    {
+        is_overlapping = convex(store, first, second, axis, mtv);
+    }
+
+    cached.axis = is_flipped ? -axis : axis;
+    chunk.axes.emplace_back(cached);
+
+    return is_overlapping;
+}
+
+bool CollisionKernels::compute_penetration(ColliderStore const& store, u32 const first, u32 const second, glm::vec2& mtv)
+{
+    return compute_penetration(store, first, second, true, mtv);
+}
+
+bool CollisionKernels::compute_penetration(ColliderStore const& store, u32 const first, u32 const second, bool const is_simd,
+                                           glm::vec2& mtv)
+{
+    ColliderType2D const first_type = store.types[first];
+    ColliderType2D const second_type = store.types[second];
+
+    if (first_type == ColliderType2D::Circle && second_type == ColliderType2D::Circle)
+    {
+        return circle_circle(store, first, second, mtv);
+    }
+
+    if (first_type == ColliderType2D::Rectangle && second_type == ColliderType2D::Rectangle)
+    {
+        return rectangle_rectangle(store, first, second, is_simd, mtv);
+    }
+
+    if (first_type == ColliderType2D::Circle && second_type == ColliderType2D::Rectangle)
+    {
+        return circle_rectangle(store, first, second, is_simd, mtv);
+    }
+
+    if (first_type == ColliderType2D::Rectangle && second_type == ColliderType2D::Circle)
+    {
+        bool const overlapped = circle_rectangle(store, second, first, is_simd, mtv);
+        mtv = -mtv;
+        return overlapped;
+    }
+
+    glm::vec2 axis = {};
+    return convex(store, first, second, axis, mtv);
+}
+
+bool CollisionKernels::convex(ColliderStore const& store, u32 const first, u32 const second, glm::vec2& axis, glm::vec2& mtv)
+{
+    return GJK::find_penetration(store.shapes[first], store.shapes[second], axis, mtv);
+}
+
+bool CollisionKernels::is_convex_pair(ColliderStore const& store, u32 const first, u32 const second)
+{
+    auto const is_convex = [](ColliderType2D const type) { return type == ColliderType2D::Capsule || type == ColliderType2D::Polygon; };
+    return is_convex(store.types[first]) || is_convex(store.types[second]);
+}
+
+NarrowphaseBenchmark CollisionKernels::benchmark(ColliderStore const& store, std::span<ColliderPair const> const pairs,
+                                                 u32 const iterations)
+{
+    NarrowphaseBenchmark benchmark = {};
+    std::vector<ColliderPair> tested_pairs = {};
+
+    for (auto const& pair : pairs)
+    {
+        if (pair.first < store.size() && pair.second < store.size() && !is_convex_pair(store, pair.first, pair.second))
+            tested_pairs.emplace_back(pair);
+    }
+
+    benchmark.pairs = static_cast<u32>(tested_pairs.size());
+
+    std::vector<NarrowphaseResult> specific_results(tested_pairs.size());
+    std::vector<NarrowphaseResult> convex_results(tested_pairs.size());
+
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    for (u32 iteration = 0; iteration < iterations; ++iteration)
+    {
+        for (u32 i = 0; i < tested_pairs.size(); ++i)
+        {
+            NarrowphaseResult& result = specific_results[i];
+            result.is_overlapping = compute_penetration(store, tested_pairs[i].first, tested_pairs[i].second, result.mtv);
+        }
+    }
+
+    auto const middle = std::chrono::high_resolution_clock::now();
+
+    for (u32 iteration = 0; iteration < iterations; ++iteration)
+    {
+        for (u32 i = 0; i < tested_pairs.size(); ++i)
+        {
+            NarrowphaseResult& result = convex_results[i];
+            glm::vec2 axis = {};
+            result.is_overlapping = convex(store, tested_pairs[i].first, tested_pairs[i].second, axis, result.mtv);
+        }
+    }
+
+    auto const end = std::chrono::high_resolution_clock::now();
+
+    benchmark.specific_seconds = std::chrono::duration<double>(middle - start).count();
+    benchmark.convex_seconds = std::chrono::duration<double>(end - middle).count();
+
+    // Circle pairs report half of the depth, compared by the length of the MTV only since rectangle pairs point it the other way
+    for (u32 i = 0; i < tested_pairs.size(); ++i)
+    {
+        NarrowphaseResult const& specific = specific_results[i];
+        NarrowphaseResult const& convex_result = convex_results[i];
+
+        bool const are_circles =
+            store.types[tested_pairs[i].first] == ColliderType2D::Circle && store.types[tested_pairs[i].second] == ColliderType2D::Circle;
+        float const specific_depth = glm::length(specific.mtv) * (are_circles ? 2.0f : 1.0f);
+
+        if (specific.is_overlapping != convex_result.is_overlapping
+            || (specific.is_overlapping && std::abs(specific_depth - glm::length(convex_result.mtv)) > 0.01f))
+        {
+            benchmark.mismatched_pairs += 1;
+        }
+    }
+
+    return benchmark;
+}
+
+KernelBenchmark CollisionKernels::benchmark_simd(u32 const collider_count, u32 const iterations)
+{
+    KernelBenchmark benchmark = {};
+    benchmark.colliders = collider_count;
+    benchmark.iterations = std::max(iterations, 1u);
+    benchmark.simd_width = simd_width;
+
+    // Playfield grows with the count, crowded enough for most candidate pairs to overlap
+    float const half_size = std::sqrt(static_cast<float>(collider_count)) * 0.4f;
+
+    ColliderStore store = {};
+    std::vector<BroadphaseProxy> proxies = {};
+    generate_colliders(collider_count, half_size, store, proxies);
+
+    std::vector<ColliderPair> pairs = {};
+    Broadphase broadphase = {};
+    broadphase.find_pairs(proxies, DynamicAABBTree {}, pairs);
+
+    benchmark.pairs = static_cast<u32>(pairs.size());
+
+    Chunk simd_chunk = {};
+    Chunk scalar_chunk = {};
+
+    // Warm up, buffers of the chunks grow to their size
+    run_chunk(store, pairs, {}, true, simd_chunk);
+    run_chunk(store, pairs, {}, false, scalar_chunk);
+
+    // Alternating, so both of them run with the same state of the caches and clocks
+    for (u32 iteration = 0; iteration < benchmark.iterations; ++iteration)
+    {
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        run_chunk(store, pairs, {}, true, simd_chunk);
+
+        auto const middle = std::chrono::high_resolution_clock::now();
+
+        run_chunk(store, pairs, {}, false, scalar_chunk);
+
+        auto const end = std::chrono::high_resolution_clock::now();
+
+        benchmark.simd_seconds += std::chrono::duration<double>(middle - start).count();
+        benchmark.scalar_seconds += std::chrono::duration<double>(end - middle).count();
+    }
+
+    benchmark.simd_seconds /= benchmark.iterations;
+    benchmark.scalar_seconds /= benchmark.iterations;
+
+    for (u32 i = 0; i < pairs.size(); ++i)
+    {
+        NarrowphaseResult const& simd = simd_chunk.results[i];
+        NarrowphaseResult const& scalar = scalar_chunk.results[i];
+
+        if (simd.is_overlapping)
+            benchmark.overlapping_pairs += 1;
+
+        if (simd.is_overlapping != scalar.is_overlapping || std::memcmp(&simd.mtv, &scalar.mtv, sizeof(glm::vec2)) != 0)
+            benchmark.mismatched_pairs += 1;
+    }
+
+    return benchmark;
+}
+
+std::vector<CollisionBenchmark> CollisionKernels::benchmark_collisions(u32 const collider_count, u32 const iterations)
+{
+    // Playfield grows with the count, so every collider has about as many neighbours regardless of it
+    float const half_size = std::sqrt(static_cast<float>(collider_count)) * 0.5f;
+
+    ColliderStore store = {};
+    std::vector<BroadphaseProxy> proxies = {};
+    generate_colliders(collider_count, half_size, store, proxies);
+
+    for (u32 i = 0; i < collider_count; ++i)
+    {
+        proxies[i].is_static = i % 10 == 0;
+    }
+
+    std::vector<CollisionBenchmark> benchmarks = {};
+
+    CollisionBenchmark ordered_benchmark = {};
+    ordered_benchmark.colliders = collider_count;
+    ordered_benchmark.iterations = std::max(iterations, 1u);
+
+    // Every pair twice, once in each order, the same as solve_collisions() before it had a broadphase
+    for (u32 iteration = 0; iteration < ordered_benchmark.iterations; ++iteration)
+    {
+        u32 pairs = 0;
+        u32 overlapping_pairs = 0;
+
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (u32 i = 0; i < collider_count; ++i)
+        {
+            for (u32 j = 0; j < collider_count; ++j)
+            {
+                if (i == j || (proxies[i].is_static && proxies[j].is_static))
+                    continue;
+
+                glm::vec2 mtv = {};
+                pairs += 1;
+
+                if (compute_penetration(store, i, j, mtv))
+                    overlapping_pairs += 1;
+            }
+        }
+
+        ordered_benchmark.seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        ordered_benchmark.pairs = pairs;
+        ordered_benchmark.overlapping_pairs = overlapping_pairs;
+    }
+
+    ordered_benchmark.seconds /= ordered_benchmark.iterations;
+    benchmarks.emplace_back(ordered_benchmark);
+
+    DynamicAABBTree tree = {};
+
+    for (u32 i = 0; i < collider_count; ++i)
+    {
+        tree.create_proxy(proxies[i].bounds, i);
+    }
+
+    std::vector<ColliderPair> pairs = {};
+    std::vector<NarrowphaseResult> results = {};
+
+    for (auto const type :
+         {BroadphaseType::BruteForce, BroadphaseType::UniformGrid, BroadphaseType::SweepAndPrune, BroadphaseType::DynamicTree})
+    {
+        Broadphase broadphase = {};
+        broadphase.set_type(type);
+        broadphase.set_grid_bounds(glm::vec2(-half_size), glm::vec2(half_size));
+
+        CollisionKernels kernels = {};
+
+        CollisionBenchmark benchmark = {};
+        benchmark.broadphase = type;
+        benchmark.colliders = collider_count;
+        benchmark.iterations = std::max(iterations, 1u);
+
+        // Warm up, buffers of the backend and the kernels grow to their size
+        broadphase.find_pairs(proxies, tree, pairs);
+        kernels.run(store, pairs, results);
+
+        for (u32 iteration = 0; iteration < benchmark.iterations; ++iteration)
+        {
+            auto const start = std::chrono::high_resolution_clock::now();
+
+            broadphase.find_pairs(proxies, tree, pairs);
+            kernels.run(store, pairs, results);
+
+            benchmark.seconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        }
+
+        benchmark.seconds /= benchmark.iterations;
+        benchmark.pairs = static_cast<u32>(pairs.size());
+        benchmark.overlapping_pairs = static_cast<u32>(std::ranges::count(results, true, &NarrowphaseResult::is_overlapping));
+        benchmarks.emplace_back(benchmark);
+    }
+
+    return benchmarks;
+}
+
+bool CollisionKernels::circle_circle(ColliderStore const& store, u32 const first, u32 const second, glm::vec2& mtv)
+{
+    glm::vec2 const center1_2d = {store.center_x[first], store.center_y[first]};
+    glm::vec2 const center2_2d = {store.center_x[second], store.center_y[second]};
+
+    float const positions_distance = glm::distance(center1_2d, center2_2d);
+    float const radius_sum = store.radii[first] + store.radii[second];
+
+    bool const are_overlapping = positions_distance < radius_sum;
+
+    if (are_overlapping)
+    {
+        mtv = 0.5f * (glm::normalize(center1_2d - center2_2d) * (store.radii[first] + store.radii[second] - positions_distance));
+    }
+
+    return are_overlapping;
+}
+
+void CollisionKernels::circle_circle_batch(ColliderStore const& store, std::span<ColliderPair const> const pairs,
+                                           std::vector<u32> const& indices, [[maybe_unused]] bool const is_simd,
+                                           std::vector<NarrowphaseResult>& results)
+{
+    u32 i = 0;
+
+#if COLLISION_KERNELS_AVX2
+    for (; is_simd && i + 8 <= indices.size(); i += 8)
+    {
+        alignas(32) std::array<float, 8> x1, y1, x2, y2, r1, r2;
+
+        for (u32 lane = 0; lane < 8; ++lane)
+        {
+            auto const [first, second] = pairs[indices[i + lane]];
+            x1[lane] = store.center_x[first];
+            y1[lane] = store.center_y[first];
+            x2[lane] = store.center_x[second];
+            y2[lane] = store.center_y[second];
+            r1[lane] = store.radii[first];
+            r2[lane] = store.radii[second];
+        }
+
+        __m256 const dx = _mm256_sub_ps(_mm256_load_ps(x1.data()), _mm256_load_ps(x2.data()));
+        __m256 const dy = _mm256_sub_ps(_mm256_load_ps(y1.data()), _mm256_load_ps(y2.data()));
+        __m256 const distance_squared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+        __m256 const distance = _mm256_sqrt_ps(distance_squared);
+        __m256 const radius_sum = _mm256_add_ps(_mm256_load_ps(r1.data()), _mm256_load_ps(r2.data()));
+
+        __m256 const inverse_length = _mm256_div_ps(_mm256_set1_ps(1.0f), distance);
+        __m256 const penetration = _mm256_sub_ps(radius_sum, distance);
+        __m256 const half = _mm256_set1_ps(0.5f);
+        __m256 const mtv_x = _mm256_mul_ps(half, _mm256_mul_ps(_mm256_mul_ps(dx, inverse_length), penetration));
+        __m256 const mtv_y = _mm256_mul_ps(half, _mm256_mul_ps(_mm256_mul_ps(dy, inverse_length), penetration));
+        i32 const overlapping = _mm256_movemask_ps(_mm256_cmp_ps(distance, radius_sum, _CMP_LT_OQ));
+
+        alignas(32) std::array<float, 8> out_x, out_y;
+        _mm256_store_ps(out_x.data(), mtv_x);
+        _mm256_store_ps(out_y.data(), mtv_y);
+
+        for (u32 lane = 0; lane < 8; ++lane)
+        {
+            NarrowphaseResult& result = results[indices[i + lane]];
+            result.is_overlapping = (overlapping >> lane) & 1;
+            result.mtv = result.is_overlapping ? glm::vec2(out_x[lane], out_y[lane]) : glm::vec2(0.0f);
+        }
+    }
+#endif
+
+#if COLLISION_KERNELS_SSE
+    for (; is_simd && i + 4 <= indices.size(); i += 4)
+    {
+        alignas(16) std::array<float, 4> x1, y1, x2, y2, r1, r2;
+
+        for (u32 lane = 0; lane < 4; ++lane)
+        {
+            auto const [first, second] = pairs[indices[i + lane]];
+            x1[lane] = store.center_x[first];
+            y1[lane] = store.center_y[first];
+            x2[lane] = store.center_x[second];
+            y2[lane] = store.center_y[second];
+            r1[lane] = store.radii[first];
+            r2[lane] = store.radii[second];
+        }
+
+        // Same operations as glm::distance() and glm::normalize() in circle_circle()
+        __m128 const dx = _mm_sub_ps(_mm_load_ps(x1.data()), _mm_load_ps(x2.data()));
+        __m128 const dy = _mm_sub_ps(_mm_load_ps(y1.data()), _mm_load_ps(y2.data()));
+        __m128 const distance_squared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        __m128 const distance = _mm_sqrt_ps(distance_squared);
+        __m128 const radius_sum = _mm_add_ps(_mm_load_ps(r1.data()), _mm_load_ps(r2.data()));
+
+        __m128 const inverse_length = _mm_div_ps(_mm_set1_ps(1.0f), distance);
+        __m128 const penetration = _mm_sub_ps(radius_sum, distance);
+        __m128 const half = _mm_set1_ps(0.5f);
+        __m128 const mtv_x = _mm_mul_ps(half, _mm_mul_ps(_mm_mul_ps(dx, inverse_length), penetration));
+        __m128 const mtv_y = _mm_mul_ps(half, _mm_mul_ps(_mm_mul_ps(dy, inverse_length), penetration));
+        i32 const overlapping = _mm_movemask_ps(_mm_cmplt_ps(distance, radius_sum));
+
+        alignas(16) std::array<float, 4> out_x, out_y;
+        _mm_store_ps(out_x.data(), mtv_x);
+        _mm_store_ps(out_y.data(), mtv_y);
+
+        for (u32 lane = 0; lane < 4; ++lane)
+        {
+            NarrowphaseResult& result = results[indices[i + lane]];
+            result.is_overlapping = (overlapping >> lane) & 1;
+            result.mtv = result.is_overlapping ? glm::vec2(out_x[lane], out_y[lane]) : glm::vec2(0.0f);
+        }
+    }
+#endif
+
+    for (; i < indices.size(); ++i)
+    {
+        auto const [first, second] = pairs[indices[i]];
+        NarrowphaseResult& result = results[indices[i]];
+        result.mtv = {};
+        result.is_overlapping = circle_circle(store, first, second, result.mtv);
+    }
+}
+
+bool CollisionKernels::rectangle_rectangle(ColliderStore const& store, u32 const first, u32 const second, glm::vec2& mtv)
+{
+    return rectangle_rectangle(store, first, second, true, mtv);
+}
+
+bool CollisionKernels::rectangle_rectangle(ColliderStore const& store, u32 const first, u32 const second,
+                                           [[maybe_unused]] bool const is_simd, glm::vec2& mtv)
+{
+    // Axes of the first rectangle followed by the axes of the second one
+    std::array const axes = {store.edge_normals[first][0], store.edge_normals[first][1], store.edge_normals[second][0],
+                             store.edge_normals[second][1]};
+
+    std::array<float, 4> overlaps = {};
+
+#if COLLISION_KERNELS_SSE
+    if (is_simd)
+    {
+        // Every lane projects both rectangles onto a different axis
+        __m128 const axis_x = _mm_setr_ps(axes[0].x, axes[1].x, axes[2].x, axes[3].x);
+        __m128 const axis_y = _mm_setr_ps(axes[0].y, axes[1].y, axes[2].y, axes[3].y);
+
+        auto const project = [&](u32 const rectangle, __m128& min, __m128& max) {
+            min = _mm_set1_ps(std::numeric_limits<float>::infinity());
+            max = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+
+            for (u8 i = 0; i < 4; ++i)
+            {
+                __m128 const projection = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(store.corners_x[rectangle][i]), axis_x),
+                                                     _mm_mul_ps(_mm_set1_ps(store.corners_y[rectangle][i]), axis_y));
+
+                // Operand order keeps the first of equal projections, like AK::Math::project_on_axis()
+                min = _mm_min_ps(projection, min);
+                max = _mm_max_ps(projection, max);
+            }
+        };
+
+        __m128 min1, max1, min2, max2;
+        project(first, min1, max1);
+        project(second, min2, max2);
+
+        _mm_storeu_ps(overlaps.data(), _mm_sub_ps(_mm_min_ps(max1, max2), _mm_max_ps(min1, min2)));
+    }
+    else
+#endif
+    {
+        for (u8 axis = 0; axis < 4; ++axis)
+        {
+            std::array<glm::vec2, 4> corners1 = {};
+            std::array<glm::vec2, 4> corners2 = {};
+
+            for (u8 i = 0; i < 4; ++i)
+            {
+                corners1[i] = {store.corners_x[first][i], store.corners_y[first][i]};
+                corners2[i] = {store.corners_x[second][i], store.corners_y[second][i]};
+            }
+
+            glm::vec2 const projection1 = AK::Math::project_on_axis(corners1, axes[axis]);
+            glm::vec2 const projection2 = AK::Math::project_on_axis(corners2, axes[axis]);
+
+            overlaps[axis] = std::min(projection1.y, projection2.y) - std::max(projection1.x, projection2.x);
+        }
+    }
+
+    // We need to find the minimal overlap and axis on which it happens.
+    float min_overlap = std::numeric_limits<float>::infinity();
+    glm::vec2 smallest_axis = {};
+
+    for (u8 axis = 0; axis < 4; ++axis)
+    {
+        // Shapes are not overlapping. Disjoint ranges give a negative overlap here, the same as 0 from
+        // AK::Math::get_ranges_overlap_length() as far as this check goes.
+        if (!(overlaps[axis] >= 0.05f))
+        {
+            return false;
+        }
+
+        if (overlaps[axis] < min_overlap)
+        {
+            min_overlap = overlaps[axis];
+            smallest_axis = axes[axis];
+        }
+    }
+
+    mtv = smallest_axis * min_overlap;
+
+    glm::vec2 const center1 = {store.position_x[first], store.position_y[first]};
+    glm::vec2 const center2 = {store.position_x[second], store.position_y[second]};
+
+    // Need to reverse the MTV if center offset and overlap are not pointing in the same direction.
+    if (glm::dot(center2 - center1, mtv) < 0.0f)
+        mtv = -mtv;
+
+    return true;
+}
+
+bool CollisionKernels::circle_rectangle(ColliderStore const& store, u32 const circle, u32 const rectangle, glm::vec2& mtv)
+{
+    return circle_rectangle(store, circle, rectangle, true, mtv);
+}
+
+bool CollisionKernels::circle_rectangle(ColliderStore const& store, u32 const circle, u32 const rectangle,
+                                        [[maybe_unused]] bool const is_simd, glm::vec2& mtv)
+{
+    assert(store.types[circle] == ColliderType2D::Circle && store.types[rectangle] == ColliderType2D::Rectangle);
+
+    glm::vec2 const center = {store.center_x[circle], store.center_y[circle]};
+    float const radius = store.radii[circle];
+
+    // Circle center is inside the rectangle, so it doesn't intersect with any of the sides but still collides with it.
+    // Needed when spawning a circle inside a rectangle or after fast movement.
+    if (is_point_inside_obb(store, rectangle, center))
+    {
+        glm::vec2 axis = {};
+        return convex(store, circle, rectangle, axis, mtv);
+    }
+
+    // Penetration of the circle with every side of the rectangle, the side from corner i to corner i + 1
+    std::array<float, 4> distances = {};
+    std::array<float, 4> push_x = {};
+    std::array<float, 4> push_y = {};
+
+    auto const& corners_x = store.corners_x[rectangle];
+    auto const& corners_y = store.corners_y[rectangle];
+
+#if COLLISION_KERNELS_SSE
+    if (is_simd)
+    {
+        __m128 const p1_x = _mm_loadu_ps(corners_x.data());
+        __m128 const p1_y = _mm_loadu_ps(corners_y.data());
+        __m128 const p2_x = _mm_shuffle_ps(p1_x, p1_x, _MM_SHUFFLE(0, 3, 2, 1));
+        __m128 const p2_y = _mm_shuffle_ps(p1_y, p1_y, _MM_SHUFFLE(0, 3, 2, 1));
+        __m128 const center_x = _mm_set1_ps(center.x);
+        __m128 const center_y = _mm_set1_ps(center.y);
+
+        __m128 const v_x = _mm_sub_ps(center_x, p1_x);
+        __m128 const v_y = _mm_sub_ps(center_y, p1_y);
+        __m128 const segment_x = _mm_sub_ps(p2_x, p1_x);
+        __m128 const segment_y = _mm_sub_ps(p2_y, p1_y);
+        __m128 const segment_length_squared = _mm_add_ps(_mm_mul_ps(segment_x, segment_x), _mm_mul_ps(segment_y, segment_y));
+
+        __m128 t = _mm_div_ps(_mm_add_ps(_mm_mul_ps(v_x, segment_x), _mm_mul_ps(v_y, segment_y)), segment_length_squared);
+
+        // Operand order matches glm::clamp()
+        t = _mm_min_ps(_mm_set1_ps(1.0f), _mm_max_ps(_mm_setzero_ps(), t));
+
+        __m128 const closest_x = _mm_add_ps(p1_x, _mm_mul_ps(t, segment_x));
+        __m128 const closest_y = _mm_add_ps(p1_y, _mm_mul_ps(t, segment_y));
+
+        __m128 const offset_x = _mm_sub_ps(center_x, closest_x);
+        __m128 const offset_y = _mm_sub_ps(center_y, closest_y);
+        __m128 const distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(offset_x, offset_x), _mm_mul_ps(offset_y, offset_y)));
+
+        __m128 const inverse_length = _mm_div_ps(_mm_set1_ps(1.0f), distance);
+        __m128 const penetration = _mm_sub_ps(_mm_set1_ps(radius), distance);
+
+        _mm_storeu_ps(distances.data(), distance);
+        _mm_storeu_ps(push_x.data(), _mm_mul_ps(_mm_mul_ps(offset_x, inverse_length), penetration));
+        _mm_storeu_ps(push_y.data(), _mm_mul_ps(_mm_mul_ps(offset_y, inverse_length), penetration));
+    }
+    else
+#endif
+    {
+        for (u8 i = 0; i < 4; ++i)
+        {
+            glm::vec2 const p1 = {corners_x[i], corners_y[i]};
+            glm::vec2 const p2 = {corners_x[(i + 1) % 4], corners_y[(i + 1) % 4]};
+
+            glm::vec2 const v = center - p1;
+            glm::vec2 const segment = p2 - p1;
+            float const segment_length_squared = glm::dot(segment, segment);
+
+            float t = glm::dot(v, segment) / segment_length_squared;
+            t = glm::clamp(t, 0.0f, 1.0f);
+
+            glm::vec2 const closest_point = p1 + t * segment;
+            distances[i] = glm::distance(center, closest_point);
+
+            glm::vec2 const push = glm::normalize(center - closest_point) * (radius - distances[i]);
+            push_x[i] = push.x;
+            push_y[i] = push.y;
+        }
+    }
+
+    // Summed in the same order as the sides were tested before
+    bool is_overlapping = false;
+    glm::vec2 mtv_temp = {};
+
+    for (u8 i = 0; i < 4; ++i)
+    {
+        if (distances[i] <= radius)
+        {
+            mtv_temp += glm::vec2(push_x[i], push_y[i]);
+            is_overlapping = true;
+        }
+    }
+
+    if (is_overlapping)
+    {
+        mtv = mtv_temp;
+        return true;
+    }
+
+    return false;
+}
+
+bool CollisionKernels::is_point_inside_obb(ColliderStore const& store, u32 const rectangle, glm::vec2 const& point)
+{
+    auto const& corners_x = store.corners_x[rectangle];
+    auto const& corners_y = store.corners_y[rectangle];
+
+    glm::vec2 const corner0 = {corners_x[0], corners_y[0]};
+    glm::vec2 const ap = point - corner0; // Vector from one rectangle corner to point
+    glm::vec2 const ab = glm::vec2(corners_x[1], corners_y[1]) - corner0; // One rectangle axis
+    glm::vec2 const ad = glm::vec2(corners_x[3], corners_y[3]) - corner0; // Another rectangle axis
+
+    // Dot products
+    float const ap_dot_ab = glm::dot(ap, ab);
+    float const ab_dot_ab = glm::dot(ab, ab);
+    float const ap_dot_ad = glm::dot(ap, ad);
+    float const ad_dot_ad = glm::dot(ad, ad);
+
+    return (0.0f <= ap_dot_ab && ap_dot_ab <= ab_dot_ab) && (0.0f <= ap_dot_ad && ap_dot_ad <= ad_dot_ad);
+}
+
+void CollisionKernels::generate_colliders(u32 const collider_count, float const half_size, ColliderStore& store,
+                                          std::vector<BroadphaseProxy>& proxies)
+{
+    std::mt19937 generator(1);
+    std::uniform_real_distribution position_distribution(-half_size, half_size);
+    std::uniform_real_distribution size_distribution(0.2f, 0.5f);
+    std::uniform_real_distribution angle_distribution(0.0f, 2.0f * glm::pi<float>());
+
+    proxies.resize(collider_count);
+
+    for (u32 i = 0; i < collider_count; ++i)
+    {
+        store.push_back();
+
+        glm::vec2 const center = {position_distribution(generator), position_distribution(generator)};
+        std::array<glm::vec2, 4> corners = {};
+
+        // Three circles for every two rectangles
+        if (i % 5 < 3)
+        {
+            float const radius = size_distribution(generator);
+
+            store.types[i] = ColliderType2D::Circle;
+            store.radii[i] = radius;
+            store.extents[i] = {radius, radius};
+            corners = {center + glm::vec2(-radius, -radius), center + glm::vec2(radius, -radius), center + glm::vec2(radius, radius),
+                       center + glm::vec2(-radius, radius)};
+            store.shapes[i] = ConvexShape2D::make_hull(std::span(&center, 1), radius);
+        }
+        else
+        {
+            glm::vec2 const half_extents = {size_distribution(generator), size_distribution(generator)};
+            float const angle = angle_distribution(generator);
+            glm::vec2 const axis_x = glm::vec2(std::cos(angle), std::sin(angle)) * half_extents.x;
+            glm::vec2 const axis_y = glm::vec2(-std::sin(angle), std::cos(angle)) * half_extents.y;
+
+            store.types[i] = ColliderType2D::Rectangle;
+            store.extents[i] = half_extents * 2.0f;
+            corners = {center - axis_x - axis_y, center + axis_x - axis_y, center + axis_x + axis_y, center - axis_x + axis_y};
+            store.shapes[i] = ConvexShape2D::make_hull(corners);
+        }
+
+        store.center_x[i] = center.x;
+        store.center_y[i] = center.y;
+        store.position_x[i] = center.x;
+        store.position_y[i] = center.y;
+
+        for (u8 corner = 0; corner < 4; ++corner)
+        {
+            store.corners_x[i][corner] = corners[corner].x;
+            store.corners_y[i][corner] = corners[corner].y;
+        }
+
+        store.axes[i] = {glm::normalize(corners[1] - corners[0]), glm::normalize(corners[3] - corners[0])};
+        store.edge_normals[i] = {AK::Math::get_perpendicular_axis(corners, 0), AK::Math::get_perpendicular_axis(corners, 1)};
+
+        proxies[i].bounds = {glm::min(glm::min(corners[0], corners[1]), glm::min(corners[2], corners[3])),
+                             glm::max(glm::max(corners[0], corners[1]), glm::max(corners[2], corners[3]))};
+    }
+}
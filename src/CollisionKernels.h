@@ -0,0 +1,216 @@
+#pragma once
+
+#include <array>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "AK/Types.h"
+#include "Broadphase.h"
+#include "Collider2D.h"
+#include "GJK.h"
+
+#if defined(__AVX2__)
+#define COLLISION_KERNELS_AVX2 1
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define COLLISION_KERNELS_SSE 1
+#endif
+
+namespace AK
+{
+class JobSystem;
+}
+
+// Narrowphase data of every registered collider, rows are in the same order as PhysicsEngine's colliders.
+struct ColliderStore
+{
+    void push_back();
+    void swap_remove(u32 const index);
+    void clear();
+
+    // Copies the data cached by the collider, center is passed separately since circles are tested with their live center
+    void write(u32 const index, Collider2D const& collider, glm::vec2 const& center);
+
+    [[nodiscard]] u32 size() const;
+
+    std::vector<ColliderType2D> types = {};
+    std::vector<float> center_x = {};
+    std::vector<float> center_y = {};
+
+    // Entity position, used to orient the rectangle-rectangle MTV
+    std::vector<float> position_x = {};
+    std::vector<float> position_y = {};
+
+    std::vector<float> radii = {};
+    std::vector<glm::vec2> extents = {};
+
+    std::vector<std::array<float, 4>> corners_x = {};
+    std::vector<std::array<float, 4>> corners_y = {};
+
+    // Normalized rectangle edges, same as Collider2D::get_axes()
+    std::vector<std::array<glm::vec2, 2>> axes = {};
+
+    // Normals of the first two edges, the only separating axis candidates of a rectangle
+    std::vector<std::array<glm::vec2, 2>> edge_normals = {};
+
+    // Used by GJK for pairs with a capsule or a polygon
+    std::vector<ConvexShape2D> shapes = {};
+
+    // Identify pairs in the separating axis cache across steps
+    std::vector<ColliderHandle> handles = {};
+
+    std::vector<u32> transform_versions = {};
+};
+
+struct NarrowphaseResult
+{
+    glm::vec2 mtv = {};
+    bool is_overlapping = false;
+};
+
+// Separating axis of a pair tested with GJK in the last step, pointing from the second collider to the first one.
+// First collider is the one with the smaller handle.
+struct CachedAxis
+{
+    ColliderHandle first = {};
+    ColliderHandle second = {};
+    glm::vec2 axis = {};
+};
+
+// Same pairs tested with the shape specific functions and with GJK
+struct NarrowphaseBenchmark
+{
+    u32 pairs = 0;
+    double specific_seconds = 0.0;
+    double convex_seconds = 0.0;
+
+    // Pairs the two disagree on, whether they overlap or by more than a hundredth in the MTV length
+    u32 mismatched_pairs = 0;
+};
+
+// Same pairs of circles and rectangles tested with the SIMD kernels and with their scalar versions
+struct KernelBenchmark
+{
+    u32 colliders = 0;
+    u32 pairs = 0;
+    u32 overlapping_pairs = 0;
+    u32 iterations = 0;
+    u32 simd_width = 1;
+
+    // Average of testing every pair once
+    double simd_seconds = 0.0;
+    double scalar_seconds = 0.0;
+
+    // Pairs whose results differ in any bit
+    u32 mismatched_pairs = 0;
+};
+
+// Same circles and rectangles tested the way solve_collisions() used to, every ordered pair, or through a broadphase
+struct CollisionBenchmark
+{
+    // Empty for every ordered pair
+    std::optional<BroadphaseType> broadphase = {};
+    u32 colliders = 0;
+
+    // Tested by the narrowphase in a single step
+    u32 pairs = 0;
+    u32 overlapping_pairs = 0;
+    u32 iterations = 0;
+
+    // Average of a single step, broadphase included
+    double seconds = 0.0;
+};
+
+// Batched versions of PhysicsEngine's collision tests. SIMD paths compute the same operations in the same order
+// as the scalar ones, so results match them bit for bit.
+class CollisionKernels
+{
+public:
+    // Fills results[i] for every pair, scratch buffers are kept between calls so this doesn't allocate once warmed up.
+    // With a job system, pairs are split into contiguous chunks tested as separate jobs into their own buffers,
+    // which are then merged in chunk order. Every pair gives the same result regardless of the thread count.
+    void run(ColliderStore const& store, std::vector<ColliderPair> const& pairs, std::vector<NarrowphaseResult>& results,
+             AK::JobSystem* const jobs = nullptr);
+
+    // Chunks are not made smaller than this, small batches are not worth waking the workers for
+    static constexpr u32 min_pairs_per_chunk = 256;
+
+    // Circle pairs tested at once, 1 when the build has no SIMD kernels
+#if COLLISION_KERNELS_AVX2
+    static constexpr u32 simd_width = 8;
+#elif COLLISION_KERNELS_SSE
+    static constexpr u32 simd_width = 4;
+#else
+    static constexpr u32 simd_width = 1;
+#endif
+
+    // Single pair, first collider's MTV. Pairs of circles and rectangles use the functions below,
+    // pairs with a capsule or a polygon go through GJK and EPA.
+    static bool compute_penetration(ColliderStore const& store, u32 const first, u32 const second, glm::vec2& mtv);
+
+    static bool circle_circle(ColliderStore const& store, u32 const first, u32 const second, glm::vec2& mtv);
+    static bool rectangle_rectangle(ColliderStore const& store, u32 const first, u32 const second, glm::vec2& mtv);
+    static bool circle_rectangle(ColliderStore const& store, u32 const circle, u32 const rectangle, glm::vec2& mtv);
+
+    // Any two shapes, MTV pushes the first collider out by the whole depth. Axis is the guess to start from,
+    // replaced with the separating axis found.
+    static bool convex(ColliderStore const& store, u32 const first, u32 const second, glm::vec2& axis, glm::vec2& mtv);
+
+    [[nodiscard]] static bool is_convex_pair(ColliderStore const& store, u32 const first, u32 const second);
+
+    // Times compute_penetration() and convex() on the pairs of circles and rectangles, iterations times each
+    static NarrowphaseBenchmark benchmark(ColliderStore const& store, std::span<ColliderPair const> const pairs, u32 const iterations);
+
+    // Generates circles and rectangles and tests their pairs the way run() does, once through the SIMD kernels and once
+    // through their scalar versions, iterations times each. Independent of the physics engine, the colliders are
+    // always generated from the same seed.
+    static KernelBenchmark benchmark_simd(u32 const collider_count, u32 const iterations);
+
+    // Generates circles and rectangles, a tenth of them static, and tests them the way solve_collisions() used to,
+    // every ordered pair that isn't static-static, then with every broadphase backend followed by run().
+    // Iterations times each on the calling thread, the colliders are always generated from the same seed.
+    static std::vector<CollisionBenchmark> benchmark_collisions(u32 const collider_count, u32 const iterations);
+
+    // Pairs tested with GJK in the last run() and the ones rejected by their cached separating axis alone
+    [[nodiscard]] u32 get_convex_pair_count() const;
+    [[nodiscard]] u32 get_axis_early_out_count() const;
+
+private:
+    // Results of a contiguous range of pairs, indices are relative to the start of the range
+    struct Chunk
+    {
+        std::vector<NarrowphaseResult> results = {};
+        std::vector<u32> circle_circle_pairs = {};
+        std::vector<CachedAxis> axes = {};
+        u32 axis_early_outs = 0;
+    };
+
+    // Without is_simd, or in builds without SIMD kernels, every pair goes through the scalar versions
+    static void run_chunk(ColliderStore const& store, std::span<ColliderPair const> const pairs, std::span<CachedAxis const> const cache,
+                          bool const is_simd, Chunk& chunk);
+    static bool convex_cached(ColliderStore const& store, u32 const first, u32 const second, std::span<CachedAxis const> const cache,
+                              Chunk& chunk, glm::vec2& mtv);
+    static void circle_circle_batch(ColliderStore const& store, std::span<ColliderPair const> const pairs,
+                                    std::vector<u32> const& indices, bool const is_simd, std::vector<NarrowphaseResult>& results);
+
+    static bool compute_penetration(ColliderStore const& store, u32 const first, u32 const second, bool const is_simd, glm::vec2& mtv);
+    static bool rectangle_rectangle(ColliderStore const& store, u32 const first, u32 const second, bool const is_simd, glm::vec2& mtv);
+    static bool circle_rectangle(ColliderStore const& store, u32 const circle, u32 const rectangle, bool const is_simd, glm::vec2& mtv);
+
+    static bool is_point_inside_obb(ColliderStore const& store, u32 const rectangle, glm::vec2 const& point);
+
+    // Three circles for every two randomly rotated rectangles, spread over a square of half_size
+    static void generate_colliders(u32 const collider_count, float const half_size, ColliderStore& store,
+                                   std::vector<BroadphaseProxy>& proxies);
+
+    std::vector<Chunk> m_chunks = {};
+
+    // Sorted by the handles, read by every chunk and rebuilt from their axes after the run
+    std::vector<CachedAxis> m_axis_cache = {};
+    u32 m_convex_pair_count = 0;
+    u32 m_axis_early_out_count = 0;
+};
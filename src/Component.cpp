@@ -2,6 +2,7 @@
 
 #include "AK/AK.h"
 #include "Entity.h"
+#include "FixedUpdateScheduler.h"
 #include "MainScene.h"
 
 #if EDITOR
@@ -73,6 +74,10 @@ void Component::destroy_immediate()
 {
     assert(entity != nullptr);
 
+#if _DEBUG
+    FixedUpdateScheduler::validate_structural_change("destroys a component");
+#endif
+
     auto const shared = shared_from_this();
 
     if (!has_been_awaken)
@@ -90,6 +95,8 @@ void Component::destroy_immediate()
     uninitialize();
 
     AK::swap_and_erase(entity->components, shared);
+    entity->rebuild_component_types();
+    MainScene::get_instance()->update_component_set(*entity);
     entity = nullptr;
 }
 
@@ -105,15 +112,20 @@ void Component::draw_editor()
 
 void Component::set_can_tick(bool const value)
 {
-    if (m_can_tick != value)
-    {
-        if (value)
-            MainScene::get_instance()->tickable_components.emplace_back(shared_from_this());
-        else
-            AK::swap_and_erase(MainScene::get_instance()->tickable_components, shared_from_this());
-    }
+    if (m_can_tick == value)
+        return;
 
+#if _DEBUG
+    FixedUpdateScheduler::validate_structural_change("changes whether a component ticks");
+#endif
+
+    // Set first, the tick list reads it when applying changes made during an iteration
     m_can_tick = value;
+
+    if (value)
+        MainScene::get_instance()->tickable_components.add(shared_from_this());
+    else
+        MainScene::get_instance()->tickable_components.remove(*this);
 }
 
 bool Component::get_can_tick() const
@@ -126,6 +138,10 @@ void Component::set_enabled(bool const value)
     if (value == m_enabled)
         return;
 
+#if _DEBUG
+    FixedUpdateScheduler::validate_structural_change("enables or disables a component");
+#endif
+
     m_enabled = value;
 
     if (value)
@@ -142,3 +158,14 @@ bool Component::enabled() const
 {
     return m_enabled;
 }
+
+ComponentType Component::get_type() const
+{
+    if (!m_is_type_resolved)
+    {
+        m_type = find_component_type(*this);
+        m_is_type_resolved = true;
+    }
+
+    return m_type;
+}
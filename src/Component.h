@@ -3,9 +3,12 @@
 #include <memory>
 #include <string>
 
+#include "AK/Pool.h"
+#include "ComponentType.h"
 #include "Debug.h"
 #include "EngineDefines.h"
 #include "Serialization.h"
+#include "TickList.h"
 
 class Collider2D;
 class Entity;
@@ -49,6 +52,9 @@ public:
     void set_enabled(bool const value);
     bool enabled() const;
 
+    // Most derived type of this component
+    [[nodiscard]] ComponentType get_type() const;
+
     std::string guid = "";
 
     std::string custom_name = "";
@@ -56,4 +62,14 @@ public:
 private:
     bool m_enabled = true;
     bool m_can_tick = false;
+
+    // Resolved on the first call to get_type(), the constructor only sees the Component part of the object.
+    // Types EngineHeaderTool hasn't seen resolve to Unknown, so resolving is tracked separately.
+    mutable ComponentType m_type = ComponentType::Unknown;
+    mutable bool m_is_type_resolved = false;
+
+    // Index in the tick list of the scene, valid only while the component is tickable
+    u32 m_tick_slot = TickList::invalid_slot;
+
+    friend class TickList;
 };
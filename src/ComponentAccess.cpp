@@ -0,0 +1,79 @@
+#include "ComponentAccess.h"
+
+#include "Transform.h"
+
+#include <array>
+
+namespace
+{
+
+template<typename T>
+struct AccessBit
+{
+    static_assert(component_type_of<T> != ComponentType::Unknown, "Accesses are component classes or Transform");
+
+    static constexpr u16 value = static_cast<u16>(component_type_of<T>);
+};
+
+template<>
+struct AccessBit<Transform>
+{
+    static constexpr u16 value = transform_access_bit;
+};
+
+std::array<ComponentAccess, component_type_count> const& get_accesses()
+{
+    static std::array<ComponentAccess, component_type_count> const accesses = [] {
+        std::array<ComponentAccess, component_type_count> table = {};
+
+#define ENUMERATE_COMPONENT_ACCESS(name) table[static_cast<u16>(ComponentType::name)].is_declared = true;
+#define ENUMERATE_COMPONENT_READ(name, resource) table[static_cast<u16>(ComponentType::name)].reads.set(AccessBit<class resource>::value);
+#define ENUMERATE_COMPONENT_WRITE(name, resource) table[static_cast<u16>(ComponentType::name)].writes.set(AccessBit<class resource>::value);
+        ENUMERATE_COMPONENT_ACCESSES
+#undef ENUMERATE_COMPONENT_WRITE
+#undef ENUMERATE_COMPONENT_READ
+#undef ENUMERATE_COMPONENT_ACCESS
+
+        return table;
+    }();
+
+    return accesses;
+}
+
+}
+
+ComponentAccess const& get_component_access(ComponentType const type)
+{
+    static ComponentAccess constexpr undeclared = {};
+
+    if (type == ComponentType::Unknown)
+        return undeclared;
+
+    return get_accesses()[static_cast<u16>(type)];
+}
+
+bool do_component_accesses_conflict(ComponentType const a, ComponentType const b)
+{
+    ComponentAccess const& first = get_component_access(a);
+    ComponentAccess const& second = get_component_access(b);
+
+    if (!first.is_declared || !second.is_declared)
+        return true;
+
+    // Transforms are only touched within the component's own hierarchy, the scheduler keeps hierarchies on one thread
+    ComponentAccessSet first_touches = first.reads | first.writes;
+    ComponentAccessSet second_touches = second.reads | second.writes;
+    first_touches.reset(transform_access_bit);
+    second_touches.reset(transform_access_bit);
+
+    if (a == b)
+        return first_touches.test(static_cast<u16>(a));
+
+    // Every component writes itself
+    ComponentAccessSet first_writes = first.writes;
+    ComponentAccessSet second_writes = second.writes;
+    first_writes.set(static_cast<u16>(a));
+    second_writes.set(static_cast<u16>(b));
+
+    return (first_writes & second_touches).any() || (second_writes & first_touches).any();
+}
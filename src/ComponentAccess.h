@@ -0,0 +1,43 @@
+#pragma once
+
+#include <bitset>
+
+#include "AK/Types.h"
+#include "ComponentList.h"
+#include "ComponentType.h"
+
+// What a component's fixed_update() touches besides the component itself, read by EngineHeaderTool. Put them in the
+// class body, arguments are component class names or Transform:
+//
+//     FIXED_UPDATE_READS(GameController)
+//     FIXED_UPDATE_WRITES(Transform)
+//
+// Components of a type read or written here can be on any entity. Transforms can only be those of the component's
+// own hierarchy, its entity's root and everything below it. Writing other components of its own type needs a
+// declaration too. Empty parentheses declare a component that touches nothing else.
+#ifndef FIXED_UPDATE_READS
+#define FIXED_UPDATE_READS(...)
+#endif
+
+#ifndef FIXED_UPDATE_WRITES
+#define FIXED_UPDATE_WRITES(...)
+#endif
+
+// One bit per component type, and one after them for Transform
+u16 constexpr transform_access_bit = component_type_count;
+using ComponentAccessSet = std::bitset<component_type_count + 1>;
+
+struct ComponentAccess
+{
+    // Types without any FIXED_UPDATE_READS or FIXED_UPDATE_WRITES can touch anything
+    bool is_declared = false;
+    ComponentAccessSet reads = {};
+    ComponentAccessSet writes = {};
+};
+
+// Declared for exactly this type, kids don't inherit the declarations of their parents
+ComponentAccess const& get_component_access(ComponentType const type);
+
+// True if the fixed_update() of one type might touch what the other one writes. A type conflicts with itself when it
+// touches other components of its own type.
+bool do_component_accesses_conflict(ComponentType const a, ComponentType const b);
@@ -16,6 +16,7 @@
     ENUMERATE_COMPONENT(FloeButton, "Floe Button")                              \
     ENUMERATE_COMPONENT(NowPromptTrigger, "Now Prompt Trigger")                 \
     ENUMERATE_COMPONENT(ParticleSystem, "Particle System")                      \
+    ENUMERATE_COMPONENT(Rigidbody2D, "Rigidbody2D")                             \
     ENUMERATE_COMPONENT(Sound, "Sound")                                         \
     ENUMERATE_COMPONENT(SoundListener, "Sound Listener")                        \
     ENUMERATE_COMPONENT(Clock, "Clock")                                         \
@@ -53,3 +54,71 @@
     ENUMERATE_COMPONENT(EndScreen, "End Screen")                                \
     // # Auto component list end                                                \
     // # Put new component here
+
+// # Auto component type list start
+#define ENUMERATE_COMPONENT_TYPES                                 \
+    ENUMERATE_COMPONENT_TYPE(Camera, Component)                   \
+    ENUMERATE_COMPONENT_TYPE(Clock, Component)                    \
+    ENUMERATE_COMPONENT_TYPE(Collider2D, Component)               \
+    ENUMERATE_COMPONENT_TYPE(Credits, Component)                  \
+    ENUMERATE_COMPONENT_TYPE(Curve, Component)                    \
+    ENUMERATE_COMPONENT_TYPE(Customer, Component)                 \
+    ENUMERATE_COMPONENT_TYPE(CustomerManager, Component)          \
+    ENUMERATE_COMPONENT_TYPE(DebugDrawing, Component)             \
+    ENUMERATE_COMPONENT_TYPE(DebugInputController, Component)     \
+    ENUMERATE_COMPONENT_TYPE(DialoguePromptController, Component) \
+    ENUMERATE_COMPONENT_TYPE(Drawable, Component)                 \
+    ENUMERATE_COMPONENT_TYPE(ExampleDynamicText, Component)       \
+    ENUMERATE_COMPONENT_TYPE(ExampleUIBar, Component)             \
+    ENUMERATE_COMPONENT_TYPE(Factory, Component)                  \
+    ENUMERATE_COMPONENT_TYPE(Floater, Component)                  \
+    ENUMERATE_COMPONENT_TYPE(FloatersManager, Component)          \
+    ENUMERATE_COMPONENT_TYPE(FloeButton, Component)               \
+    ENUMERATE_COMPONENT_TYPE(GameController, Component)           \
+    ENUMERATE_COMPONENT_TYPE(HovercraftWithoutKeeper, Component)  \
+    ENUMERATE_COMPONENT_TYPE(IceBound, Component)                 \
+    ENUMERATE_COMPONENT_TYPE(LevelController, Component)          \
+    ENUMERATE_COMPONENT_TYPE(Light, Component)                    \
+    ENUMERATE_COMPONENT_TYPE(Lighthouse, Component)               \
+    ENUMERATE_COMPONENT_TYPE(LighthouseKeeper, Component)         \
+    ENUMERATE_COMPONENT_TYPE(LighthouseLight, Component)          \
+    ENUMERATE_COMPONENT_TYPE(NowPromptTrigger, Component)         \
+    ENUMERATE_COMPONENT_TYPE(ParticleSystem, Component)           \
+    ENUMERATE_COMPONENT_TYPE(Player, Component)                   \
+    ENUMERATE_COMPONENT_TYPE(PlayerInput, Component)              \
+    ENUMERATE_COMPONENT_TYPE(Popup, Component)                    \
+    ENUMERATE_COMPONENT_TYPE(Port, Component)                     \
+    ENUMERATE_COMPONENT_TYPE(Rigidbody2D, Component)              \
+    ENUMERATE_COMPONENT_TYPE(Ship, Component)                     \
+    ENUMERATE_COMPONENT_TYPE(ShipEyes, Component)                 \
+    ENUMERATE_COMPONENT_TYPE(ShipSpawner, Component)              \
+    ENUMERATE_COMPONENT_TYPE(Sound, Component)                    \
+    ENUMERATE_COMPONENT_TYPE(SoundListener, Component)            \
+    ENUMERATE_COMPONENT_TYPE(Thanks, Component)                   \
+    ENUMERATE_COMPONENT_TYPE(Path, Curve)                         \
+    ENUMERATE_COMPONENT_TYPE(Button, Drawable)                    \
+    ENUMERATE_COMPONENT_TYPE(Model, Drawable)                     \
+    ENUMERATE_COMPONENT_TYPE(Panel, Drawable)                     \
+    ENUMERATE_COMPONENT_TYPE(Particle, Drawable)                  \
+    ENUMERATE_COMPONENT_TYPE(ScreenText, Drawable)                \
+    ENUMERATE_COMPONENT_TYPE(Skybox, Drawable)                    \
+    ENUMERATE_COMPONENT_TYPE(DirectionalLight, Light)             \
+    ENUMERATE_COMPONENT_TYPE(PointLight, Light)                   \
+    ENUMERATE_COMPONENT_TYPE(SpotLight, Light)                    \
+    ENUMERATE_COMPONENT_TYPE(EndScreen, Popup)                    \
+    ENUMERATE_COMPONENT_TYPE(Cube, Model)                         \
+    ENUMERATE_COMPONENT_TYPE(Ellipse, Model)                      \
+    ENUMERATE_COMPONENT_TYPE(Grass, Model)                        \
+    ENUMERATE_COMPONENT_TYPE(Sphere, Model)                       \
+    ENUMERATE_COMPONENT_TYPE(Sprite, Model)                       \
+    ENUMERATE_COMPONENT_TYPE(Terrain, Model)                      \
+    ENUMERATE_COMPONENT_TYPE(Water, Model)                        \
+    ENUMERATE_COMPONENT_TYPE(SkyboxDX11, Skybox)                  \
+    ENUMERATE_COMPONENT_TYPE(SkyboxGL, Skybox)                    \
+    // # Auto component type list end                             \
+    // # Put new component type here
+
+// # Auto component access list start
+#define ENUMERATE_COMPONENT_ACCESSES \
+    // # Auto component access list end \
+    // # Put new component access here
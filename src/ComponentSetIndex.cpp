@@ -0,0 +1,241 @@
+#include "ComponentSetIndex.h"
+
+#include "Component.h"
+#include "Entity.h"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+
+void ComponentSetIndex::add_entity(Entity& entity)
+{
+    if (entity.m_component_set != invalid_index)
+        return;
+
+    if (m_iteration_depth > 0)
+    {
+        entity.m_component_set = pending_index;
+        m_pending_additions.emplace_back(entity.weak_from_this());
+        return;
+    }
+
+    gather_components(entity);
+    insert_row(entity, find_or_create_set());
+}
+
+void ComponentSetIndex::remove_entity(Entity& entity)
+{
+    u32 const set_index = entity.m_component_set;
+
+    if (set_index == invalid_index)
+        return;
+
+    entity.m_component_set = invalid_index;
+
+    if (set_index == pending_index)
+        return;
+
+    if (m_iteration_depth > 0)
+    {
+        // Row is removed after the iteration, until then nothing in it is reachable
+        ComponentSet& set = m_sets[set_index];
+        u32 const column_count = static_cast<u32>(set.types.size());
+
+        set.entities[entity.m_component_set_row] = nullptr;
+        std::fill_n(set.components.begin() + entity.m_component_set_row * column_count, column_count, nullptr);
+
+        m_pending_removals.emplace_back(set_index, entity.m_component_set_row);
+        return;
+    }
+
+    remove_row(set_index, entity.m_component_set_row);
+}
+
+void ComponentSetIndex::update_entity(Entity& entity)
+{
+    u32 const set_index = entity.m_component_set;
+
+    if (set_index == invalid_index || set_index == pending_index)
+        return;
+
+    ComponentSet& set = m_sets[set_index];
+    u32 const column_count = static_cast<u32>(set.types.size());
+
+    if (m_iteration_depth > 0)
+    {
+        // Removed components can be destroyed before the iteration is over, so they can't stay in the row
+        for (u32 column = 0; column < column_count; ++column)
+        {
+            Component*& component = set.components[entity.m_component_set_row * column_count + column];
+            bool const is_present =
+                std::ranges::any_of(entity.components, [component](auto const& present) { return present.get() == component; });
+
+            if (!is_present)
+                component = nullptr;
+        }
+
+        m_pending_updates.emplace_back(entity.weak_from_this());
+        return;
+    }
+
+    gather_components(entity);
+    u32 const new_set_index = find_or_create_set();
+
+    if (new_set_index == set_index)
+    {
+        // Same types, but the components themselves might have been replaced
+        for (u32 column = 0; column < column_count; ++column)
+        {
+            m_sets[set_index].components[entity.m_component_set_row * column_count + column] = m_sorted_components[column].second;
+        }
+
+        return;
+    }
+
+    remove_row(set_index, entity.m_component_set_row);
+    insert_row(entity, new_set_index);
+}
+
+void ComponentSetIndex::clear()
+{
+    assert(m_iteration_depth == 0);
+
+    for (auto const& set : m_sets)
+    {
+        for (auto const entity : set.entities)
+        {
+            if (entity != nullptr)
+                entity->m_component_set = invalid_index;
+        }
+    }
+
+    m_sets.clear();
+    m_pending_removals.clear();
+    m_pending_additions.clear();
+    m_pending_updates.clear();
+}
+
+u32 ComponentSetIndex::get_set_count() const
+{
+    return static_cast<u32>(m_sets.size());
+}
+
+u32 ComponentSetIndex::get_entity_count() const
+{
+    u32 count = 0;
+
+    for (auto const& set : m_sets)
+    {
+        count += static_cast<u32>(set.entities.size());
+    }
+
+    return count;
+}
+
+bool ComponentSetIndex::is_active(Entity const& entity)
+{
+    return entity.is_active();
+}
+
+void ComponentSetIndex::gather_components(Entity const& entity)
+{
+    m_sorted_components.clear();
+
+    for (auto const& component : entity.components)
+    {
+        m_sorted_components.emplace_back(std::type_index(typeid(*component)), component.get());
+    }
+
+    // Stable, so components of the same type keep their columns
+    std::ranges::stable_sort(m_sorted_components, {}, &std::pair<std::type_index, Component*>::first);
+}
+
+u32 ComponentSetIndex::find_or_create_set()
+{
+    auto const has_same_types = [this](ComponentSet const& set) {
+        return std::ranges::equal(set.types, m_sorted_components, {}, {}, &std::pair<std::type_index, Component*>::first);
+    };
+
+    if (auto const it = std::ranges::find_if(m_sets, has_same_types); it != m_sets.end())
+        return static_cast<u32>(it - m_sets.begin());
+
+    ComponentSet& set = m_sets.emplace_back();
+
+    for (auto const& [type, component] : m_sorted_components)
+    {
+        set.types.emplace_back(type);
+    }
+
+    return static_cast<u32>(m_sets.size()) - 1;
+}
+
+void ComponentSetIndex::insert_row(Entity& entity, u32 const set_index)
+{
+    ComponentSet& set = m_sets[set_index];
+
+    entity.m_component_set = set_index;
+    entity.m_component_set_row = static_cast<u32>(set.entities.size());
+
+    set.entities.emplace_back(&entity);
+
+    for (auto const& [type, component] : m_sorted_components)
+    {
+        set.components.emplace_back(component);
+    }
+}
+
+void ComponentSetIndex::remove_row(u32 const set_index, u32 const row)
+{
+    ComponentSet& set = m_sets[set_index];
+    u32 const last_row = static_cast<u32>(set.entities.size()) - 1;
+    u32 const column_count = static_cast<u32>(set.types.size());
+
+    // Last row takes the place of the removed one
+    if (row != last_row)
+    {
+        set.entities[row] = set.entities[last_row];
+        std::copy_n(set.components.begin() + last_row * column_count, column_count, set.components.begin() + row * column_count);
+
+        if (set.entities[row] != nullptr)
+            set.entities[row]->m_component_set_row = row;
+    }
+
+    set.entities.pop_back();
+    set.components.resize(set.components.size() - column_count);
+}
+
+void ComponentSetIndex::flush_pending()
+{
+    // Highest rows first, so the last row moved into a removed one is never removed itself
+    std::ranges::sort(m_pending_removals, std::greater {});
+
+    for (auto const& [set_index, row] : m_pending_removals)
+    {
+        remove_row(set_index, row);
+    }
+
+    m_pending_removals.clear();
+
+    // Moved out first, adding or updating an entity can queue nothing now
+    auto const additions = std::move(m_pending_additions);
+    m_pending_additions.clear();
+
+    for (auto const& weak_entity : additions)
+    {
+        // Entities removed in the meantime are no longer pending
+        if (auto const entity = weak_entity.lock(); entity != nullptr && entity->m_component_set == pending_index)
+        {
+            entity->m_component_set = invalid_index;
+            add_entity(*entity);
+        }
+    }
+
+    auto const updates = std::move(m_pending_updates);
+    m_pending_updates.clear();
+
+    for (auto const& weak_entity : updates)
+    {
+        if (auto const entity = weak_entity.lock(); entity != nullptr)
+            update_entity(*entity);
+    }
+}
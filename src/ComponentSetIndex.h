@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <memory>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "AK/Types.h"
+
+class Component;
+class Entity;
+
+// Entities grouped by the set of concrete types of their components, so the entities with some types of components
+// are found without looking at any other entity. Only an index: components stay where their pools allocated them and
+// are still updated by the scene's tick list, in the order they became tickable.
+class ComponentSetIndex
+{
+public:
+    static constexpr u32 invalid_index = std::numeric_limits<u32>::max();
+
+    // Entity added while iterating, it gets its row once the iteration is over
+    static constexpr u32 pending_index = invalid_index - 1;
+
+    struct ComponentSet
+    {
+        // Sorted, a type is repeated for entities with several components of that type
+        std::vector<std::type_index> types = {};
+
+        // One row for every entity, its components are in the order of types
+        std::vector<Entity*> entities = {};
+        std::vector<Component*> components = {};
+    };
+
+    ComponentSetIndex() = default;
+
+    ComponentSetIndex(ComponentSetIndex const&) = delete;
+    void operator=(ComponentSetIndex const&) = delete;
+
+    void add_entity(Entity& entity);
+    void remove_entity(Entity& entity);
+
+    // Moves the entity to the set matching its current components
+    void update_entity(Entity& entity);
+
+    void clear();
+
+    // Calls function(entity, components...) for every active entity with components of exactly these types, with the
+    // first component of every type. Entities are visited in no particular order. Entities added, changed or removed by
+    // function are moved once the outermost iteration is over, until then removed ones aren't visited anymore.
+    template<typename... T, typename Function>
+    void for_each(Function const& function)
+    {
+        std::array<std::type_index, sizeof...(T)> const types = {std::type_index(typeid(T))...};
+
+        m_iteration_depth += 1;
+
+        // NOTE: Sets are only created when nothing iterates, so the vector isn't reallocated here.
+        for (auto const& set : m_sets)
+        {
+            std::array<u32, sizeof...(T)> columns = {};
+            bool has_types = true;
+
+            for (u32 i = 0; i < types.size(); ++i)
+            {
+                auto const it = std::ranges::lower_bound(set.types, types[i]);
+                has_types = has_types && it != set.types.end() && *it == types[i];
+                columns[i] = static_cast<u32>(it - set.types.begin());
+            }
+
+            if (!has_types)
+                continue;
+
+            u32 const column_count = static_cast<u32>(set.types.size());
+
+            for (u32 row = 0; row < set.entities.size(); ++row)
+            {
+                if (set.entities[row] == nullptr || !is_active(*set.entities[row]))
+                    continue;
+
+                Component* const* const components = set.components.data() + row * column_count;
+
+                [&]<size_t... I>(std::index_sequence<I...>) {
+                    if (((components[columns[I]] != nullptr) && ...))
+                        function(*set.entities[row], *static_cast<T*>(components[columns[I]])...);
+                }(std::index_sequence_for<T...> {});
+            }
+        }
+
+        m_iteration_depth -= 1;
+
+        if (m_iteration_depth == 0)
+            flush_pending();
+    }
+
+    [[nodiscard]] u32 get_set_count() const;
+    [[nodiscard]] u32 get_entity_count() const;
+
+private:
+    // Parked or queued for destruction, Entity is incomplete here
+    [[nodiscard]] static bool is_active(Entity const& entity);
+
+    // Fills m_sorted_components with the components of the entity sorted by their type
+    void gather_components(Entity const& entity);
+
+    u32 find_or_create_set();
+    void insert_row(Entity& entity, u32 const set_index);
+    void remove_row(u32 const set_index, u32 const row);
+    void flush_pending();
+
+    std::vector<ComponentSet> m_sets = {};
+
+    std::vector<std::pair<std::type_index, Component*>> m_sorted_components = {};
+
+    u32 m_iteration_depth = 0;
+    std::vector<std::pair<u32, u32>> m_pending_removals = {};
+    std::vector<std::weak_ptr<Entity>> m_pending_additions = {};
+    std::vector<std::weak_ptr<Entity>> m_pending_updates = {};
+};
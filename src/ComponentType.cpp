@@ -0,0 +1,205 @@
+#include "ComponentType.h"
+
+#include "Component.h"
+#include "Entity.h"
+
+// # Auto component type headers start
+#include "Camera.h"
+#include "Game/Clock.h"
+#include "Collider2D.h"
+#include "Game/Credits.h"
+#include "Curve.h"
+#include "Game/Customer.h"
+#include "Game/CustomerManager.h"
+#include "DebugDrawing.h"
+#include "DebugInputController.h"
+#include "DialoguePromptController.h"
+#include "Drawable.h"
+#include "ExampleDynamicText.h"
+#include "ExampleUIBar.h"
+#include "Game/Factory.h"
+#include "Floater.h"
+#include "FloatersManager.h"
+#include "FloeButton.h"
+#include "Game/GameController.h"
+#include "Game/HovercraftWithoutKeeper.h"
+#include "Game/IceBound.h"
+#include "Game/LevelController.h"
+#include "Light.h"
+#include "Game/Lighthouse.h"
+#include "Game/LighthouseKeeper.h"
+#include "Game/LighthouseLight.h"
+#include "NowPromptTrigger.h"
+#include "ParticleSystem.h"
+#include "Game/Player.h"
+#include "Game/Player/PlayerInput.h"
+#include "Game/Popup.h"
+#include "Game/Port.h"
+#include "Rigidbody2D.h"
+#include "Game/Ship.h"
+#include "Game/ShipEyes.h"
+#include "Game/ShipSpawner.h"
+#include "Sound.h"
+#include "SoundListener.h"
+#include "Game/Thanks.h"
+#include "Game/Path.h"
+#include "Button.h"
+#include "Model.h"
+#include "Panel.h"
+#include "Particle.h"
+#include "ScreenText.h"
+#include "Skybox.h"
+#include "DirectionalLight.h"
+#include "PointLight.h"
+#include "SpotLight.h"
+#include "Game/EndScreen.h"
+#include "Cube.h"
+#include "Ellipse.h"
+#include "Grass.h"
+#include "Sphere.h"
+#include "Sprite.h"
+#include "Terrain.h"
+#include "Water.h"
+#include "SkyboxDX11.h"
+#include "SkyboxGL.h"
+// # Auto component type headers end
+// # Put new component type header here
+
+#include <chrono>
+#include <typeindex>
+#include <unordered_map>
+
+ComponentType find_component_type(Component const& component)
+{
+    static std::unordered_map<std::type_index, ComponentType> const types = [] {
+        std::unordered_map<std::type_index, ComponentType> map = {};
+        map.emplace(typeid(Component), ComponentType::Component);
+
+#define ENUMERATE_COMPONENT_TYPE(name, parent) map.emplace(typeid(class name), ComponentType::name);
+        ENUMERATE_COMPONENT_TYPES
+#undef ENUMERATE_COMPONENT_TYPE
+
+        return map;
+    }();
+
+    if (auto const it = types.find(typeid(component)); it != types.end())
+        return it->second;
+
+    return ComponentType::Unknown;
+}
+
+namespace
+{
+
+// Same as Entity::get_component() before component types
+template<typename T>
+std::shared_ptr<T> find_with_dynamic_cast(Entity const& entity)
+{
+    for (auto const& component : entity.components)
+    {
+        if (auto comp = std::dynamic_pointer_cast<T>(component); comp != nullptr)
+            return comp;
+    }
+
+    return nullptr;
+}
+
+template<typename T>
+u32 find_all(std::vector<std::shared_ptr<Entity>> const& entities, bool const use_dynamic_cast, std::vector<Component*>& found)
+{
+    for (auto const& entity : entities)
+    {
+        found.emplace_back(use_dynamic_cast ? find_with_dynamic_cast<T>(*entity).get() : entity->get_component<T>().get());
+    }
+
+    return static_cast<u32>(entities.size());
+}
+
+u32 find_all_types(std::vector<std::shared_ptr<Entity>> const& entities, bool const use_dynamic_cast, std::vector<Component*>& found)
+{
+    // Present, parent of a present one, missing, present on some entities only
+    return find_all<class Rigidbody2D>(entities, use_dynamic_cast, found) + find_all<class Curve>(entities, use_dynamic_cast, found)
+         + find_all<class Collider2D>(entities, use_dynamic_cast, found)
+         + find_all<class DialoguePromptController>(entities, use_dynamic_cast, found);
+}
+
+}
+
+ComponentLookupBenchmark benchmark_component_lookup(u32 const entity_count)
+{
+    ComponentLookupBenchmark benchmark = {};
+
+    std::vector<std::shared_ptr<Entity>> entities = {};
+    entities.reserve(entity_count);
+
+    for (u32 i = 0; i < entity_count; ++i)
+    {
+        auto const entity = Entity::create_internal("Benchmark");
+        u32 const component_count = 8 + i % 9;
+
+        for (u32 j = 0; j < component_count; ++j)
+        {
+            switch ((i + j) % 7)
+            {
+            case 0:
+                entity->add_component_internal(Floater::create());
+                break;
+
+            case 1:
+                entity->add_component_internal(ExampleUIBar::create());
+                break;
+
+            case 2:
+                entity->add_component_internal(ExampleDynamicText::create());
+                break;
+
+            case 3:
+                entity->add_component_internal(NowPromptTrigger::create());
+                break;
+
+            case 4:
+                entity->add_component_internal(Path::create());
+                break;
+
+            case 5:
+                if (i % 2 == 0)
+                    entity->add_component_internal(DialoguePromptController::create());
+                else
+                    entity->add_component_internal(Floater::create());
+                break;
+
+            default:
+                entity->add_component_internal(Rigidbody2D::create());
+                break;
+            }
+        }
+
+        entities.emplace_back(entity);
+    }
+
+    std::vector<Component*> dynamic_cast_found = {};
+    std::vector<Component*> component_type_found = {};
+    dynamic_cast_found.reserve(entity_count * 4);
+    component_type_found.reserve(entity_count * 4);
+
+    auto const start = std::chrono::high_resolution_clock::now();
+
+    benchmark.lookups = find_all_types(entities, true, dynamic_cast_found);
+
+    auto const middle = std::chrono::high_resolution_clock::now();
+
+    find_all_types(entities, false, component_type_found);
+
+    auto const end = std::chrono::high_resolution_clock::now();
+
+    benchmark.dynamic_cast_seconds = std::chrono::duration<double>(middle - start).count();
+    benchmark.component_type_seconds = std::chrono::duration<double>(end - middle).count();
+
+    for (u32 i = 0; i < benchmark.lookups; ++i)
+    {
+        if (dynamic_cast_found[i] != component_type_found[i])
+            benchmark.mismatched_lookups += 1;
+    }
+
+    return benchmark;
+}
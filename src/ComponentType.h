@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <type_traits>
+
+#include "AK/Types.h"
+#include "ComponentList.h"
+
+class Component;
+
+// NOTE: Elaborated names everywhere, some components share their names with Windows functions
+#define ENUMERATE_COMPONENT_TYPE(name, parent) class name;
+ENUMERATE_COMPONENT_TYPES
+#undef ENUMERATE_COMPONENT_TYPE
+
+// Dense id of every class deriving from Component, generated by EngineHeaderTool. Parents come before their kids.
+enum class ComponentType : u16
+{
+    Component,
+#define ENUMERATE_COMPONENT_TYPE(name, parent) name,
+    ENUMERATE_COMPONENT_TYPES
+#undef ENUMERATE_COMPONENT_TYPE
+    Unknown
+};
+
+u16 constexpr component_type_count = static_cast<u16>(ComponentType::Unknown);
+
+// Component is its own parent
+std::array<ComponentType, component_type_count> constexpr component_type_parents = {
+    ComponentType::Component,
+#define ENUMERATE_COMPONENT_TYPE(name, parent) ComponentType::parent,
+    ENUMERATE_COMPONENT_TYPES
+#undef ENUMERATE_COMPONENT_TYPE
+};
+
+// Class names, for logs and the editor
+std::array<char const*, component_type_count> constexpr component_type_names = {
+    "Component",
+#define ENUMERATE_COMPONENT_TYPE(name, parent) #name,
+    ENUMERATE_COMPONENT_TYPES
+#undef ENUMERATE_COMPONENT_TYPE
+};
+
+// Unknown for classes that don't derive from Component or that EngineHeaderTool hasn't seen yet
+template<typename T>
+struct ComponentTypeOf
+{
+    static constexpr ComponentType value = ComponentType::Unknown;
+};
+
+template<>
+struct ComponentTypeOf<Component>
+{
+    static constexpr ComponentType value = ComponentType::Component;
+};
+
+#define ENUMERATE_COMPONENT_TYPE(name, parent)                      \
+    template<>                                                      \
+    struct ComponentTypeOf<class name>                              \
+    {                                                               \
+        static constexpr ComponentType value = ComponentType::name; \
+    };
+ENUMERATE_COMPONENT_TYPES
+#undef ENUMERATE_COMPONENT_TYPE
+
+template<typename T>
+ComponentType constexpr component_type_of = ComponentTypeOf<std::remove_cv_t<T>>::value;
+
+// True if the type is the base or derives from it
+constexpr bool is_component_type_of(ComponentType type, ComponentType const base)
+{
+    if (type == ComponentType::Unknown || base == ComponentType::Unknown)
+        return false;
+
+    while (type != base)
+    {
+        if (type == ComponentType::Component)
+            return false;
+
+        type = component_type_parents[static_cast<u16>(type)];
+    }
+
+    return true;
+}
+
+// Type of the most derived class of the component. Uses RTTI, so only meant for when components are added.
+ComponentType find_component_type(Component const& component);
+
+struct ComponentLookupBenchmark
+{
+    u32 lookups = 0;
+    u32 mismatched_lookups = 0;
+    double dynamic_cast_seconds = 0.0;
+    double component_type_seconds = 0.0;
+};
+
+// Looks up present, missing and parent types on entities with 8 to 16 components, once with dynamic casts
+// and once through Entity::get_component()
+ComponentLookupBenchmark benchmark_component_lookup(u32 const entity_count);
@@ -0,0 +1,122 @@
+#include "ContactSolver.h"
+
+#include <algorithm>
+
+void ContactSolver::clear()
+{
+    m_contacts.clear();
+}
+
+void ContactSolver::add_contact(ContactKey const& key, u32 const body_a, u32 const body_b, glm::vec2 const& normal, float const depth)
+{
+    ContactManifold contact = {};
+    contact.key = key;
+    contact.body_a = body_a;
+    contact.body_b = body_b;
+    contact.normal = normal;
+    contact.depth = depth;
+    m_contacts.emplace_back(contact);
+}
+
+std::vector<ContactManifold>& ContactSolver::get_contacts()
+{
+    return m_contacts;
+}
+
+void ContactSolver::solve(std::vector<SolverBody>& bodies)
+{
+    warm_start(bodies);
+
+    for (u32 i = 0; i < velocity_iterations; ++i)
+    {
+        solve_velocities(bodies);
+    }
+
+    correct_positions(bodies);
+    store_impulses();
+}
+
+u32 ContactSolver::get_warm_started_count() const
+{
+    return m_warm_started_count;
+}
+
+void ContactSolver::warm_start(std::vector<SolverBody>& bodies)
+{
+    m_warm_started_count = 0;
+
+    for (auto& contact : m_contacts)
+    {
+        SolverBody& a = bodies[contact.body_a];
+        SolverBody& b = bodies[contact.body_b];
+
+        float const inverse_mass_sum = a.inverse_mass + b.inverse_mass;
+        contact.effective_mass = inverse_mass_sum > 0.0f ? 1.0f / inverse_mass_sum : 0.0f;
+
+        // Bounce off only when hitting fast enough, otherwise resting contacts would jitter
+        float const normal_velocity = glm::dot(a.velocity - b.velocity, contact.normal);
+        float const restitution = std::max(a.restitution, b.restitution);
+        contact.velocity_bias = normal_velocity < -restitution_threshold ? -restitution * normal_velocity : 0.0f;
+
+        auto const cached = std::ranges::lower_bound(m_cached_contacts, contact.key, {}, &ContactManifold::key);
+
+        if (cached == m_cached_contacts.end() || cached->key != contact.key)
+            continue;
+
+        contact.normal_impulse = cached->normal_impulse;
+        m_warm_started_count += 1;
+
+        glm::vec2 const impulse = contact.normal * contact.normal_impulse;
+        a.velocity += impulse * a.inverse_mass;
+        b.velocity -= impulse * b.inverse_mass;
+    }
+}
+
+void ContactSolver::solve_velocities(std::vector<SolverBody>& bodies)
+{
+    for (auto& contact : m_contacts)
+    {
+        if (contact.effective_mass == 0.0f)
+            continue;
+
+        SolverBody& a = bodies[contact.body_a];
+        SolverBody& b = bodies[contact.body_b];
+
+        float const normal_velocity = glm::dot(a.velocity - b.velocity, contact.normal);
+        float lambda = -contact.effective_mass * (normal_velocity - contact.velocity_bias);
+
+        // Contacts can only push, so the total impulse is clamped instead of this iteration's one
+        float const previous_impulse = contact.normal_impulse;
+        contact.normal_impulse = std::max(previous_impulse + lambda, 0.0f);
+        lambda = contact.normal_impulse - previous_impulse;
+
+        glm::vec2 const impulse = contact.normal * lambda;
+        a.velocity += impulse * a.inverse_mass;
+        b.velocity -= impulse * b.inverse_mass;
+    }
+}
+
+void ContactSolver::correct_positions(std::vector<SolverBody>& bodies) const
+{
+    for (auto const& contact : m_contacts)
+    {
+        if (contact.effective_mass == 0.0f)
+            continue;
+
+        float const correction =
+            std::min(std::max(contact.depth - linear_slop, 0.0f) * position_correction_factor, max_position_correction);
+        glm::vec2 const push = contact.normal * (correction * contact.effective_mass);
+
+        SolverBody& a = bodies[contact.body_a];
+        SolverBody& b = bodies[contact.body_b];
+        a.position_correction += push * a.inverse_mass;
+        b.position_correction -= push * b.inverse_mass;
+    }
+}
+
+void ContactSolver::store_impulses()
+{
+    std::ranges::sort(m_contacts, {}, &ContactManifold::key);
+    std::swap(m_contacts, m_cached_contacts);
+    m_contacts.clear();
+}
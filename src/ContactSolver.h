@@ -0,0 +1,87 @@
+#pragma once
+
+#include <compare>
+#include <vector>
+
+#include <glm/vec2.hpp>
+
+#include "AK/Types.h"
+#include "Collider2D.h"
+
+// Unordered pair of colliders in contact, first always has the smaller slot
+struct ContactKey
+{
+    ColliderHandle first = {};
+    ColliderHandle second = {};
+
+    auto operator<=>(ContactKey const&) const = default;
+};
+
+// State of a body during a single solver step, indexed the same as PhysicsEngine's colliders
+struct SolverBody
+{
+    glm::vec2 velocity = {};
+    glm::vec2 position_correction = {};
+    float inverse_mass = 0.0f;
+    float restitution = 0.0f;
+};
+
+// Bodies don't rotate, so a manifold is a single normal constraint
+struct ContactManifold
+{
+    ContactKey key = {};
+    u32 body_a = 0;
+    u32 body_b = 0;
+
+    // Points from B to A, the direction A has to move to separate
+    glm::vec2 normal = {};
+    float depth = 0.0f;
+
+    // Accumulated over the iterations and kept between steps for warm starting
+    float normal_impulse = 0.0f;
+
+    float effective_mass = 0.0f;
+    float velocity_bias = 0.0f;
+};
+
+// Sequential impulse solver for the contacts of a single step
+class ContactSolver
+{
+public:
+    static constexpr u32 velocity_iterations = 8;
+
+    // Relative speed below which contacts don't bounce
+    static constexpr float restitution_threshold = 0.5f;
+
+    // Penetration that is allowed to stay, and the part of the rest that is removed every step
+    static constexpr float linear_slop = 0.005f;
+    static constexpr float position_correction_factor = 0.8f;
+    static constexpr float max_position_correction = 0.2f;
+
+    void clear();
+
+    // Body indices are resolved after the narrowphase, callbacks might add or remove colliders before that
+    void add_contact(ContactKey const& key, u32 const body_a, u32 const body_b, glm::vec2 const& normal, float const depth);
+
+    // Contacts of this step, body indices have to be fixed up if colliders were added or removed since add_contact()
+    [[nodiscard]] std::vector<ContactManifold>& get_contacts();
+
+    // Solves the contacts in the order they were added, warm started with the impulses of the previous step.
+    // Velocities and position corrections are written to bodies, which then have to be integrated by the caller.
+    void solve(std::vector<SolverBody>& bodies);
+
+    [[nodiscard]] u32 get_warm_started_count() const;
+
+private:
+    void warm_start(std::vector<SolverBody>& bodies);
+    void solve_velocities(std::vector<SolverBody>& bodies);
+    void correct_positions(std::vector<SolverBody>& bodies) const;
+    void store_impulses();
+
+    std::vector<ContactManifold> m_contacts = {};
+
+    // Sorted by key, swapped with the contacts every step so they don't allocate once warmed up
+    std::vector<ContactManifold> m_cached_contacts = {};
+
+    u32 m_warm_started_count = 0;
+};
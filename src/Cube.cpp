@@ -9,7 +9,7 @@
 
 std::shared_ptr<Cube> Cube::create()
 {
-    auto cube = std::make_shared<Cube>(AK::Badge<Cube> {}, default_material);
+    auto cube = AK::make_pooled<Cube>(AK::Badge<Cube> {}, default_material);
     cube->prepare();
 
     return cube;
@@ -17,7 +17,7 @@ std::shared_ptr<Cube> Cube::create()
 
 std::shared_ptr<Cube> Cube::create(std::shared_ptr<Material> const& material, bool const big_cube)
 {
-    auto cube = std::make_shared<Cube>(AK::Badge<Cube> {}, material);
+    auto cube = AK::make_pooled<Cube>(AK::Badge<Cube> {}, material);
     cube->m_big_cube = big_cube;
     cube->prepare();
 
@@ -27,7 +27,7 @@ std::shared_ptr<Cube> Cube::create(std::shared_ptr<Material> const& material, bo
 std::shared_ptr<Cube> Cube::create(std::string const& diffuse_texture_path, std::shared_ptr<Material> const& material, bool const big_cube)
 {
     AK::Badge<Cube> badge;
-    auto cube = std::make_shared<Cube>(AK::Badge<Cube> {}, diffuse_texture_path, material);
+    auto cube = AK::make_pooled<Cube>(AK::Badge<Cube> {}, diffuse_texture_path, material);
     cube->m_big_cube = big_cube;
     cube->prepare();
 
@@ -38,7 +38,7 @@ std::shared_ptr<Cube> Cube::create(std::string const& diffuse_texture_path, std:
                                    std::shared_ptr<Material> const& material, bool const big_cube)
 {
     AK::Badge<Cube> badge;
-    auto cube = std::make_shared<Cube>(AK::Badge<Cube> {}, diffuse_texture_path, specular_texture_path, material);
+    auto cube = AK::make_pooled<Cube>(AK::Badge<Cube> {}, diffuse_texture_path, specular_texture_path, material);
     cube->m_big_cube = big_cube;
     cube->prepare();
 
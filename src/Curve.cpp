@@ -15,7 +15,7 @@
 
 std::shared_ptr<Curve> Curve::create()
 {
-    return std::make_shared<Curve>(AK::Badge<Curve> {});
+    return AK::make_pooled<Curve>(AK::Badge<Curve> {});
 }
 
 Curve::Curve(AK::Badge<Curve>)
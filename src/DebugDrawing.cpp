@@ -15,7 +15,7 @@ DebugDrawing::DebugDrawing(AK::Badge<DebugDrawing>)
 
 std::shared_ptr<DebugDrawing> DebugDrawing::create()
 {
-    return std::make_shared<DebugDrawing>(AK::Badge<DebugDrawing> {});
+    return AK::make_pooled<DebugDrawing>(AK::Badge<DebugDrawing> {});
 }
 
 DebugDrawing::DebugDrawing(AK::Badge<DebugDrawing>, glm::vec3 const position, float const radius, double const time)
@@ -25,7 +25,7 @@ DebugDrawing::DebugDrawing(AK::Badge<DebugDrawing>, glm::vec3 const position, fl
 
 std::shared_ptr<DebugDrawing> DebugDrawing::create(glm::vec3 position, float radius, double time)
 {
-    return std::make_shared<DebugDrawing>(AK::Badge<DebugDrawing> {}, position, radius, time);
+    return AK::make_pooled<DebugDrawing>(AK::Badge<DebugDrawing> {}, position, radius, time);
 }
 
 DebugDrawing::DebugDrawing(AK::Badge<DebugDrawing>, glm::vec3 const position, glm::vec3 const euler_angles, glm::vec3 const extents,
@@ -36,7 +36,7 @@ DebugDrawing::DebugDrawing(AK::Badge<DebugDrawing>, glm::vec3 const position, gl
 
 std::shared_ptr<DebugDrawing> DebugDrawing::create(glm::vec3 position, glm::vec3 euler_angles, glm::vec3 extents, double time)
 {
-    return std::make_shared<DebugDrawing>(AK::Badge<DebugDrawing> {}, position, euler_angles, extents, time);
+    return AK::make_pooled<DebugDrawing>(AK::Badge<DebugDrawing> {}, position, euler_angles, extents, time);
 }
 
 void DebugDrawing::initialize()
@@ -96,7 +96,7 @@ void DebugDrawing::update()
     m_current_time += delta_time;
 
     if (m_current_time > m_lifetime)
-        entity->destroy_immediate();
+        entity->destroy();
 }
 
 void DebugDrawing::uninitialize()
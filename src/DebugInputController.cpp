@@ -4,7 +4,7 @@
 
 std::shared_ptr<DebugInputController> DebugInputController::create()
 {
-    auto instance = std::make_shared<DebugInputController>(AK::Badge<DebugInputController> {});
+    auto instance = AK::make_pooled<DebugInputController>(AK::Badge<DebugInputController> {});
 
     if (m_instance)
     {
@@ -16,7 +16,7 @@
 
 std::shared_ptr<DialoguePromptController> DialoguePromptController::create()
 {
-    auto prompt = std::make_shared<DialoguePromptController>(AK::Badge<DialoguePromptController> {});
+    auto prompt = AK::make_pooled<DialoguePromptController>(AK::Badge<DialoguePromptController> {});
     return prompt;
 }
 
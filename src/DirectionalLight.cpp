@@ -6,7 +6,7 @@
 
 std::shared_ptr<DirectionalLight> DirectionalLight::create()
 {
-    auto directional_light = std::make_shared<DirectionalLight>(AK::Badge<DirectionalLight> {});
+    auto directional_light = AK::make_pooled<DirectionalLight>(AK::Badge<DirectionalLight> {});
     directional_light->set_up_shadow_mapping();
     directional_light->m_near_plane = -20.0f;
     directional_light->m_far_plane = 20.0f;
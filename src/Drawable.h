@@ -5,6 +5,8 @@
 #include "DrawType.h"
 #include "Material.h"
 
+#include <limits>
+
 class Drawable : public Component
 {
 public:
@@ -43,5 +45,10 @@ protected:
 
 private:
     i32 m_is_glowing = 0;
+
+    // Index in material->drawables while registered, so unregistering doesn't search for it
+    u32 m_material_slot = std::numeric_limits<u32>::max();
+
     friend class SceneSerializer;
+    friend class Renderer;
 };
@@ -0,0 +1,362 @@
+#include "DynamicAABBTree.h"
+
+#include <algorithm>
+#include <cmath>
+
+i32 DynamicAABBTree::create_proxy(BoundingBox2D const& bounds, u32 const user_data)
+{
+    i32 const proxy_id = allocate_node();
+
+    Node& node = m_nodes[proxy_id];
+    node.bounds = {bounds.min - bounds_margin, bounds.max + bounds_margin};
+    node.user_data = user_data;
+    node.height = 0;
+
+    insert_leaf(proxy_id);
+    m_proxy_count += 1;
+
+    return proxy_id;
+}
+
+void DynamicAABBTree::destroy_proxy(i32 const proxy_id)
+{
+    assert(proxy_id >= 0 && proxy_id < static_cast<i32>(m_nodes.size()));
+    assert(m_nodes[proxy_id].is_leaf());
+
+    remove_leaf(proxy_id);
+    free_node(proxy_id);
+    m_proxy_count -= 1;
+}
+
+bool DynamicAABBTree::move_proxy(i32 const proxy_id, BoundingBox2D const& bounds)
+{
+    assert(proxy_id >= 0 && proxy_id < static_cast<i32>(m_nodes.size()));
+    assert(m_nodes[proxy_id].is_leaf());
+
+    if (contains(m_nodes[proxy_id].bounds, bounds))
+        return false;
+
+    remove_leaf(proxy_id);
+    m_nodes[proxy_id].bounds = {bounds.min - bounds_margin, bounds.max + bounds_margin};
+    insert_leaf(proxy_id);
+
+    return true;
+}
+
+void DynamicAABBTree::set_user_data(i32 const proxy_id, u32 const user_data)
+{
+    assert(proxy_id >= 0 && proxy_id < static_cast<i32>(m_nodes.size()));
+
+    m_nodes[proxy_id].user_data = user_data;
+}
+
+u32 DynamicAABBTree::get_user_data(i32 const proxy_id) const
+{
+    assert(proxy_id >= 0 && proxy_id < static_cast<i32>(m_nodes.size()));
+
+    return m_nodes[proxy_id].user_data;
+}
+
+BoundingBox2D const& DynamicAABBTree::get_fat_bounds(i32 const proxy_id) const
+{
+    assert(proxy_id >= 0 && proxy_id < static_cast<i32>(m_nodes.size()));
+
+    return m_nodes[proxy_id].bounds;
+}
+
+i32 DynamicAABBTree::get_height() const
+{
+    if (m_root == null_node)
+        return 0;
+
+    return m_nodes[m_root].height;
+}
+
+u32 DynamicAABBTree::get_proxy_count() const
+{
+    return m_proxy_count;
+}
+
+void DynamicAABBTree::clear()
+{
+    m_nodes.clear();
+    m_root = null_node;
+    m_free_list = null_node;
+    m_proxy_count = 0;
+}
+
+BoundingBox2D DynamicAABBTree::combine(BoundingBox2D const& a, BoundingBox2D const& b)
+{
+    return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+}
+
+float DynamicAABBTree::perimeter(BoundingBox2D const& bounds)
+{
+    return 2.0f * (bounds.max.x - bounds.min.x + bounds.max.y - bounds.min.y);
+}
+
+bool DynamicAABBTree::contains(BoundingBox2D const& outer, BoundingBox2D const& inner)
+{
+    return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+}
+
+float DynamicAABBTree::distance_squared_to_bounds(glm::vec2 const& point, BoundingBox2D const& bounds)
+{
+    glm::vec2 const closest = glm::clamp(point, bounds.min, bounds.max);
+    glm::vec2 const offset = point - closest;
+    return glm::dot(offset, offset);
+}
+
+bool DynamicAABBTree::ray_hits_bounds(glm::vec2 const& origin, glm::vec2 const& inverse_direction, float const max_distance,
+                                      BoundingBox2D const& bounds)
+{
+    float t_min = 0.0f;
+    float t_max = max_distance;
+
+    for (u32 axis = 0; axis < 2; ++axis)
+    {
+        // Ray parallel to the slab
+        if (std::isinf(inverse_direction[axis]))
+        {
+            if (origin[axis] < bounds.min[axis] || origin[axis] > bounds.max[axis])
+                return false;
+
+            continue;
+        }
+
+        float t1 = (bounds.min[axis] - origin[axis]) * inverse_direction[axis];
+        float t2 = (bounds.max[axis] - origin[axis]) * inverse_direction[axis];
+
+        if (t1 > t2)
+            std::swap(t1, t2);
+
+        t_min = std::max(t_min, t1);
+        t_max = std::min(t_max, t2);
+
+        if (t_min > t_max)
+            return false;
+    }
+
+    return true;
+}
+
+i32 DynamicAABBTree::allocate_node()
+{
+    if (m_free_list == null_node)
+    {
+        m_nodes.emplace_back();
+        return static_cast<i32>(m_nodes.size()) - 1;
+    }
+
+    i32 const node_id = m_free_list;
+    m_free_list = m_nodes[node_id].parent;
+
+    m_nodes[node_id] = {};
+    return node_id;
+}
+
+void DynamicAABBTree::free_node(i32 const node_id)
+{
+    m_nodes[node_id].parent = m_free_list;
+    m_nodes[node_id].child1 = null_node;
+    m_nodes[node_id].child2 = null_node;
+    m_nodes[node_id].height = -1;
+    m_free_list = node_id;
+}
+
+void DynamicAABBTree::insert_leaf(i32 const leaf)
+{
+    if (m_root == null_node)
+    {
+        m_root = leaf;
+        m_nodes[m_root].parent = null_node;
+        return;
+    }
+
+    // Find the best sibling using the surface area heuristic
+    BoundingBox2D const leaf_bounds = m_nodes[leaf].bounds;
+    i32 index = m_root;
+
+    while (!m_nodes[index].is_leaf())
+    {
+        i32 const child1 = m_nodes[index].child1;
+        i32 const child2 = m_nodes[index].child2;
+
+        float const area = perimeter(m_nodes[index].bounds);
+        float const combined_area = perimeter(combine(m_nodes[index].bounds, leaf_bounds));
+
+        // Cost of creating a new parent for this node and the new leaf
+        float const cost = 2.0f * combined_area;
+
+        // Minimum cost of pushing the leaf further down the tree
+        float const inheritance_cost = 2.0f * (combined_area - area);
+
+        auto const descend_cost = [&](i32 const child) {
+            float const child_combined_area = perimeter(combine(leaf_bounds, m_nodes[child].bounds));
+
+            if (m_nodes[child].is_leaf())
+                return child_combined_area + inheritance_cost;
+
+            return child_combined_area - perimeter(m_nodes[child].bounds) + inheritance_cost;
+        };
+
+        float const cost1 = descend_cost(child1);
+        float const cost2 = descend_cost(child2);
+
+        if (cost < cost1 && cost < cost2)
+            break;
+
+        index = cost1 < cost2 ? child1 : child2;
+    }
+
+    i32 const sibling = index;
+
+    // Create a new parent
+    i32 const old_parent = m_nodes[sibling].parent;
+    i32 const new_parent = allocate_node();
+    m_nodes[new_parent].parent = old_parent;
+    m_nodes[new_parent].bounds = combine(leaf_bounds, m_nodes[sibling].bounds);
+    m_nodes[new_parent].height = m_nodes[sibling].height + 1;
+    m_nodes[new_parent].child1 = sibling;
+    m_nodes[new_parent].child2 = leaf;
+    m_nodes[sibling].parent = new_parent;
+    m_nodes[leaf].parent = new_parent;
+
+    if (old_parent != null_node)
+    {
+        if (m_nodes[old_parent].child1 == sibling)
+            m_nodes[old_parent].child1 = new_parent;
+        else
+            m_nodes[old_parent].child2 = new_parent;
+    }
+    else
+    {
+        m_root = new_parent;
+    }
+
+    // Walk back up the tree fixing heights and bounds
+    index = m_nodes[leaf].parent;
+    while (index != null_node)
+    {
+        index = balance(index);
+
+        i32 const child1 = m_nodes[index].child1;
+        i32 const child2 = m_nodes[index].child2;
+
+        m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+        m_nodes[index].bounds = combine(m_nodes[child1].bounds, m_nodes[child2].bounds);
+
+        index = m_nodes[index].parent;
+    }
+}
+
+void DynamicAABBTree::remove_leaf(i32 const leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = null_node;
+        return;
+    }
+
+    i32 const parent = m_nodes[leaf].parent;
+    i32 const grand_parent = m_nodes[parent].parent;
+    i32 const sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grand_parent == null_node)
+    {
+        m_root = sibling;
+        m_nodes[sibling].parent = null_node;
+        free_node(parent);
+        return;
+    }
+
+    // Destroy the parent and connect the sibling to the grand parent
+    if (m_nodes[grand_parent].child1 == parent)
+        m_nodes[grand_parent].child1 = sibling;
+    else
+        m_nodes[grand_parent].child2 = sibling;
+
+    m_nodes[sibling].parent = grand_parent;
+    free_node(parent);
+
+    i32 index = grand_parent;
+    while (index != null_node)
+    {
+        index = balance(index);
+
+        i32 const child1 = m_nodes[index].child1;
+        i32 const child2 = m_nodes[index].child2;
+
+        m_nodes[index].bounds = combine(m_nodes[child1].bounds, m_nodes[child2].bounds);
+        m_nodes[index].height = 1 + std::max(m_nodes[child1].height, m_nodes[child2].height);
+
+        index = m_nodes[index].parent;
+    }
+}
+
+// Performs a left or right rotation if node A is imbalanced. Returns the new root of the subtree.
+i32 DynamicAABBTree::balance(i32 const node_id)
+{
+    i32 const a = node_id;
+
+    if (m_nodes[a].is_leaf() || m_nodes[a].height < 2)
+        return a;
+
+    i32 const b = m_nodes[a].child1;
+    i32 const c = m_nodes[a].child2;
+
+    i32 const balance = m_nodes[c].height - m_nodes[b].height;
+
+    auto const rotate_up = [&](i32 const raised, i32 const other) {
+        // Raises the given child of A to replace A, A takes the place of one of its children
+        i32 const f = m_nodes[raised].child1;
+        i32 const g = m_nodes[raised].child2;
+
+        m_nodes[raised].child1 = a;
+        m_nodes[raised].parent = m_nodes[a].parent;
+        m_nodes[a].parent = raised;
+
+        if (m_nodes[raised].parent != null_node)
+        {
+            i32 const raised_parent = m_nodes[raised].parent;
+
+            if (m_nodes[raised_parent].child1 == a)
+                m_nodes[raised_parent].child1 = raised;
+            else
+                m_nodes[raised_parent].child2 = raised;
+        }
+        else
+        {
+            m_root = raised;
+        }
+
+        // Keep the taller grandchild under the raised node
+        i32 const kept = m_nodes[f].height > m_nodes[g].height ? f : g;
+        i32 const moved = kept == f ? g : f;
+
+        m_nodes[raised].child2 = kept;
+
+        if (m_nodes[a].child1 == raised)
+            m_nodes[a].child1 = moved;
+        else
+            m_nodes[a].child2 = moved;
+
+        m_nodes[moved].parent = a;
+
+        m_nodes[a].bounds = combine(m_nodes[other].bounds, m_nodes[moved].bounds);
+        m_nodes[raised].bounds = combine(m_nodes[a].bounds, m_nodes[kept].bounds);
+
+        m_nodes[a].height = 1 + std::max(m_nodes[other].height, m_nodes[moved].height);
+        m_nodes[raised].height = 1 + std::max(m_nodes[a].height, m_nodes[kept].height);
+
+        return raised;
+    };
+
+    if (balance > 1)
+        return rotate_up(c, b);
+
+    if (balance < -1)
+        return rotate_up(b, c);
+
+    return a;
+}
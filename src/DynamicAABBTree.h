@@ -0,0 +1,217 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "AK/Types.h"
+#include "Bounds.h"
+
+// Bounding volume hierarchy over 2D bounds, based on b2DynamicTree from Box2D.
+// Leaves store fattened bounds, so objects that only move a little don't need to be reinserted.
+class DynamicAABBTree
+{
+public:
+    static constexpr i32 null_node = -1;
+
+    DynamicAABBTree() = default;
+
+    i32 create_proxy(BoundingBox2D const& bounds, u32 const user_data);
+    void destroy_proxy(i32 const proxy_id);
+
+    // Returns true if the proxy left its fattened bounds and had to be reinserted.
+    bool move_proxy(i32 const proxy_id, BoundingBox2D const& bounds);
+
+    void set_user_data(i32 const proxy_id, u32 const user_data);
+    [[nodiscard]] u32 get_user_data(i32 const proxy_id) const;
+    [[nodiscard]] BoundingBox2D const& get_fat_bounds(i32 const proxy_id) const;
+
+    [[nodiscard]] i32 get_height() const;
+    [[nodiscard]] u32 get_proxy_count() const;
+
+    void clear();
+
+    // Calls callback(user_data) for every proxy whose fattened bounds overlap the given bounds.
+    // Returning false from the callback stops the query.
+    template<typename Callback>
+    void query(BoundingBox2D const& bounds, Callback&& callback) const
+    {
+        NodeStack stack = {};
+        u32 stack_size = 0;
+        push(stack, stack_size, m_root);
+
+        while (stack_size > 0)
+        {
+            i32 const node_id = stack[--stack_size];
+            if (node_id == null_node)
+                continue;
+
+            Node const& node = m_nodes[node_id];
+
+            if (!node.bounds.overlaps(bounds))
+                continue;
+
+            if (node.is_leaf())
+            {
+                if (!callback(node.user_data))
+                    return;
+            }
+            else
+            {
+                push(stack, stack_size, node.child1);
+                push(stack, stack_size, node.child2);
+            }
+        }
+    }
+
+    // Calls callback(user_data, max_distance) for every proxy whose fattened bounds are hit by the ray within max_distance.
+    // The callback returns the new max distance, so returning the distance of a hit clips the ray
+    // and returning 0 stops the query.
+    template<typename Callback>
+    void raycast(glm::vec2 const& origin, glm::vec2 const& direction, float max_distance, Callback&& callback) const
+    {
+        glm::vec2 const inverse_direction = {1.0f / direction.x, 1.0f / direction.y};
+
+        NodeStack stack = {};
+        u32 stack_size = 0;
+        push(stack, stack_size, m_root);
+
+        while (stack_size > 0)
+        {
+            i32 const node_id = stack[--stack_size];
+            if (node_id == null_node)
+                continue;
+
+            Node const& node = m_nodes[node_id];
+
+            if (!ray_hits_bounds(origin, inverse_direction, max_distance, node.bounds))
+                continue;
+
+            if (node.is_leaf())
+            {
+                max_distance = callback(node.user_data, max_distance);
+
+                if (max_distance <= 0.0f)
+                    return;
+            }
+            else
+            {
+                push(stack, stack_size, node.child1);
+                push(stack, stack_size, node.child2);
+            }
+        }
+    }
+
+    // Finds the proxy with the smallest distance(user_data), where distance() can't be smaller than the distance
+    // from the point to the proxy's bounds. Returning infinity from distance() skips the proxy.
+    // Returns false if nothing was found.
+    template<typename Distance>
+    bool query_nearest(glm::vec2 const& point, Distance&& distance, u32& nearest_user_data) const
+    {
+        float nearest_distance_squared = std::numeric_limits<float>::infinity();
+        bool found = false;
+
+        NodeStack stack = {};
+        u32 stack_size = 0;
+        push(stack, stack_size, m_root);
+
+        while (stack_size > 0)
+        {
+            i32 const node_id = stack[--stack_size];
+            if (node_id == null_node)
+                continue;
+
+            Node const& node = m_nodes[node_id];
+
+            if (distance_squared_to_bounds(point, node.bounds) >= nearest_distance_squared)
+                continue;
+
+            if (node.is_leaf())
+            {
+                float const leaf_distance = distance(node.user_data);
+
+                if (leaf_distance * leaf_distance < nearest_distance_squared)
+                {
+                    nearest_distance_squared = leaf_distance * leaf_distance;
+                    nearest_user_data = node.user_data;
+                    found = true;
+                }
+            }
+            else
+            {
+                // Visit the closer child first, it's more likely to shrink the search radius
+                float const distance1 = distance_squared_to_bounds(point, m_nodes[node.child1].bounds);
+                float const distance2 = distance_squared_to_bounds(point, m_nodes[node.child2].bounds);
+
+                if (distance1 < distance2)
+                {
+                    push(stack, stack_size, node.child2);
+                    push(stack, stack_size, node.child1);
+                }
+                else
+                {
+                    push(stack, stack_size, node.child1);
+                    push(stack, stack_size, node.child2);
+                }
+            }
+        }
+
+        return found;
+    }
+
+    // Fattening applied to the bounds of every proxy
+    inline static float bounds_margin = 0.1f;
+
+private:
+    struct Node
+    {
+        BoundingBox2D bounds = {};
+
+        // Next free node when the node is in the free list
+        i32 parent = null_node;
+        i32 child1 = null_node;
+        i32 child2 = null_node;
+
+        // Leaf = 0, free node = -1
+        i32 height = -1;
+
+        u32 user_data = 0;
+
+        [[nodiscard]] bool is_leaf() const
+        {
+            return child1 == null_node;
+        }
+    };
+
+    // Balanced trees with tens of thousands of proxies are nowhere near this deep
+    using NodeStack = std::array<i32, 256>;
+
+    static void push(NodeStack& stack, u32& stack_size, i32 const node_id)
+    {
+        assert(stack_size < stack.size());
+        stack[stack_size++] = node_id;
+    }
+
+    [[nodiscard]] static BoundingBox2D combine(BoundingBox2D const& a, BoundingBox2D const& b);
+    [[nodiscard]] static float perimeter(BoundingBox2D const& bounds);
+    [[nodiscard]] static bool contains(BoundingBox2D const& outer, BoundingBox2D const& inner);
+    [[nodiscard]] static float distance_squared_to_bounds(glm::vec2 const& point, BoundingBox2D const& bounds);
+    [[nodiscard]] static bool ray_hits_bounds(glm::vec2 const& origin, glm::vec2 const& inverse_direction, float const max_distance,
+                                              BoundingBox2D const& bounds);
+
+    i32 allocate_node();
+    void free_node(i32 const node_id);
+
+    void insert_leaf(i32 const leaf);
+    void remove_leaf(i32 const leaf);
+
+    i32 balance(i32 const node_id);
+
+    std::vector<Node> m_nodes = {};
+    i32 m_root = null_node;
+    i32 m_free_list = null_node;
+    u32 m_proxy_count = 0;
+};
@@ -10,10 +10,12 @@
 #include <imgui_internal.h>
 #endif
 
+#include <algorithm>
 #include <filesystem>
 #include <glm/gtc/type_ptr.inl>
 #include <glm/gtx/string_cast.hpp>
 
+#include "AK/Pool.h"
 #include "AK/ScopeGuard.h"
 
 #include "Button.h"
@@ -66,8 +68,10 @@
 #include "Panel.h"
 #include "Particle.h"
 #include "ParticleSystem.h"
+#include "PhysicsEngine.h"
 #include "PointLight.h"
 #include "RendererDX11.h"
+#include "Rigidbody2D.h"
 #include "SceneSerializer.h"
 #include "ScreenText.h"
 #include "Sound.h"
@@ -104,16 +108,6 @@ Editor::Editor(AK::Badge<Editor>)
         Camera::set_main_camera(m_editor_camera);
 }
 
-Editor::~Editor()
-{
-    std::filesystem::path const copied_entity_path = m_copied_entity_path;
-
-    if (std::filesystem::exists(copied_entity_path))
-    {
-        std::filesystem::remove(copied_entity_path);
-    }
-}
-
 std::shared_ptr<Editor> Editor::create()
 {
     auto editor = std::make_shared<Editor>(AK::Badge<Editor> {});
@@ -196,6 +190,11 @@ void Editor::draw_debug_window(std::shared_ptr<EditorWindow> const& window)
     ImGui::SameLine();
     ImGui::Checkbox("Show newest logs", &m_always_newest_logs);
     ImGui::Text("Application average %.3f ms/frame", m_average_ms_per_frame);
+    draw_physics_stats();
+    draw_scene_stats();
+    draw_job_stats();
+    draw_allocation_stats();
+    draw_prefab_stats();
     draw_scene_save();
 
     std::string const log_count = "Logs " + std::to_string(Debug::debug_messages.size());
@@ -245,6 +244,342 @@ void Editor::draw_debug_window(std::shared_ptr<EditorWindow> const& window)
     Renderer::get_instance()->wireframe_mode_active = m_polygon_mode_active;
 }
 
+void Editor::draw_physics_stats()
+{
+    if (!ImGui::CollapsingHeader("Physics"))
+        return;
+
+    auto const physics_engine = PhysicsEngine::get_instance();
+
+    std::array const broadphase_types = {"Brute force", "Uniform grid", "Sweep and prune", "Dynamic tree"};
+    i32 current_item_index = static_cast<i32>(physics_engine->get_broadphase_type());
+    if (ImGui::Combo("Broadphase", &current_item_index, broadphase_types.data(), broadphase_types.size()))
+    {
+        physics_engine->set_broadphase_type(static_cast<BroadphaseType>(current_item_index));
+    }
+
+    i32 max_substeps = static_cast<i32>(physics_engine->get_max_substeps());
+    if (ImGui::SliderInt("Max substeps", &max_substeps, 1, 32))
+    {
+        physics_engine->set_max_substeps(static_cast<u32>(max_substeps));
+    }
+
+    bool should_carry = physics_engine->get_carry_leftover_time();
+    if (ImGui::Checkbox("Carry leftover time", &should_carry))
+    {
+        physics_engine->set_carry_leftover_time(should_carry);
+    }
+
+    if (should_carry)
+    {
+        i32 max_carried_steps = static_cast<i32>(physics_engine->get_max_carried_steps());
+        if (ImGui::SliderInt("Max carried steps", &max_carried_steps, 0, 64))
+        {
+            physics_engine->set_max_carried_steps(static_cast<u32>(max_carried_steps));
+        }
+    }
+
+    bool is_interpolated = physics_engine->is_interpolation_enabled();
+    if (ImGui::Checkbox("Interpolate poses", &is_interpolated))
+    {
+        physics_engine->set_interpolation_enabled(is_interpolated);
+    }
+
+    bool is_multithreaded = physics_engine->is_narrowphase_multithreaded();
+    ImGui::BeginDisabled(PHYSICS_SINGLE_THREADED);
+    if (ImGui::Checkbox("Multithreaded narrowphase", &is_multithreaded))
+    {
+        physics_engine->set_narrowphase_multithreaded(is_multithreaded);
+    }
+    ImGui::EndDisabled();
+
+    if (ImGui::TreeNode("Layer matrix"))
+    {
+        ImGui::SliderInt("Layer", &m_selected_collision_layer, 0, static_cast<i32>(collision_layer_count) - 1);
+
+        u32 const layer = static_cast<u32>(m_selected_collision_layer);
+        u32 row = 0;
+
+        for (u32 other = 0; other < collision_layer_count; ++other)
+        {
+            if (physics_engine->do_layers_collide(layer, other))
+                row |= 1u << other;
+        }
+
+        if (ImGuiEx::InputLayerMask("Collides with", &row))
+        {
+            for (u32 other = 0; other < collision_layer_count; ++other)
+            {
+                physics_engine->set_layers_collide(layer, other, (row & (1u << other)) != 0);
+            }
+        }
+
+        ImGui::TreePop();
+    }
+
+    PhysicsStats const& stats = physics_engine->get_stats();
+    ImGui::Text("Substeps: %u", stats.substeps);
+    ImGui::Text("Dropped steps: %u", stats.dropped_steps);
+    ImGui::Text("Interpolation alpha: %.2f", physics_engine->get_interpolation_alpha());
+    ImGui::Text("Colliders: %u", stats.colliders);
+    ImGui::Text("Candidate pairs: %u", stats.candidate_pairs);
+    ImGui::Text("Rejected by layers: %u", stats.layer_rejected_pairs);
+    ImGui::Text("Awake colliders: %u", stats.awake_colliders);
+    ImGui::Text("Asleep colliders: %u", stats.asleep_colliders);
+    ImGui::Text("Sleeping pairs: %u", stats.sleeping_pairs);
+    ImGui::Text("Overlapping pairs: %u", stats.overlapping_pairs);
+    ImGui::Text("Tree height: %d", stats.tree_height);
+    ImGui::Text("Trigger pairs: %u", stats.trigger_pairs);
+    ImGui::Text("Trigger enters: %u", stats.trigger_enters);
+    ImGui::Text("Trigger exits: %u", stats.trigger_exits);
+    ImGui::Text("Solver contacts: %u", stats.solver_contacts);
+    ImGui::Text("Warm started contacts: %u", stats.warm_started_contacts);
+    ImGui::Text("Narrowphase: %.0f pairs/s", stats.narrowphase_pairs_per_second);
+    ImGui::Text("Narrowphase threads: %u", stats.narrowphase_threads);
+    ImGui::Text("Convex pairs: %u", stats.convex_pairs);
+    ImGui::Text("Separating axis early outs: %u", stats.axis_early_outs);
+
+    if (ImGui::Button("Benchmark narrowphase"))
+    {
+        m_narrowphase_benchmark = physics_engine->benchmark_narrowphase(100);
+    }
+
+    // Same circle and rectangle pairs, tested 100 times by both
+    if (m_narrowphase_benchmark.pairs > 0)
+    {
+        double const tests = static_cast<double>(m_narrowphase_benchmark.pairs) * 100.0;
+        ImGui::Text("Shape specific: %.0f pairs/s", tests / std::max(m_narrowphase_benchmark.specific_seconds, 1e-9));
+        ImGui::Text("GJK/EPA: %.0f pairs/s", tests / std::max(m_narrowphase_benchmark.convex_seconds, 1e-9));
+        ImGui::Text("Mismatched pairs: %u of %u", m_narrowphase_benchmark.mismatched_pairs, m_narrowphase_benchmark.pairs);
+    }
+}
+
+void Editor::draw_scene_stats()
+{
+    if (!ImGui::CollapsingHeader("Scene"))
+        return;
+
+    auto const scene = MainScene::get_instance();
+
+    bool is_component_set_index_enabled = scene->is_component_set_index_enabled();
+    if (ImGui::Checkbox("Component set index", &is_component_set_index_enabled))
+    {
+        scene->set_component_set_index_enabled(is_component_set_index_enabled);
+    }
+
+    FixedUpdateScheduler& scheduler = scene->get_fixed_update_scheduler();
+
+    bool is_fixed_update_parallel = scheduler.is_parallel();
+    if (ImGui::Checkbox("Parallel fixed update", &is_fixed_update_parallel))
+    {
+        scheduler.set_parallel(is_fixed_update_parallel);
+    }
+
+#if _DEBUG
+    bool is_validation_enabled = scheduler.is_validation_enabled();
+    if (ImGui::Checkbox("Validate fixed update accesses", &is_validation_enabled))
+    {
+        scheduler.set_validation_enabled(is_validation_enabled);
+    }
+#endif
+
+    FixedUpdateStats const& fixed_update_stats = scheduler.get_stats();
+    ImGui::Text("Fixed update phases: %u", fixed_update_stats.phases);
+    ImGui::Text("Fixed update hierarchies: %u", fixed_update_stats.hierarchies);
+    ImGui::Text("Parallel fixed updates: %u", fixed_update_stats.parallel_components);
+    ImGui::Text("Main thread fixed updates: %u", fixed_update_stats.main_thread_components);
+    ImGui::Text("Access violations: %u", fixed_update_stats.violations);
+
+    ComponentSetIndex const& index = scene->get_component_set_index();
+    ImGui::Text("Component sets: %u", index.get_set_count());
+    ImGui::Text("Entities in component sets: %u", index.get_entity_count());
+
+    if (ImGui::Button("Benchmark query"))
+    {
+        m_scene_query_benchmark = Scene::benchmark_query(50000, 20);
+    }
+
+    if (m_scene_query_benchmark.entities > 0)
+    {
+        ImGui::Text("%u of %u entities match, averaged over %u queries", m_scene_query_benchmark.matches, m_scene_query_benchmark.entities,
+                    m_scene_query_benchmark.iterations);
+        ImGui::Text("Every entity: %.3f ms", m_scene_query_benchmark.scan_seconds * 1000.0);
+        ImGui::Text("Component sets: %.3f ms", m_scene_query_benchmark.index_seconds * 1000.0);
+    }
+
+    if (ImGui::Button("Benchmark component lookup"))
+    {
+        m_component_lookup_benchmark = benchmark_component_lookup(10000);
+    }
+
+    if (m_component_lookup_benchmark.lookups > 0)
+    {
+        double const lookups = m_component_lookup_benchmark.lookups;
+        ImGui::Text("Dynamic casts: %.0f lookups/s", lookups / std::max(m_component_lookup_benchmark.dynamic_cast_seconds, 1e-9));
+        ImGui::Text("Component types: %.0f lookups/s", lookups / std::max(m_component_lookup_benchmark.component_type_seconds, 1e-9));
+        ImGui::Text("Mismatched lookups: %u of %u", m_component_lookup_benchmark.mismatched_lookups, m_component_lookup_benchmark.lookups);
+    }
+}
+
+void Editor::draw_job_stats()
+{
+    if (!ImGui::CollapsingHeader("Jobs"))
+        return;
+
+    auto const jobs = AK::JobSystem::get_instance();
+    ImGui::Text("Worker threads: %u", jobs->get_worker_count());
+
+    if (ImGui::Button("Stress test"))
+    {
+        m_job_stress_result = AK::JobSystem::run_stress_test(jobs->get_worker_count(), 20);
+    }
+
+    if (m_job_stress_result.jobs > 0)
+    {
+        ImGui::Text("Jobs: %u in %.3f s", m_job_stress_result.jobs, m_job_stress_result.seconds);
+        ImGui::Text("Failures: %u", m_job_stress_result.failures);
+    }
+
+    if (ImGui::Button("Benchmark scaling"))
+    {
+        m_job_scaling_results = AK::JobSystem::benchmark_scaling(jobs->get_thread_count(), 1 << 20);
+    }
+
+    for (auto const& [threads, seconds, speedup] : m_job_scaling_results)
+    {
+        ImGui::Text("%u threads: %.3f ms, %.2fx", threads, seconds * 1000.0, speedup);
+    }
+}
+
+void Editor::draw_allocation_stats()
+{
+    if (!ImGui::CollapsingHeader("Allocations"))
+        return;
+
+    for (auto const& [name, block_size, slab_count, live_blocks, peak_blocks, allocations] : AK::SlabPool::get_all_stats())
+    {
+        ImGui::Text("%s (%u B): %u live, %u peak, %u slabs, %llu total", name, block_size, live_blocks, peak_blocks, slab_count,
+                    static_cast<unsigned long long>(allocations));
+    }
+
+    if (ImGui::Button("Benchmark entity allocation"))
+    {
+        m_entity_allocation_benchmark = Entity::benchmark_allocation(100000);
+    }
+
+    if (m_entity_allocation_benchmark.entities > 0)
+    {
+        double const entities = m_entity_allocation_benchmark.entities;
+        ImGui::Text("Heap: %.0f entities/s", entities / std::max(m_entity_allocation_benchmark.heap_seconds, 1e-9));
+        ImGui::Text("Pools: %.0f entities/s", entities / std::max(m_entity_allocation_benchmark.pooled_seconds, 1e-9));
+    }
+}
+
+void Editor::draw_prefab_stats()
+{
+    if (!ImGui::CollapsingHeader("Prefabs"))
+        return;
+
+    if (ImGui::Button("Clear prefab cache"))
+    {
+        SceneSerializer::clear_prefab_cache();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark prefabs"))
+    {
+        m_prefab_benchmarks = SceneSerializer::benchmark_prefabs(100);
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark cloning"))
+    {
+        m_clone_benchmarks = {EntityCloner::benchmark("ShipBig", 100), EntityCloner::benchmark("Level_3", 10)};
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Cook scenes"))
+    {
+        m_cook_result = SceneCooker::cook_all();
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark cooked loading"))
+    {
+        m_cooked_load_benchmarks = SceneCooker::benchmark(20);
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::Button("Benchmark deserialization"))
+    {
+        m_deserialization_benchmarks = SceneSerializer::benchmark_deserialization();
+    }
+
+    for (auto const& [entities, seconds] : m_deserialization_benchmarks)
+    {
+        ImGui::Text("%u entities: %.3f ms, %.3f us per entity", entities, seconds * 1000.0, seconds * 1000000.0 / entities);
+    }
+
+    if (m_cook_result.has_value())
+    {
+        ImGui::Text("Cooked %u files, %u up to date, %u failed", m_cook_result->cooked, m_cook_result->up_to_date,
+                    static_cast<u32>(m_cook_result->failed.size()));
+
+        for (auto const& file_path : m_cook_result->failed)
+        {
+            ImGui::Text("Could not cook %s", file_path.c_str());
+        }
+    }
+
+    for (auto const& [name, loads, source_size, cooked_size, parse_seconds, cooked_seconds] : m_cooked_load_benchmarks)
+    {
+        ImGui::Text("%s (%u KB, %u KB cooked): %.3f ms parsed, %.3f ms cooked, %.1fx", name.c_str(), static_cast<u32>(source_size / 1024),
+                    static_cast<u32>(cooked_size / 1024), parse_seconds * 1000.0 / loads, cooked_seconds * 1000.0 / loads,
+                    parse_seconds / std::max(cooked_seconds, 1e-9));
+    }
+
+    for (auto const& [name, entities, clones, clone_seconds, serialization_seconds] : m_clone_benchmarks)
+    {
+        ImGui::Text("%s (%u entities): %.3f ms cloned, %.3f ms serialized, %.1fx", name.c_str(), entities, clone_seconds * 1000.0 / clones,
+                    serialization_seconds * 1000.0 / clones, serialization_seconds / std::max(clone_seconds, 1e-9));
+    }
+
+    for (auto const& [name, instances, uncached_seconds, cached_seconds] : m_prefab_benchmarks)
+    {
+        ImGui::Text("%s: %.3f ms uncached, %.3f ms cached, %.1fx", name.c_str(), uncached_seconds * 1000.0 / instances,
+                    cached_seconds * 1000.0 / instances, uncached_seconds / std::max(cached_seconds, 1e-9));
+    }
+
+    ImGui::Separator();
+
+    for (auto const& [name, capacity, parked, hits, misses, releases, discards] :
+         MainScene::get_instance()->get_prefab_pool().get_stats())
+    {
+        ImGui::Text("%s: %u/%u parked, %u hits, %u misses, %u releases, %u discarded", name.c_str(), parked, capacity, hits, misses,
+                    releases, discards);
+    }
+
+    ImGui::Separator();
+
+    auto& level_streamer = MainScene::get_instance()->get_level_streamer();
+    double frame_budget = level_streamer.get_frame_budget();
+
+    if (ImGui::InputDouble("Level streaming budget (ms)", &frame_budget, 0.5, 1.0, "%.1f"))
+    {
+        level_streamer.set_frame_budget(std::max(frame_budget, 0.0));
+    }
+
+    for (auto const& load : level_streamer.get_loads())
+    {
+        ImGui::ProgressBar(load->get_progress(), ImVec2(-FLT_MIN, 0.0f), load->get_prefab_name().c_str());
+    }
+}
+
 void Editor::draw_content_browser(std::shared_ptr<EditorWindow> const& window)
 {
     bool is_still_open = true;
@@ -610,8 +945,7 @@ void Editor::draw_scene_hierarchy(std::shared_ptr<EditorWindow> const& window)
 
     if (ImGui::BeginPopup("HierarchyPopup", ImGuiPopupFlags_MouseButtonRight))
     {
-        std::filesystem::path const copied_entity_path = m_copied_entity_path;
-        bool const copied_entity_exists = std::filesystem::exists(copied_entity_path);
+        bool const copied_entity_exists = !m_copied_entity.entities.empty();
 
         if (!copied_entity_exists)
         {
@@ -1446,23 +1780,20 @@ void Editor::delete_selected_entity() const
     }
 }
 
-void Editor::copy_selected_entity() const
+void Editor::copy_selected_entity()
 {
     if (m_selected_entity.expired())
         return;
 
-    auto const scene_serializer = std::make_shared<SceneSerializer>(m_open_scene);
-    scene_serializer->set_instance(scene_serializer);
-    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
-    scene_serializer->serialize_this_entity(m_selected_entity.lock(), m_copied_entity_path);
+    m_copied_entity = EntityCloner::create_prototype(*m_selected_entity.lock());
 }
 
 void Editor::paste_entity() const
 {
-    auto const scene_serializer = std::make_shared<SceneSerializer>(m_open_scene);
-    scene_serializer->set_instance(scene_serializer);
-    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
-    scene_serializer->deserialize_this_entity("./.editor/copied_entity.txt");
+    if (m_copied_entity.entities.empty())
+        return;
+
+    (void)EntityCloner::instantiate(m_copied_entity, {});
 }
 
 void Editor::add_child_entity() const
@@ -1484,6 +1815,7 @@ void Editor::save_entity_as_prefab()
     scene_serializer->set_instance(scene_serializer);
     ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
     scene_serializer->serialize_this_entity(m_selected_entity.lock(), m_prefab_path + m_selected_entity.lock()->name + ".txt");
+    SceneSerializer::clear_prefab_cache();
 
     load_assets();
 }
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "AK/Badge.h"
+#include "AK/JobSystem.h"
 #include "AK/Types.h"
+#include "CollisionKernels.h"
+#include "Entity.h"
+#include "EntityCloner.h"
 #include "Scene.h"
+#include "SceneCooker.h"
+#include "SceneSerializer.h"
 #include "Transform.h"
 
 #include <array>
+#include <optional>
 
 class DebugDrawing;
 class Camera;
@@ -147,7 +154,6 @@ public:
     static std::shared_ptr<Editor> create();
 
     explicit Editor(AK::Badge<Editor>);
-    ~Editor();
 
     void draw();
     void set_scene(std::shared_ptr<Scene> const& scene);
@@ -187,6 +193,11 @@ private:
     void draw_inspector(std::shared_ptr<EditorWindow> const& window);
     void draw_scene_hierarchy(std::shared_ptr<EditorWindow> const& window);
     void draw_scene_save();
+    void draw_physics_stats();
+    void draw_scene_stats();
+    void draw_job_stats();
+    void draw_allocation_stats();
+    void draw_prefab_stats();
 
     void draw_entity_recursively(std::shared_ptr<Transform> const& transform);
     static void entity_drag(std::shared_ptr<Entity> const& entity);
@@ -205,7 +216,7 @@ private:
     void switch_gizmo_snapping();
 
     void delete_selected_entity() const;
-    void copy_selected_entity() const;
+    void copy_selected_entity();
     void paste_entity() const;
     void add_child_entity() const;
     void save_entity_as_prefab();
@@ -218,7 +229,8 @@ private:
     std::vector<std::shared_ptr<DebugDrawing>> m_debug_drawings = {};
     bool m_debug_drawings_enabled = true;
 
-    std::string m_copied_entity_path = "./.editor/copied_entity.txt";
+    // Copied when copying, pasting works after the entity is changed or destroyed
+    ClonePrototype m_copied_entity = {};
 
     glm::dvec2 m_last_mouse_position = glm::dvec2(1280.0 / 2.0, 720.0 / 2.0);
     float m_yaw = 0.0f;
@@ -247,6 +259,18 @@ private:
     i32 m_last_window_id = 0;
 
     bool m_polygon_mode_active = false;
+    i32 m_selected_collision_layer = 0;
+    NarrowphaseBenchmark m_narrowphase_benchmark = {};
+    SceneQueryBenchmark m_scene_query_benchmark = {};
+    ComponentLookupBenchmark m_component_lookup_benchmark = {};
+    AK::JobStressResult m_job_stress_result = {};
+    std::vector<AK::JobScalingResult> m_job_scaling_results = {};
+    EntityAllocationBenchmark m_entity_allocation_benchmark = {};
+    std::vector<PrefabBenchmark> m_prefab_benchmarks = {};
+    std::vector<CloneBenchmark> m_clone_benchmarks = {};
+    std::vector<CookedLoadBenchmark> m_cooked_load_benchmarks = {};
+    std::optional<CookResult> m_cook_result = {};
+    std::vector<DeserializationBenchmark> m_deserialization_benchmarks = {};
     bool m_always_newest_logs = false;
     i64 m_frame_count = 0;
     double m_current_time = 0.0;
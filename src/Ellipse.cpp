@@ -10,7 +10,7 @@
 
 std::shared_ptr<class Ellipse> Ellipse::create()
 {
-    auto ellipse = std::make_shared<Ellipse>(AK::Badge<Ellipse> {});
+    auto ellipse = AK::make_pooled<Ellipse>(AK::Badge<Ellipse> {});
 
     return ellipse;
 }
@@ -18,7 +18,7 @@ std::shared_ptr<class Ellipse> Ellipse::create()
 std::shared_ptr<class Ellipse> Ellipse::create(float const center_x, float const center_z, float const radius_x, float const radius_z,
                                                i32 const segment_count, std::shared_ptr<Material> const& material)
 {
-    auto ellipse = std::make_shared<Ellipse>(AK::Badge<Ellipse> {}, center_x, center_z, radius_x, radius_z, segment_count, material);
+    auto ellipse = AK::make_pooled<Ellipse>(AK::Badge<Ellipse> {}, center_x, center_z, radius_x, radius_z, segment_count, material);
 
     return ellipse;
 }
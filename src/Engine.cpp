@@ -7,12 +7,15 @@
 
 #include <miniaudio.h>
 
+#include "AK/JobSystem.h"
 #include "AssetPreloader.h"
 #include "Editor.h"
+#include "Floater.h"
 #include "Game/Game.h"
 #include "Globals.h"
 #include "Input.h"
 #include "MainScene.h"
+#include "Particle.h"
 #include "PhysicsEngine.h"
 #include "Renderer.h"
 #include "RendererDX11.h"
@@ -47,6 +50,8 @@ i32 Engine::initialize()
 
     Renderer::get_instance()->set_vsync(enable_vsync);
 
+    AK::JobSystem::initialize(job_worker_count);
+
     PhysicsEngine::get_instance()->initialize();
 
     if (auto const result = initialize_thirdparty_after_renderer(); result != 0)
@@ -81,6 +86,10 @@ void Engine::create_game()
     auto const main_scene = std::make_shared<Scene>();
     MainScene::set_instance(main_scene);
 
+    // Many instances with cheap updates, after everything else like before
+    main_scene->tickable_components.register_batch<Floater>();
+    main_scene->tickable_components.register_batch<Particle>();
+
     asset_preloader->preload_text_asset("./res/scenes/MainScene.txt");
     asset_preloader->preload_text_asset("./res/prefabs/Level_0.txt");
     asset_preloader->preload_text_asset("./res/prefabs/Level_1.txt");
@@ -154,6 +163,8 @@ void Engine::run()
         glfwPollEvents();
         Input::input->update_keys();
 
+        AK::JobSystem::get_instance()->run_main_thread_jobs();
+
 #if EDITOR
         // Start the Dear ImGui frame
         switch (Renderer::renderer_api)
@@ -179,14 +190,24 @@ void Engine::run()
 
         Renderer::get_instance()->begin_frame();
 
-        if (m_is_game_running && !m_is_game_paused)
+        bool const is_updating = m_is_game_running && !m_is_game_paused;
+
+        if (is_updating)
         {
             PhysicsEngine::get_instance()->run_updates();
             MainScene::get_instance()->run_frame();
         }
 
+        // NOTE: Before interpolating, destroying a collider moves others to its index and restore_poses() goes by index.
+        MainScene::get_instance()->destroy_queued_entities();
+
+        if (is_updating)
+            PhysicsEngine::get_instance()->interpolate_poses();
+
         Renderer::get_instance()->render();
 
+        PhysicsEngine::get_instance()->restore_poses();
+
         Renderer::get_instance()->end_frame();
 
 #if EDITOR
@@ -245,6 +266,8 @@ void Engine::clean_up()
     ImGui::DestroyContext();
 #endif
 
+    AK::JobSystem::uninitialize();
+
     glfwDestroyWindow(window->get_glfw_window());
     glfwTerminate();
 }
@@ -39,6 +39,9 @@ public:
     inline static bool enable_vsync = false;
     inline static bool enable_mouse_capture = false;
 
+    // Threads of the job system besides the main one, zero picks one for every other hardware thread
+    inline static u32 job_worker_count = 0;
+
     inline static ma_engine audio_engine;
 
     inline static std::shared_ptr<Window> window;
@@ -1,3 +1,8 @@
 #pragma once
 
 #define EDITOR true
+
+// Set by the PHYSICS_SINGLE_THREADED CMake option, keeps the physics narrowphase on the main thread
+#ifndef PHYSICS_SINGLE_THREADED
+#define PHYSICS_SINGLE_THREADED false
+#endif
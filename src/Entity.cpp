@@ -1,31 +1,38 @@
 #include "Entity.h"
 
 #include "AK/AK.h"
-#include "Engine.h"
+#include "EntityCloner.h"
+#include "FixedUpdateScheduler.h"
 #include "MainScene.h"
 
+#include <array>
+#include <chrono>
+
+namespace
+{
+
+class BenchmarkComponent final : public Component
+{
+public:
+    u32 value = 0;
+};
+
+}
+
 Entity::Entity(AK::Badge<Entity>, std::string const& name) : name(std::move(name))
 {
 }
 
 std::shared_ptr<Entity> Entity::create(std::string const& name)
 {
-    auto entity = std::make_shared<Entity>(AK::Badge<Entity> {}, name);
-    entity->guid = AK::generate_guid();
-    std::hash<std::string> constexpr hasher;
-    entity->hashed_guid = hasher(entity->guid);
-    entity->transform = std::make_shared<Transform>(entity);
+    auto entity = allocate(AK::generate_guid(), name);
     MainScene::get_instance()->add_child(entity);
     return entity;
 }
 
 std::shared_ptr<Entity> Entity::create(std::string const& guid, std::string const& name)
 {
-    auto entity = std::make_shared<Entity>(AK::Badge<Entity> {}, name);
-    entity->guid = guid;
-    std::hash<std::string> constexpr hasher;
-    entity->hashed_guid = hasher(entity->guid);
-    entity->transform = std::make_shared<Transform>(entity);
+    auto entity = allocate(guid, name);
     MainScene::get_instance()->add_child(entity);
     return entity;
 }
@@ -33,54 +40,151 @@ std::shared_ptr<Entity> Entity::create(std::string const& guid, std::string cons
 // Entity that is not tied to any scene
 std::shared_ptr<Entity> Entity::create_internal(std::string const& name)
 {
-    auto entity = std::make_shared<Entity>(AK::Badge<Entity> {}, name);
-    entity->guid = AK::generate_guid();
+    return allocate(AK::generate_guid(), name);
+}
+
+std::shared_ptr<Entity> Entity::allocate(std::string const& guid, std::string const& name, bool const is_pooled)
+{
+#if _DEBUG
+    FixedUpdateScheduler::validate_structural_change("creates an entity");
+#endif
+
+    auto entity = is_pooled ? AK::make_pooled<Entity>(AK::Badge<Entity> {}, name) : std::make_shared<Entity>(AK::Badge<Entity> {}, name);
+    entity->guid = guid;
     std::hash<std::string> constexpr hasher;
     entity->hashed_guid = hasher(entity->guid);
-    entity->transform = std::make_shared<Transform>(entity);
+    entity->transform = is_pooled ? AK::make_pooled<Transform>(entity) : std::make_shared<Transform>(entity);
     return entity;
 }
 
-void Entity::destroy_immediate()
+EntityAllocationBenchmark Entity::benchmark_allocation(u32 const entity_count)
 {
-    for (u32 i = 0; i < components.size(); ++i)
-    {
-        components[i]->on_destroyed();
-    }
+    EntityAllocationBenchmark benchmark = {};
+    benchmark.entities = entity_count;
 
-    // NOTE: We need to keep a pointer to this object to keep it alive for the duration of this function.
-    auto const ptr = shared_from_this();
-    MainScene::get_instance()->remove_child(ptr);
+    // Scene of its own, the open one is left alone
+    auto const previous_scene = MainScene::get_instance();
+    auto const scene = std::make_shared<Scene>();
+    MainScene::set_instance(scene);
 
-    for (u32 i = 0; i < components.size(); ++i)
-    {
-        if (!components[i]->has_been_awaken)
+    auto const spawn_and_destroy = [&](bool const is_pooled) {
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (u32 i = 0; i < entity_count; ++i)
         {
-            MainScene::get_instance()->remove_component_to_awake(components[i]);
+            auto const entity = allocate(AK::generate_guid(), "Benchmark", is_pooled);
+            scene->add_child(entity);
+
+            if (is_pooled)
+                entity->add_component_internal(AK::make_pooled<BenchmarkComponent>());
+            else
+                entity->add_component_internal(std::make_shared<BenchmarkComponent>());
         }
 
-        if (!components[i]->has_been_started)
+        for (auto const& entity : scene->entities)
         {
-            MainScene::get_instance()->remove_component_to_start(components[i]);
+            entity->destroy();
         }
 
-        components[i]->set_can_tick(false);
+        scene->destroy_queued_entities();
 
-        if (Engine::is_game_running())
-            components[i]->set_enabled(false);
+        std::chrono::duration<double> const time = std::chrono::high_resolution_clock::now() - start;
+        return time.count();
+    };
 
-        components[i]->uninitialize();
-        components[i]->entity = nullptr;
+    // Second runs, the first pooled one is busy allocating slabs
+    for (u32 run = 0; run < 2; ++run)
+    {
+        benchmark.heap_seconds = spawn_and_destroy(false);
+        benchmark.pooled_seconds = spawn_and_destroy(true);
     }
 
-    auto const children_copy = transform->children;
-    for (auto const& child : children_copy)
+    MainScene::set_instance(previous_scene);
+
+    return benchmark;
+}
+
+void Entity::destroy()
+{
+#if _DEBUG
+    FixedUpdateScheduler::validate_structural_change("destroys an entity");
+#endif
+
+    if (m_is_queued_for_destruction || m_is_being_destroyed)
+        return;
+
+    if (m_prefab_instance != nullptr && MainScene::get_instance()->get_prefab_pool().release(shared_from_this()))
+        return;
+
+    m_is_queued_for_destruction = true;
+    MainScene::get_instance()->queue_destroy(shared_from_this());
+}
+
+void Entity::destroy_immediate()
+{
+#if _DEBUG
+    FixedUpdateScheduler::validate_structural_change("destroys an entity");
+#endif
+
+    if (m_is_being_destroyed)
+        return;
+
+    if (m_prefab_instance != nullptr && MainScene::get_instance()->get_prefab_pool().release(shared_from_this()))
+        return;
+
+    // NOTE: We need to keep a pointer to this object to keep it alive for the duration of this function.
+    std::array const entities = {shared_from_this()};
+    MainScene::get_instance()->destroy_entities(entities);
+}
+
+bool Entity::is_queued_for_destruction() const
+{
+    return m_is_queued_for_destruction;
+}
+
+bool Entity::is_active() const
+{
+    return !m_is_parked && !m_is_queued_for_destruction;
+}
+
+std::shared_ptr<Entity> Entity::clone(std::shared_ptr<Transform> const& parent) const
+{
+    return EntityCloner::clone(*this, parent);
+}
+
+void Entity::add_component_type(u32 const index)
+{
+#if _DEBUG
+    FixedUpdateScheduler::validate_structural_change("adds a component");
+#endif
+
+    ComponentType type = components[index]->get_type();
+
+    if (type == ComponentType::Unknown)
+    {
+        m_has_unknown_components = true;
+        return;
+    }
+
+    // Parents are present already if the type is
+    while (!m_component_types.test(static_cast<u16>(type)))
     {
-        child->entity.lock()->destroy_immediate();
+        m_component_types.set(static_cast<u16>(type));
+
+        if (type == ComponentType::Component)
+            break;
+
+        type = component_type_parents[static_cast<u16>(type)];
     }
+}
+
+void Entity::rebuild_component_types()
+{
+    m_component_types.reset();
+    m_has_unknown_components = false;
 
-    if (!transform->parent.expired())
+    for (u32 i = 0; i < components.size(); ++i)
     {
-        transform->set_parent(nullptr);
+        add_component_type(i);
     }
 }
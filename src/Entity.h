@@ -6,6 +6,15 @@
 #include "MainScene.h"
 #include "Transform.h"
 
+#include <bitset>
+
+struct EntityAllocationBenchmark
+{
+    u32 entities = 0;
+    double heap_seconds = 0.0;
+    double pooled_seconds = 0.0;
+};
+
 class Entity : public std::enable_shared_from_this<Entity>
 {
 public:
@@ -16,15 +25,36 @@ public:
     // Entity that is not tied to any scene
     static std::shared_ptr<Entity> create_internal(std::string const& name = "Entity");
 
+    // Destroys the entity and its children at the end of the frame, together with everything else destroyed this frame.
+    // Until then it stays in the scene but is inactive.
+    void destroy();
+
+    // Destroys the entity and its children right away, for the editor and code that needs them gone at once
     void destroy_immediate();
 
+    [[nodiscard]] bool is_queued_for_destruction() const;
+
+    // False while it is parked by the scene's PrefabPool or queued for destruction. The tick list, renderer, physics and
+    // component set queries skip inactive entities.
+    [[nodiscard]] bool is_active() const;
+
+    // Copy of the entity and its serialized children, made in memory instead of through serialization.
+    // Parented to the given transform, or to nothing.
+    std::shared_ptr<Entity> clone(std::shared_ptr<Transform> const& parent = nullptr) const;
+
+    // Creates entities with a transform and a component and destroys them again, once allocated from the pools
+    // and once from the heap. Uses a scene of its own.
+    static EntityAllocationBenchmark benchmark_allocation(u32 const entity_count);
+
     template<class T>
     std::shared_ptr<T> add_component()
     {
         auto component = std::make_shared<T>();
         components.emplace_back(component);
         component->entity = shared_from_this();
+        add_component_type(static_cast<u32>(components.size()) - 1);
 
+        MainScene::get_instance()->update_component_set(*this);
         MainScene::get_instance()->add_component_to_start(component);
 
         // Initialization for internal components
@@ -62,7 +92,9 @@ public:
     {
         components.emplace_back(component);
         component->entity = shared_from_this();
+        add_component_type(static_cast<u32>(components.size()) - 1);
 
+        MainScene::get_instance()->update_component_set(*this);
         MainScene::get_instance()->add_component_to_start(component);
 
         // Initialization for internal components
@@ -101,7 +133,9 @@ public:
         auto component = std::make_shared<T>(std::forward<TArgs>(args)...);
         components.emplace_back(component);
         component->entity = shared_from_this();
+        add_component_type(static_cast<u32>(components.size()) - 1);
 
+        MainScene::get_instance()->update_component_set(*this);
         MainScene::get_instance()->add_component_to_start(component);
 
         // Initialization for internal components
@@ -141,6 +175,7 @@ public:
     {
         components.emplace_back(component);
         component->entity = shared_from_this();
+        add_component_type(static_cast<u32>(components.size()) - 1);
 
         // Initialization for internal components
         component->initialize();
@@ -151,6 +186,25 @@ public:
     template<typename T>
     std::shared_ptr<T> get_component()
     {
+        if constexpr (component_type_of<T> != ComponentType::Unknown)
+        {
+            if (!m_has_unknown_components)
+            {
+                u16 constexpr type = static_cast<u16>(component_type_of<T>);
+
+                if (!m_component_types.test(type))
+                    return nullptr;
+
+                for (auto const& component : components)
+                {
+                    if (is_component_type_of(component->get_type(), component_type_of<T>))
+                        return std::static_pointer_cast<T>(component);
+                }
+
+                return nullptr;
+            }
+        }
+
         for (auto const& component : components)
         {
             auto comp = std::dynamic_pointer_cast<T>(component);
@@ -165,6 +219,26 @@ public:
     std::vector<std::shared_ptr<T>> get_components()
     {
         std::vector<std::shared_ptr<T>> vector = {};
+
+        if constexpr (component_type_of<T> != ComponentType::Unknown)
+        {
+            if (!m_has_unknown_components)
+            {
+                u16 constexpr type = static_cast<u16>(component_type_of<T>);
+
+                if (!m_component_types.test(type))
+                    return vector;
+
+                for (auto const& component : components)
+                {
+                    if (is_component_type_of(component->get_type(), component_type_of<T>))
+                        vector.emplace_back(std::static_pointer_cast<T>(component));
+                }
+
+                return vector;
+            }
+        }
+
         for (auto const& component : components)
         {
             auto comp = std::dynamic_pointer_cast<T>(component);
@@ -184,8 +258,44 @@ public:
     bool is_serialized = true;
 
 private:
+    // Entity and its transform come from their pools unless the benchmark compares them with the heap
+    static std::shared_ptr<Entity> allocate(std::string const& guid, std::string const& name, bool const is_pooled = true);
+
     std::string m_parent_guid; // NOTE: Only for serialization
     bool m_is_being_deserialized = false;
 
+    bool m_is_queued_for_destruction = false;
+
+    // Set once the scene starts destroying it, it is never undone
+    bool m_is_being_destroyed = false;
+
+    // Only on the root of an instance of a pooled prefab, destroying it releases the instance to the scene's PrefabPool
+    std::shared_ptr<PrefabInstance> m_prefab_instance = {};
+
+    bool m_is_parked = false;
+
+    // Set and row of this entity in the scene's component set index, if it is enabled
+    u32 m_component_set = ComponentSetIndex::invalid_index;
+    u32 m_component_set_row = 0;
+
+    // Marks the type of the component and all of its parents as present
+    void add_component_type(u32 const index);
+
+    // Called after components were removed, their order might have changed too
+    void rebuild_component_types();
+
+    // Types of the components and their parents. Absent types are rejected without looking at the components,
+    // present ones are found by a scan over them, entities only have a few.
+    std::bitset<component_type_count> m_component_types = {};
+
+    // Components of types that EngineHeaderTool hasn't seen can only be found with dynamic casts
+    bool m_has_unknown_components = false;
+
     friend class SceneSerializer;
+    friend class ComponentSetIndex;
+    friend class Component;
+    friend class Scene;
+    friend class PrefabPool;
+    friend class EntityCloner;
+    friend class LevelStreamer;
 };
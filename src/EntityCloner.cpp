@@ -0,0 +1,1064 @@
+#include "EntityCloner.h"
+
+#include <chrono>
+
+#include "AK/AK.h"
+#include "Entity.h"
+#include "Material.h"
+#include "SceneSerializer.h"
+
+#include "Button.h"
+#include "Camera.h"
+#include "Collider2D.h"
+#include "Cube.h"
+#include "Curve.h"
+#include "DebugInputController.h"
+#include "DialoguePromptController.h"
+#include "DirectionalLight.h"
+#include "ExampleDynamicText.h"
+#include "ExampleUIBar.h"
+#include "Floater.h"
+#include "FloatersManager.h"
+#include "FloeButton.h"
+#include "Game/Clock.h"
+#include "Game/Credits.h"
+#include "Game/Customer.h"
+#include "Game/CustomerManager.h"
+#include "Game/EndScreen.h"
+#include "Game/Factory.h"
+#include "Game/GameController.h"
+#include "Game/HovercraftWithoutKeeper.h"
+#include "Game/IceBound.h"
+#include "Game/LevelController.h"
+#include "Game/Lighthouse.h"
+#include "Game/LighthouseKeeper.h"
+#include "Game/LighthouseLight.h"
+#include "Game/Path.h"
+#include "Game/Player.h"
+#include "Game/Player/PlayerInput.h"
+#include "Game/Popup.h"
+#include "Game/Port.h"
+#include "Game/Ship.h"
+#include "Game/ShipEyes.h"
+#include "Game/ShipSpawner.h"
+#include "Game/Thanks.h"
+#include "Model.h"
+#include "NowPromptTrigger.h"
+#include "Panel.h"
+#include "ParticleSystem.h"
+#include "PointLight.h"
+#include "Rigidbody2D.h"
+#include "ScreenText.h"
+#include "Sound.h"
+#include "SoundListener.h"
+#include "Sphere.h"
+#include "SpotLight.h"
+#include "Sprite.h"
+#include "Water.h"
+// # Put new header here
+
+std::shared_ptr<Entity> EntityCloner::clone(Entity const& entity, std::shared_ptr<Transform> const& parent)
+{
+    if (!entity.is_serialized)
+        return nullptr;
+
+    EntityCloner cloner = {};
+    cloner.add_entities(entity);
+
+    return cloner.copy_entities(parent).front();
+}
+
+std::vector<std::shared_ptr<Entity>> EntityCloner::instantiate(ClonePrototype const& prototype, std::span<std::string const> const guids)
+{
+    EntityCloner cloner = {};
+    cloner.m_guids = guids;
+
+    for (u32 i = 0; i < prototype.entities.size(); ++i)
+    {
+        cloner.m_sources.emplace_back(prototype.entities[i].get(), &prototype.components[i]);
+    }
+
+    return cloner.copy_entities(nullptr);
+}
+
+ClonePrototype EntityCloner::create_prototype(Entity const& entity)
+{
+    ClonePrototype prototype = {};
+
+    if (!entity.is_serialized)
+        return prototype;
+
+    EntityCloner cloner = {};
+    cloner.m_prototype = &prototype;
+    cloner.add_entities(entity);
+
+    prototype.entities = cloner.copy_entities(nullptr);
+    return prototype;
+}
+
+CloneBenchmark EntityCloner::benchmark(std::string const& prefab_name, u32 const clone_count)
+{
+    CloneBenchmark benchmark = {};
+    benchmark.name = prefab_name;
+    benchmark.clones = clone_count;
+
+    // Scene of its own, the open one is left alone
+    auto const previous_scene = MainScene::get_instance();
+    auto const scene = std::make_shared<Scene>();
+    MainScene::set_instance(scene);
+
+    auto const source = SceneSerializer::load_prefab(prefab_name);
+
+    if (source == nullptr)
+    {
+        MainScene::set_instance(previous_scene);
+        return benchmark;
+    }
+
+    EntityCloner counter = {};
+    counter.add_entities(*source);
+    benchmark.entities = static_cast<u32>(counter.m_sources.size());
+
+    auto const destroy_copies = [&] {
+        for (auto const& entity : scene->entities)
+        {
+            if (entity != source && entity->transform->parent.expired())
+                entity->destroy();
+        }
+
+        scene->destroy_queued_entities();
+    };
+
+    auto const start_clone = std::chrono::high_resolution_clock::now();
+
+    for (u32 i = 0; i < clone_count; ++i)
+    {
+        (void)clone(*source, nullptr);
+    }
+
+    destroy_copies();
+
+    std::chrono::duration<double> const clone_time = std::chrono::high_resolution_clock::now() - start_clone;
+    benchmark.clone_seconds = clone_time.count();
+
+    auto const start_serialization = std::chrono::high_resolution_clock::now();
+
+    // Serializer for every copy, like the editor used, it remembers the guids it replaced.
+    // NOTE: Kept in memory and parsed from the text, so neither the disk nor cooked files are measured.
+    for (u32 i = 0; i < clone_count; ++i)
+    {
+        auto const scene_serializer = std::make_shared<SceneSerializer>(scene);
+        SceneSerializer::set_instance(scene_serializer);
+        (void)scene_serializer->deserialize_this_entity_from_text(SceneSerializer::serialize_this_entity_to_text(source));
+    }
+
+    destroy_copies();
+
+    std::chrono::duration<double> const serialization_time = std::chrono::high_resolution_clock::now() - start_serialization;
+    benchmark.serialization_seconds = serialization_time.count();
+
+    SceneSerializer::set_instance(nullptr);
+
+    MainScene::set_instance(previous_scene);
+
+    return benchmark;
+}
+
+void EntityCloner::add_entities(Entity const& entity)
+{
+    m_sources.emplace_back(&entity, &entity.components);
+
+    for (auto const& child : entity.transform->children)
+    {
+        auto const child_entity = child->entity.lock();
+
+        if (child_entity == nullptr || !child_entity->is_serialized)
+            continue;
+
+        add_entities(*child_entity);
+    }
+}
+
+std::vector<std::shared_ptr<Entity>> EntityCloner::copy_entities(std::shared_ptr<Transform> const& parent)
+{
+    std::vector<std::shared_ptr<Entity>> copies = {};
+    copies.reserve(m_sources.size());
+
+    u32 guid_index = 0;
+
+    // First pass. Create all entities and components, so references between them can be remapped.
+    for (auto const& [source, source_components] : m_sources)
+    {
+        std::shared_ptr<Entity> copy = nullptr;
+
+        // Entities of a prototype aren't in any scene
+        if (m_prototype != nullptr)
+            copy = Entity::allocate(AK::generate_guid(), source->name);
+        else if (m_guids.empty())
+            copy = Entity::create(source->name);
+        else
+            copy = Entity::create(m_guids[guid_index++], source->name);
+
+        copy->m_is_being_deserialized = true;
+
+        if (m_prototype != nullptr)
+            m_prototype->components.emplace_back();
+
+        copy->transform->set_local_position(source->transform->get_local_position());
+        copy->transform->set_euler_angles(source->transform->get_euler_angles());
+        copy->transform->set_local_scale(source->transform->get_local_scale());
+
+        for (auto const& component : *source_components)
+        {
+            auto const component_copy = create_component(*component);
+
+            if (component_copy == nullptr)
+                continue;
+
+            if (!m_guids.empty())
+                component_copy->guid = m_guids[guid_index++];
+
+            if (m_prototype != nullptr)
+                m_prototype->components.back().emplace_back(component_copy);
+
+            m_component_copies.emplace(component.get(), component_copy);
+            m_components.emplace_back(component.get(), component_copy, copy);
+        }
+
+        m_entity_copies.emplace(source, copy);
+        copies.emplace_back(copy);
+    }
+
+    for (u32 i = 0; i < m_sources.size(); ++i)
+    {
+        auto const source_parent = m_sources[i].entity->transform->parent.lock();
+        auto const parent_copy = i == 0 || source_parent == nullptr ? nullptr : m_entity_copies.at(source_parent->entity.lock().get());
+
+        if (i == 0 && parent != nullptr)
+            copies[i]->transform->set_parent(parent);
+        else if (parent_copy != nullptr)
+            copies[i]->transform->set_parent(parent_copy->transform);
+    }
+
+    // Second pass. Assign components' values including references to other components.
+    for (auto const& [source, copy, entity_copy] : m_components)
+    {
+        copy_fields(*source, *copy);
+
+        // Components of a prototype are only added to the entities instantiated from it
+        if (m_prototype != nullptr)
+            continue;
+
+        entity_copy->add_component(copy);
+        copy->reprepare();
+    }
+
+    for (auto const& copy : copies)
+    {
+        copy->m_is_being_deserialized = false;
+    }
+
+    if (m_prototype == nullptr && MainScene::get_instance()->is_running)
+    {
+        for (auto const& [source, copy, entity_copy] : m_components)
+        {
+            copy->awake();
+            copy->has_been_awaken = true;
+
+            if (copy->enabled())
+            {
+                copy->on_enabled();
+            }
+        }
+    }
+
+    return copies;
+}
+
+std::shared_ptr<Material> EntityCloner::clone_value(std::shared_ptr<Material> const& value) const
+{
+    if (value == nullptr)
+        return nullptr;
+
+    auto const copy = Material::create(value->shader, value->get_render_order());
+    copy->color = value->color;
+    copy->needs_forward_rendering = value->needs_forward_rendering;
+    copy->casts_shadows = value->casts_shadows;
+    copy->is_billboard = value->is_billboard;
+
+    return copy;
+}
+
+std::shared_ptr<Component> EntityCloner::create_component(Component const& component)
+{
+    switch (component.get_type())
+    {
+    // # Auto clone creation start
+    case ComponentType::Camera:
+        return Camera::create();
+
+    case ComponentType::Collider2D:
+        return Collider2D::create();
+
+    case ComponentType::Curve:
+        return Curve::create();
+
+    case ComponentType::Path:
+        return Path::create();
+
+    case ComponentType::DebugInputController:
+        return DebugInputController::create();
+
+    case ComponentType::DialoguePromptController:
+        return DialoguePromptController::create();
+
+    case ComponentType::Button:
+        return Button::create();
+
+    case ComponentType::Model:
+        return Model::create();
+
+    case ComponentType::Cube:
+        return Cube::create();
+
+    case ComponentType::Sphere:
+        return Sphere::create();
+
+    case ComponentType::Sprite:
+        return Sprite::create();
+
+    case ComponentType::Water:
+        return Water::create();
+
+    case ComponentType::Panel:
+        return Panel::create();
+
+    case ComponentType::ScreenText:
+        return ScreenText::create();
+
+    case ComponentType::ExampleDynamicText:
+        return ExampleDynamicText::create();
+
+    case ComponentType::ExampleUIBar:
+        return ExampleUIBar::create();
+
+    case ComponentType::Floater:
+        return Floater::create();
+
+    case ComponentType::FloatersManager:
+        return FloatersManager::create();
+
+    case ComponentType::FloeButton:
+        return FloeButton::create();
+
+    case ComponentType::DirectionalLight:
+        return DirectionalLight::create();
+
+    case ComponentType::PointLight:
+        return PointLight::create();
+
+    case ComponentType::SpotLight:
+        return SpotLight::create();
+
+    case ComponentType::NowPromptTrigger:
+        return NowPromptTrigger::create();
+
+    case ComponentType::ParticleSystem:
+        return ParticleSystem::create();
+
+    case ComponentType::Rigidbody2D:
+        return Rigidbody2D::create();
+
+    case ComponentType::Sound:
+        return Sound::create();
+
+    case ComponentType::SoundListener:
+        return SoundListener::create();
+
+    case ComponentType::Clock:
+        return Clock::create();
+
+    case ComponentType::Credits:
+        return Credits::create();
+
+    case ComponentType::Customer:
+        return Customer::create();
+
+    case ComponentType::CustomerManager:
+        return CustomerManager::create();
+
+    case ComponentType::Factory:
+        return Factory::create();
+
+    case ComponentType::GameController:
+        return GameController::create();
+
+    case ComponentType::HovercraftWithoutKeeper:
+        return HovercraftWithoutKeeper::create();
+
+    case ComponentType::IceBound:
+        return IceBound::create();
+
+    case ComponentType::LevelController:
+        return LevelController::create();
+
+    case ComponentType::Lighthouse:
+        return Lighthouse::create();
+
+    case ComponentType::LighthouseKeeper:
+        return LighthouseKeeper::create();
+
+    case ComponentType::LighthouseLight:
+        return LighthouseLight::create();
+
+    case ComponentType::Player:
+        return Player::create();
+
+    case ComponentType::Popup:
+        return Popup::create();
+
+    case ComponentType::EndScreen:
+        return EndScreen::create();
+
+    case ComponentType::Port:
+        return Port::create();
+
+    case ComponentType::Ship:
+        return Ship::create();
+
+    case ComponentType::ShipEyes:
+        return ShipEyes::create();
+
+    case ComponentType::ShipSpawner:
+        return ShipSpawner::create();
+
+    case ComponentType::Thanks:
+        return Thanks::create();
+
+    case ComponentType::PlayerInput:
+        return PlayerInput::create();
+
+    // # Put new clone creation here
+
+    default:
+        return nullptr;
+    }
+}
+
+void EntityCloner::copy_fields(Component const& source, Component& copy) const
+{
+    switch (source.get_type())
+    {
+    // # Auto clone start
+    case ComponentType::Camera:
+    {
+        auto const& from = static_cast<class Camera const&>(source);
+        auto& to = static_cast<class Camera&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.width = clone_value(from.width);
+        to.height = clone_value(from.height);
+        to.fov = clone_value(from.fov);
+        to.near_plane = clone_value(from.near_plane);
+        to.far_plane = clone_value(from.far_plane);
+        break;
+    }
+
+    case ComponentType::Collider2D:
+    {
+        auto const& from = static_cast<class Collider2D const&>(source);
+        auto& to = static_cast<class Collider2D&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.offset = clone_value(from.offset);
+        to.is_trigger = clone_value(from.is_trigger);
+        to.is_static = clone_value(from.is_static);
+        to.is_continuous = clone_value(from.is_continuous);
+        to.collision_layer = clone_value(from.collision_layer);
+        to.collision_mask = clone_value(from.collision_mask);
+        to.collider_type = clone_value(from.collider_type);
+        to.width = clone_value(from.width);
+        to.height = clone_value(from.height);
+        to.radius = clone_value(from.radius);
+        to.vertices = clone_value(from.vertices);
+        to.drag = clone_value(from.drag);
+        to.velocity = clone_value(from.velocity);
+        break;
+    }
+
+    case ComponentType::Curve:
+    {
+        auto const& from = static_cast<class Curve const&>(source);
+        auto& to = static_cast<class Curve&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.points = clone_value(from.points);
+        break;
+    }
+
+    case ComponentType::Path:
+    {
+        auto const& from = static_cast<class Path const&>(source);
+        auto& to = static_cast<class Path&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.points = clone_value(from.points);
+        break;
+    }
+
+    case ComponentType::DebugInputController:
+    {
+        auto const& from = static_cast<class DebugInputController const&>(source);
+        auto& to = static_cast<class DebugInputController&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.gamma = clone_value(from.gamma);
+        to.exposure = clone_value(from.exposure);
+        break;
+    }
+
+    case ComponentType::DialoguePromptController:
+    {
+        auto const& from = static_cast<class DialoguePromptController const&>(source);
+        auto& to = static_cast<class DialoguePromptController&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.interp_speed = clone_value(from.interp_speed);
+        to.dialogue_panel = clone_value(from.dialogue_panel);
+        to.panel_parent = clone_value(from.panel_parent);
+        to.keeper_sprite = clone_value(from.keeper_sprite);
+        to.upper_text = clone_value(from.upper_text);
+        to.middle_text = clone_value(from.middle_text);
+        to.lower_text = clone_value(from.lower_text);
+        to.dialogue_objects = clone_value(from.dialogue_objects);
+        break;
+    }
+
+    case ComponentType::Button:
+    {
+        auto const& from = static_cast<class Button const&>(source);
+        auto& to = static_cast<class Button&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.path_default = clone_value(from.path_default);
+        to.path_hovered = clone_value(from.path_hovered);
+        to.path_pressed = clone_value(from.path_pressed);
+        to.top_left_corner = clone_value(from.top_left_corner);
+        to.top_right_corner = clone_value(from.top_right_corner);
+        to.bottom_left_corner = clone_value(from.bottom_left_corner);
+        to.bottom_right_corner = clone_value(from.bottom_right_corner);
+        to.material = clone_value(from.material);
+        break;
+    }
+
+    case ComponentType::Model:
+    {
+        auto const& from = static_cast<class Model const&>(source);
+        auto& to = static_cast<class Model&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.model_path = clone_value(from.model_path);
+        to.material = clone_value(from.material);
+        break;
+    }
+
+    case ComponentType::Cube:
+    {
+        auto const& from = static_cast<class Cube const&>(source);
+        auto& to = static_cast<class Cube&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.diffuse_texture_path = clone_value(from.diffuse_texture_path);
+        to.specular_texture_path = clone_value(from.specular_texture_path);
+        to.model_path = clone_value(from.model_path);
+        to.material = clone_value(from.material);
+        break;
+    }
+
+    case ComponentType::Sphere:
+    {
+        auto const& from = static_cast<class Sphere const&>(source);
+        auto& to = static_cast<class Sphere&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.sector_count = clone_value(from.sector_count);
+        to.stack_count = clone_value(from.stack_count);
+        to.texture_path = clone_value(from.texture_path);
+        to.radius = clone_value(from.radius);
+        to.model_path = clone_value(from.model_path);
+        to.material = clone_value(from.material);
+        break;
+    }
+
+    case ComponentType::Sprite:
+    {
+        auto const& from = static_cast<class Sprite const&>(source);
+        auto& to = static_cast<class Sprite&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.diffuse_texture_path = clone_value(from.diffuse_texture_path);
+        to.model_path = clone_value(from.model_path);
+        to.material = clone_value(from.material);
+        break;
+    }
+
+    case ComponentType::Water:
+    {
+        auto const& from = static_cast<class Water const&>(source);
+        auto& to = static_cast<class Water&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.waves = clone_value(from.waves);
+        to.m_ps_buffer = clone_value(from.m_ps_buffer);
+        to.tesselation_level = clone_value(from.tesselation_level);
+        to.model_path = clone_value(from.model_path);
+        to.material = clone_value(from.material);
+        break;
+    }
+
+    case ComponentType::Panel:
+    {
+        auto const& from = static_cast<class Panel const&>(source);
+        auto& to = static_cast<class Panel&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.background_path = clone_value(from.background_path);
+        to.material = clone_value(from.material);
+        break;
+    }
+
+    case ComponentType::ScreenText:
+    {
+        auto const& from = static_cast<class ScreenText const&>(source);
+        auto& to = static_cast<class ScreenText&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.text = clone_value(from.text);
+        to.position = clone_value(from.position);
+        to.font_size = clone_value(from.font_size);
+        to.color = clone_value(from.color);
+        to.flags = clone_value(from.flags);
+        to.font_name = clone_value(from.font_name);
+        to.bold = clone_value(from.bold);
+        to.button_ref = clone_value(from.button_ref);
+        to.material = clone_value(from.material);
+        break;
+    }
+
+    case ComponentType::ExampleDynamicText:
+    {
+        auto const& from = static_cast<class ExampleDynamicText const&>(source);
+        auto& to = static_cast<class ExampleDynamicText&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        break;
+    }
+
+    case ComponentType::ExampleUIBar:
+    {
+        auto const& from = static_cast<class ExampleUIBar const&>(source);
+        auto& to = static_cast<class ExampleUIBar&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.value = clone_value(from.value);
+        break;
+    }
+
+    case ComponentType::Floater:
+    {
+        auto const& from = static_cast<class Floater const&>(source);
+        auto& to = static_cast<class Floater&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.sink = clone_value(from.sink);
+        to.side_floaters_offset = clone_value(from.side_floaters_offset);
+        to.side_roation_strength = clone_value(from.side_roation_strength);
+        to.forward_rotation_strength = clone_value(from.forward_rotation_strength);
+        to.forward_floaters_offest = clone_value(from.forward_floaters_offest);
+        to.water = clone_value(from.water);
+        break;
+    }
+
+    case ComponentType::FloatersManager:
+    {
+        auto const& from = static_cast<class FloatersManager const&>(source);
+        auto& to = static_cast<class FloatersManager&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.big_boat_settings = clone_value(from.big_boat_settings);
+        to.small_boat_settings = clone_value(from.small_boat_settings);
+        to.medium_boat_settings = clone_value(from.medium_boat_settings);
+        to.tool_boat_settings = clone_value(from.tool_boat_settings);
+        to.pirate_boat_settings = clone_value(from.pirate_boat_settings);
+        to.water = clone_value(from.water);
+        break;
+    }
+
+    case ComponentType::FloeButton:
+    {
+        auto const& from = static_cast<class FloeButton const&>(source);
+        auto& to = static_cast<class FloeButton&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.floe_button_type = clone_value(from.floe_button_type);
+        break;
+    }
+
+    case ComponentType::DirectionalLight:
+    {
+        auto const& from = static_cast<class DirectionalLight const&>(source);
+        auto& to = static_cast<class DirectionalLight&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.ambient = clone_value(from.ambient);
+        to.diffuse = clone_value(from.diffuse);
+        to.specular = clone_value(from.specular);
+        to.m_near_plane = clone_value(from.m_near_plane);
+        to.m_far_plane = clone_value(from.m_far_plane);
+        to.m_blocker_search_num_samples = clone_value(from.m_blocker_search_num_samples);
+        to.m_pcf_num_samples = clone_value(from.m_pcf_num_samples);
+        to.m_light_world_size = clone_value(from.m_light_world_size);
+        to.m_light_frustum_width = clone_value(from.m_light_frustum_width);
+        break;
+    }
+
+    case ComponentType::PointLight:
+    {
+        auto const& from = static_cast<class PointLight const&>(source);
+        auto& to = static_cast<class PointLight&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.constant = clone_value(from.constant);
+        to.linear = clone_value(from.linear);
+        to.quadratic = clone_value(from.quadratic);
+        to.ambient = clone_value(from.ambient);
+        to.diffuse = clone_value(from.diffuse);
+        to.specular = clone_value(from.specular);
+        to.m_near_plane = clone_value(from.m_near_plane);
+        to.m_far_plane = clone_value(from.m_far_plane);
+        to.m_blocker_search_num_samples = clone_value(from.m_blocker_search_num_samples);
+        to.m_pcf_num_samples = clone_value(from.m_pcf_num_samples);
+        to.m_light_world_size = clone_value(from.m_light_world_size);
+        to.m_light_frustum_width = clone_value(from.m_light_frustum_width);
+        break;
+    }
+
+    case ComponentType::SpotLight:
+    {
+        auto const& from = static_cast<class SpotLight const&>(source);
+        auto& to = static_cast<class SpotLight&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.constant = clone_value(from.constant);
+        to.linear = clone_value(from.linear);
+        to.quadratic = clone_value(from.quadratic);
+        to.scattering_factor = clone_value(from.scattering_factor);
+        to.cut_off = clone_value(from.cut_off);
+        to.outer_cut_off = clone_value(from.outer_cut_off);
+        to.ambient = clone_value(from.ambient);
+        to.diffuse = clone_value(from.diffuse);
+        to.specular = clone_value(from.specular);
+        to.m_near_plane = clone_value(from.m_near_plane);
+        to.m_far_plane = clone_value(from.m_far_plane);
+        to.m_blocker_search_num_samples = clone_value(from.m_blocker_search_num_samples);
+        to.m_pcf_num_samples = clone_value(from.m_pcf_num_samples);
+        to.m_light_world_size = clone_value(from.m_light_world_size);
+        to.m_light_frustum_width = clone_value(from.m_light_frustum_width);
+        break;
+    }
+
+    case ComponentType::NowPromptTrigger:
+    {
+        auto const& from = static_cast<class NowPromptTrigger const&>(source);
+        auto& to = static_cast<class NowPromptTrigger&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        break;
+    }
+
+    case ComponentType::ParticleSystem:
+    {
+        auto const& from = static_cast<class ParticleSystem const&>(source);
+        auto& to = static_cast<class ParticleSystem&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.particle_type = clone_value(from.particle_type);
+        to.play_once = clone_value(from.play_once);
+        to.rotate_particles = clone_value(from.rotate_particles);
+        to.spawn_instantly = clone_value(from.spawn_instantly);
+        to.sprite_path = clone_value(from.sprite_path);
+        to.min_spawn_interval = clone_value(from.min_spawn_interval);
+        to.max_spawn_interval = clone_value(from.max_spawn_interval);
+        to.start_velocity_1 = clone_value(from.start_velocity_1);
+        to.start_velocity_2 = clone_value(from.start_velocity_2);
+        to.min_spawn_alpha = clone_value(from.min_spawn_alpha);
+        to.max_spawn_alpha = clone_value(from.max_spawn_alpha);
+        to.start_min_particle_size = clone_value(from.start_min_particle_size);
+        to.start_max_particle_size = clone_value(from.start_max_particle_size);
+        to.emitter_bounds = clone_value(from.emitter_bounds);
+        to.min_spawn_count = clone_value(from.min_spawn_count);
+        to.max_spawn_count = clone_value(from.max_spawn_count);
+        to.start_color_1 = clone_value(from.start_color_1);
+        to.end_color_1 = clone_value(from.end_color_1);
+        to.lifetime_1 = clone_value(from.lifetime_1);
+        to.lifetime_2 = clone_value(from.lifetime_2);
+        to.m_simulate_in_world_space = clone_value(from.m_simulate_in_world_space);
+        break;
+    }
+
+    case ComponentType::Rigidbody2D:
+    {
+        auto const& from = static_cast<class Rigidbody2D const&>(source);
+        auto& to = static_cast<class Rigidbody2D&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.mass = clone_value(from.mass);
+        to.restitution = clone_value(from.restitution);
+        to.drag = clone_value(from.drag);
+        to.velocity = clone_value(from.velocity);
+        break;
+    }
+
+    case ComponentType::Sound:
+    {
+        auto const& from = static_cast<class Sound const&>(source);
+        auto& to = static_cast<class Sound&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.path = clone_value(from.path);
+        to.volume = clone_value(from.volume);
+        to.play_on_awake = clone_value(from.play_on_awake);
+        to.is_positional = clone_value(from.is_positional);
+        break;
+    }
+
+    case ComponentType::SoundListener:
+    {
+        auto const& from = static_cast<class SoundListener const&>(source);
+        auto& to = static_cast<class SoundListener&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        break;
+    }
+
+    case ComponentType::Clock:
+    {
+        auto const& from = static_cast<class Clock const&>(source);
+        auto& to = static_cast<class Clock&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        break;
+    }
+
+    case ComponentType::Credits:
+    {
+        auto const& from = static_cast<class Credits const&>(source);
+        auto& to = static_cast<class Credits&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.back_to_menu_button = clone_value(from.back_to_menu_button);
+        break;
+    }
+
+    case ComponentType::Customer:
+    {
+        auto const& from = static_cast<class Customer const&>(source);
+        auto& to = static_cast<class Customer&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.collider = clone_value(from.collider);
+        to.left_hand = clone_value(from.left_hand);
+        to.right_hand = clone_value(from.right_hand);
+        break;
+    }
+
+    case ComponentType::CustomerManager:
+    {
+        auto const& from = static_cast<class CustomerManager const&>(source);
+        auto& to = static_cast<class CustomerManager&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.destination_curve = clone_value(from.destination_curve);
+        to.customer_prefab = clone_value(from.customer_prefab);
+        break;
+    }
+
+    case ComponentType::Factory:
+    {
+        auto const& from = static_cast<class Factory const&>(source);
+        auto& to = static_cast<class Factory&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.type = clone_value(from.type);
+        to.lights = clone_value(from.lights);
+        to.factory_light = clone_value(from.factory_light);
+        break;
+    }
+
+    case ComponentType::GameController:
+    {
+        auto const& from = static_cast<class GameController const&>(source);
+        auto& to = static_cast<class GameController&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.current_scene = clone_value(from.current_scene);
+        to.next_scene = clone_value(from.next_scene);
+        to.dialog_manager = clone_value(from.dialog_manager);
+        break;
+    }
+
+    case ComponentType::HovercraftWithoutKeeper:
+    {
+        auto const& from = static_cast<class HovercraftWithoutKeeper const&>(source);
+        auto& to = static_cast<class HovercraftWithoutKeeper&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        break;
+    }
+
+    case ComponentType::IceBound:
+    {
+        auto const& from = static_cast<class IceBound const&>(source);
+        auto& to = static_cast<class IceBound&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        break;
+    }
+
+    case ComponentType::LevelController:
+    {
+        auto const& from = static_cast<class LevelController const&>(source);
+        auto& to = static_cast<class LevelController&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.map_time = clone_value(from.map_time);
+        to.map_food = clone_value(from.map_food);
+        to.maximum_lighthouse_level = clone_value(from.maximum_lighthouse_level);
+        to.factories = clone_value(from.factories);
+        to.port = clone_value(from.port);
+        to.lighthouse = clone_value(from.lighthouse);
+        to.customer_manager = clone_value(from.customer_manager);
+        to.playfield_width = clone_value(from.playfield_width);
+        to.playfield_additional_width = clone_value(from.playfield_additional_width);
+        to.playfield_height = clone_value(from.playfield_height);
+        to.playfield_y_shift = clone_value(from.playfield_y_shift);
+        to.ships_limit_curve = clone_value(from.ships_limit_curve);
+        to.ships_limit = clone_value(from.ships_limit);
+        to.ships_speed_curve = clone_value(from.ships_speed_curve);
+        to.ships_speed = clone_value(from.ships_speed);
+        to.ships_range_curve = clone_value(from.ships_range_curve);
+        to.ships_turn_curve = clone_value(from.ships_turn_curve);
+        to.ships_additional_speed_curve = clone_value(from.ships_additional_speed_curve);
+        to.pirates_in_control_curve = clone_value(from.pirates_in_control_curve);
+        to.is_tutorial = clone_value(from.is_tutorial);
+        to.starting_packages = clone_value(from.starting_packages);
+        to.tutorial_level = clone_value(from.tutorial_level);
+        break;
+    }
+
+    case ComponentType::Lighthouse:
+    {
+        auto const& from = static_cast<class Lighthouse const&>(source);
+        auto& to = static_cast<class Lighthouse&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.light = clone_value(from.light);
+        to.water = clone_value(from.water);
+        to.spawn_position = clone_value(from.spawn_position);
+        break;
+    }
+
+    case ComponentType::LighthouseKeeper:
+    {
+        auto const& from = static_cast<class LighthouseKeeper const&>(source);
+        auto& to = static_cast<class LighthouseKeeper&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.maximum_speed = clone_value(from.maximum_speed);
+        to.acceleration = clone_value(from.acceleration);
+        to.deceleration = clone_value(from.deceleration);
+        to.lighthouse = clone_value(from.lighthouse);
+        to.port = clone_value(from.port);
+        to.keeper_dust = clone_value(from.keeper_dust);
+        to.keeper_splash = clone_value(from.keeper_splash);
+        to.packages = clone_value(from.packages);
+        break;
+    }
+
+    case ComponentType::LighthouseLight:
+    {
+        auto const& from = static_cast<class LighthouseLight const&>(source);
+        auto& to = static_cast<class LighthouseLight&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.spotlight = clone_value(from.spotlight);
+        to.spotlight_beam_width = clone_value(from.spotlight_beam_width);
+        break;
+    }
+
+    case ComponentType::Player:
+    {
+        auto const& from = static_cast<class Player const&>(source);
+        auto& to = static_cast<class Player&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.packages_text = clone_value(from.packages_text);
+        to.flashes_text = clone_value(from.flashes_text);
+        to.level_text = clone_value(from.level_text);
+        to.clock_text = clone_value(from.clock_text);
+        break;
+    }
+
+    case ComponentType::Popup:
+    {
+        auto const& from = static_cast<class Popup const&>(source);
+        auto& to = static_cast<class Popup&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        break;
+    }
+
+    case ComponentType::EndScreen:
+    {
+        auto const& from = static_cast<class EndScreen const&>(source);
+        auto& to = static_cast<class EndScreen&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.is_failed = clone_value(from.is_failed);
+        to.number_of_stars = clone_value(from.number_of_stars);
+        to.stars = clone_value(from.stars);
+        to.star_scale = clone_value(from.star_scale);
+        to.next_level_button = clone_value(from.next_level_button);
+        to.restart_button = clone_value(from.restart_button);
+        to.menu_button = clone_value(from.menu_button);
+        break;
+    }
+
+    case ComponentType::Port:
+    {
+        auto const& from = static_cast<class Port const&>(source);
+        auto& to = static_cast<class Port&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.lights = clone_value(from.lights);
+        break;
+    }
+
+    case ComponentType::Ship:
+    {
+        auto const& from = static_cast<class Ship const&>(source);
+        auto& to = static_cast<class Ship&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.type = clone_value(from.type);
+        to.light = clone_value(from.light);
+        to.spawner = clone_value(from.spawner);
+        to.eyes = clone_value(from.eyes);
+        to.my_light = clone_value(from.my_light);
+        break;
+    }
+
+    case ComponentType::ShipEyes:
+    {
+        auto const& from = static_cast<class ShipEyes const&>(source);
+        auto& to = static_cast<class ShipEyes&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        break;
+    }
+
+    case ComponentType::ShipSpawner:
+    {
+        auto const& from = static_cast<class ShipSpawner const&>(source);
+        auto& to = static_cast<class ShipSpawner&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.paths = clone_value(from.paths);
+        to.floaters_manager = clone_value(from.floaters_manager);
+        to.light = clone_value(from.light);
+        to.last_chance_food_threshold = clone_value(from.last_chance_food_threshold);
+        to.last_chance_time_threshold = clone_value(from.last_chance_time_threshold);
+        to.main_event_spawn = clone_value(from.main_event_spawn);
+        to.backup_spawn = clone_value(from.backup_spawn);
+        break;
+    }
+
+    case ComponentType::Thanks:
+    {
+        auto const& from = static_cast<class Thanks const&>(source);
+        auto& to = static_cast<class Thanks&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.back_to_menu_button = clone_value(from.back_to_menu_button);
+        break;
+    }
+
+    case ComponentType::PlayerInput:
+    {
+        auto const& from = static_cast<class PlayerInput const&>(source);
+        auto& to = static_cast<class PlayerInput&>(copy);
+        to.custom_name = clone_value(from.custom_name);
+        to.player_speed = clone_value(from.player_speed);
+        to.camera_speed = clone_value(from.camera_speed);
+        break;
+    }
+
+    // # Put new clone here
+
+    default:
+        break;
+    }
+}
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "AK/Types.h"
+
+class Component;
+class Entity;
+class Material;
+class Transform;
+
+struct CloneBenchmark
+{
+    std::string name = {};
+    u32 entities = 0;
+    u32 clones = 0;
+    double clone_seconds = 0.0;
+    double serialization_seconds = 0.0;
+};
+
+// Entities and components deserialized from a prefab or copied from the scene once, to be copied by
+// EntityCloner::instantiate(). They aren't in any scene and the components aren't added to their entities, so nothing
+// initializes or updates them.
+struct ClonePrototype
+{
+    // Parents before their children, parented to each other
+    std::vector<std::shared_ptr<Entity>> entities = {};
+
+    // Components of every entity, in the order they are added
+    std::vector<std::vector<std::shared_ptr<Component>>> components = {};
+};
+
+// Copies entities and their serialized children in memory, with the same result as serializing and deserializing them.
+// Component fields are copied by code EngineHeaderTool generates from the serialized variables. References to entities and
+// components of the copied hierarchy point to their copies, references to anything else are kept.
+class EntityCloner
+{
+public:
+    // Use Entity::clone() instead
+    static std::shared_ptr<Entity> clone(Entity const& entity, std::shared_ptr<Transform> const& parent);
+
+    // Copies the prototype into the main scene, the copies are in the same order. They are given the guids in order,
+    // every entity followed by its components.
+    static std::vector<std::shared_ptr<Entity>> instantiate(ClonePrototype const& prototype, std::span<std::string const> const guids);
+
+    // Copies the entity and its serialized children into a prototype, it can still be instantiated after they change or
+    // are destroyed. Empty when the entity isn't serialized.
+    [[nodiscard]] static ClonePrototype create_prototype(Entity const& entity);
+
+    // Loads the prefab in a scene of its own, then copies it with clone() and with a round trip through YAML text, like the
+    // editor used to copy entities
+    static CloneBenchmark benchmark(std::string const& prefab_name, u32 const clone_count);
+
+private:
+    EntityCloner() = default;
+
+    void add_entities(Entity const& entity);
+    [[nodiscard]] std::vector<std::shared_ptr<Entity>> copy_entities(std::shared_ptr<Transform> const& parent);
+
+    // Empty component of the same type, nullptr for components that aren't serialized
+    [[nodiscard]] static std::shared_ptr<Component> create_component(Component const& component);
+    void copy_fields(Component const& source, Component& copy) const;
+
+    template<typename T>
+    [[nodiscard]] T clone_value(T const& value) const
+    {
+        return value;
+    }
+
+    template<typename T>
+    requires std::is_base_of_v<Component, T>
+    [[nodiscard]] std::shared_ptr<T> clone_value(std::shared_ptr<T> const& value) const
+    {
+        if (value == nullptr)
+            return nullptr;
+
+        auto const it = m_component_copies.find(value.get());
+        return it != m_component_copies.end() ? std::static_pointer_cast<T>(it->second) : value;
+    }
+
+    template<typename T>
+    requires std::is_base_of_v<Component, T>
+    [[nodiscard]] std::weak_ptr<T> clone_value(std::weak_ptr<T> const& value) const
+    {
+        return clone_value(value.lock());
+    }
+
+    template<typename T>
+    requires std::is_base_of_v<Entity, T>
+    [[nodiscard]] std::shared_ptr<T> clone_value(std::shared_ptr<T> const& value) const
+    {
+        if (value == nullptr)
+            return nullptr;
+
+        auto const it = m_entity_copies.find(value.get());
+        return it != m_entity_copies.end() ? std::static_pointer_cast<T>(it->second) : value;
+    }
+
+    template<typename T>
+    requires std::is_base_of_v<Entity, T>
+    [[nodiscard]] std::weak_ptr<T> clone_value(std::weak_ptr<T> const& value) const
+    {
+        return clone_value(value.lock());
+    }
+
+    template<typename T>
+    [[nodiscard]] std::vector<T> clone_value(std::vector<T> const& values) const
+    {
+        std::vector<T> copies = {};
+        copies.reserve(values.size());
+
+        for (auto const& value : values)
+        {
+            copies.emplace_back(clone_value(value));
+        }
+
+        return copies;
+    }
+
+    // Deserialization creates a new material for every component
+    [[nodiscard]] std::shared_ptr<Material> clone_value(std::shared_ptr<Material> const& value) const;
+
+    struct Source
+    {
+        Entity const* entity = nullptr;
+        std::vector<std::shared_ptr<Component>> const* components = nullptr;
+    };
+
+    // Serialized entities of the hierarchy, parents before their children
+    std::vector<Source> m_sources = {};
+
+    // Given to the copies when instantiating a prototype, empty when cloning
+    std::span<std::string const> m_guids = {};
+
+    // Filled with the copies instead of the scene when creating a prototype
+    ClonePrototype* m_prototype = nullptr;
+
+    std::unordered_map<Entity const*, std::shared_ptr<Entity>> m_entity_copies = {};
+    std::unordered_map<Component const*, std::shared_ptr<Component>> m_component_copies = {};
+
+    // Source, copy and entity copy of every component, in the order they are added to their entities
+    std::vector<std::tuple<Component const*, std::shared_ptr<Component>, std::shared_ptr<Entity>>> m_components = {};
+};
@@ -76,6 +76,13 @@ public:
         }
     }
 
+    void clear()
+    {
+        std::lock_guard guard(mutex);
+
+        m_listeners.clear();
+    }
+
     [[nodiscard]] i32 count() const
     {
         std::lock_guard guard(mutex);
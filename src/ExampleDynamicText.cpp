@@ -8,7 +8,7 @@
 
 std::shared_ptr<ExampleDynamicText> ExampleDynamicText::create()
 {
-    return std::make_shared<ExampleDynamicText>();
+    return AK::make_pooled<ExampleDynamicText>();
 }
 
 void ExampleDynamicText::awake()
@@ -11,7 +11,7 @@
 
 std::shared_ptr<ExampleUIBar> ExampleUIBar::create()
 {
-    return std::make_shared<ExampleUIBar>();
+    return AK::make_pooled<ExampleUIBar>();
 }
 
 void ExampleUIBar::awake()
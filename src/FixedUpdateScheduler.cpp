@@ -0,0 +1,293 @@
+#include "FixedUpdateScheduler.h"
+
+#include "AK/JobSystem.h"
+#include "Component.h"
+#include "ComponentAccess.h"
+#include "Debug.h"
+#include "Entity.h"
+#include "Transform.h"
+
+#include <algorithm>
+
+namespace
+{
+
+Transform const* find_root(Transform const& transform)
+{
+    Transform const* root = &transform;
+
+    for (auto parent = transform.parent.lock(); parent != nullptr; parent = parent->parent.lock())
+    {
+        root = parent.get();
+    }
+
+    return root;
+}
+
+bool can_run_as_job(ComponentType const type)
+{
+    return get_component_access(type).is_declared && !do_component_accesses_conflict(type, type);
+}
+
+#if _DEBUG
+struct ValidationContext
+{
+    FixedUpdateScheduler* scheduler = nullptr;
+    Component const* component = nullptr;
+    Transform const* root = nullptr;
+};
+
+thread_local ValidationContext const* t_validation_context = nullptr;
+#endif
+
+}
+
+void FixedUpdateScheduler::run(std::span<Component* const> const components)
+{
+    m_stats = {};
+    m_phase_count = 0;
+    m_items.clear();
+    m_root_groups.clear();
+    m_type_phases.fill(invalid_phase);
+
+    for (auto& types : m_phase_types)
+    {
+        types.clear();
+    }
+
+    auto const jobs = AK::JobSystem::get_instance();
+    bool const has_workers = m_is_parallel && jobs != nullptr && jobs->get_worker_count() > 0;
+
+    // Everything is gathered first, fixed_update() can change the tick list
+    for (auto const component : components)
+    {
+        if (component->entity == nullptr)
+            continue;
+
+        ComponentType const type = component->get_type();
+
+        Item item = {};
+        item.component = component;
+
+        if (has_workers && can_run_as_job(type))
+        {
+            item.root = find_root(*component->entity->transform);
+            item.group = m_root_groups.try_emplace(item.root, static_cast<u32>(m_root_groups.size())).first->second;
+            item.phase = find_phase(type);
+            m_stats.parallel_components += 1;
+        }
+        else
+        {
+            m_stats.main_thread_components += 1;
+        }
+
+        m_items.emplace_back(item);
+    }
+
+    // Main thread components run where they tick, the jobs ticking between two of them run in phases in between
+    for (u32 begin = 0; begin < m_items.size();)
+    {
+        if (m_items[begin].phase == invalid_phase)
+        {
+            Component* const component = m_items[begin].component;
+
+            if (component->entity != nullptr && component->enabled() && component->entity->is_active())
+                component->fixed_update();
+
+            begin += 1;
+            continue;
+        }
+
+        u32 end = begin + 1;
+
+        while (end < m_items.size() && m_items[end].phase != invalid_phase)
+        {
+            end += 1;
+        }
+
+        run_phases(std::span<Item>(m_items).subspan(begin, end - begin));
+
+        begin = end;
+    }
+
+    m_stats.phases = m_phase_count;
+
+#if _DEBUG
+    log_violations();
+#endif
+}
+
+void FixedUpdateScheduler::set_parallel(bool const value)
+{
+    m_is_parallel = value;
+}
+
+bool FixedUpdateScheduler::is_parallel() const
+{
+    return m_is_parallel;
+}
+
+FixedUpdateStats const& FixedUpdateScheduler::get_stats() const
+{
+    return m_stats;
+}
+
+#if _DEBUG
+void FixedUpdateScheduler::set_validation_enabled(bool const value)
+{
+    m_is_validation_enabled = value;
+}
+
+bool FixedUpdateScheduler::is_validation_enabled() const
+{
+    return m_is_validation_enabled;
+}
+
+void FixedUpdateScheduler::validate_transform_write(Transform const& transform)
+{
+    ValidationContext const* context = t_validation_context;
+
+    if (context == nullptr)
+        return;
+
+    ComponentAccess const& access = get_component_access(context->component->get_type());
+
+    if (!access.writes.test(transform_access_bit))
+        context->scheduler->report_violation(*context->component, "writes a transform without FIXED_UPDATE_WRITES(Transform)");
+    else if (find_root(transform) != context->root)
+        context->scheduler->report_violation(*context->component, "writes a transform of another hierarchy");
+}
+
+void FixedUpdateScheduler::validate_structural_change(char const* change)
+{
+    ValidationContext const* context = t_validation_context;
+
+    if (context == nullptr)
+        return;
+
+    context->scheduler->report_violation(*context->component, change);
+}
+#endif
+
+u32 FixedUpdateScheduler::find_phase(ComponentType const type)
+{
+    u32& phase = m_type_phases[static_cast<u16>(type)];
+
+    if (phase != invalid_phase)
+        return phase;
+
+    // First phase with no conflicting type, phases are created in the order their first component ticks
+    for (phase = 0; phase < m_phase_count; ++phase)
+    {
+        auto const& types = m_phase_types[phase];
+
+        if (std::ranges::none_of(types, [type](ComponentType const other) { return do_component_accesses_conflict(type, other); }))
+            break;
+    }
+
+    if (phase == m_phase_count)
+    {
+        m_phase_count += 1;
+
+        if (m_phase_types.size() < m_phase_count)
+            m_phase_types.resize(m_phase_count);
+    }
+
+    m_phase_types[phase].emplace_back(type);
+
+    return phase;
+}
+
+void FixedUpdateScheduler::run_phases(std::span<Item> const items)
+{
+    // Hierarchies are grouped in the order they first tick, components keep their tick order within a hierarchy
+    std::ranges::stable_sort(items, [](Item const& a, Item const& b) {
+        return a.phase != b.phase ? a.phase < b.phase : a.group < b.group;
+    });
+
+    for (u32 begin = 0; begin < items.size();)
+    {
+        u32 end = begin + 1;
+
+        while (end < items.size() && items[end].phase == items[begin].phase)
+        {
+            end += 1;
+        }
+
+        run_phase(items.subspan(begin, end - begin));
+
+        begin = end;
+    }
+}
+
+void FixedUpdateScheduler::run_phase(std::span<Item const> const items)
+{
+    // Every hierarchy becomes one group
+    m_group_starts.clear();
+
+    for (u32 i = 0; i < items.size(); ++i)
+    {
+        if (i == 0 || items[i].group != items[i - 1].group)
+            m_group_starts.emplace_back(i);
+    }
+
+    u32 const group_count = static_cast<u32>(m_group_starts.size());
+    m_group_starts.emplace_back(static_cast<u32>(items.size()));
+    m_stats.hierarchies += group_count;
+
+    auto const jobs = AK::JobSystem::get_instance();
+    u32 const grain_size = std::max(group_count / (jobs->get_thread_count() * 4), 1u);
+
+    jobs->parallel_for(0, group_count, grain_size, [&](u32 const first, u32 const last) {
+        for (u32 i = m_group_starts[first]; i < m_group_starts[last]; ++i)
+        {
+            run_item(items[i]);
+        }
+    });
+}
+
+void FixedUpdateScheduler::run_item(Item const& item)
+{
+    Component* const component = item.component;
+
+    if (component->entity == nullptr || !component->enabled() || !component->entity->is_active())
+        return;
+
+#if _DEBUG
+    if (m_is_validation_enabled)
+    {
+        // Jobs waiting inside of fixed_update() can run other items on this thread
+        ValidationContext const* previous_context = t_validation_context;
+        ValidationContext const context = {this, component, item.root};
+        t_validation_context = &context;
+
+        component->fixed_update();
+
+        t_validation_context = previous_context;
+        return;
+    }
+#endif
+
+    component->fixed_update();
+}
+
+#if _DEBUG
+void FixedUpdateScheduler::report_violation(Component const& component, std::string const& message)
+{
+    std::scoped_lock const lock(m_violations_mutex);
+
+    m_violations.emplace_back(std::string(component_type_names[static_cast<u16>(component.get_type())]) + " " + message + ".");
+    m_stats.violations += 1;
+}
+
+void FixedUpdateScheduler::log_violations()
+{
+    for (auto& violation : m_violations)
+    {
+        if (m_reported_violations.emplace(violation).second)
+            Debug::log("Fixed update: " + violation, DebugType::Error);
+    }
+
+    m_violations.clear();
+}
+#endif
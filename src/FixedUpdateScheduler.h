@@ -0,0 +1,103 @@
+#pragma once
+
+#include <array>
+#include <limits>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "AK/Types.h"
+#include "ComponentType.h"
+
+class Component;
+class Transform;
+
+struct FixedUpdateStats
+{
+    u32 phases = 0;
+    u32 hierarchies = 0;
+    u32 parallel_components = 0;
+    u32 main_thread_components = 0;
+    u32 violations = 0;
+};
+
+// Runs fixed_update() of the tickable components. Types that declare what they access (see ComponentAccess.h) are
+// split into phases of types that don't conflict with each other. Every phase runs on the job system's threads,
+// with all components of one transform hierarchy in the same job, in tick order. Undeclared types and types
+// conflicting with themselves run on the main thread in tick order, the declared components ticking before them
+// are done by then and the ones ticking after them haven't started.
+class FixedUpdateScheduler
+{
+public:
+    FixedUpdateScheduler() = default;
+
+    FixedUpdateScheduler(FixedUpdateScheduler const&) = delete;
+    void operator=(FixedUpdateScheduler const&) = delete;
+
+    void run(std::span<Component* const> components);
+
+    // Not parallel runs everything on the main thread in tick order
+    void set_parallel(bool const value);
+    [[nodiscard]] bool is_parallel() const;
+
+    // Of the last run()
+    [[nodiscard]] FixedUpdateStats const& get_stats() const;
+
+#if _DEBUG
+    // Checks the transform writes and structural changes of components running in the phases, every violation
+    // is logged once
+    void set_validation_enabled(bool const value);
+    [[nodiscard]] bool is_validation_enabled() const;
+
+    // Do nothing outside of the phases
+    static void validate_transform_write(Transform const& transform);
+    static void validate_structural_change(char const* change);
+#endif
+
+private:
+    static constexpr u32 invalid_phase = std::numeric_limits<u32>::max();
+
+    struct Item
+    {
+        Component* component = nullptr;
+        Transform const* root = nullptr;
+
+        // Of the root, in the order hierarchies first tick
+        u32 group = 0;
+
+        // invalid_phase runs on the main thread
+        u32 phase = invalid_phase;
+    };
+
+    [[nodiscard]] u32 find_phase(ComponentType const type);
+    void run_phases(std::span<Item> const items);
+    void run_phase(std::span<Item const> const items);
+    void run_item(Item const& item);
+
+#if _DEBUG
+    void report_violation(Component const& component, std::string const& message);
+    void log_violations();
+#endif
+
+    bool m_is_parallel = true;
+    FixedUpdateStats m_stats = {};
+
+    // Scratch buffers, kept between runs so they don't allocate every frame
+    std::vector<Item> m_items = {};
+    std::unordered_map<Transform const*, u32> m_root_groups = {};
+    std::vector<u32> m_group_starts = {};
+    std::vector<std::vector<ComponentType>> m_phase_types = {};
+    u32 m_phase_count = 0;
+    std::array<u32, component_type_count> m_type_phases = {};
+
+#if _DEBUG
+    bool m_is_validation_enabled = true;
+
+    std::mutex m_violations_mutex = {};
+    std::vector<std::string> m_violations = {};
+    std::unordered_set<std::string> m_reported_violations = {};
+#endif
+};
@@ -17,14 +17,14 @@ Floater::Floater(AK::Badge<Floater>)
 
 std::shared_ptr<Floater> Floater::create()
 {
-    return std::make_shared<Floater>(AK::Badge<Floater> {});
+    return AK::make_pooled<Floater>(AK::Badge<Floater> {});
 }
 
 std::shared_ptr<Floater> Floater::create(std::weak_ptr<Water> const& water, float const sink, float const side_floaters_offset,
                                          float const side_rotation_strength, float const forward_rotation_strength,
                                          float const forward_floaters_offset)
 {
-    auto floater = std::make_shared<Floater>(AK::Badge<Floater> {});
+    auto floater = AK::make_pooled<Floater>(AK::Badge<Floater> {});
     floater->water = water;
     floater->sink = sink;
     floater->side_floaters_offset = side_floaters_offset;
@@ -60,17 +60,86 @@ void Floater::update()
     if (water.expired())
         return;
 
-    auto water_ptr = water.lock();
+    auto const water_ptr = water.lock();
+    auto const samples = get_wave_samples();
+    std::array<float, wave_sample_count> heights = {};
 
+    for (u32 i = 0; i < wave_sample_count; ++i)
+    {
+        heights[i] = water_ptr->get_wave_height(samples[i]);
+    }
+
+    apply_wave_heights(samples, heights);
+}
+
+void Floater::update_all(std::span<Floater* const> const floaters)
+{
+    std::shared_ptr<Water> batch_water = nullptr;
+
+    auto const update_batch = [&] {
+        if (m_batch.empty())
+            return;
+
+        m_batch_heights.resize(m_batch_samples.size());
+        batch_water->get_wave_heights(m_batch_samples, m_batch_heights);
+
+        for (u32 i = 0; i < m_batch.size(); ++i)
+        {
+            m_batch[i]->apply_wave_heights(std::span(m_batch_samples).subspan(i * wave_sample_count, wave_sample_count),
+                                           std::span(m_batch_heights).subspan(i * wave_sample_count, wave_sample_count));
+        }
+
+        m_batch.clear();
+        m_batch_samples.clear();
+    };
+
+    // Floaters of one water usually come one after another, a batch ends when the water changes
+    for (auto const floater : floaters)
+    {
+        if (floater->entity == nullptr)
+            continue;
+
+        auto const water_ptr = floater->water.lock();
+
+        if (water_ptr == nullptr)
+            continue;
+
+        if (water_ptr != batch_water)
+        {
+            update_batch();
+            batch_water = water_ptr;
+        }
+
+        auto const samples = floater->get_wave_samples();
+        m_batch_samples.insert(m_batch_samples.end(), samples.begin(), samples.end());
+        m_batch.emplace_back(floater);
+    }
+
+    update_batch();
+}
+
+std::array<glm::vec2, Floater::wave_sample_count> Floater::get_wave_samples() const
+{
     glm::vec3 const position = entity->transform->get_position();
     glm::vec2 const position_2d = AK::convert_3d_to_2d(position);
     glm::vec2 const movement_direction = AK::convert_3d_to_2d(glm::normalize(entity->transform->get_forward()));
     glm::vec2 perpendicular_to_movement_direction = {movement_direction.y, -movement_direction.x};
-    float const height_to_the_left = water_ptr->get_wave_height(position_2d + perpendicular_to_movement_direction * side_floaters_offset);
-    float const height_to_the_right = water_ptr->get_wave_height(position_2d + perpendicular_to_movement_direction * -side_floaters_offset);
-    float const height = water_ptr->get_wave_height(position_2d) - sink;
-    float const height_at_front = water_ptr->get_wave_height(position_2d + movement_direction * forward_floaters_offest);
-    float const height_at_back = water_ptr->get_wave_height(position_2d + movement_direction * -forward_floaters_offest);
+
+    return {position_2d,
+            position_2d + perpendicular_to_movement_direction * side_floaters_offset,
+            position_2d + perpendicular_to_movement_direction * -side_floaters_offset,
+            position_2d + movement_direction * forward_floaters_offest,
+            position_2d + movement_direction * -forward_floaters_offest};
+}
+
+void Floater::apply_wave_heights(std::span<glm::vec2 const> const samples, std::span<float const> const heights) const
+{
+    glm::vec2 const position_2d = samples[0];
+    float const height = heights[0] - sink;
+    float const height_to_the_left = heights[1];
+    float const height_to_the_right = heights[2];
+    float const height_at_front = heights[3];
+    float const height_at_back = heights[4];
 
     entity->transform->set_position(glm::vec3(position_2d.x, height, position_2d.y));
 
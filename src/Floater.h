@@ -4,6 +4,9 @@
 #include "Component.h"
 #include "Water.h"
 
+#include <array>
+#include <span>
+
 class Floater final : public Component
 {
 public:
@@ -19,6 +22,9 @@ public:
     virtual void awake() override;
     virtual void update() override;
 
+    // Wave heights of all floaters on the same water are computed together
+    static void update_all(std::span<Floater* const> const floaters);
+
     float sink = 0.01f;
 
     float side_floaters_offset = 0.1f;
@@ -30,5 +36,15 @@ public:
     std::weak_ptr<Water> water = {};
 
 private:
+    static constexpr u32 wave_sample_count = 5;
+
+    // Center, left, right, front and back of the floater on the water plane
+    [[nodiscard]] std::array<glm::vec2, wave_sample_count> get_wave_samples() const;
+    void apply_wave_heights(std::span<glm::vec2 const> const samples, std::span<float const> const heights) const;
+
     float m_previous_height = {};
+
+    inline static std::vector<Floater*> m_batch = {};
+    inline static std::vector<glm::vec2> m_batch_samples = {};
+    inline static std::vector<float> m_batch_heights = {};
 };
@@ -11,7 +11,7 @@ FloatersManager::FloatersManager(AK::Badge<FloatersManager>)
 
 std::shared_ptr<FloatersManager> FloatersManager::create()
 {
-    return std::make_shared<FloatersManager>(AK::Badge<FloatersManager> {});
+    return AK::make_pooled<FloatersManager>(AK::Badge<FloatersManager> {});
 }
 
 #if EDITOR
@@ -14,7 +14,7 @@ bool FloeButton::are_credits_open = false;
 
 std::shared_ptr<FloeButton> FloeButton::create()
 {
-    auto floe = std::make_shared<FloeButton>(AK::Badge<FloeButton> {});
+    auto floe = AK::make_pooled<FloeButton>(AK::Badge<FloeButton> {});
     return floe;
 }
 
@@ -0,0 +1,508 @@
+#include "GJK.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace
+{
+
+float cross(glm::vec2 const& a, glm::vec2 const& b)
+{
+    return a.x * b.y - a.y * b.x;
+}
+
+}
+
+u32 ConvexShape2D::find_support(glm::vec2 const& direction) const
+{
+    u32 best_index = 0;
+    float best_distance = glm::dot(points[0], direction);
+
+    for (u32 i = 1; i < count; ++i)
+    {
+        float const distance = glm::dot(points[i], direction);
+
+        if (distance > best_distance)
+        {
+            best_index = i;
+            best_distance = distance;
+        }
+    }
+
+    return best_index;
+}
+
+ConvexShape2D ConvexShape2D::make_hull(std::span<glm::vec2 const> const points, float const radius)
+{
+    ConvexShape2D shape = {};
+    shape.radius = radius;
+
+    if (points.empty())
+    {
+        shape.count = 1;
+        return shape;
+    }
+
+    std::vector<glm::vec2> sorted(points.begin(), points.end());
+    std::ranges::sort(sorted, [](glm::vec2 const& a, glm::vec2 const& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); });
+
+    // Monotone chain, lower hull followed by the upper one
+    std::vector<glm::vec2> hull = {};
+    hull.reserve(sorted.size() * 2);
+
+    auto const add_point = [&hull](glm::vec2 const& point, size_t const chain_start) {
+        while (hull.size() >= chain_start + 2 && cross(hull.back() - hull[hull.size() - 2], point - hull[hull.size() - 2]) <= 0.0f)
+            hull.pop_back();
+
+        hull.emplace_back(point);
+    };
+
+    for (auto const& point : sorted)
+    {
+        add_point(point, 0);
+    }
+
+    size_t const lower_size = hull.size();
+
+    for (auto it = sorted.rbegin() + 1; it != sorted.rend(); ++it)
+    {
+        add_point(*it, lower_size - 1);
+    }
+
+    // Last point is the same as the first one
+    if (hull.size() > 1)
+        hull.pop_back();
+
+    shape.count = std::min(static_cast<u32>(hull.size()), max_points);
+    std::copy_n(hull.begin(), shape.count, shape.points.begin());
+
+    return shape;
+}
+
+ConvexDistance GJK::find_distance(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2 const& axis)
+{
+    Simplex simplex = {};
+    return run(a, b, axis, simplex);
+}
+
+bool GJK::is_separated_along(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2 const& axis)
+{
+    if (glm::dot(axis, axis) < tolerance * tolerance)
+        return false;
+
+    glm::vec2 const normal = glm::normalize(axis);
+    float const min_a = glm::dot(a.points[a.find_support(-normal)], normal) - a.radius;
+    float const max_b = glm::dot(b.points[b.find_support(normal)], normal) + b.radius;
+
+    return min_a > max_b;
+}
+
+bool GJK::find_penetration(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2& axis, glm::vec2& mtv)
+{
+    Simplex simplex = {};
+    ConvexDistance const distance = run(a, b, axis, simplex);
+    float const radius_sum = a.radius + b.radius;
+
+    if (!distance.are_cores_overlapping)
+    {
+        glm::vec2 const normal = (distance.point_a - distance.point_b) / distance.distance;
+        axis = normal;
+
+        if (distance.distance >= radius_sum)
+            return false;
+
+        mtv = normal * (radius_sum - distance.distance);
+        return true;
+    }
+
+    glm::vec2 normal = {};
+    float depth = 0.0f;
+    expand(a, b, simplex, normal, depth);
+
+    axis = -normal;
+    mtv = -normal * (depth + radius_sum);
+    return true;
+}
+
+bool GJK::are_overlapping(ConvexShape2D const& a, ConvexShape2D const& b)
+{
+    ConvexDistance const distance = find_distance(a, b, a.points[0] - b.points[0]);
+    return distance.are_cores_overlapping || distance.distance <= a.radius + b.radius;
+}
+
+bool GJK::find_time_of_impact(ConvexShape2D const& a, glm::vec2 const& displacement, ConvexShape2D const& b, float& time,
+                              glm::vec2& normal)
+{
+    float const radius_sum = a.radius + b.radius;
+
+    ConvexShape2D moved = a;
+    glm::vec2 axis = a.points[0] - b.points[0];
+    float t = 0.0f;
+
+    for (u32 i = 0; i < max_iterations; ++i)
+    {
+        for (u32 point = 0; point < a.count; ++point)
+        {
+            moved.points[point] = a.points[point] + displacement * t;
+        }
+
+        ConvexDistance const distance = find_distance(moved, b, axis);
+        float const gap = distance.distance - radius_sum;
+
+        if (distance.are_cores_overlapping || gap <= 0.0f)
+        {
+            if (i == 0)
+                return false;
+
+            // Advanced a tiny bit too far, the previous axis is still the best normal
+            time = t;
+            normal = glm::normalize(axis);
+            return true;
+        }
+
+        axis = (distance.point_a - distance.point_b) / distance.distance;
+
+        if (gap < tolerance)
+        {
+            time = t;
+            normal = axis;
+            return true;
+        }
+
+        // B is entirely behind the plane through its closest point, a can't hit it before reaching that plane
+        float const approach_speed = -glm::dot(displacement, axis);
+
+        if (approach_speed <= 0.0f)
+            return false;
+
+        t += gap / approach_speed;
+
+        if (t > 1.0f)
+            return false;
+    }
+
+    time = t;
+    normal = axis;
+    return true;
+}
+
+GJK::SimplexVertex GJK::make_vertex(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2 const& direction)
+{
+    SimplexVertex vertex = {};
+    vertex.index_a = a.find_support(direction);
+    vertex.index_b = b.find_support(-direction);
+    vertex.point_a = a.points[vertex.index_a];
+    vertex.point_b = b.points[vertex.index_b];
+    vertex.point = vertex.point_a - vertex.point_b;
+    vertex.weight = 1.0f;
+    return vertex;
+}
+
+ConvexDistance GJK::run(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2 const& axis, Simplex& simplex)
+{
+    glm::vec2 initial_axis = axis;
+
+    if (glm::dot(initial_axis, initial_axis) < tolerance * tolerance)
+        initial_axis = a.points[0] - b.points[0];
+
+    if (glm::dot(initial_axis, initial_axis) < tolerance * tolerance)
+        initial_axis = {1.0f, 0.0f};
+
+    // Difference of the shapes lies along the axis, its closest point is the one furthest against it
+    simplex.vertices[0] = make_vertex(a, b, -initial_axis);
+    simplex.count = 1;
+
+    for (u32 iteration = 0;; ++iteration)
+    {
+        if (simplex.count == 2)
+            solve_segment(simplex);
+        else if (simplex.count == 3)
+            solve_triangle(simplex);
+
+        // Origin is inside the triangle
+        if (simplex.count == 3 || iteration == max_iterations)
+            break;
+
+        glm::vec2 const direction = get_search_direction(simplex);
+
+        if (glm::dot(direction, direction) < std::numeric_limits<float>::epsilon() * std::numeric_limits<float>::epsilon())
+            break;
+
+        SimplexVertex const vertex = make_vertex(a, b, direction);
+
+        // Same support points as before, no progress can be made
+        bool is_duplicate = false;
+
+        for (u32 i = 0; i < simplex.count; ++i)
+        {
+            if (simplex.vertices[i].index_a == vertex.index_a && simplex.vertices[i].index_b == vertex.index_b)
+            {
+                is_duplicate = true;
+                break;
+            }
+        }
+
+        if (is_duplicate)
+            break;
+
+        simplex.vertices[simplex.count] = vertex;
+        simplex.count += 1;
+    }
+
+    ConvexDistance result = {};
+
+    for (u32 i = 0; i < simplex.count; ++i)
+    {
+        result.point_a += simplex.vertices[i].point_a * simplex.vertices[i].weight;
+        result.point_b += simplex.vertices[i].point_b * simplex.vertices[i].weight;
+    }
+
+    if (simplex.count == 3)
+        result.point_b = result.point_a;
+
+    result.distance = glm::distance(result.point_a, result.point_b);
+    result.are_cores_overlapping = simplex.count == 3 || result.distance < tolerance;
+
+    return result;
+}
+
+void GJK::solve_segment(Simplex& simplex)
+{
+    glm::vec2 const w1 = simplex.vertices[0].point;
+    glm::vec2 const w2 = simplex.vertices[1].point;
+    glm::vec2 const e12 = w2 - w1;
+
+    // Region of w1
+    float const d12_2 = -glm::dot(w1, e12);
+    if (d12_2 <= 0.0f)
+    {
+        simplex.vertices[0].weight = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    // Region of w2
+    float const d12_1 = glm::dot(w2, e12);
+    if (d12_1 <= 0.0f)
+    {
+        simplex.vertices[0] = simplex.vertices[1];
+        simplex.vertices[0].weight = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    float const inverse_d12 = 1.0f / (d12_1 + d12_2);
+    simplex.vertices[0].weight = d12_1 * inverse_d12;
+    simplex.vertices[1].weight = d12_2 * inverse_d12;
+}
+
+void GJK::solve_triangle(Simplex& simplex)
+{
+    glm::vec2 const w1 = simplex.vertices[0].point;
+    glm::vec2 const w2 = simplex.vertices[1].point;
+    glm::vec2 const w3 = simplex.vertices[2].point;
+
+    glm::vec2 const e12 = w2 - w1;
+    float const d12_1 = glm::dot(w2, e12);
+    float const d12_2 = -glm::dot(w1, e12);
+
+    glm::vec2 const e13 = w3 - w1;
+    float const d13_1 = glm::dot(w3, e13);
+    float const d13_2 = -glm::dot(w1, e13);
+
+    glm::vec2 const e23 = w3 - w2;
+    float const d23_1 = glm::dot(w3, e23);
+    float const d23_2 = -glm::dot(w2, e23);
+
+    float const n123 = cross(e12, e13);
+    float const d123_1 = n123 * cross(w2, w3);
+    float const d123_2 = n123 * cross(w3, w1);
+    float const d123_3 = n123 * cross(w1, w2);
+
+    // Region of w1
+    if (d12_2 <= 0.0f && d13_2 <= 0.0f)
+    {
+        simplex.vertices[0].weight = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    // Edge from w1 to w2
+    if (d12_1 > 0.0f && d12_2 > 0.0f && d123_3 <= 0.0f)
+    {
+        float const inverse_d12 = 1.0f / (d12_1 + d12_2);
+        simplex.vertices[0].weight = d12_1 * inverse_d12;
+        simplex.vertices[1].weight = d12_2 * inverse_d12;
+        simplex.count = 2;
+        return;
+    }
+
+    // Edge from w1 to w3
+    if (d13_1 > 0.0f && d13_2 > 0.0f && d123_2 <= 0.0f)
+    {
+        float const inverse_d13 = 1.0f / (d13_1 + d13_2);
+        simplex.vertices[0].weight = d13_1 * inverse_d13;
+        simplex.vertices[2].weight = d13_2 * inverse_d13;
+        simplex.vertices[1] = simplex.vertices[2];
+        simplex.count = 2;
+        return;
+    }
+
+    // Region of w2
+    if (d12_1 <= 0.0f && d23_2 <= 0.0f)
+    {
+        simplex.vertices[0] = simplex.vertices[1];
+        simplex.vertices[0].weight = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    // Region of w3
+    if (d13_1 <= 0.0f && d23_1 <= 0.0f)
+    {
+        simplex.vertices[0] = simplex.vertices[2];
+        simplex.vertices[0].weight = 1.0f;
+        simplex.count = 1;
+        return;
+    }
+
+    // Edge from w2 to w3
+    if (d23_1 > 0.0f && d23_2 > 0.0f && d123_1 <= 0.0f)
+    {
+        float const inverse_d23 = 1.0f / (d23_1 + d23_2);
+        simplex.vertices[1].weight = d23_1 * inverse_d23;
+        simplex.vertices[2].weight = d23_2 * inverse_d23;
+        simplex.vertices[0] = simplex.vertices[2];
+        simplex.count = 2;
+        return;
+    }
+
+    // Origin is inside the triangle
+    float const inverse_d123 = 1.0f / (d123_1 + d123_2 + d123_3);
+    simplex.vertices[0].weight = d123_1 * inverse_d123;
+    simplex.vertices[1].weight = d123_2 * inverse_d123;
+    simplex.vertices[2].weight = d123_3 * inverse_d123;
+    simplex.count = 3;
+}
+
+glm::vec2 GJK::get_search_direction(Simplex const& simplex)
+{
+    if (simplex.count == 1)
+        return -simplex.vertices[0].point;
+
+    // Perpendicular to the segment on the side of the origin
+    glm::vec2 const e12 = simplex.vertices[1].point - simplex.vertices[0].point;
+
+    if (cross(e12, -simplex.vertices[0].point) > 0.0f)
+        return {-e12.y, e12.x};
+
+    return {e12.y, -e12.x};
+}
+
+void GJK::expand(ConvexShape2D const& a, ConvexShape2D const& b, Simplex const& simplex, glm::vec2& normal, float& depth)
+{
+    std::array<glm::vec2, 3 + max_expansion_iterations> polytope = {};
+    u32 count = 0;
+
+    for (u32 i = 0; i < simplex.count; ++i)
+    {
+        polytope[count] = simplex.vertices[i].point;
+        count += 1;
+    }
+
+    // Shapes only touch, grow the simplex into a triangle around the origin first
+    if (count == 1)
+    {
+        for (glm::vec2 const direction : {glm::vec2(1.0f, 0.0f), glm::vec2(-1.0f, 0.0f), glm::vec2(0.0f, 1.0f), glm::vec2(0.0f, -1.0f)})
+        {
+            glm::vec2 const point = make_vertex(a, b, direction).point;
+
+            if (glm::distance(point, polytope[0]) > tolerance)
+            {
+                polytope[count] = point;
+                count += 1;
+                break;
+            }
+        }
+    }
+
+    glm::vec2 flat_normal = {0.0f, 1.0f};
+
+    if (count == 2)
+    {
+        glm::vec2 const edge = polytope[1] - polytope[0];
+        flat_normal = glm::normalize(glm::vec2(-edge.y, edge.x));
+
+        for (glm::vec2 const direction : {flat_normal, -flat_normal})
+        {
+            glm::vec2 const point = make_vertex(a, b, direction).point;
+
+            if (std::abs(cross(edge, point - polytope[0])) > tolerance * glm::length(edge))
+            {
+                polytope[count] = point;
+                count += 1;
+                break;
+            }
+        }
+    }
+
+    // Difference of the shapes is a point or a segment through the origin
+    if (count < 3)
+    {
+        normal = flat_normal;
+        depth = 0.0f;
+        return;
+    }
+
+    // Edge normals below point outwards only for counter-clockwise polygons
+    if (cross(polytope[1] - polytope[0], polytope[2] - polytope[0]) < 0.0f)
+        std::swap(polytope[1], polytope[2]);
+
+    normal = flat_normal;
+    depth = 0.0f;
+
+    for (u32 iteration = 0; iteration < max_expansion_iterations; ++iteration)
+    {
+        u32 closest_edge = 0;
+        float closest_distance = std::numeric_limits<float>::infinity();
+        glm::vec2 closest_normal = {};
+
+        for (u32 i = 0; i < count; ++i)
+        {
+            glm::vec2 const edge = polytope[(i + 1) % count] - polytope[i];
+            float const edge_length = glm::length(edge);
+
+            if (edge_length < tolerance)
+                continue;
+
+            glm::vec2 const edge_normal = glm::vec2(edge.y, -edge.x) / edge_length;
+            float const distance = glm::dot(edge_normal, polytope[i]);
+
+            if (distance < closest_distance)
+            {
+                closest_edge = i;
+                closest_distance = distance;
+                closest_normal = edge_normal;
+            }
+        }
+
+        if (closest_distance == std::numeric_limits<float>::infinity())
+            return;
+
+        normal = closest_normal;
+        depth = std::max(closest_distance, 0.0f);
+
+        glm::vec2 const support = make_vertex(a, b, closest_normal).point;
+
+        // Edge is on the boundary of the difference
+        if (glm::dot(support, closest_normal) - closest_distance < tolerance || count == polytope.size())
+            return;
+
+        std::copy_backward(polytope.begin() + closest_edge + 1, polytope.begin() + count, polytope.begin() + count + 1);
+        polytope[closest_edge + 1] = support;
+        count += 1;
+    }
+}
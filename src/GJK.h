@@ -0,0 +1,96 @@
+#pragma once
+
+#include <array>
+#include <span>
+
+#include <glm/vec2.hpp>
+
+#include "AK/Types.h"
+
+// Convex hull of the points grown by the radius. A circle is a single point with a radius, a capsule is a segment
+// with a radius, rectangles and polygons have no radius.
+struct ConvexShape2D
+{
+    static constexpr u32 max_points = 8;
+
+    // Index of the point furthest along the direction, the first one of equal points
+    [[nodiscard]] u32 find_support(glm::vec2 const& direction) const;
+
+    // Counter-clockwise convex hull of the points. Hulls with more than max_points points keep only the first ones,
+    // which is still convex.
+    static ConvexShape2D make_hull(std::span<glm::vec2 const> const points, float const radius = 0.0f);
+
+    std::array<glm::vec2, max_points> points = {};
+    u32 count = 0;
+    float radius = 0.0f;
+};
+
+// Closest points of the shapes without their radii
+struct ConvexDistance
+{
+    glm::vec2 point_a = {};
+    glm::vec2 point_b = {};
+    float distance = 0.0f;
+
+    // Shapes without radii overlap, closest points are meaningless
+    bool are_cores_overlapping = false;
+};
+
+// GJK distance and EPA penetration between any two convex shapes. Axes passed in and out always point from b to a.
+class GJK
+{
+public:
+    static constexpr u32 max_iterations = 32;
+    static constexpr u32 max_expansion_iterations = 32;
+    static constexpr float tolerance = 0.0001f;
+
+    // Axis is only a guess to start from, the separating axis of the previous step is the best one
+    static ConvexDistance find_distance(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2 const& axis);
+
+    // Returns true if the projections of the shapes onto the axis don't overlap, which is enough to skip
+    // the rest of the test. Costs two support queries.
+    static bool is_separated_along(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2 const& axis);
+
+    // MTV moves a out of b by the whole penetration depth. Axis is used as the first guess and is replaced
+    // with the axis found by this test, overlapping or not.
+    static bool find_penetration(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2& axis, glm::vec2& mtv);
+
+    // Touching shapes overlap
+    static bool are_overlapping(ConvexShape2D const& a, ConvexShape2D const& b);
+
+    // Conservative advancement of a moving by displacement. Time is a fraction of the displacement and the normal
+    // points from b to a. Shapes that already overlap are not hit.
+    static bool find_time_of_impact(ConvexShape2D const& a, glm::vec2 const& displacement, ConvexShape2D const& b, float& time,
+                                    glm::vec2& normal);
+
+private:
+    struct SimplexVertex
+    {
+        glm::vec2 point_a = {};
+        glm::vec2 point_b = {};
+
+        // Point of the Minkowski difference, point_a - point_b
+        glm::vec2 point = {};
+        float weight = 0.0f;
+        u32 index_a = 0;
+        u32 index_b = 0;
+    };
+
+    struct Simplex
+    {
+        std::array<SimplexVertex, 3> vertices = {};
+        u32 count = 0;
+    };
+
+    static SimplexVertex make_vertex(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2 const& direction);
+    static ConvexDistance run(ConvexShape2D const& a, ConvexShape2D const& b, glm::vec2 const& axis, Simplex& simplex);
+
+    // Reduce the simplex to the feature closest to the origin and set the barycentric weights of its vertices
+    static void solve_segment(Simplex& simplex);
+    static void solve_triangle(Simplex& simplex);
+
+    static glm::vec2 get_search_direction(Simplex const& simplex);
+
+    // Penetration normal of the Minkowski difference pointing out of it and the depth of the origin, without radii
+    static void expand(ConvexShape2D const& a, ConvexShape2D const& b, Simplex const& simplex, glm::vec2& normal, float& depth);
+};
@@ -16,7 +16,7 @@
 
 std::shared_ptr<Clock> Clock::create()
 {
-    auto instance = std::make_shared<Clock>(AK::Badge<Clock> {});
+    auto instance = AK::make_pooled<Clock>(AK::Badge<Clock> {});
 
     if (m_instance)
     {
@@ -12,7 +12,7 @@
 
 std::shared_ptr<Credits> Credits::create()
 {
-    return std::make_shared<Credits>(AK::Badge<Credits> {});
+    return AK::make_pooled<Credits>(AK::Badge<Credits> {});
 }
 
 Credits::Credits(AK::Badge<Credits>)
@@ -9,7 +9,6 @@
 #include "Globals.h"
 #include "LighthouseKeeper.h"
 #include "PhysicsEngine.h"
-#include "SceneSerializer.h"
 
 #include <glm/gtc/random.hpp>
 
@@ -19,7 +18,7 @@
 
 std::shared_ptr<Customer> Customer::create()
 {
-    return std::make_shared<Customer>(AK::Badge<Customer> {});
+    return AK::make_pooled<Customer>(AK::Badge<Customer> {});
 }
 
 Customer::Customer(AK::Badge<Customer>)
@@ -110,7 +109,7 @@ void Customer::fixed_update()
 
         m_is_jumping = true;
 
-        auto const particle = SceneSerializer::load_prefab("PenguinJump");
+        auto const particle = MainScene::get_instance()->get_prefab_pool().acquire("PenguinJump");
         particle->transform->set_position(entity->transform->get_position() + glm::vec3(0.0f, 0.1f, 0.0f));
     }
     else if (m_is_jumping)
@@ -132,7 +131,7 @@ void Customer::fixed_update()
             }
             if (entity->transform->get_position().y <= desired_height - 5.0f)
             {
-                entity->destroy_immediate();
+                entity->destroy();
                 return;
             }
         }
@@ -14,6 +14,8 @@ public:
     explicit Customer(AK::Badge<Customer>);
 
     virtual void awake() override;
+
+    // NOTE: Plays sounds, acquires prefabs and uses glm::linearRand(), so it doesn't declare its accesses and stays on the main thread
     virtual void fixed_update() override;
     virtual void on_collision_enter(std::shared_ptr<Collider2D> const& other) override;
 
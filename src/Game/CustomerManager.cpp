@@ -15,7 +15,7 @@
 
 std::shared_ptr<CustomerManager> CustomerManager::create()
 {
-    return std::make_shared<CustomerManager>(AK::Badge<CustomerManager> {});
+    return AK::make_pooled<CustomerManager>(AK::Badge<CustomerManager> {});
 }
 
 CustomerManager::CustomerManager(AK::Badge<CustomerManager>)
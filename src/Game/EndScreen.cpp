@@ -25,7 +25,7 @@
 
 std::shared_ptr<EndScreen> EndScreen::create()
 {
-    return std::make_shared<EndScreen>(AK::Badge<EndScreen> {});
+    return AK::make_pooled<EndScreen>(AK::Badge<EndScreen> {});
 }
 
 EndScreen::EndScreen(AK::Badge<EndScreen>)
@@ -113,7 +113,7 @@ void EndScreen::update()
 
                 if (m_is_hiding)
                 {
-                    entity->destroy_immediate();
+                    entity->destroy();
                 }
             }
         }
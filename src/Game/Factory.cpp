@@ -13,7 +13,7 @@
 
 std::shared_ptr<Factory> Factory::create()
 {
-    return std::make_shared<Factory>(AK::Badge<Factory> {});
+    return AK::make_pooled<Factory>(AK::Badge<Factory> {});
 }
 
 Factory::Factory(AK::Badge<Factory>)
@@ -85,7 +85,7 @@ void Factory::set_type(FactoryType const type)
 
     if (!model.expired())
     {
-        model.lock()->destroy_immediate();
+        model.lock()->destroy();
     }
 
     auto const standard_shader = ResourceManager::get_instance().load_shader("./res/shaders/lit.hlsl", "./res/shaders/lit.hlsl");
@@ -7,6 +7,7 @@
 #include "Globals.h"
 #include "Input.h"
 #include "LevelController.h"
+#include "LevelStreamer.h"
 #include "Path.h"
 #include "Player.h"
 #include "SceneSerializer.h"
@@ -21,7 +22,7 @@
 
 std::shared_ptr<GameController> GameController::create()
 {
-    auto instance = std::make_shared<GameController>(AK::Badge<GameController> {});
+    auto instance = AK::make_pooled<GameController>(AK::Badge<GameController> {});
 
     if (m_instance)
     {
@@ -55,6 +56,18 @@ void GameController::uninitialize()
 
 void GameController::awake()
 {
+    // Spawned over and over again, their components reset everything they need in reprepare()
+    auto& prefab_pool = MainScene::get_instance()->get_prefab_pool();
+    prefab_pool.set_capacity("PenguinJump", 32);
+    prefab_pool.set_capacity("SpacePrompt", 2);
+    prefab_pool.set_capacity("WASDPrompt", 1);
+    prefab_pool.set_capacity("MousePrompt", 1);
+    prefab_pool.set_capacity("ShipSmall", 8);
+    prefab_pool.set_capacity("ShipMedium", 8);
+    prefab_pool.set_capacity("ShipBig", 8);
+    prefab_pool.set_capacity("ShipPirates", 8);
+    prefab_pool.set_capacity("ShipTool", 8);
+
     if (!SceneSerializer::load_prefab("DEBUGINPUTCONTROLLER"))
     {
         auto const entity = Entity::create("DEBUGINPUTCONTROLLER");
@@ -119,10 +132,21 @@ void GameController::update()
         return;
     }
 
+    if (m_next_scene_load != nullptr && next_scene.expired())
+    {
+        next_scene = m_next_scene_load->get_entity();
+    }
+
     if (m_move_to_next_scene_counter < 1.0f)
     {
         m_move_to_next_scene_counter += delta_time * 0.75f;
 
+        // Don't get ahead of the level that is still streaming in
+        if (m_next_scene_load != nullptr)
+        {
+            m_move_to_next_scene_counter = std::min(m_move_to_next_scene_counter, m_next_scene_load->get_progress());
+        }
+
         update_scenes_position();
     }
     else
@@ -171,11 +195,9 @@ void GameController::reset_scene()
 
     m_level_number = 0;
 
-    next_scene = SceneSerializer::load_prefab(m_levels_order.back());
+    load_next_scene(m_levels_order.back());
     m_levels_order.pop_back();
 
-    reset_level();
-
     auto const path = entity->get_component<Path>();
     m_current_position = path->points[path->points.size() - 1];
     m_next_position = path->points[0];
@@ -192,6 +214,34 @@ void GameController::reset_scene()
     m_move_to_next_scene = true;
 }
 
+void GameController::load_next_scene(std::string const& level)
+{
+    auto const on_loaded = [](std::shared_ptr<Entity> const& scene) {
+        auto const game_controller = get_instance();
+
+        if (game_controller == nullptr)
+            return;
+
+        game_controller->m_next_scene_load = nullptr;
+
+        if (scene == nullptr)
+        {
+            game_controller->m_move_to_next_scene = false;
+            game_controller->m_move_to_next_scene_counter = 0.0f;
+            return;
+        }
+
+        game_controller->next_scene = scene;
+        game_controller->reset_level();
+    };
+
+    // NOTE: The new level's LevelController replaces the instance once it's created, it must not be destroyed earlier
+    //       because the current level still uses it while the new one is being parsed.
+    auto const on_parsed = [] { LevelController::get_instance()->destroy_immediate(); };
+
+    m_next_scene_load = MainScene::get_instance()->get_level_streamer().load(level, on_loaded, on_parsed);
+}
+
 float GameController::ease_in_out_cubic(float const x) const
 {
     return x < 0.5f ? 4.0f * x * x * x : 1.0f - std::pow(-2.0f * x + 2.0f, 3.0f) / 2.0f;
@@ -202,6 +252,11 @@ void GameController::update_scenes_position() const
     current_scene.lock()->transform->set_local_position(
         glm::vec3(m_current_position.x - ease_in_out_cubic(m_move_to_next_scene_counter) * m_next_position.x, 0.0f,
                   m_current_position.y - ease_in_out_cubic(m_move_to_next_scene_counter) * m_next_position.y));
+
+    // Not created yet while it's being parsed
+    if (next_scene.expired())
+        return;
+
     next_scene.lock()->transform->set_local_position(
         glm::vec3(m_next_position.x - ease_in_out_cubic(m_move_to_next_scene_counter) * m_next_position.x, 0.0f,
                   m_next_position.y - ease_in_out_cubic(m_move_to_next_scene_counter) * m_next_position.y));
@@ -211,7 +266,6 @@ void GameController::move_to_next_scene()
 {
     LevelController::get_instance()->lighthouse.lock()->turn_light(false);
     LevelController::get_instance()->destroy_mouse_prompt();
-    LevelController::get_instance()->destroy_immediate();
 
     if (m_levels_order.empty())
     {
@@ -219,11 +273,9 @@ void GameController::move_to_next_scene()
         return;
     }
 
-    next_scene = SceneSerializer::load_prefab(m_levels_order.back());
+    load_next_scene(m_levels_order.back());
     m_levels_order.pop_back();
 
-    reset_level();
-
     auto const& path = entity->get_component<Path>();
     m_current_position = path->points[m_level_number];
     m_next_position = path->points[m_level_number + 1];
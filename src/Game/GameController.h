@@ -8,6 +8,8 @@
 
 #include <glm/vec2.hpp>
 
+class LevelLoad;
+
 class GameController final : public Component
 {
 public:
@@ -41,6 +43,10 @@ public:
 
 private:
     void reset_scene();
+
+    // Streams the level in, the transition waits for it in update()
+    void load_next_scene(std::string const& level);
+
     float ease_in_out_cubic(float const x) const;
 
     void update_scenes_position() const;
@@ -49,6 +55,7 @@ private:
 
     bool m_move_to_next_scene = false;
     float m_move_to_next_scene_counter = 0.0f;
+    std::shared_ptr<LevelLoad> m_next_scene_load = {};
 
     glm::vec2 m_current_position = {};
     glm::vec2 m_next_position = {};
@@ -11,7 +11,7 @@
 
 std::shared_ptr<HovercraftWithoutKeeper> HovercraftWithoutKeeper::create()
 {
-    return std::make_shared<HovercraftWithoutKeeper>(AK::Badge<HovercraftWithoutKeeper> {});
+    return AK::make_pooled<HovercraftWithoutKeeper>(AK::Badge<HovercraftWithoutKeeper> {});
 }
 
 HovercraftWithoutKeeper::HovercraftWithoutKeeper(AK::Badge<HovercraftWithoutKeeper>)
@@ -19,7 +19,7 @@
 
 std::shared_ptr<IceBound> IceBound::create()
 {
-    return std::make_shared<IceBound>(AK::Badge<IceBound> {});
+    return AK::make_pooled<IceBound>(AK::Badge<IceBound> {});
 }
 
 IceBound::IceBound(AK::Badge<IceBound>)
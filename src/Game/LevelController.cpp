@@ -8,6 +8,7 @@
 #include "GameController.h"
 #include "Globals.h"
 #include "Input.h"
+#include "PhysicsEngine.h"
 #include "Player.h"
 #include "SceneSerializer.h"
 #include "ScreenText.h"
@@ -23,7 +24,7 @@
 
 std::shared_ptr<LevelController> LevelController::create()
 {
-    auto instance = std::make_shared<LevelController>();
+    auto instance = AK::make_pooled<LevelController>();
 
     if (m_instance)
     {
@@ -65,6 +66,11 @@ void LevelController::awake()
     set_can_tick(true);
     on_lighthouse_upgraded();
     Clock::get_instance()->update_visibility();
+
+    // Everything that collides lives on the playfield, so the broadphase grid doesn't need to cover more than that
+    float const half_width = playfield_width + playfield_additional_width;
+    PhysicsEngine::get_instance()->set_broadphase_bounds({-half_width, playfield_y_shift - playfield_height},
+                                                         {half_width, playfield_y_shift + playfield_height});
 }
 
 void LevelController::update()
@@ -153,13 +159,15 @@ void LevelController::update()
             && (Input::input->get_key_down(GLFW_KEY_W) || Input::input->get_key_down(GLFW_KEY_S) || Input::input->get_key_down(GLFW_KEY_A)
                 || Input::input->get_key_down(GLFW_KEY_D)))
         {
-            m_story_wasd_prompt.lock()->destroy_immediate();
+            m_story_wasd_prompt.lock()->destroy();
+            m_story_wasd_prompt.reset();
         }
 
         // For disabling second space prompt in tutorial when space is used.
         if (!m_story_second_space_prompt.expired() && Input::input->get_key_down(GLFW_KEY_SPACE))
         {
-            m_story_second_space_prompt.lock()->destroy_immediate();
+            m_story_second_space_prompt.lock()->destroy();
+            m_story_second_space_prompt.reset();
         }
     }
     else
@@ -187,7 +195,10 @@ void LevelController::update()
                 }
 
                 if (!m_story_mouse_prompt.expired())
-                    m_story_mouse_prompt.lock()->destroy_immediate();
+                {
+                    m_story_mouse_prompt.lock()->destroy();
+                    m_story_mouse_prompt.reset();
+                }
 
                 check_tutorial_progress(TutorialProgressAction::LighthouseEnabled);
                 lighthouse.lock()->turn_light(true);
@@ -370,7 +381,7 @@ void LevelController::check_tutorial_progress(TutorialProgressAction action)
             if (action == TutorialProgressAction::ShipEnteredPort)
             {
                 GameController::get_instance()->dialog_manager.lock()->play_content(2);
-                m_story_space_prompt = SceneSerializer::load_prefab("SpacePrompt");
+                m_story_space_prompt = MainScene::get_instance()->get_prefab_pool().acquire("SpacePrompt");
                 m_story_space_prompt.lock()->transform->set_position(m_space_prompt_pos);
                 m_story_space_prompt.lock()->transform->set_parent(entity->transform);
                 set_exiting_lighthouse(true);
@@ -383,9 +394,12 @@ void LevelController::check_tutorial_progress(TutorialProgressAction action)
                 GameController::get_instance()->dialog_manager.lock()->end_content();
 
                 if (!m_story_space_prompt.expired())
-                    m_story_space_prompt.lock()->destroy_immediate();
+                {
+                    m_story_space_prompt.lock()->destroy();
+                    m_story_space_prompt.reset();
+                }
 
-                m_story_wasd_prompt = SceneSerializer::load_prefab("WASDPrompt");
+                m_story_wasd_prompt = MainScene::get_instance()->get_prefab_pool().acquire("WASDPrompt");
                 m_story_wasd_prompt.lock()->transform->set_position(m_wasd_prompt_pos);
                 m_story_wasd_prompt.lock()->transform->set_parent(entity->transform);
 
@@ -463,7 +477,7 @@ void LevelController::check_tutorial_progress(TutorialProgressAction action)
 
                     if (lighthouse.lock()->is_keeper_inside())
                     {
-                        m_story_second_space_prompt = SceneSerializer::load_prefab("SpacePrompt");
+                        m_story_second_space_prompt = MainScene::get_instance()->get_prefab_pool().acquire("SpacePrompt");
                         m_story_second_space_prompt.lock()->transform->set_position(m_second_space_prompt_pos);
                         m_story_second_space_prompt.lock()->transform->set_parent(entity->transform);
                     }
@@ -664,7 +678,7 @@ void LevelController::progress_tutorial(i32 step)
 
 void LevelController::spawn_prompt(std::string const& prefab_name, glm::vec3 const& position, std::weak_ptr<Entity>& optional_ref)
 {
-    optional_ref = SceneSerializer::load_prefab(prefab_name);
+    optional_ref = MainScene::get_instance()->get_prefab_pool().acquire(prefab_name);
     optional_ref.lock()->transform->set_position(position);
     optional_ref.lock()->transform->set_parent(entity->transform);
 }
@@ -676,7 +690,7 @@ void LevelController::spawn_mouse_prompt_on_new_level()
 
     if (!GameController::get_instance()->is_moving_to_next_scene())
     {
-        m_story_mouse_prompt = SceneSerializer::load_prefab("MousePrompt");
+        m_story_mouse_prompt = MainScene::get_instance()->get_prefab_pool().acquire("MousePrompt");
         m_mouse_prompt_pos = lighthouse.lock()->entity->transform->get_position() + glm::vec3(0.0f, 1.3f, -0.75f);
         m_story_mouse_prompt.lock()->transform->set_position(m_mouse_prompt_pos);
         m_story_mouse_prompt.lock()->transform->set_parent(entity->transform);
@@ -686,7 +700,10 @@ void LevelController::spawn_mouse_prompt_on_new_level()
 void LevelController::destroy_mouse_prompt()
 {
     if (!m_story_mouse_prompt.expired())
-        m_story_mouse_prompt.lock()->destroy_immediate();
+    {
+        m_story_mouse_prompt.lock()->destroy();
+        m_story_mouse_prompt.reset();
+    }
 }
 
 void LevelController::end_level()
@@ -21,7 +21,7 @@
 
 std::shared_ptr<Lighthouse> Lighthouse::create()
 {
-    return std::make_shared<Lighthouse>(AK::Badge<Lighthouse> {});
+    return AK::make_pooled<Lighthouse>(AK::Badge<Lighthouse> {});
 }
 
 Lighthouse::Lighthouse(AK::Badge<Lighthouse>)
@@ -174,7 +174,7 @@ void Lighthouse::despawn_hovercraft()
         return;
     }
 
-    m_hovercraft.lock()->destroy_immediate();
+    m_hovercraft.lock()->destroy();
 }
 
 void Lighthouse::spawn_fake_packages(u32 const packages_count, std::shared_ptr<Transform> const& parent) const
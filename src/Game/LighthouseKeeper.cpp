@@ -28,7 +28,7 @@
 
 std::shared_ptr<LighthouseKeeper> LighthouseKeeper::create()
 {
-    return std::make_shared<LighthouseKeeper>(AK::Badge<LighthouseKeeper> {});
+    return AK::make_pooled<LighthouseKeeper>(AK::Badge<LighthouseKeeper> {});
 }
 
 LighthouseKeeper::LighthouseKeeper(AK::Badge<LighthouseKeeper>)
@@ -273,7 +273,7 @@ void LighthouseKeeper::hide_interaction_prompt(WorldPromptType type)
     case WorldPromptType::Factory:
         if (!m_factory_prompt.expired())
         {
-            m_factory_prompt.lock()->destroy_immediate();
+            m_factory_prompt.lock()->destroy();
             m_factory_prompt.reset();
         }
         break;
@@ -281,7 +281,7 @@ void LighthouseKeeper::hide_interaction_prompt(WorldPromptType type)
     case WorldPromptType::Lighthouse:
         if (!m_lighthouse_prompt.expired())
         {
-            m_lighthouse_prompt.lock()->destroy_immediate();
+            m_lighthouse_prompt.lock()->destroy();
             m_lighthouse_prompt.reset();
         }
         break;
@@ -289,7 +289,7 @@ void LighthouseKeeper::hide_interaction_prompt(WorldPromptType type)
     case WorldPromptType::Port:
         if (!m_port_prompt.expired())
         {
-            m_port_prompt.lock()->destroy_immediate();
+            m_port_prompt.lock()->destroy();
             m_port_prompt.reset();
         }
         break;
@@ -303,25 +303,17 @@ glm::vec2 LighthouseKeeper::get_speed() const
 
 void LighthouseKeeper::handle_input()
 {
-    auto const& factories = LevelController::get_instance()->factories;
-    if (factories.size() > 0)
-    {
-        std::shared_ptr<Factory> closest_factory = factories[0].lock();
-        float closest_distance = distance(AK::convert_3d_to_2d(closest_factory->entity->transform->get_position()),
-                                          AK::convert_3d_to_2d(entity->transform->get_position()));
-
-        for (u32 i = 1; i < factories.size(); ++i)
-        {
-            auto const factory_locked = factories[i].lock();
-            float const distance = glm::distance(AK::convert_3d_to_2d(factory_locked->entity->transform->get_position()),
-                                                 AK::convert_3d_to_2d(entity->transform->get_position()));
+    glm::vec2 const keeper_position = AK::convert_3d_to_2d(entity->transform->get_position());
+    auto const closest_factory_collider =
+        PhysicsEngine::get_instance()->query_nearest(keeper_position, [](std::shared_ptr<Collider2D> const& collider) {
+            return collider->entity->get_component<Factory>() != nullptr;
+        });
 
-            if (distance < closest_distance)
-            {
-                closest_distance = distance;
-                closest_factory = factory_locked;
-            }
-        }
+    if (closest_factory_collider != nullptr)
+    {
+        std::shared_ptr<Factory> const closest_factory = closest_factory_collider->entity->get_component<Factory>();
+        float const closest_distance =
+            glm::distance(AK::convert_3d_to_2d(closest_factory->entity->transform->get_position()), keeper_position);
 
         if (closest_distance < interact_with_factory_distance && Player::get_instance()->packages > 0)
         {
@@ -437,7 +429,7 @@ void LighthouseKeeper::handle_input()
             if (Input::input->get_key_down(GLFW_KEY_SPACE) && lighthouse.lock()->is_entering_lighthouse_allowed)
             {
                 lighthouse_locked->enter();
-                entity->destroy_immediate();
+                entity->destroy();
                 m_engine_sound->stop_with_fade(1000);
                 hide_interaction_prompt(WorldPromptType::Lighthouse);
                 return;
@@ -477,7 +469,7 @@ void LighthouseKeeper::remove_package()
 {
     if (packages.size() > 0)
     {
-        packages.back().lock()->destroy_immediate();
+        packages.back().lock()->destroy();
         packages.pop_back();
     }
     else
@@ -15,7 +15,7 @@
 
 std::shared_ptr<LighthouseLight> LighthouseLight::create()
 {
-    return std::make_shared<LighthouseLight>(AK::Badge<LighthouseLight> {});
+    return AK::make_pooled<LighthouseLight>(AK::Badge<LighthouseLight> {});
 }
 
 LighthouseLight::LighthouseLight(AK::Badge<LighthouseLight>)
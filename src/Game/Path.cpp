@@ -15,7 +15,7 @@
 
 std::shared_ptr<Path> Path::create()
 {
-    return std::make_shared<Path>(AK::Badge<Path> {});
+    return AK::make_pooled<Path>(AK::Badge<Path> {});
 }
 
 Path::Path(AK::Badge<Path>)
@@ -17,7 +17,7 @@
 
 std::shared_ptr<Player> Player::create()
 {
-    auto instance = std::make_shared<Player>(AK::Badge<Player> {});
+    auto instance = AK::make_pooled<Player>(AK::Badge<Player> {});
 
     if (m_instance)
     {
@@ -10,7 +10,7 @@
 
 std::shared_ptr<PlayerInput> PlayerInput::create()
 {
-    auto player_input = std::make_shared<PlayerInput>(AK::Badge<PlayerInput> {});
+    auto player_input = AK::make_pooled<PlayerInput>(AK::Badge<PlayerInput> {});
 
     return player_input;
 }
@@ -22,7 +22,7 @@
 
 std::shared_ptr<Popup> Popup::create()
 {
-    return std::make_shared<Popup>(AK::Badge<Popup> {});
+    return AK::make_pooled<Popup>(AK::Badge<Popup> {});
 }
 
 Popup::Popup(AK::Badge<Popup>)
@@ -58,7 +58,7 @@ void Popup::update()
 
             if (m_is_hiding)
             {
-                entity->destroy_immediate();
+                entity->destroy();
             }
         }
     }
@@ -13,7 +13,7 @@
 
 std::shared_ptr<Port> Port::create()
 {
-    return std::make_shared<Port>(AK::Badge<Port> {});
+    return AK::make_pooled<Port>(AK::Badge<Port> {});
 }
 
 Port::Port(AK::Badge<Port>)
@@ -38,6 +38,12 @@ void Port::on_trigger_enter(std::shared_ptr<Collider2D> const& other)
 
 void Port::on_trigger_exit(std::shared_ptr<Collider2D> const& other)
 {
+    // Also sent when the ship's collider is disabled or its entity is parked
+    if (auto const ship = other->entity->get_component<Ship>(); ship != nullptr)
+    {
+        AK::erase(m_ships_inside, ship);
+    }
+
     if (auto const keeper = other->entity->get_component<LighthouseKeeper>(); keeper != nullptr)
     {
         keeper->set_is_inside_port(false);
@@ -158,7 +164,7 @@ void Port::draw_editor()
         {
             for (auto const& light : lights)
             {
-                light.lock()->destroy_immediate();
+                light.lock()->destroy();
             }
 
             lights.clear();
@@ -195,7 +201,7 @@ void Port::draw_editor()
         {
             for (auto const& light : lights)
             {
-                light.lock()->destroy_immediate();
+                light.lock()->destroy();
             }
 
             lights.clear();
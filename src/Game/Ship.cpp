@@ -27,13 +27,13 @@
 
 std::shared_ptr<Ship> Ship::create()
 {
-    return std::make_shared<Ship>(AK::Badge<Ship> {});
+    return AK::make_pooled<Ship>(AK::Badge<Ship> {});
 }
 
 std::shared_ptr<Ship> Ship::create(std::shared_ptr<LighthouseLight> const& light, std::shared_ptr<ShipSpawner> const& spawner,
                                    std::shared_ptr<ShipEyes> const& eyes)
 {
-    auto ship = std::make_shared<Ship>(AK::Badge<Ship> {});
+    auto ship = AK::make_pooled<Ship>(AK::Badge<Ship> {});
     ship->light = light;
     ship->spawner = spawner;
     ship->eyes = eyes;
@@ -53,6 +53,35 @@ void Ship::awake()
     set_can_tick(true);
 }
 
+void Ship::reprepare()
+{
+    Component::reprepare();
+
+    is_destroyed = false;
+    behavioral_state = BehavioralState::Normal;
+    is_in_flash_collider = false;
+    floater.reset();
+
+    m_speed = 0.0f;
+    m_direction = 0.0f;
+    m_range_factor = ship_type_to_range_factor(type);
+    m_is_in_port = false;
+    m_collision_rotation_counter = 0.0f;
+    m_destroyed_counter = 0.0f;
+    m_scale_down_counter = 0.0f;
+    m_pirates_in_control_counter = 0.0f;
+    m_avoid_direction = 0;
+
+    if (entity != nullptr)
+    {
+        if (auto const drawable = entity->get_component<Drawable>())
+            drawable->set_glowing(false);
+    }
+
+    if (auto const light = my_light.lock())
+        light->set_pulsate(false);
+}
+
 void Ship::set_start_direction()
 {
     glm::vec2 const ship_position = AK::convert_3d_to_2d(entity->transform->get_local_position());
@@ -122,7 +151,7 @@ bool Ship::control_state_change()
         {
             auto const nearest_ship = spawner.lock()->find_nearest_ship_object(light.lock()->get_position());
 
-            if (nearest_ship.value().lock() == shared_from_this())
+            if (nearest_ship.has_value() && nearest_ship.value().lock() == shared_from_this())
             {
                 behavioral_state = BehavioralState::Control;
                 light.lock()->controlled_ship = std::static_pointer_cast<Ship>(shared_from_this());
@@ -350,7 +379,7 @@ void Ship::destroyed_behavior()
     }
     else
     {
-        entity->destroy_immediate();
+        release();
     }
 }
 
@@ -375,7 +404,7 @@ void Ship::collected_by_keeper_behavior()
     }
     else
     {
-        entity->destroy_immediate();
+        release();
     }
 }
 
@@ -383,7 +412,7 @@ void Ship::update()
 {
     if (is_out_of_room())
     {
-        entity->destroy_immediate();
+        release();
         return;
     }
 
@@ -607,6 +636,18 @@ void Ship::on_destroyed()
     on_ship_destroyed(static_pointer_cast<Ship>(shared_from_this()));
 }
 
+void Ship::release()
+{
+    on_ship_destroyed(static_pointer_cast<Ship>(shared_from_this()));
+    on_ship_destroyed.clear();
+
+    // Added by the spawner, a parked ship has to have the components of its prefab
+    if (auto const locked_floater = floater.lock())
+        locked_floater->destroy_immediate();
+
+    entity->destroy();
+}
+
 #if EDITOR
 void Ship::draw_editor()
 {
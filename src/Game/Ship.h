@@ -159,6 +159,7 @@ public:
     explicit Ship(AK::Badge<Ship>);
 
     virtual void awake() override;
+    virtual void reprepare() override;
     virtual void update() override;
     virtual void on_destroyed() override;
 #if EDITOR
@@ -231,6 +232,9 @@ private:
     void scale_down();
     bool is_out_of_room() const;
 
+    // NOTE: Pooled ships are parked without on_destroyed(), so listeners are notified and dropped here.
+    void release();
+
     float m_speed = 0.0f;
     float m_direction = 0.0f;
     float m_range_factor = 1.0f;
@@ -20,7 +20,7 @@
 
 std::shared_ptr<ShipEyes> ShipEyes::create()
 {
-    return std::make_shared<ShipEyes>(AK::Badge<ShipEyes> {});
+    return AK::make_pooled<ShipEyes>(AK::Badge<ShipEyes> {});
 }
 
 ShipEyes::ShipEyes(AK::Badge<ShipEyes>)
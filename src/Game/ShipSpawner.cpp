@@ -25,12 +25,12 @@
 
 std::shared_ptr<ShipSpawner> ShipSpawner::create()
 {
-    return std::make_shared<ShipSpawner>(AK::Badge<ShipSpawner> {});
+    return AK::make_pooled<ShipSpawner>(AK::Badge<ShipSpawner> {});
 }
 
 std::shared_ptr<ShipSpawner> ShipSpawner::create(std::shared_ptr<LighthouseLight> const& light)
 {
-    auto ship_spawner = std::make_shared<ShipSpawner>(AK::Badge<ShipSpawner> {});
+    auto ship_spawner = AK::make_pooled<ShipSpawner>(AK::Badge<ShipSpawner> {});
     ship_spawner->light = light;
 
     return ship_spawner;
@@ -611,7 +611,7 @@ void ShipSpawner::prepare_for_spawn()
                 }
             }
 
-            m_warning_lights.back().lock()->destroy_immediate();
+            m_warning_lights.back().lock()->destroy();
             m_warning_lights.pop_back();
 
             spawn_ship(being_spawn);
@@ -639,7 +639,7 @@ void ShipSpawner::prepare_for_spawn()
             }
             else
             {
-                m_warning_lights.back().lock()->destroy_immediate();
+                m_warning_lights.back().lock()->destroy();
                 m_warning_lights.pop_back();
 
                 spawn_ship(being_spawn);
@@ -680,7 +680,7 @@ void ShipSpawner::prepare_for_spawn()
 
             if (!m_warning_lights.back().expired())
             {
-                m_warning_lights.back().lock()->destroy_immediate();
+                m_warning_lights.back().lock()->destroy();
                 m_warning_lights.pop_back();
             }
 
@@ -721,7 +721,7 @@ void ShipSpawner::prepare_for_spawn()
         {
             for (i32 i = m_warning_lights.size() - 1; i >= 0; i--)
             {
-                m_warning_lights[i].lock()->destroy_immediate();
+                m_warning_lights[i].lock()->destroy();
                 m_warning_lights.pop_back();
 
                 spawn_ship(being_spawn);
@@ -783,7 +783,7 @@ void ShipSpawner::prepare_for_spawn()
                 Debug::log("There is no warning but one should be destroyed!", DebugType::Error);
                 return;
             }
-            m_warning_lights.back().lock()->destroy_immediate();
+            m_warning_lights.back().lock()->destroy();
             m_warning_lights.pop_back();
 
             spawn_ship(being_spawn);
@@ -817,7 +817,7 @@ void ShipSpawner::prepare_for_spawn()
                     return;
                 }
 
-                m_warning_lights.back().lock()->destroy_immediate();
+                m_warning_lights.back().lock()->destroy();
                 m_warning_lights.pop_back();
 
                 spawn_ship(being_spawn);
@@ -873,7 +873,7 @@ void ShipSpawner::spawn_ship(SpawnEvent const* being_spawn)
 
         if (is_cargo_spawned)
         {
-            ship = SceneSerializer::load_prefab("ShipPirates");
+            ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipPirates");
             spawning_boat_settings = floaters_manager.lock()->pirate_boat_settings;
         }
     }
@@ -882,27 +882,27 @@ void ShipSpawner::spawn_ship(SpawnEvent const* being_spawn)
     {
         if (being_spawn->spawn_list.back() == ShipType::FoodSmall)
         {
-            ship = SceneSerializer::load_prefab("ShipSmall");
+            ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipSmall");
             spawning_boat_settings = floaters_manager.lock()->small_boat_settings;
         }
         else if (being_spawn->spawn_list.back() == ShipType::FoodMedium)
         {
-            ship = SceneSerializer::load_prefab("ShipMedium");
+            ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipMedium");
             spawning_boat_settings = floaters_manager.lock()->medium_boat_settings;
         }
         else if (being_spawn->spawn_list.back() == ShipType::FoodBig)
         {
-            ship = SceneSerializer::load_prefab("ShipBig");
+            ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipBig");
             spawning_boat_settings = floaters_manager.lock()->big_boat_settings;
         }
         else if (being_spawn->spawn_list.back() == ShipType::Pirates)
         {
-            ship = SceneSerializer::load_prefab("ShipPirates");
+            ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipPirates");
             spawning_boat_settings = floaters_manager.lock()->pirate_boat_settings;
         }
         else if (being_spawn->spawn_list.back() == ShipType::Tool)
         {
-            ship = SceneSerializer::load_prefab("ShipTool");
+            ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipTool");
             spawning_boat_settings = floaters_manager.lock()->tool_boat_settings;
         }
     }
@@ -933,27 +933,27 @@ void ShipSpawner::spawn_ship_at_position(ShipType const type, glm::vec2 position
     FloaterSettings spawning_boat_settings = {};
     if (type == ShipType::FoodSmall)
     {
-        ship = SceneSerializer::load_prefab("ShipSmall");
+        ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipSmall");
         spawning_boat_settings = floaters_manager.lock()->small_boat_settings;
     }
     else if (type == ShipType::FoodMedium)
     {
-        ship = SceneSerializer::load_prefab("ShipMedium");
+        ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipMedium");
         spawning_boat_settings = floaters_manager.lock()->medium_boat_settings;
     }
     else if (type == ShipType::FoodBig)
     {
-        ship = SceneSerializer::load_prefab("ShipBig");
+        ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipBig");
         spawning_boat_settings = floaters_manager.lock()->big_boat_settings;
     }
     else if (type == ShipType::Pirates)
     {
-        ship = SceneSerializer::load_prefab("ShipPirates");
+        ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipPirates");
         spawning_boat_settings = floaters_manager.lock()->pirate_boat_settings;
     }
     else if (type == ShipType::Tool)
     {
-        ship = SceneSerializer::load_prefab("ShipTool");
+        ship = MainScene::get_instance()->get_prefab_pool().acquire("ShipTool");
         spawning_boat_settings = floaters_manager.lock()->tool_boat_settings;
     }
     auto const floater = ship->add_component(
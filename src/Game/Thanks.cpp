@@ -14,7 +14,7 @@
 
 std::shared_ptr<Thanks> Thanks::create()
 {
-    return std::make_shared<Thanks>(AK::Badge<Thanks> {});
+    return AK::make_pooled<Thanks>(AK::Badge<Thanks> {});
 }
 
 Thanks::Thanks(AK::Badge<Thanks>)
@@ -7,7 +7,7 @@
 
 std::shared_ptr<Grass> Grass::create()
 {
-    auto grass = std::make_shared<Grass>(AK::Badge<Grass> {}, default_material);
+    auto grass = AK::make_pooled<Grass>(AK::Badge<Grass> {}, default_material);
     grass->prepare();
 
     return grass;
@@ -15,7 +15,7 @@ std::shared_ptr<Grass> Grass::create()
 
 std::shared_ptr<Grass> Grass::create(std::shared_ptr<Material> const& material)
 {
-    auto grass = std::make_shared<Grass>(AK::Badge<Grass> {}, material);
+    auto grass = AK::make_pooled<Grass>(AK::Badge<Grass> {}, material);
     grass->prepare();
 
     return grass;
@@ -23,7 +23,7 @@ std::shared_ptr<Grass> Grass::create(std::shared_ptr<Material> const& material)
 
 std::shared_ptr<Grass> Grass::create(std::shared_ptr<Material> const& material, std::string const& diffuse_texture_path)
 {
-    auto grass = std::make_shared<Grass>(AK::Badge<Grass> {}, material, diffuse_texture_path);
+    auto grass = AK::make_pooled<Grass>(AK::Badge<Grass> {}, material, diffuse_texture_path);
     grass->prepare();
 
     return grass;
@@ -0,0 +1,348 @@
+#include "LevelStreamer.h"
+
+#include "AK/AK.h"
+#include "AK/JobSystem.h"
+#include "AK/ScopeGuard.h"
+#include "AssetPreloader.h"
+#include "Debug.h"
+#include "Engine.h"
+#include "Entity.h"
+#include "MainScene.h"
+#include "Model.h"
+#include "SceneSerializer.h"
+#include "TextureLoader.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <unordered_set>
+#include <utility>
+
+#include <yaml-cpp/yaml.h>
+
+std::string const& LevelLoad::get_prefab_name() const
+{
+    return m_prefab_name;
+}
+
+LevelLoadStage LevelLoad::get_stage() const
+{
+    return m_stage;
+}
+
+float LevelLoad::get_progress() const
+{
+    switch (m_stage)
+    {
+    case LevelLoadStage::Parsing:
+        return 0.0f;
+
+    case LevelLoadStage::Preparing:
+    case LevelLoadStage::Awaking:
+    {
+        // Creating the entities is one step, preparing and awaking a component are one each
+        u32 const step_count = 1 + 2 * m_component_count;
+        u32 const steps_done = 1 + m_component_index + (m_stage == LevelLoadStage::Awaking ? m_component_count : 0);
+        return static_cast<float>(steps_done) / static_cast<float>(step_count);
+    }
+
+    case LevelLoadStage::Done:
+    case LevelLoadStage::Failed:
+        return 1.0f;
+
+    default:
+        std::unreachable();
+    }
+}
+
+bool LevelLoad::is_done() const
+{
+    return m_stage == LevelLoadStage::Done || m_stage == LevelLoadStage::Failed;
+}
+
+std::shared_ptr<Entity> LevelLoad::get_entity() const
+{
+    return m_entity.lock();
+}
+
+void LevelStreamer::set_frame_budget(double const milliseconds)
+{
+    m_frame_budget = milliseconds;
+}
+
+double LevelStreamer::get_frame_budget() const
+{
+    return m_frame_budget;
+}
+
+std::shared_ptr<LevelLoad> LevelStreamer::load(std::string const& prefab_name,
+                                               std::function<void(std::shared_ptr<Entity> const&)> on_loaded,
+                                               std::function<void()> on_parsed)
+{
+    auto load = std::make_shared<LevelLoad>();
+    load->m_prefab_name = prefab_name;
+    load->m_on_loaded = std::move(on_loaded);
+    load->m_on_parsed = std::move(on_parsed);
+    m_loads.emplace_back(load);
+
+    auto const job_system = AK::JobSystem::get_instance();
+
+    if (job_system == nullptr)
+    {
+        parse(*load);
+        return load;
+    }
+
+    // NOTE: The job keeps the load alive, the streamer might have forgotten it by the time it's parsed.
+    job_system->schedule("Parse level", [load] { parse(*load); });
+
+    return load;
+}
+
+void LevelStreamer::update()
+{
+    if (m_loads.empty())
+        return;
+
+    auto const start = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> const budget(m_frame_budget);
+    auto const is_over_budget = [&] { return std::chrono::high_resolution_clock::now() - start >= budget; };
+
+    // Callbacks can start new loads, those are advanced from the next frame on
+    auto const loads = m_loads;
+
+    for (auto const& load : loads)
+    {
+        // Forgotten by a callback
+        if (std::ranges::find(m_loads, load) == m_loads.end())
+            continue;
+
+        advance(*load, is_over_budget);
+
+        if (!load->is_done())
+            continue;
+
+        std::erase(m_loads, load);
+        load->m_serializer = nullptr;
+
+        if (load->m_on_loaded)
+            load->m_on_loaded(load->m_stage == LevelLoadStage::Done ? load->get_entity() : nullptr);
+    }
+}
+
+void LevelStreamer::clear()
+{
+    m_loads.clear();
+}
+
+std::vector<std::shared_ptr<LevelLoad>> const& LevelStreamer::get_loads() const
+{
+    return m_loads;
+}
+
+void LevelStreamer::parse(LevelLoad& load)
+{
+    // NOTE: Runs on a worker. Touches only the load, files and caches that lock themselves, the main thread logs errors.
+    ScopeGuard set_parsed = [&] { load.m_is_parsed.store(true, std::memory_order_release); };
+
+    std::string const file_path = SceneSerializer::m_prefab_path + load.m_prefab_name + ".txt";
+    std::optional<std::string> prefab_data = Engine::asset_preloader->get_text_asset(file_path);
+
+    if (!prefab_data.has_value())
+    {
+        std::ifstream prefab_file(file_path);
+
+        if (!prefab_file.is_open())
+        {
+            load.m_has_failed_parsing = true;
+            return;
+        }
+
+        std::stringstream stream;
+        stream << prefab_file.rdbuf();
+        prefab_file.close();
+
+        prefab_data = stream.str();
+    }
+
+    auto const prefab = SceneSerializer::parse_prefab_template(prefab_data.value());
+
+    if (prefab == nullptr)
+    {
+        load.m_has_failed_parsing = true;
+        return;
+    }
+
+    load.m_data = prefab->data;
+    load.m_guid_slots = prefab->guid_slots;
+    load.m_slot_guid_indices = prefab->slot_guid_indices;
+    load.m_guid_count = prefab->guid_count;
+
+    // Preparing the models on the main thread then only creates their meshes and textures
+    std::unordered_set<std::string> model_paths = {};
+
+    for (auto const entity : load.m_data["Entities"])
+    {
+        for (auto const component : entity["Components"])
+        {
+            auto const model_path = component["model_path"];
+
+            if (!model_path || !model_path.IsScalar() || model_path.Scalar().empty() || !model_paths.emplace(model_path.Scalar()).second)
+                continue;
+
+            auto const model = Model::import_model(model_path.Scalar());
+
+            if (model == nullptr)
+                continue;
+
+            for (auto const& mesh : model->meshes)
+            {
+                for (auto const* names : {&mesh.diffuse_textures, &mesh.specular_textures})
+                {
+                    for (auto const& name : *names)
+                    {
+                        std::string const texture_path = model->directory + '/' + name;
+                        TextureLoader::preload_file(texture_path);
+                        load.m_texture_paths.emplace_back(texture_path);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void LevelStreamer::advance(LevelLoad& load, std::function<bool()> const& is_over_budget)
+{
+    if (load.m_stage == LevelLoadStage::Parsing)
+    {
+        if (!load.m_is_parsed.load(std::memory_order_acquire))
+            return;
+
+        if (load.m_has_failed_parsing)
+        {
+            fail(load);
+            return;
+        }
+
+        if (load.m_on_parsed)
+            load.m_on_parsed();
+
+        create_entities(load);
+
+        if (load.m_stage == LevelLoadStage::Failed || is_over_budget())
+            return;
+    }
+
+    // Destroyed while it was loading
+    auto const entity = load.m_entity.lock();
+
+    if (entity == nullptr || entity->m_is_being_destroyed || entity->m_is_queued_for_destruction)
+    {
+        fail(load);
+        return;
+    }
+
+    auto const& components = load.m_serializer->deserialized_pool;
+
+    if (load.m_stage == LevelLoadStage::Preparing)
+    {
+        while (load.m_component_index < load.m_component_count)
+        {
+            components[load.m_component_index]->reprepare();
+            load.m_component_index += 1;
+
+            if (is_over_budget())
+                return;
+        }
+
+        // Only those ResourceManager had already are still there
+        for (auto const& texture_path : load.m_texture_paths)
+        {
+            TextureLoader::discard_preloaded_file(texture_path);
+        }
+
+        load.m_stage = LevelLoadStage::Awaking;
+        load.m_component_index = 0;
+    }
+
+    if (load.m_stage == LevelLoadStage::Awaking)
+    {
+        while (load.m_component_index < load.m_component_count)
+        {
+            auto const& component = components[load.m_component_index];
+            load.m_component_index += 1;
+
+            // Awaken by the scene, if it wasn't running when the level was created
+            if (component->has_been_awaken)
+                continue;
+
+            component->awake();
+            component->has_been_awaken = true;
+
+            if (component->enabled())
+            {
+                component->on_enabled();
+            }
+
+            MainScene::get_instance()->add_component_to_start(component);
+
+            if (is_over_budget())
+                return;
+        }
+
+        load.m_stage = LevelLoadStage::Done;
+    }
+}
+
+void LevelStreamer::create_entities(LevelLoad& load)
+{
+    std::vector<std::string> guids = {};
+    guids.reserve(load.m_guid_count);
+
+    for (u32 i = 0; i < load.m_guid_count; ++i)
+    {
+        guids.emplace_back(AK::generate_guid());
+    }
+
+    for (u32 i = 0; i < load.m_guid_slots.size(); ++i)
+    {
+        load.m_guid_slots[i] = guids[load.m_slot_guid_indices[i]];
+    }
+
+    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    scene_serializer->set_instance(scene_serializer);
+    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
+
+    scene_serializer->m_deserialization_mode = DeserializationMode::StreamFromPrefab;
+
+    load.m_serializer = scene_serializer;
+    load.m_entity = scene_serializer->create_injected_entities(load.m_data);
+
+    load.m_data = {};
+    load.m_guid_slots.clear();
+
+    if (load.m_entity.expired())
+    {
+        fail(load);
+        return;
+    }
+
+    load.m_component_count = static_cast<u32>(scene_serializer->deserialized_pool.size());
+    load.m_stage = LevelLoadStage::Preparing;
+}
+
+void LevelStreamer::fail(LevelLoad& load)
+{
+    Debug::log("Level " + load.m_prefab_name + " could not be loaded or was destroyed while loading.", DebugType::Error);
+
+    load.m_stage = LevelLoadStage::Failed;
+
+    if (load.m_serializer == nullptr)
+        return;
+
+    for (auto const& entity : load.m_serializer->deserialized_entities_pool)
+    {
+        entity->destroy();
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <yaml-cpp/node/node.h>
+
+#include "AK/Types.h"
+
+class Entity;
+class SceneSerializer;
+
+enum class LevelLoadStage
+{
+    Parsing,   // The prefab is parsed and its models and textures are read on a worker
+    Preparing, // Entities and components are in the scene, components are prepared a few every frame
+    Awaking,   // Components are awaken a few every frame
+    Done,
+    Failed,
+};
+
+// Level being streamed in by LevelStreamer
+class LevelLoad
+{
+public:
+    [[nodiscard]] std::string const& get_prefab_name() const;
+    [[nodiscard]] LevelLoadStage get_stage() const;
+
+    // From 0 to 1, parsing doesn't count
+    [[nodiscard]] float get_progress() const;
+
+    [[nodiscard]] bool is_done() const;
+
+    // First entity of the prefab, once the entities were created
+    [[nodiscard]] std::shared_ptr<Entity> get_entity() const;
+
+private:
+    std::string m_prefab_name = {};
+    LevelLoadStage m_stage = LevelLoadStage::Parsing;
+
+    std::function<void()> m_on_parsed = {};
+    std::function<void(std::shared_ptr<Entity> const&)> m_on_loaded = {};
+
+    // Written by the worker, the main thread reads them once m_is_parsed is set
+    std::atomic<bool> m_is_parsed = false;
+    bool m_has_failed_parsing = false;
+    YAML::Node m_data = {};
+    std::vector<YAML::Node> m_guid_slots = {};
+    std::vector<u32> m_slot_guid_indices = {};
+    u32 m_guid_count = 0;
+    std::vector<std::string> m_texture_paths = {};
+
+    std::shared_ptr<SceneSerializer> m_serializer = {};
+    std::weak_ptr<Entity> m_entity = {};
+
+    // Next component to prepare or awake
+    u32 m_component_index = 0;
+    u32 m_component_count = 0;
+
+    friend class LevelStreamer;
+};
+
+// Loads level prefabs without stalling the frame. The prefab file is parsed, its models imported and its texture files
+// read on a worker. All entities and components are then created at once on the main thread, so the level is never
+// half there, and they are prepared and awaken a few at a time, spending at most the frame budget every frame.
+class LevelStreamer
+{
+public:
+    LevelStreamer() = default;
+
+    LevelStreamer(LevelStreamer const&) = delete;
+    void operator=(LevelStreamer const&) = delete;
+
+    // Main thread time in milliseconds spent on loads every frame. Every load makes some progress every frame,
+    // the entities of a level are also always created in one go.
+    void set_frame_budget(double const milliseconds);
+    [[nodiscard]] double get_frame_budget() const;
+
+    // on_parsed is called right before the level's entities are created, ex. to destroy what they replace.
+    // on_loaded is called once the level is awake, or with nullptr when it can't be loaded.
+    std::shared_ptr<LevelLoad> load(std::string const& prefab_name, std::function<void(std::shared_ptr<Entity> const&)> on_loaded = {},
+                                    std::function<void()> on_parsed = {});
+
+    // Called by the scene every frame, once its components were awaken
+    void update();
+
+    // Forgets the loads, entities they created are left in the scene
+    void clear();
+
+    [[nodiscard]] std::vector<std::shared_ptr<LevelLoad>> const& get_loads() const;
+
+private:
+    // Worker side of the load
+    static void parse(LevelLoad& load);
+
+    // Does at least one step of the load, then more while there is time left
+    static void advance(LevelLoad& load, std::function<bool()> const& is_over_budget);
+
+    static void create_entities(LevelLoad& load);
+    static void fail(LevelLoad& load);
+
+    double m_frame_budget = 2.0;
+    std::vector<std::shared_ptr<LevelLoad>> m_loads = {};
+};
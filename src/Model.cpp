@@ -24,14 +24,14 @@
 
 std::shared_ptr<Model> Model::create()
 {
-    auto model = std::make_shared<Model>(AK::Badge<Model> {}, default_material);
+    auto model = AK::make_pooled<Model>(AK::Badge<Model> {}, default_material);
 
     return model;
 }
 
 std::shared_ptr<Model> Model::create(std::string const& model_path, std::shared_ptr<Material> const& material)
 {
-    auto model = std::make_shared<Model>(AK::Badge<Model> {}, model_path, material);
+    auto model = AK::make_pooled<Model>(AK::Badge<Model> {}, model_path, material);
     model->prepare();
 
     return model;
@@ -39,14 +39,14 @@ std::shared_ptr<Model> Model::create(std::string const& model_path, std::shared_
 
 std::shared_ptr<Model> Model::create(std::shared_ptr<Material> const& material)
 {
-    auto model = std::make_shared<Model>(AK::Badge<Model> {}, material);
+    auto model = AK::make_pooled<Model>(AK::Badge<Model> {}, material);
 
     return model;
 }
 
 std::shared_ptr<Model> Model::create(std::shared_ptr<Mesh> mesh, std::shared_ptr<Material> const& material)
 {
-    auto model = std::make_shared<Model>(AK::Badge<Model> {}, material);
+    auto model = AK::make_pooled<Model>(AK::Badge<Model> {}, material);
 
     model->m_meshes.emplace_back(mesh);
 
@@ -164,42 +164,79 @@ void Model::reprepare()
     prepare();
 }
 
-void Model::load_model(std::string const& path)
+std::shared_ptr<ImportedModel const> Model::import_model(std::string const& path)
 {
+    {
+        std::scoped_lock const lock(m_imported_models_mutex);
+
+        if (auto const it = m_imported_models.find(path); it != m_imported_models.end())
+            return it->second;
+    }
+
     Assimp::Importer importer;
     aiScene const* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
 
     if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || scene->mRootNode == nullptr)
     {
         std::cout << "Error. Failed loading a model: " << importer.GetErrorString() << "\n";
-        return;
+        return nullptr;
     }
 
+    auto model = std::make_shared<ImportedModel>();
+
     std::filesystem::path const filesystem_path = path;
-    m_directory = filesystem_path.parent_path().string();
+    model->directory = filesystem_path.parent_path().string();
 
-    proccess_node(scene->mRootNode, scene);
+    proccess_node(scene->mRootNode, scene, *model);
+
+    // Imported by another thread in the meantime, the first one is kept
+    std::scoped_lock const lock(m_imported_models_mutex);
+    return m_imported_models.emplace(path, std::move(model)).first->second;
 }
 
-void Model::proccess_node(aiNode const* node, aiScene const* scene)
+void Model::load_model(std::string const& path)
+{
+    auto const model = import_model(path);
+
+    if (model == nullptr)
+        return;
+
+    m_directory = model->directory;
+
+    for (auto const& mesh : model->meshes)
+    {
+        std::vector<std::shared_ptr<Texture>> textures;
+
+        std::vector<std::shared_ptr<Texture>> diffuse_maps = load_material_textures(mesh.diffuse_textures, TextureType::Diffuse);
+        textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
+
+        std::vector<std::shared_ptr<Texture>> specular_maps = load_material_textures(mesh.specular_textures, TextureType::Specular);
+        textures.insert(textures.end(), specular_maps.begin(), specular_maps.end());
+
+        m_meshes.emplace_back(ResourceManager::get_instance().load_mesh(m_meshes.size(), model_path, mesh.vertices, mesh.indices, textures,
+                                                                        m_draw_type, material));
+    }
+}
+
+void Model::proccess_node(aiNode const* node, aiScene const* scene, ImportedModel& model)
 {
     for (u32 i = 0; i < node->mNumMeshes; ++i)
     {
         aiMesh const* mesh = scene->mMeshes[node->mMeshes[i]];
-        m_meshes.emplace_back(proccess_mesh(mesh, scene));
+        model.meshes.emplace_back(proccess_mesh(mesh, scene));
     }
 
     for (u32 i = 0; i < node->mNumChildren; ++i)
     {
-        proccess_node(node->mChildren[i], scene);
+        proccess_node(node->mChildren[i], scene, model);
     }
 }
 
-std::shared_ptr<Mesh> Model::proccess_mesh(aiMesh const* mesh, aiScene const* scene)
+ImportedMesh Model::proccess_mesh(aiMesh const* mesh, aiScene const* scene)
 {
-    std::vector<Vertex> vertices;
-    std::vector<u32> indices;
-    std::vector<std::shared_ptr<Texture>> textures;
+    ImportedMesh imported_mesh = {};
+    std::vector<Vertex>& vertices = imported_mesh.vertices;
+    std::vector<u32>& indices = imported_mesh.indices;
 
     for (u32 i = 0; i < mesh->mNumVertices; ++i)
     {
@@ -235,32 +272,36 @@ std::shared_ptr<Mesh> Model::proccess_mesh(aiMesh const* mesh, aiScene const* sc
 
     aiMaterial const* assimp_material = scene->mMaterials[mesh->mMaterialIndex];
 
-    std::vector<std::shared_ptr<Texture>> diffuse_maps =
-        load_material_textures(assimp_material, aiTextureType_DIFFUSE, TextureType::Diffuse);
-    textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
+    auto const texture_names = [&](aiTextureType const type) {
+        std::vector<std::string> names;
+
+        u32 const material_count = assimp_material->GetTextureCount(type);
+        for (u32 i = 0; i < material_count; ++i)
+        {
+            aiString str;
+            assimp_material->GetTexture(type, i, &str);
+            names.emplace_back(str.C_Str());
+        }
+
+        return names;
+    };
 
-    std::vector<std::shared_ptr<Texture>> specular_maps =
-        load_material_textures(assimp_material, aiTextureType_SPECULAR, TextureType::Specular);
-    textures.insert(textures.end(), specular_maps.begin(), specular_maps.end());
+    imported_mesh.diffuse_textures = texture_names(aiTextureType_DIFFUSE);
+    imported_mesh.specular_textures = texture_names(aiTextureType_SPECULAR);
 
-    return ResourceManager::get_instance().load_mesh(m_meshes.size(), model_path, vertices, indices, textures, m_draw_type, material);
+    return imported_mesh;
 }
 
-std::vector<std::shared_ptr<Texture>> Model::load_material_textures(aiMaterial const* material, aiTextureType const type,
-                                                                    TextureType const type_name)
+std::vector<std::shared_ptr<Texture>> Model::load_material_textures(std::vector<std::string> const& names, TextureType const type_name)
 {
     std::vector<std::shared_ptr<Texture>> textures;
 
-    u32 const material_count = material->GetTextureCount(type);
-    for (u32 i = 0; i < material_count; ++i)
+    for (auto const& name : names)
     {
-        aiString str;
-        material->GetTexture(type, i, &str);
-
         bool is_already_loaded = false;
         for (auto const& loaded_texture : m_loaded_textures)
         {
-            if (std::strcmp(loaded_texture->path.data(), str.C_Str()) == 0)
+            if (loaded_texture->path == name)
             {
                 textures.push_back(loaded_texture);
                 is_already_loaded = true;
@@ -271,8 +312,7 @@ std::vector<std::shared_ptr<Texture>> Model::load_material_textures(aiMaterial c
         if (is_already_loaded)
             continue;
 
-        auto file_path = std::string(str.C_Str());
-        file_path = m_directory + '/' + file_path;
+        auto const file_path = m_directory + '/' + name;
 
         TextureSettings settings = {};
         settings.flip_vertically = false;
@@ -1,18 +1,35 @@
 #pragma once
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
-#include <assimp/material.h>
-
 #include "AK/Badge.h"
 #include "Mesh.h"
 #include "Texture.h"
+#include "Vertex.h"
 
-struct aiMaterial;
 struct aiMesh;
 struct aiScene;
 struct aiNode;
 
+// Mesh of a model file as Assimp read it, nothing of it is on the GPU yet
+struct ImportedMesh
+{
+    std::vector<Vertex> vertices = {};
+    std::vector<u32> indices = {};
+
+    // Relative to the directory of the model
+    std::vector<std::string> diffuse_textures = {};
+    std::vector<std::string> specular_textures = {};
+};
+
+struct ImportedModel
+{
+    std::string directory = {};
+    std::vector<ImportedMesh> meshes = {};
+};
+
 class Model : public Drawable
 {
 public:
@@ -40,6 +57,10 @@ public:
     virtual void adjust_bounding_box() override;
     virtual BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const override;
 
+    // Reads the model file with Assimp, unless it was read already. Can be called from any thread,
+    // level streaming imports the models of a level on a worker.
+    static std::shared_ptr<ImportedModel const> import_model(std::string const& path);
+
     std::string model_path = "";
 
 protected:
@@ -50,11 +71,14 @@ protected:
 
 private:
     void load_model(std::string const& path);
-    void proccess_node(aiNode const* node, aiScene const* scene);
-    std::shared_ptr<Mesh> proccess_mesh(aiMesh const* mesh, aiScene const* scene);
-    std::vector<std::shared_ptr<Texture>> load_material_textures(aiMaterial const* material, aiTextureType type,
-                                                                 TextureType const type_name);
+    static void proccess_node(aiNode const* node, aiScene const* scene, ImportedModel& model);
+    static ImportedMesh proccess_mesh(aiMesh const* mesh, aiScene const* scene);
+    std::vector<std::shared_ptr<Texture>> load_material_textures(std::vector<std::string> const& names, TextureType const type_name);
 
     std::string m_directory;
     std::vector<std::shared_ptr<Texture>> m_loaded_textures;
+
+    // Models are imported once, like ResourceManager never unloads the meshes created from them
+    inline static std::mutex m_imported_models_mutex = {};
+    inline static std::unordered_map<std::string, std::shared_ptr<ImportedModel const>> m_imported_models = {};
 };
@@ -8,7 +8,7 @@
 
 std::shared_ptr<NowPromptTrigger> NowPromptTrigger::create()
 {
-    return std::make_shared<NowPromptTrigger>(AK::Badge<NowPromptTrigger> {});
+    return AK::make_pooled<NowPromptTrigger>(AK::Badge<NowPromptTrigger> {});
 }
 
 NowPromptTrigger::NowPromptTrigger(AK::Badge<NowPromptTrigger>)
@@ -47,6 +47,6 @@ void NowPromptTrigger::update()
     {
         m_entered_triger = false;
         if (!m_story_now_prompt.expired())
-            m_story_now_prompt.lock()->destroy_immediate();
+            m_story_now_prompt.lock()->destroy();
     }
 }
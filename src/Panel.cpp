@@ -13,7 +13,7 @@ std::shared_ptr<Panel> Panel::create()
     auto const ui_material = Material::create(ui_shader, Renderer::ui_render_order + 1);
     ui_material->casts_shadows = false;
 
-    auto panel = std::make_shared<Panel>(AK::Badge<Panel> {}, ui_material);
+    auto panel = AK::make_pooled<Panel>(AK::Badge<Panel> {}, ui_material);
 
     panel->prepare();
 
@@ -23,7 +23,7 @@ std::shared_ptr<Particle> Particle::create()
     particle_material->casts_shadows = false;
     particle_material->needs_forward_rendering = true;
 
-    auto particle = std::make_shared<Particle>(AK::Badge<Particle> {}, 1.0f, "./res/textures/particle.png", particle_material, true);
+    auto particle = AK::make_pooled<Particle>(AK::Badge<Particle> {}, 1.0f, "./res/textures/particle.png", particle_material, true);
 
     particle->prepare();
 
@@ -38,7 +38,7 @@ std::shared_ptr<Particle> Particle::create(ParticleSpawnData const& data, float
     particle_material->casts_shadows = false;
     particle_material->needs_forward_rendering = true;
 
-    auto particle = std::make_shared<Particle>(AK::Badge<Particle> {}, spawn_bounds, sprite_path, particle_material, rotate_particle);
+    auto particle = AK::make_pooled<Particle>(AK::Badge<Particle> {}, spawn_bounds, sprite_path, particle_material, rotate_particle);
 
     particle->prepare();
     particle->set_data(data);
@@ -52,7 +52,7 @@ std::shared_ptr<Particle> Particle::create(ParticleSpawnData const& data, float
     auto const particle_material = Material::create(shader, 1000, false, false, true);
     particle_material->casts_shadows = false;
     particle_material->needs_forward_rendering = true;
-    auto particle = std::make_shared<Particle>(AK::Badge<Particle> {}, spawn_bounds, sprite_path, particle_material, rotate_particle);
+    auto particle = AK::make_pooled<Particle>(AK::Badge<Particle> {}, spawn_bounds, sprite_path, particle_material, rotate_particle);
 
     particle->prepare();
     particle->set_data(data);
@@ -178,11 +178,11 @@ bool Particle::update_lifetime()
     {
         if (!entity->transform->parent.expired())
         {
-            entity->transform->parent.lock()->entity.lock()->destroy_immediate();
+            entity->transform->parent.lock()->entity.lock()->destroy();
         }
         else if (entity != nullptr)
         {
-            entity->destroy_immediate();
+            entity->destroy();
         }
 
         return true;
@@ -205,6 +205,17 @@ void Particle::update()
     update_particle();
 }
 
+void Particle::update_all(std::span<Particle* const> const particles)
+{
+    for (auto const particle : particles)
+    {
+        if (particle->entity == nullptr || !particle->enabled())
+            continue;
+
+        particle->update();
+    }
+}
+
 void Particle::move() const
 {
     glm::vec3 new_position;
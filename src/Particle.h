@@ -4,6 +4,8 @@
 #include "GBuffer.h"
 #include "ParticleSystem.h"
 
+#include <span>
+
 class Mesh;
 
 NON_SERIALIZED
@@ -20,6 +22,9 @@ public:
 
     virtual void awake() override;
     virtual void update() override;
+
+    // Non-virtual updates one after another, particles can destroy other particles' entities
+    static void update_all(std::span<Particle* const> const particles);
     virtual bool is_particle() const override;
     virtual void draw() const override;
 
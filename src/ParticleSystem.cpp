@@ -18,7 +18,7 @@
 
 std::shared_ptr<ParticleSystem> ParticleSystem::create()
 {
-    auto particle_system = std::make_shared<ParticleSystem>(AK::Badge<ParticleSystem> {});
+    auto particle_system = AK::make_pooled<ParticleSystem>(AK::Badge<ParticleSystem> {});
     return particle_system;
 }
 
@@ -33,6 +33,16 @@ void ParticleSystem::awake()
     set_can_tick(true);
 }
 
+void ParticleSystem::reprepare()
+{
+    Component::reprepare();
+
+    m_spawn_data_vector.clear();
+    m_random_spawn_count = 0;
+    m_time_counter = 0.0;
+    m_first_time_spawning = true;
+}
+
 #if EDITOR
 void ParticleSystem::draw_editor()
 {
@@ -119,7 +129,7 @@ void ParticleSystem::update_system()
         }
 
         if (play_once && m_spawn_data_vector.empty())
-            entity->destroy_immediate();
+            entity->destroy();
     }
     m_time_counter += delta_time;
 }
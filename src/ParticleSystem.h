@@ -37,6 +37,9 @@ public:
 
     virtual void awake() override;
 
+    // Starts spawning from the beginning, with the new values
+    virtual void reprepare() override;
+
 #if EDITOR
     virtual void draw_editor() override;
 #endif
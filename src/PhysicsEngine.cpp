@@ -1,11 +1,18 @@
 #include "PhysicsEngine.h"
 
 #include "AK/AK.h"
+#include "AK/JobSystem.h"
 #include "AK/Math.h"
 #include "Debug.h"
 #include "Engine.h"
 #include "Entity.h"
+#include "GJK.h"
 #include "Globals.h"
+#include "Rigidbody2D.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 
 void PhysicsEngine::initialize()
 {
@@ -18,26 +25,155 @@ void PhysicsEngine::run_updates()
 {
     m_accumulated_delta += delta_time;
 
-    i32 const iterations = static_cast<i32>(m_accumulated_delta / fixed_delta_time);
+    u32 iterations = static_cast<u32>(m_accumulated_delta / fixed_delta_time);
+
+    if (iterations > m_max_substeps)
+    {
+        u32 const kept_steps = m_should_carry_leftover_time ? m_max_substeps + m_max_carried_steps : m_max_substeps;
+
+        if (iterations > kept_steps)
+        {
+            // Whole steps over the limit are lost, only the part of a step that is left stays for interpolation
+            m_dropped_steps += iterations - kept_steps;
+            m_accumulated_delta -= fixed_delta_time * (iterations - kept_steps);
+        }
+
+        iterations = m_max_substeps;
+    }
 
     m_accumulated_delta -= fixed_delta_time * iterations;
 
-    for (i32 i = iterations; i > 0; i--)
+    for (u32 i = iterations; i > 0; i--)
     {
         update_physics();
     }
+
+    // Resolving collisions and the last step's callbacks move colliders after the step refit the tree, queries made
+    // until the next frame only traverse it
+    update_tree();
+
+    m_stats.substeps = iterations;
+    m_stats.dropped_steps = m_dropped_steps;
+}
+
+void PhysicsEngine::set_max_substeps(u32 const max_substeps)
+{
+    m_max_substeps = std::max(max_substeps, 1u);
+}
+
+u32 PhysicsEngine::get_max_substeps() const
+{
+    return m_max_substeps;
 }
 
-void PhysicsEngine::update_physics() const
+void PhysicsEngine::set_carry_leftover_time(bool const should_carry)
+{
+    m_should_carry_leftover_time = should_carry;
+}
+
+bool PhysicsEngine::get_carry_leftover_time() const
+{
+    return m_should_carry_leftover_time;
+}
+
+void PhysicsEngine::set_max_carried_steps(u32 const max_carried_steps)
+{
+    m_max_carried_steps = max_carried_steps;
+}
+
+u32 PhysicsEngine::get_max_carried_steps() const
+{
+    return m_max_carried_steps;
+}
+
+void PhysicsEngine::interpolate_poses()
+{
+    assert(m_interpolated_colliders.empty());
+
+    if (!m_is_interpolation_enabled)
+        return;
+
+    float const alpha = get_interpolation_alpha();
+
+    for (u32 i = 0; i < colliders.size(); ++i)
+    {
+        auto const& collider = colliders[i];
+
+        if (collider->is_static || collider->m_is_asleep)
+            continue;
+
+        // Moved by gameplay code after the step, that position wins
+        if (collider->entity->transform->get_version() != collider->m_pose_version)
+            continue;
+
+        if (collider->m_previous_local_position == collider->m_current_local_position)
+            continue;
+
+        collider->entity->transform->set_local_position(
+            glm::mix(collider->m_previous_local_position, collider->m_current_local_position, alpha));
+        m_interpolated_colliders.emplace_back(i);
+    }
+}
+
+void PhysicsEngine::restore_poses()
+{
+    for (u32 const index : m_interpolated_colliders)
+    {
+        auto const& collider = colliders[index];
+        collider->entity->transform->set_local_position(collider->m_current_local_position);
+        collider->m_pose_version = collider->entity->transform->get_version();
+    }
+
+    m_interpolated_colliders.clear();
+}
+
+void PhysicsEngine::set_interpolation_enabled(bool const is_enabled)
+{
+    m_is_interpolation_enabled = is_enabled;
+}
+
+bool PhysicsEngine::is_interpolation_enabled() const
+{
+    return m_is_interpolation_enabled;
+}
+
+float PhysicsEngine::get_interpolation_alpha() const
+{
+    return std::clamp(static_cast<float>(m_accumulated_delta / fixed_delta_time), 0.0f, 1.0f);
+}
+
+void PhysicsEngine::update_physics()
 {
     MainScene::get_instance()->run_physics_frame();
 
+    snap_moved_poses();
+    wake_moved_colliders();
+
+    // Continuous circles test against the colliders as they were at the start of the step
+    update_tree();
+
     for (auto const& collider : colliders)
     {
-        collider->physics_update();
+        if (collider->m_is_asleep || !collider->entity->is_active())
+            continue;
+
+        // Moved by solve_contacts() once its contacts are resolved
+        if (collider->m_rigidbody != nullptr && !collider->is_static)
+            continue;
+
+        if (is_swept(*collider))
+        {
+            integrate_continuous(*collider);
+        }
+        else
+        {
+            collider->physics_update();
+        }
     }
 
     solve_collisions();
+    update_sleep();
+    record_poses();
 }
 
 void PhysicsEngine::on_collision_enter(std::shared_ptr<Collider2D> const& collider, std::shared_ptr<Collider2D> const& other)
@@ -86,338 +222,1210 @@ void PhysicsEngine::on_trigger_exit(std::shared_ptr<Collider2D> const& collider,
 
 bool PhysicsEngine::is_collider_registered(std::shared_ptr<Collider2D> const& collider) const
 {
-    return std::ranges::find(colliders.begin(), colliders.end(), collider) != colliders.end();
+    return collider->m_physics_index < colliders.size() && colliders[collider->m_physics_index] == collider;
 }
 
 void PhysicsEngine::emplace_collider(std::shared_ptr<Collider2D> const& collider)
 {
+    collider->m_physics_index = static_cast<u32>(colliders.size());
+    collider->m_handle = acquire_handle(collider);
+    collider->m_bounds_changed = true;
+    collider->wake_up();
     colliders.emplace_back(collider);
+    m_store.push_back();
+    m_colliders_changed = true;
+
+    // Proxy is created in update_tree(), the collider might not have valid bounds yet
 }
 
 void PhysicsEngine::remove_collider(std::shared_ptr<Collider2D> const& collider)
 {
-    AK::swap_and_erase(colliders, collider);
-}
+    if (!is_collider_registered(collider))
+        return;
 
-bool PhysicsEngine::compute_penetration(std::shared_ptr<Collider2D> const& collider, std::shared_ptr<Collider2D> const& other,
-                                        glm::vec2& mtv)
-{
-    assert(collider != nullptr);
-    assert(other != nullptr);
+    // Indices of the interpolated colliders would point to other colliders
+    assert(m_interpolated_colliders.empty());
+
+    // Removing would swap another collider into the index of a pair that is being resolved
+    assert(!m_is_resolving_pairs);
 
-    if (collider->collider_type == ColliderType2D::Circle && other->collider_type == ColliderType2D::Circle)
+    u32 const index = collider->m_physics_index;
+
+    if (collider->m_tree_proxy != DynamicAABBTree::null_node)
     {
-        return test_collision_circle_circle(*collider, *other, mtv);
+        m_tree.destroy_proxy(collider->m_tree_proxy);
+        collider->m_tree_proxy = DynamicAABBTree::null_node;
     }
 
-    if (collider->collider_type == ColliderType2D::Rectangle && other->collider_type == ColliderType2D::Rectangle)
+    collider->m_physics_index = std::numeric_limits<u32>::max();
+    release_handle(collider->m_handle);
+
+    // Swap with the last collider, tree user data is the index so it has to follow
+    if (index != colliders.size() - 1)
     {
-        return test_collision_rectangle_rectangle(*collider, *other, mtv);
+        std::shared_ptr<Collider2D> const& last = colliders.back();
+        last->m_physics_index = index;
+
+        if (last->m_tree_proxy != DynamicAABBTree::null_node)
+            m_tree.set_user_data(last->m_tree_proxy, index);
+
+        colliders[index] = last;
     }
 
-    if (collider->collider_type == ColliderType2D::Circle && other->collider_type == ColliderType2D::Rectangle)
+    colliders.pop_back();
+    m_store.swap_remove(index);
+    m_colliders_changed = true;
+}
+
+void PhysicsEngine::set_broadphase_type(BroadphaseType const type)
+{
+    m_broadphase.set_type(type);
+}
+
+BroadphaseType PhysicsEngine::get_broadphase_type() const
+{
+    return m_broadphase.get_type();
+}
+
+void PhysicsEngine::set_narrowphase_multithreaded(bool const is_multithreaded)
+{
+    m_is_narrowphase_multithreaded = is_multithreaded && !PHYSICS_SINGLE_THREADED;
+}
+
+bool PhysicsEngine::is_narrowphase_multithreaded() const
+{
+    return m_is_narrowphase_multithreaded;
+}
+
+NarrowphaseBenchmark PhysicsEngine::benchmark_narrowphase(u32 const iterations) const
+{
+    return CollisionKernels::benchmark(m_store, m_pairs, iterations);
+}
+
+void PhysicsEngine::set_layers_collide(u32 const first_layer, u32 const second_layer, bool const should_collide)
+{
+    assert(first_layer < collision_layer_count && second_layer < collision_layer_count);
+
+    if (should_collide)
     {
-        return test_collision_circle_rectangle(*collider, *other, mtv);
+        m_layer_collision_matrix[first_layer] |= 1u << second_layer;
+        m_layer_collision_matrix[second_layer] |= 1u << first_layer;
     }
-
-    if (collider->collider_type == ColliderType2D::Rectangle && other->collider_type == ColliderType2D::Circle)
+    else
     {
-        bool const overlapped = test_collision_circle_rectangle(*other, *collider, mtv);
-        mtv = -mtv;
-        return overlapped;
+        m_layer_collision_matrix[first_layer] &= ~(1u << second_layer);
+        m_layer_collision_matrix[second_layer] &= ~(1u << first_layer);
     }
+}
+
+bool PhysicsEngine::do_layers_collide(u32 const first_layer, u32 const second_layer) const
+{
+    assert(first_layer < collision_layer_count && second_layer < collision_layer_count);
 
-    return false;
+    return (m_layer_collision_matrix[first_layer] & (1u << second_layer)) != 0;
 }
 
-void PhysicsEngine::solve_collisions() const
+bool PhysicsEngine::should_collide(Collider2D const& first, Collider2D const& second) const
 {
-    // Collision detection
-    for (u32 i = 0; i < colliders.size(); i++)
-    {
-        for (u32 j = 0; j < colliders.size(); j++)
-        {
-            if (i == j || (colliders[i]->is_static && colliders[j]->is_static))
-                continue;
+    if (!do_layers_collide(first.collision_layer, second.collision_layer))
+        return false;
 
-            std::shared_ptr<Collider2D> collider1 = colliders[i];
-            std::shared_ptr<Collider2D> collider2 = colliders[j];
+    return (first.collision_mask & (1u << second.collision_layer)) != 0 && (second.collision_mask & (1u << first.collision_layer)) != 0;
+}
 
-            bool const should_overlap_as_trigger = collider1->is_trigger || collider2->is_trigger;
+void PhysicsEngine::set_broadphase_bounds(glm::vec2 const& min, glm::vec2 const& max)
+{
+    m_broadphase.set_grid_bounds(min, max);
+}
 
-            glm::vec2 mtv = {};
+PhysicsStats const& PhysicsEngine::get_stats() const
+{
+    return m_stats;
+}
 
-            if (!compute_penetration(collider1, collider2, mtv))
-            {
-                continue;
-            }
+std::optional<RaycastHit2D> PhysicsEngine::raycast(glm::vec2 const& origin, glm::vec2 const& direction, float const max_distance,
+                                                   ColliderFilter const& filter) const
+{
+    if (AK::Math::are_nearly_equal(glm::dot(direction, direction), 0.0f, 0.000001f))
+        return std::nullopt;
 
-            if (should_overlap_as_trigger)
-            {
-                collider1->add_overlapped_this_frame(collider2);
+    glm::vec2 const normalized_direction = glm::normalize(direction);
+    std::optional<RaycastHit2D> closest_hit = std::nullopt;
 
-#if _DEBUG
-                if (collider1->is_inside_trigger(collider2->guid))
-                {
-                    if (!collider2->is_inside_trigger(collider1->guid))
-                    {
-                        Debug::log("Colllider2 does not have collider1 inside trigger, but the opposite is true", DebugType::Error);
-                    }
-                }
-                else
-                {
-                    if (collider2->is_inside_trigger(collider1->guid))
-                    {
-                        Debug::log("Colllider1 does not have collider2 inside trigger, but the opposite is true", DebugType::Error);
-                    }
-                }
-#endif
+    m_tree.raycast(origin, normalized_direction, max_distance, [&](u32 const index, float const current_max_distance) {
+        auto const& collider = colliders[index];
+
+        if (!collider->entity->is_active() || (filter != nullptr && !filter(collider)))
+            return current_max_distance;
+
+        RaycastHit2D hit = {};
+        if (!raycast_collider(*collider, origin, normalized_direction, current_max_distance, hit))
+            return current_max_distance;
+
+        hit.collider = collider;
+        closest_hit = hit;
+
+        // Only look for hits closer than this one, a hit at the origin stops the query
+        return hit.distance;
+    });
+
+    return closest_hit;
+}
+
+void PhysicsEngine::overlap_circle(glm::vec2 const& center, float const radius, std::vector<std::shared_ptr<Collider2D>>& result,
+                                   ColliderFilter const& filter) const
+{
+    BoundingBox2D const bounds = {center - radius, center + radius};
+
+    m_tree.query(bounds, [&](u32 const index) {
+        auto const& collider = colliders[index];
+
+        if (!collider->entity->is_active() || !bounds.overlaps(collider->m_bounds))
+            return true;
+
+        if (collider->collider_type == ColliderType2D::Capsule || collider->collider_type == ColliderType2D::Polygon)
+        {
+            ConvexShape2D circle = {};
+            circle.points[0] = center;
+            circle.count = 1;
+            circle.radius = radius;
+
+            if (!GJK::are_overlapping(circle, collider->m_shape))
+                return true;
+        }
+        else
+        {
+            glm::vec2 closest_point = collider->m_center;
+            float radius_sum = radius;
+
+            if (collider->collider_type == ColliderType2D::Circle)
+            {
+                radius_sum += collider->radius;
             }
             else
             {
-                on_collision_enter(collider1, collider2);
-                on_collision_enter(collider2, collider1);
+                closest_point = get_closest_point_on_obb(center, collider->m_center, collider->m_axes,
+                                                         {collider->width * 0.5f, collider->height * 0.5f});
+            }
 
-                if (!collider1->is_static && !collider2->is_static)
-                {
-                    collider1->apply_mtv(mtv);
-                    collider2->apply_mtv(-mtv);
-                }
-                else if (collider1->is_static)
-                {
-                    collider2->apply_mtv(-mtv);
-                }
-                else if (collider2->is_static)
-                {
-                    collider1->apply_mtv(mtv);
-                }
+            if (glm::dot(center - closest_point, center - closest_point) > radius_sum * radius_sum)
+                return true;
+        }
 
-                on_collision_exit(collider1, collider2);
-                on_collision_exit(collider2, collider1);
+        if (filter == nullptr || filter(collider))
+            result.emplace_back(collider);
+
+        return true;
+    });
+}
+
+void PhysicsEngine::overlap_obb(glm::vec2 const& center, glm::vec2 const& half_extents, float const angle,
+                                std::vector<std::shared_ptr<Collider2D>>& result, ColliderFilter const& filter) const
+{
+    std::array const axes = {glm::vec2(std::cos(angle), std::sin(angle)), glm::vec2(-std::sin(angle), std::cos(angle))};
+    glm::vec2 const extent_x = axes[0] * half_extents.x;
+    glm::vec2 const extent_y = axes[1] * half_extents.y;
+    std::array const corners = {center - extent_x - extent_y, center + extent_x - extent_y, center + extent_x + extent_y,
+                                center - extent_x + extent_y};
+
+    glm::vec2 const bounds_extents = glm::abs(extent_x) + glm::abs(extent_y);
+    BoundingBox2D const bounds = {center - bounds_extents, center + bounds_extents};
+
+    m_tree.query(bounds, [&](u32 const index) {
+        auto const& collider = colliders[index];
+
+        if (!collider->entity->is_active() || !bounds.overlaps(collider->m_bounds))
+            return true;
+
+        if (collider->collider_type == ColliderType2D::Circle)
+        {
+            glm::vec2 const closest_point = get_closest_point_on_obb(collider->m_center, center, axes, half_extents);
+            glm::vec2 const offset = collider->m_center - closest_point;
+
+            if (glm::dot(offset, offset) > collider->radius * collider->radius)
+                return true;
+        }
+        else if (collider->collider_type == ColliderType2D::Capsule || collider->collider_type == ColliderType2D::Polygon)
+        {
+            ConvexShape2D box = {};
+            std::ranges::copy(corners, box.points.begin());
+            box.count = 4;
+
+            if (!GJK::are_overlapping(box, collider->m_shape))
+                return true;
+        }
+        else
+        {
+            // Separating axis test, the box's own axes and the collider's axes are the only candidates
+            for (auto const& axis : {axes[0], axes[1], collider->m_axes[0], collider->m_axes[1]})
+            {
+                if (!AK::Math::are_ranges_overlapping(AK::Math::project_on_axis(corners, axis),
+                                                      AK::Math::project_on_axis(collider->m_corners, axis)))
+                    return true;
             }
         }
+
+        if (filter == nullptr || filter(collider))
+            result.emplace_back(collider);
+
+        return true;
+    });
+}
+
+std::shared_ptr<Collider2D> PhysicsEngine::query_nearest(glm::vec2 const& point, ColliderFilter const& filter) const
+{
+    u32 nearest_index = 0;
+
+    // Center is always inside the collider's bounds, so its distance is a valid bound for the tree
+    bool const found = m_tree.query_nearest(
+        point,
+        [&](u32 const index) {
+            auto const& collider = colliders[index];
+
+            if (!collider->entity->is_active() || (filter != nullptr && !filter(collider)))
+                return std::numeric_limits<float>::infinity();
+
+            return glm::distance(point, collider->m_center);
+        },
+        nearest_index);
+
+    if (!found)
+        return nullptr;
+
+    return colliders[nearest_index];
+}
+
+void PhysicsEngine::update_tree()
+{
+    for (u32 i = 0; i < colliders.size(); ++i)
+    {
+        auto const& collider = colliders[i];
+
+        collider->update_center_and_corners_if_needed();
+
+        if (collider->m_tree_proxy == DynamicAABBTree::null_node)
+        {
+            collider->m_tree_proxy = m_tree.create_proxy(collider->m_bounds, i);
+        }
+        else if (collider->m_bounds_changed)
+        {
+            m_tree.move_proxy(collider->m_tree_proxy, collider->m_bounds);
+        }
+
+        collider->m_bounds_changed = false;
     }
+}
+
+void PhysicsEngine::solve_collisions()
+{
+    update_tree();
+
+    m_proxies.clear();
 
     for (auto const& collider : colliders)
     {
-        std::unordered_map<std::string, std::weak_ptr<Collider2D>> new_inside_trigger = {};
-        std::vector<std::weak_ptr<Collider2D>> new_inside_trigger_vector = {};
+        m_proxies.emplace_back(collider->get_bounds(), collider->is_static);
+    }
+
+    // Broadphase, gives every unordered pair with overlapping bounds once, static-static pairs are already skipped
+    m_broadphase.find_pairs(m_proxies, m_tree, m_pairs);
+
+    m_stats = {};
+    m_stats.colliders = static_cast<u32>(colliders.size());
+    m_stats.candidate_pairs = static_cast<u32>(m_pairs.size());
 
-        for (auto const& other : collider->get_all_overlapping_this_frame())
+    m_stats.tree_height = m_tree.get_height();
+    m_island_pairs.clear();
+    m_solver.clear();
+
+    // Layer and sleep filtering keeps the order of the remaining pairs
+    auto const rejected = std::ranges::remove_if(m_pairs, [this](ColliderPair const& pair) {
+        Collider2D const& first = *colliders[pair.first];
+        Collider2D const& second = *colliders[pair.second];
+
+        // Parked in a prefab pool or queued for destruction, their overlaps end as if they were removed
+        if (!first.entity->is_active() || !second.entity->is_active())
+            return true;
+
+        if (!should_collide(first, second))
         {
-            if (other.expired())
-                continue;
+            m_stats.layer_rejected_pairs += 1;
+            return true;
+        }
 
-            auto const other_locked = other.lock();
+        if (first.m_is_asleep && second.m_is_asleep)
+        {
+            m_stats.sleeping_pairs += 1;
 
-            new_inside_trigger.emplace(other_locked->guid, other);
-            new_inside_trigger_vector.emplace_back(other);
+            if (first.is_trigger || second.is_trigger)
+                keep_sleeping_trigger_pair(first, second);
+            else if (!first.is_static && !second.is_static)
+                m_island_pairs.emplace_back(pair);
 
-            if (!collider->is_inside_trigger(other_locked->guid))
-            {
-                on_trigger_enter(collider, other_locked);
-            }
+            return true;
         }
 
-        for (auto const& other : collider->get_inside_trigger_vector())
+        return false;
+    });
+    m_pairs.erase(rejected.begin(), rejected.end());
+
+    for (u32 i = 0; i < colliders.size(); ++i)
+    {
+        m_store.write(i, *colliders[i], colliders[i]->m_center);
+    }
+
+    // Collision detection, every pair is tested up front by the batched kernels, possibly as jobs on the worker threads.
+    // Everything below runs on the main thread in pair order, which keeps callbacks and resolution deterministic.
+    AK::JobSystem* const jobs = m_is_narrowphase_multithreaded ? AK::JobSystem::get_instance().get() : nullptr;
+    m_stats.narrowphase_threads = jobs != nullptr ? jobs->get_thread_count() : 1;
+
+    auto const kernels_start = std::chrono::high_resolution_clock::now();
+    m_kernels.run(m_store, m_pairs, m_narrowphase_results, jobs);
+    std::chrono::duration<double> const kernels_time = std::chrono::high_resolution_clock::now() - kernels_start;
+
+    if (kernels_time.count() > 0.0)
+        m_stats.narrowphase_pairs_per_second = static_cast<double>(m_pairs.size()) / kernels_time.count();
+
+    m_stats.convex_pairs = m_kernels.get_convex_pair_count();
+    m_stats.axis_early_outs = m_kernels.get_axis_early_out_count();
+
+    m_colliders_changed = false;
+    m_is_resolving_pairs = true;
+
+    for (u32 i = 0; i < m_pairs.size(); ++i)
+    {
+        auto const [first, second] = m_pairs[i];
+
+        std::shared_ptr<Collider2D> collider1 = colliders[first];
+        std::shared_ptr<Collider2D> collider2 = colliders[second];
+
+        // Callbacks of the previous pairs might have destroyed them
+        if (!collider1->entity->is_active() || !collider2->entity->is_active())
+            continue;
+
+        bool const should_overlap_as_trigger = collider1->is_trigger || collider2->is_trigger;
+
+        NarrowphaseResult result = m_narrowphase_results[i];
+
+        // MTVs and callbacks of the previous pairs might have moved these colliders, test them again as they are now
+        if (m_colliders_changed || is_store_row_stale(first) || is_store_row_stale(second))
         {
-            if (other.expired())
-                continue;
+            refresh_store_row(first);
+            refresh_store_row(second);
+
+            result = {};
+            result.is_overlapping = CollisionKernels::compute_penetration(m_store, first, second, result.mtv);
+        }
+
+        if (!result.is_overlapping)
+        {
+            continue;
+        }
+
+        glm::vec2 const mtv = result.mtv;
+
+        m_stats.overlapping_pairs += 1;
+
+        if (should_overlap_as_trigger)
+        {
+            if (collider1->m_handle.slot < collider2->m_handle.slot)
+                m_trigger_pairs.emplace_back(collider1->m_handle, collider2->m_handle);
+            else
+                m_trigger_pairs.emplace_back(collider2->m_handle, collider1->m_handle);
+        }
+        else
+        {
+            // Pair is tested only if one of the colliders is awake, the other one has to wake up to be pushed out
+            collider1->wake_up();
+            collider2->wake_up();
 
-            auto const other_locked = other.lock();
+            if (!collider1->is_static && !collider2->is_static)
+                m_island_pairs.emplace_back(first, second);
 
-            if (!new_inside_trigger.contains(other_locked->guid))
+            on_collision_enter(collider1, collider2);
+            on_collision_enter(collider2, collider1);
+
+            bool const is_first_rigidbody = collider1->m_rigidbody != nullptr && !collider1->is_static;
+            bool const is_second_rigidbody = collider2->m_rigidbody != nullptr && !collider2->is_static;
+
+            if (is_first_rigidbody || is_second_rigidbody)
             {
-                on_trigger_exit(collider, other_locked);
+                float const mtv_length = glm::length(mtv);
+
+                if (mtv_length > 0.0f)
+                {
+                    // Circle-circle MTV is already halved for the push of a single collider
+                    bool const are_circles =
+                        collider1->collider_type == ColliderType2D::Circle && collider2->collider_type == ColliderType2D::Circle;
+                    float const depth = are_circles ? mtv_length * 2.0f : mtv_length;
+
+                    // MTV of rectangles can point either way, the solver needs the normal pointing towards the first one
+                    glm::vec2 normal = mtv / mtv_length;
+                    glm::vec2 const first_center = {m_store.center_x[first], m_store.center_y[first]};
+                    glm::vec2 const second_center = {m_store.center_x[second], m_store.center_y[second]};
+
+                    if (glm::dot(normal, first_center - second_center) < 0.0f)
+                        normal = -normal;
+
+                    // Body A is always the first collider of the key, so the contact can be found again next step
+                    if (collider1->m_handle.slot < collider2->m_handle.slot)
+                        m_solver.add_contact({collider1->m_handle, collider2->m_handle}, first, second, normal, depth);
+                    else
+                        m_solver.add_contact({collider2->m_handle, collider1->m_handle}, second, first, -normal, depth);
+                }
+
+                // Colliders without a rigidbody are still pushed out on their own
+                if (!is_first_rigidbody && !collider1->is_static)
+                    collider1->apply_mtv(mtv);
+
+                if (!is_second_rigidbody && !collider2->is_static)
+                    collider2->apply_mtv(-mtv);
+            }
+            else if (!collider1->is_static && !collider2->is_static)
+            {
+                collider1->apply_mtv(mtv);
+                collider2->apply_mtv(-mtv);
+            }
+            // NOTE: Pushed out twice, the second time from the pair in the other order. See solve_collisions() in the header.
+            else if (collider1->is_static)
+            {
+                collider2->apply_mtv(-mtv);
+                push_out_of_static(second, first);
+            }
+            else if (collider2->is_static)
+            {
+                collider1->apply_mtv(mtv);
+                push_out_of_static(first, second);
             }
-        }
 
-        collider->set_inside_trigger(new_inside_trigger, new_inside_trigger_vector);
-        collider->clear_overlapped_this_frame();
+            on_collision_exit(collider1, collider2);
+            on_collision_exit(collider2, collider1);
+        }
     }
+
+    m_is_resolving_pairs = false;
+
+    solve_contacts();
+    dispatch_trigger_events();
 }
 
-bool PhysicsEngine::test_collision_rectangle_rectangle(Collider2D const& obb1, Collider2D const& obb2, glm::vec2& mtv)
+void PhysicsEngine::push_out_of_static(u32 const collider, u32 const static_collider)
 {
-    std::array const corners1 = obb1.get_corners();
-    std::array const corners2 = obb2.get_corners();
+    refresh_store_row(collider);
+    refresh_store_row(static_collider);
 
-    // Get the axes of both rectangles.
-    std::array const axes1 = {AK::Math::get_perpendicular_axis(corners1, 0), AK::Math::get_perpendicular_axis(corners1, 1)};
-    std::array const axes2 = {AK::Math::get_perpendicular_axis(corners2, 0), AK::Math::get_perpendicular_axis(corners2, 1)};
+    glm::vec2 mtv = {};
 
-    // We need to find the minimal overlap and axis on which it happens.
-    float min_overlap = std::numeric_limits<float>::infinity();
-    glm::vec2 smallest_axis = {};
+    if (CollisionKernels::compute_penetration(m_store, collider, static_collider, mtv))
+        colliders[collider]->apply_mtv(mtv);
+}
 
-    // Check overlap along the axes of the first rectangle.
-    for (auto& axis : axes1)
+void PhysicsEngine::solve_contacts()
+{
+    auto& contacts = m_solver.get_contacts();
+
+    // Callbacks added or removed colliders, which shifted the indices the contacts were added with
+    if (m_colliders_changed)
     {
-        glm::vec2 projection1 = AK::Math::project_on_axis(corners1, axis);
-        glm::vec2 projection2 = AK::Math::project_on_axis(corners2, axis);
+        std::erase_if(contacts, [this](ContactManifold& contact) {
+            auto const first = resolve_handle(contact.key.first);
+            auto const second = resolve_handle(contact.key.second);
 
-        float const overlap = AK::Math::get_ranges_overlap_length(projection1, projection2);
+            if (first == nullptr || second == nullptr || !is_collider_registered(first) || !is_collider_registered(second))
+                return true;
 
-        // Shapes are not overlapping
-        if (AK::Math::are_nearly_equal(overlap, 0.0f, 0.05f))
-        {
+            contact.body_a = first->m_physics_index;
+            contact.body_b = second->m_physics_index;
             return false;
-        }
+        });
+    }
+
+    float const dt = static_cast<float>(fixed_delta_time);
+
+    m_solver_bodies.resize(colliders.size());
+
+    for (u32 i = 0; i < colliders.size(); ++i)
+    {
+        auto const& collider = colliders[i];
+        Rigidbody2D* const rigidbody = collider->m_rigidbody;
+        SolverBody& body = m_solver_bodies[i];
+        body = {};
+
+        // Static, asleep and colliders without a rigidbody don't move, so they keep zero inverse mass
+        if (rigidbody == nullptr || collider->is_static || collider->m_is_asleep)
+            continue;
+
+        rigidbody->velocity += rigidbody->m_force * rigidbody->get_inverse_mass() * dt;
+        rigidbody->m_force = {};
+
+        body.velocity = rigidbody->velocity;
+        body.inverse_mass = rigidbody->get_inverse_mass();
+        body.restitution = rigidbody->restitution;
+    }
+
+    m_stats.solver_contacts = static_cast<u32>(contacts.size());
+
+    m_solver.solve(m_solver_bodies);
+
+    m_stats.warm_started_contacts = m_solver.get_warm_started_count();
+
+    for (u32 i = 0; i < colliders.size(); ++i)
+    {
+        auto const& collider = colliders[i];
+        Rigidbody2D* const rigidbody = collider->m_rigidbody;
+
+        if (rigidbody == nullptr || collider->is_static || collider->m_is_asleep)
+            continue;
 
-        if (overlap < min_overlap)
+        SolverBody const& body = m_solver_bodies[i];
+        rigidbody->velocity = body.velocity;
+
+        glm::vec2 displacement = body.velocity * dt + body.position_correction;
+
+        if (is_swept(*collider))
+            displacement = sweep_continuous(*collider, displacement);
+
+        if (displacement != glm::vec2(0.0f))
         {
-            min_overlap = overlap;
-            smallest_axis = axis;
+            glm::vec3 const position = collider->entity->transform->get_position();
+            collider->entity->transform->set_position(position + AK::convert_2d_to_3d(displacement));
         }
+
+        rigidbody->velocity = AK::move_towards(rigidbody->velocity, {0.0f, 0.0f}, rigidbody->drag);
     }
+}
+
+void PhysicsEngine::integrate_continuous(Collider2D& collider)
+{
+    // Same threshold as Collider2D::physics_update()
+    if (glm::epsilonEqual(collider.velocity, {0.0f, 0.0f}, 0.001f) == glm::bvec2(true, true))
+        return;
+
+    glm::vec2 const displacement = sweep_continuous(collider, collider.velocity * static_cast<float>(fixed_delta_time));
 
-    // Check overlap along the axes of the second rectangle.
-    for (auto& axis : axes2)
+    glm::vec3 const position = collider.entity->transform->get_position();
+    collider.entity->transform->set_position(position + AK::convert_2d_to_3d(displacement));
+
+    collider.velocity = AK::move_towards(collider.velocity, {0.0f, 0.0f}, collider.drag);
+}
+
+glm::vec2 PhysicsEngine::sweep_continuous(Collider2D const& collider, glm::vec2 const& total_displacement)
+{
+    glm::vec2 const start = collider.get_center_2d();
+    glm::vec2 center = start;
+    glm::vec2 displacement = total_displacement;
+
+    for (u32 i = 0; i < max_continuous_iterations; ++i)
     {
-        glm::vec2 projection1 = AK::Math::project_on_axis(corners1, axis);
-        glm::vec2 projection2 = AK::Math::project_on_axis(corners2, axis);
+        if (glm::dot(displacement, displacement) <= 0.0f)
+            break;
 
-        float const overlap = AK::Math::get_ranges_overlap_length(projection1, projection2);
+        float time = 1.0f;
+        glm::vec2 normal = {};
 
-        // Shapes are not overlapping
-        if (AK::Math::are_nearly_equal(overlap, 0.0f, 0.05f))
+        if (!find_time_of_impact(collider, center, displacement, time, normal))
         {
-            return false;
+            center += displacement;
+            break;
         }
 
-        if (overlap < min_overlap)
+        // Move into the contact a little, the collider then counts as overlapped and is skipped by the next sweeps
+        center += displacement * time - normal * continuous_contact_depth;
+
+        glm::vec2 const rest = displacement * (1.0f - time);
+        displacement = rest - normal * glm::dot(rest, normal);
+    }
+
+    return center - start;
+}
+
+bool PhysicsEngine::is_swept(Collider2D const& collider)
+{
+    return collider.is_continuous && collider.collider_type == ColliderType2D::Circle && !collider.is_trigger && !collider.is_static;
+}
+
+glm::vec2 PhysicsEngine::get_body_velocity(Collider2D const& collider)
+{
+    return collider.m_rigidbody != nullptr ? collider.m_rigidbody->velocity : collider.velocity;
+}
+
+bool PhysicsEngine::find_time_of_impact(Collider2D const& collider, glm::vec2 const& center, glm::vec2 const& displacement, float& time,
+                                        glm::vec2& normal)
+{
+    float const radius = collider.radius;
+    BoundingBox2D const bounds = {glm::min(center, center + displacement) - radius, glm::max(center, center + displacement) + radius};
+    bool has_hit = false;
+    u32 hit_index = 0;
+
+    m_tree.query(bounds, [&](u32 const index) {
+        auto const& other = colliders[index];
+
+        if (other.get() == &collider || other->is_trigger || !other->entity->is_active() || !should_collide(collider, *other))
+            return true;
+
+        other->update_center_and_corners_if_needed();
+
+        if (!bounds.overlaps(other->m_bounds))
+            return true;
+
+        float other_time = 1.0f;
+        glm::vec2 other_normal = {};
+        bool other_hit = false;
+
+        if (other->collider_type == ColliderType2D::Circle)
         {
-            min_overlap = overlap;
-            smallest_axis = axis;
+            other_hit = time_of_impact_circle_circle(center, radius, displacement, other->m_center, other->radius, other_time,
+                                                     other_normal);
         }
-    }
+        else if (other->collider_type == ColliderType2D::Rectangle)
+        {
+            other_hit = time_of_impact_circle_obb(center, radius, displacement, *other, other_time, other_normal);
+        }
+        else
+        {
+            ConvexShape2D circle = {};
+            circle.points[0] = center;
+            circle.count = 1;
+            circle.radius = radius;
 
-    mtv = smallest_axis * min_overlap;
+            other_hit = GJK::find_time_of_impact(circle, displacement, other->m_shape, other_time, other_normal);
+        }
 
-    glm::vec2 const center1 = AK::convert_3d_to_2d(obb1.entity->transform->get_position());
-    glm::vec2 const center2 = AK::convert_3d_to_2d(obb2.entity->transform->get_position());
+        // Ties go to the collider registered first, so the result doesn't depend on the tree's layout
+        if (other_hit && (!has_hit || other_time < time || (other_time == time && index < hit_index)))
+        {
+            time = other_time;
+            normal = other_normal;
+            hit_index = index;
+            has_hit = true;
+        }
+
+        return true;
+    });
+
+    return has_hit;
+}
+
+bool PhysicsEngine::time_of_impact_circle_circle(glm::vec2 const& center, float const radius, glm::vec2 const& displacement,
+                                                 glm::vec2 const& other_center, float const other_radius, float& time,
+                                                 glm::vec2& normal)
+{
+    // Point moving against a circle with both radii
+    float const radius_sum = radius + other_radius;
+    glm::vec2 const offset = center - other_center;
 
-    // Need to reverse the MTV if center offset and overlap are not pointing in the same direction.
-    if (glm::dot(center2 - center1, mtv) < 0.0f)
-        mtv = -mtv;
+    float const c = glm::dot(offset, offset) - radius_sum * radius_sum;
 
+    // Already overlapping
+    if (c < 0.0f)
+        return false;
+
+    float const b = glm::dot(offset, displacement);
+
+    // Moving away
+    if (b >= 0.0f)
+        return false;
+
+    float const a = glm::dot(displacement, displacement);
+    float const discriminant = b * b - a * c;
+
+    if (discriminant < 0.0f)
+        return false;
+
+    float const t = (-b - std::sqrt(discriminant)) / a;
+
+    if (t > 1.0f)
+        return false;
+
+    time = std::max(t, 0.0f);
+    normal = glm::normalize(offset + displacement * time);
     return true;
 }
 
-bool PhysicsEngine::test_collision_circle_circle(Collider2D const& obb1, Collider2D const& obb2, glm::vec2& mtv)
+bool PhysicsEngine::time_of_impact_circle_obb(glm::vec2 const& center, float const radius, glm::vec2 const& displacement,
+                                              Collider2D const& rectangle, float& time, glm::vec2& normal)
 {
-    glm::vec2 const center1_2d = obb1.get_center_2d();
-    glm::vec2 const center2_2d = obb2.get_center_2d();
+    // Point moving against the rectangle rounded by the radius, in the rectangle's local space
+    std::array const half_extents = {rectangle.width * 0.5f, rectangle.height * 0.5f};
+    glm::vec2 const offset = center - rectangle.m_center;
+    glm::vec2 const local_center = {glm::dot(offset, rectangle.m_axes[0]), glm::dot(offset, rectangle.m_axes[1])};
+    glm::vec2 const local_displacement = {glm::dot(displacement, rectangle.m_axes[0]), glm::dot(displacement, rectangle.m_axes[1])};
+
+    // Already overlapping
+    glm::vec2 const closest_point = glm::clamp(local_center, -glm::vec2(half_extents[0], half_extents[1]),
+                                               glm::vec2(half_extents[0], half_extents[1]));
+
+    if (glm::dot(local_center - closest_point, local_center - closest_point) < radius * radius)
+        return false;
+
+    // Slab test against the rectangle grown by the radius
+    float t_min = 0.0f;
+    float t_max = 1.0f;
+    glm::vec2 local_normal = {};
+
+    for (u8 i = 0; i < 2; ++i)
+    {
+        float const extent = half_extents[i] + radius;
+
+        if (AK::Math::are_nearly_equal(local_displacement[i], 0.0f, 0.000001f))
+        {
+            if (std::abs(local_center[i]) > extent)
+                return false;
+
+            continue;
+        }
+
+        float t1 = (-extent - local_center[i]) / local_displacement[i];
+        float t2 = (extent - local_center[i]) / local_displacement[i];
+        float side = -1.0f;
+
+        if (t1 > t2)
+        {
+            std::swap(t1, t2);
+            side = 1.0f;
+        }
+
+        if (t1 >= t_min)
+        {
+            t_min = t1;
+            local_normal = {};
+            local_normal[i] = side;
+        }
+
+        t_max = std::min(t_max, t2);
+
+        if (t_min > t_max)
+            return false;
+    }
+
+    glm::vec2 const hit = local_center + local_displacement * t_min;
+
+    // Hit the rounded part, test against the circle around the closest corner
+    if (std::abs(hit.x) > half_extents[0] && std::abs(hit.y) > half_extents[1])
+    {
+        glm::vec2 const corner = {std::copysign(half_extents[0], hit.x), std::copysign(half_extents[1], hit.y)};
+
+        if (!time_of_impact_circle_circle(local_center, radius, local_displacement, corner, 0.0f, t_min, local_normal))
+            return false;
+    }
 
-    float const positions_distance = glm::distance(center1_2d, center2_2d);
-    float const radius_sum = obb1.get_radius_2d() + obb2.get_radius_2d();
+    // Moving along or away from the hit side
+    if (glm::dot(local_displacement, local_normal) >= 0.0f)
+        return false;
 
-    bool const are_overlapping = positions_distance < radius_sum;
+    time = t_min;
+    normal = rectangle.m_axes[0] * local_normal.x + rectangle.m_axes[1] * local_normal.y;
+    return true;
+}
 
-    if (are_overlapping)
+void PhysicsEngine::snap_moved_poses()
+{
+    for (auto const& collider : colliders)
     {
-        mtv = 0.5f * (glm::normalize(center1_2d - center2_2d) * (obb1.get_radius_2d() + obb2.get_radius_2d() - positions_distance));
+        if (collider->entity->transform->get_version() != collider->m_pose_version)
+            collider->m_current_local_position = collider->entity->transform->get_local_position();
     }
+}
 
-    return are_overlapping;
+void PhysicsEngine::record_poses()
+{
+    for (auto const& collider : colliders)
+    {
+        collider->m_previous_local_position = collider->m_current_local_position;
+        collider->m_current_local_position = collider->entity->transform->get_local_position();
+        collider->m_pose_version = collider->entity->transform->get_version();
+    }
 }
 
-bool PhysicsEngine::test_collision_circle_rectangle(Collider2D const& circle_collider, Collider2D const& rect_collider, glm::vec2& mtv)
+void PhysicsEngine::wake_moved_colliders()
 {
-    // Function works in a way that obb1 is always a circle.
-    assert(circle_collider.collider_type == ColliderType2D::Circle && rect_collider.collider_type == ColliderType2D::Rectangle);
+    for (auto const& collider : colliders)
+    {
+        if (!collider->m_is_asleep)
+            continue;
+
+        bool const was_moved = collider->entity->transform->get_version() != collider->m_sleep_transform_version;
 
-    glm::vec2 const center = circle_collider.get_center_2d();
-    float const radius = circle_collider.get_radius_2d();
-    std::array const corners = rect_collider.get_corners();
+        if (was_moved || collider->m_is_shape_dirty || glm::length(get_body_velocity(*collider)) >= sleep_velocity_threshold)
+            collider->wake_up();
+    }
+}
 
-    // Pretty intuitive: We have collision if any side of the rectangle intersects with a circle.
-    if (!is_point_inside_obb(center, corners))
+void PhysicsEngine::update_sleep()
+{
+    u32 const count = static_cast<u32>(colliders.size());
+
+    for (auto const& collider : colliders)
     {
-        bool is_overlapping = false;
-        glm::vec2 mtv_temp = {};
-        is_overlapping |= compute_penetration_circle_segment(center, radius, corners[0], corners[1], mtv_temp);
-        is_overlapping |= compute_penetration_circle_segment(center, radius, corners[1], corners[2], mtv_temp);
-        is_overlapping |= compute_penetration_circle_segment(center, radius, corners[2], corners[3], mtv_temp);
-        is_overlapping |= compute_penetration_circle_segment(center, radius, corners[3], corners[0], mtv_temp);
+        glm::vec2 const position = AK::convert_3d_to_2d(collider->entity->transform->get_position());
+
+        bool const is_still = glm::length(get_body_velocity(*collider)) < sleep_velocity_threshold
+                           && glm::distance(position, collider->m_sleep_position) < sleep_distance_threshold;
+
+        if (!is_still)
+            collider->m_still_steps = 0;
+        else if (collider->m_still_steps < steps_to_sleep)
+            collider->m_still_steps += 1;
+
+        collider->m_sleep_position = position;
+        collider->m_sleep_transform_version = collider->entity->transform->get_version();
+    }
+
+    // Callbacks added or removed colliders, island pairs point to wrong colliders so nothing falls asleep this step
+    bool const can_fall_asleep = !m_colliders_changed;
 
-        if (is_overlapping)
+    m_island_parents.resize(count);
+    m_island_still_steps.resize(count);
+
+    for (u32 i = 0; i < count; ++i)
+    {
+        m_island_parents[i] = i;
+        m_island_still_steps[i] = colliders[i]->m_still_steps;
+    }
+
+    if (can_fall_asleep)
+    {
+        for (auto const& [first, second] : m_island_pairs)
         {
-            mtv = mtv_temp;
-            return true;
+            u32 const first_island = find_island(first);
+            u32 const second_island = find_island(second);
+
+            if (first_island == second_island)
+                continue;
+
+            m_island_parents[second_island] = first_island;
+            m_island_still_steps[first_island] = std::min(m_island_still_steps[first_island], m_island_still_steps[second_island]);
         }
     }
-    // Check for the case where a circle is inside a rectangle. Therefore, it doesn't intersect with rectangle's
-    // sides, but still collides with it.
-    else
-    {
-        // Calculate MTV, needed when spawning a circle inside a rect or fast movement.
-        glm::vec2 const dimensions = rect_collider.get_extents();
-        float const max_rect_length = std::max(dimensions.x, dimensions.y);
 
-        auto min_distance_vector = glm::vec2(1.0f);
-        auto new_min_distance_vector = glm::vec2(0.0f);
-        glm::vec2 cast_point = {};
+    for (u32 i = 0; i < count; ++i)
+    {
+        auto const& collider = colliders[i];
+        bool const should_sleep = can_fall_asleep && m_island_still_steps[find_island(i)] >= steps_to_sleep;
 
-        auto const axes = rect_collider.get_axes();
-        std::array const borders = {axes[0], -axes[1], -axes[0], axes[1]};
+        if (should_sleep && !collider->m_is_asleep)
+        {
+            collider->m_is_asleep = true;
+            collider->velocity = {};
 
-        for (u8 i = 0; i < 4; ++i)
+            if (collider->m_rigidbody != nullptr)
+                collider->m_rigidbody->velocity = {};
+        }
+        else if (!should_sleep && collider->m_is_asleep)
         {
-            u8 const first = i;
-            u8 next = first + 1;
+            // Some collider in its island moved
+            collider->m_is_asleep = false;
+        }
+
+        if (collider->m_is_asleep)
+            m_stats.asleep_colliders += 1;
+        else
+            m_stats.awake_colliders += 1;
+    }
+}
+
+u32 PhysicsEngine::find_island(u32 index)
+{
+    while (m_island_parents[index] != index)
+    {
+        m_island_parents[index] = m_island_parents[m_island_parents[index]];
+        index = m_island_parents[index];
+    }
+
+    return index;
+}
+
+void PhysicsEngine::keep_sleeping_trigger_pair(Collider2D const& first, Collider2D const& second)
+{
+    TriggerPair pair = {first.m_handle, second.m_handle};
+
+    if (second.m_handle.slot < first.m_handle.slot)
+        std::swap(pair.first, pair.second);
+
+    if (std::ranges::binary_search(m_previous_trigger_pairs, pair))
+        m_trigger_pairs.emplace_back(pair);
+}
+
+void PhysicsEngine::refresh_store_row(u32 const index)
+{
+    m_store.write(index, *colliders[index], colliders[index]->get_center_2d());
+}
+
+bool PhysicsEngine::is_store_row_stale(u32 const index) const
+{
+    return m_store.transform_versions[index] != colliders[index]->entity->transform->get_version();
+}
+
+void PhysicsEngine::dispatch_trigger_events()
+{
+    std::ranges::sort(m_trigger_pairs);
+
+    // Colliders removed by collision callbacks shift indices, which could report a pair twice
+    auto const duplicates = std::ranges::unique(m_trigger_pairs);
+    m_trigger_pairs.erase(duplicates.begin(), duplicates.end());
+
+    m_stats.trigger_pairs = static_cast<u32>(m_trigger_pairs.size());
 
-            if (next == 4)
-                next = 0;
+    // Colliders removed from now on are still referenced by this step's pairs, recycle them after the next diff
+    std::swap(m_released_slots, m_slots_to_recycle);
 
-            cast_point = center + borders[i] * max_rect_length;
-            new_min_distance_vector = AK::Math::line_intersection(center, cast_point, corners[first], corners[next]) - center;
+    auto const is_registered = [this](ColliderHandle const handle) { return m_collider_slots[handle.slot].is_registered; };
 
-            if (glm::length(new_min_distance_vector) < glm::length(min_distance_vector))
-                min_distance_vector = new_min_distance_vector;
+    auto const send_enter = [&](TriggerPair const& pair) {
+        m_stats.trigger_enters += 1;
+
+        auto const first = resolve_handle(pair.first);
+        auto const second = resolve_handle(pair.second);
+
+        if (first == nullptr || second == nullptr)
+            return;
+
+        // Callbacks might remove colliders
+        if (is_registered(pair.first))
+            on_trigger_enter(first, second);
+
+        if (is_registered(pair.second))
+            on_trigger_enter(second, first);
+    };
+
+    auto const send_exit = [&](TriggerPair const& pair) {
+        m_stats.trigger_exits += 1;
+
+        auto const first = resolve_handle(pair.first);
+        auto const second = resolve_handle(pair.second);
+
+        if (first == nullptr || second == nullptr)
+            return;
+
+        // Removed colliders don't get events, but the ones that stayed are told about them leaving
+        if (is_registered(pair.first))
+            on_trigger_exit(first, second);
+
+        if (is_registered(pair.second))
+            on_trigger_exit(second, first);
+    };
+
+    // Both vectors are sorted, so a single merge pass gives pairs that started and stopped overlapping
+    auto const& previous = m_previous_trigger_pairs;
+    auto const& current = m_trigger_pairs;
+    u32 previous_index = 0;
+    u32 current_index = 0;
+
+    while (previous_index < previous.size() || current_index < current.size())
+    {
+        if (current_index == current.size() || (previous_index < previous.size() && previous[previous_index] < current[current_index]))
+        {
+            send_exit(previous[previous_index]);
+            previous_index += 1;
+        }
+        else if (previous_index == previous.size() || current[current_index] < previous[previous_index])
+        {
+            send_enter(current[current_index]);
+            current_index += 1;
         }
+        else
+        {
+            previous_index += 1;
+            current_index += 1;
+        }
+    }
 
-        mtv = min_distance_vector + radius;
+    std::swap(m_trigger_pairs, m_previous_trigger_pairs);
+    m_trigger_pairs.clear();
 
-        return true;
+    for (u32 const slot_index : m_slots_to_recycle)
+    {
+        ColliderSlot& slot = m_collider_slots[slot_index];
+        slot.is_released = false;
+
+        // Registered again before the diff
+        if (slot.is_registered)
+            continue;
+
+        slot.collider.reset();
+        slot.generation += 1;
+        m_free_slots.emplace_back(slot_index);
     }
 
-    return false;
+    m_slots_to_recycle.clear();
 }
 
-bool PhysicsEngine::compute_penetration_circle_segment(glm::vec2 const& center, float const radius, glm::vec2 const& p1,
-                                                       glm::vec2 const& p2, glm::vec2& mtv)
+ColliderHandle PhysicsEngine::acquire_handle(std::shared_ptr<Collider2D> const& collider)
 {
-    glm::vec2 const v = center - p1;
-    glm::vec2 const segment = p2 - p1;
-    float const segment_length_squared = glm::dot(segment, segment);
+    ColliderHandle const previous_handle = collider->m_handle;
 
-    float t = glm::dot(v, segment) / segment_length_squared;
-    t = glm::clamp(t, 0.0f, 1.0f);
+    // Collider was removed and added back before its slot got recycled, keep the handle so its pairs carry on
+    if (previous_handle.slot < m_collider_slots.size())
+    {
+        ColliderSlot& slot = m_collider_slots[previous_handle.slot];
 
-    glm::vec2 const closest_point = p1 + t * segment;
-    float const distance = glm::distance(center, closest_point);
+        if (slot.generation == previous_handle.generation && slot.collider.lock() == collider)
+        {
+            slot.is_registered = true;
+            return previous_handle;
+        }
+    }
 
-    if (distance <= radius)
+    u32 slot_index = 0;
+
+    if (m_free_slots.empty())
     {
-        mtv += glm::normalize(center - closest_point) * (radius - distance);
-        return distance <= radius;
+        slot_index = static_cast<u32>(m_collider_slots.size());
+        m_collider_slots.emplace_back();
     }
+    else
+    {
+        slot_index = m_free_slots.back();
+        m_free_slots.pop_back();
+    }
+
+    ColliderSlot& slot = m_collider_slots[slot_index];
+    slot.collider = collider;
+    slot.is_registered = true;
 
-    return false;
+    return {slot_index, slot.generation};
 }
 
-bool PhysicsEngine::is_point_inside_obb(glm::vec2 const& point, std::array<glm::vec2, 4> const& rectangle_corners)
+void PhysicsEngine::release_handle(ColliderHandle const handle)
 {
-    glm::vec2 const ap = point - rectangle_corners[0]; // Vector from one rectangle corner to point
-    glm::vec2 const ab = rectangle_corners[1] - rectangle_corners[0]; // One rectangle axis
-    glm::vec2 const ad = rectangle_corners[3] - rectangle_corners[0]; // Another rectangle axis
+    ColliderSlot& slot = m_collider_slots[handle.slot];
+    assert(slot.generation == handle.generation);
 
-    // Dot products
-    float const ap_dot_ab = glm::dot(ap, ab);
-    float const ab_dot_ab = glm::dot(ab, ab);
-    float const ap_dot_ad = glm::dot(ap, ad);
-    float const ad_dot_ad = glm::dot(ad, ad);
+    slot.is_registered = false;
 
-    return (0.0f <= ap_dot_ab && ap_dot_ab <= ab_dot_ab) && (0.0f <= ap_dot_ad && ap_dot_ad <= ad_dot_ad);
+    if (!slot.is_released)
+    {
+        slot.is_released = true;
+        m_released_slots.emplace_back(handle.slot);
+    }
+}
+
+std::shared_ptr<Collider2D> PhysicsEngine::resolve_handle(ColliderHandle const handle) const
+{
+    ColliderSlot const& slot = m_collider_slots[handle.slot];
+
+    if (slot.generation != handle.generation)
+        return nullptr;
+
+    return slot.collider.lock();
+}
+
+glm::vec2 PhysicsEngine::get_closest_point_on_obb(glm::vec2 const& point, glm::vec2 const& center, std::array<glm::vec2, 2> const& axes,
+                                                  glm::vec2 const& half_extents)
+{
+    glm::vec2 const offset = point - center;
+
+    float const x = glm::clamp(glm::dot(offset, axes[0]), -half_extents.x, half_extents.x);
+    float const y = glm::clamp(glm::dot(offset, axes[1]), -half_extents.y, half_extents.y);
+
+    return center + axes[0] * x + axes[1] * y;
+}
+
+bool PhysicsEngine::raycast_collider(Collider2D const& collider, glm::vec2 const& origin, glm::vec2 const& direction,
+                                     float const max_distance, RaycastHit2D& hit)
+{
+    glm::vec2 const offset = origin - collider.m_center;
+
+    if (collider.collider_type == ColliderType2D::Circle)
+    {
+        float const c = glm::dot(offset, offset) - collider.radius * collider.radius;
+
+        // Origin inside the circle
+        if (c <= 0.0f)
+        {
+            hit.point = origin;
+            hit.normal = -direction;
+            hit.distance = 0.0f;
+            return true;
+        }
+
+        float const b = glm::dot(offset, direction);
+        float const discriminant = b * b - c;
+
+        if (b > 0.0f || discriminant < 0.0f)
+            return false;
+
+        float const distance = -b - std::sqrt(discriminant);
+
+        if (distance > max_distance)
+            return false;
+
+        hit.point = origin + direction * distance;
+        hit.normal = glm::normalize(hit.point - collider.m_center);
+        hit.distance = distance;
+        return true;
+    }
+
+    if (collider.collider_type == ColliderType2D::Capsule || collider.collider_type == ColliderType2D::Polygon)
+    {
+        // Point swept along the ray
+        ConvexShape2D point = {};
+        point.points[0] = origin;
+        point.count = 1;
+
+        if (GJK::are_overlapping(point, collider.m_shape))
+        {
+            hit.point = origin;
+            hit.normal = -direction;
+            hit.distance = 0.0f;
+            return true;
+        }
+
+        float time = 0.0f;
+        glm::vec2 normal = {};
+
+        if (!GJK::find_time_of_impact(point, direction * max_distance, collider.m_shape, time, normal))
+            return false;
+
+        hit.distance = time * max_distance;
+        hit.point = origin + direction * hit.distance;
+        hit.normal = normal;
+        return true;
+    }
+
+    // Slab test in the rectangle's local space
+    std::array const half_extents = {collider.width * 0.5f, collider.height * 0.5f};
+    float t_min = 0.0f;
+    float t_max = max_distance;
+    glm::vec2 normal = -direction;
+
+    for (u8 i = 0; i < 2; ++i)
+    {
+        float const local_origin = glm::dot(offset, collider.m_axes[i]);
+        float const local_direction = glm::dot(direction, collider.m_axes[i]);
+
+        if (AK::Math::are_nearly_equal(local_direction, 0.0f, 0.000001f))
+        {
+            if (std::abs(local_origin) > half_extents[i])
+                return false;
+
+            continue;
+        }
+
+        float t1 = (-half_extents[i] - local_origin) / local_direction;
+        float t2 = (half_extents[i] - local_origin) / local_direction;
+        glm::vec2 entry_normal = -collider.m_axes[i];
+
+        if (t1 > t2)
+        {
+            std::swap(t1, t2);
+            entry_normal = collider.m_axes[i];
+        }
+
+        if (t1 > t_min)
+        {
+            t_min = t1;
+            normal = entry_normal;
+        }
+
+        t_max = std::min(t_max, t2);
+
+        if (t_min > t_max)
+            return false;
+    }
+
+    hit.point = origin + direction * t_min;
+    hit.normal = normal;
+    hit.distance = t_min;
+    return true;
 }
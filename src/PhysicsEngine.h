@@ -1,8 +1,15 @@
 #pragma once
 
+#include <functional>
+#include <optional>
 #include <vector>
 
+#include "Broadphase.h"
 #include "Collider2D.h"
+#include "CollisionKernels.h"
+#include "ContactSolver.h"
+#include "DynamicAABBTree.h"
+#include "EngineDefines.h"
 
 enum class CollisionType
 {
@@ -12,11 +19,71 @@ enum class CollisionType
     CircleRectangle
 };
 
+struct PhysicsStats
+{
+    u32 colliders = 0;
+    u32 candidate_pairs = 0;
+
+    // Candidate pairs dropped by collision layers before the narrowphase
+    u32 layer_rejected_pairs = 0;
+    u32 overlapping_pairs = 0;
+    i32 tree_height = 0;
+
+    u32 trigger_pairs = 0;
+    u32 trigger_enters = 0;
+    u32 trigger_exits = 0;
+
+    // Contacts of bodies with a Rigidbody2D resolved by the impulse solver, and the ones that reused last step's impulse
+    u32 solver_contacts = 0;
+    u32 warm_started_contacts = 0;
+
+    u32 awake_colliders = 0;
+    u32 asleep_colliders = 0;
+
+    // Candidate pairs of two asleep colliders, skipped before the narrowphase
+    u32 sleeping_pairs = 0;
+
+    // Fixed steps run during the last frame and steps dropped because of the substep limit so far
+    u32 substeps = 0;
+    u32 dropped_steps = 0;
+
+    // Throughput of the batched narrowphase kernels
+    double narrowphase_pairs_per_second = 0.0;
+    u32 narrowphase_threads = 0;
+
+    // Pairs with a capsule or a polygon tested with GJK, and the ones rejected by last step's separating axis
+    u32 convex_pairs = 0;
+    u32 axis_early_outs = 0;
+};
+
+struct RaycastHit2D
+{
+    std::shared_ptr<Collider2D> collider = nullptr;
+    glm::vec2 point = {};
+    glm::vec2 normal = {};
+    float distance = 0.0f;
+};
+
+// Returns true if the collider should be considered by a spatial query
+using ColliderFilter = std::function<bool(std::shared_ptr<Collider2D> const&)>;
+
 class PhysicsEngine
 {
 public:
     PhysicsEngine() = default;
 
+    // Colliders fall asleep together with everything they touch once all of them stayed below both thresholds
+    // for steps_to_sleep steps. Distance is the movement during a single step.
+    static constexpr float sleep_velocity_threshold = 0.01f;
+    static constexpr float sleep_distance_threshold = 0.0005f;
+    static constexpr u32 steps_to_sleep = 60;
+
+    // Continuous circles stop this deep inside the collider they hit, so the narrowphase still reports the contact
+    static constexpr float continuous_contact_depth = 0.001f;
+
+    // Number of times a continuous circle can hit something and slide along it during a single step
+    static constexpr u32 max_continuous_iterations = 4;
+
     static void set_instance(std::shared_ptr<PhysicsEngine> const& scene)
     {
         m_instance = scene;
@@ -33,6 +100,25 @@ public:
     void initialize();
     void run_updates();
 
+    // Limits fixed steps run in a single frame, so a long frame doesn't make the next ones even longer.
+    // Time over the limit is either dropped or carried over to the next frames. At most max_carried_steps fixed steps
+    // are carried, the rest is dropped too, otherwise frames that keep taking too long would pile up time forever.
+    void set_max_substeps(u32 const max_substeps);
+    [[nodiscard]] u32 get_max_substeps() const;
+    void set_carry_leftover_time(bool const should_carry);
+    [[nodiscard]] bool get_carry_leftover_time() const;
+    void set_max_carried_steps(u32 const max_carried_steps);
+    [[nodiscard]] u32 get_max_carried_steps() const;
+
+    // Moves awake colliders between their last two fixed step poses for rendering, by the accumulated time
+    // that is not simulated yet. restore_poses() has to be called after rendering, before the next frame's logic.
+    // Colliders can't be removed in between, the interpolated ones are remembered by index.
+    void interpolate_poses();
+    void restore_poses();
+    void set_interpolation_enabled(bool const is_enabled);
+    [[nodiscard]] bool is_interpolation_enabled() const;
+    [[nodiscard]] float get_interpolation_alpha() const;
+
     static void on_collision_enter(std::shared_ptr<Collider2D> const& collider, std::shared_ptr<Collider2D> const& other);
     static void on_collision_exit(std::shared_ptr<Collider2D> const& collider, std::shared_ptr<Collider2D> const& other);
 
@@ -43,24 +129,196 @@ public:
     void emplace_collider(std::shared_ptr<Collider2D> const& collider);
     void remove_collider(std::shared_ptr<Collider2D> const& collider);
 
-    static bool compute_penetration(std::shared_ptr<Collider2D> const& collider, std::shared_ptr<Collider2D> const& other, glm::vec2& mtv);
+    void set_broadphase_type(BroadphaseType const type);
+    [[nodiscard]] BroadphaseType get_broadphase_type() const;
+
+    // Area that the uniform grid broadphase is built over, usually the level's playfield.
+    void set_broadphase_bounds(glm::vec2 const& min, glm::vec2 const& max);
+
+    // Spreads narrowphase pair tests over worker threads. Callbacks and collision resolution always run on the main
+    // thread in pair order, so the results are the same either way. Always off with PHYSICS_SINGLE_THREADED.
+    void set_narrowphase_multithreaded(bool const is_multithreaded);
+    [[nodiscard]] bool is_narrowphase_multithreaded() const;
+
+    // Tests the circle and rectangle pairs of the last step with both the shape specific functions and GJK
+    NarrowphaseBenchmark benchmark_narrowphase(u32 const iterations) const;
+
+    // Collision matrix between layers, symmetric, every layer collides with every other one by default.
+    // Checked together with the masks of both colliders before any narrowphase work.
+    void set_layers_collide(u32 const first_layer, u32 const second_layer, bool const should_collide);
+    [[nodiscard]] bool do_layers_collide(u32 const first_layer, u32 const second_layer) const;
+    [[nodiscard]] bool should_collide(Collider2D const& first, Collider2D const& second) const;
+
+    // Stats of the last fixed step
+    [[nodiscard]] PhysicsStats const& get_stats() const;
+
+    // Spatial queries over all enabled colliders, triggers included. They only go through the dynamic tree,
+    // regardless of the broadphase type. The tree is refit during every fixed step and once at the end of
+    // run_updates(), so queries see colliders where they were then. Colliders moved or added later in the frame
+    // are found at their new place from the next refit.
+    // Returns the closest hit along the ray. Direction doesn't have to be normalized.
+    std::optional<RaycastHit2D> raycast(glm::vec2 const& origin, glm::vec2 const& direction, float const max_distance,
+                                        ColliderFilter const& filter = nullptr) const;
+
+    // Appends every collider overlapping the circle to result.
+    void overlap_circle(glm::vec2 const& center, float const radius, std::vector<std::shared_ptr<Collider2D>>& result,
+                        ColliderFilter const& filter = nullptr) const;
+
+    // Appends every collider overlapping the oriented box to result. Angle is in radians, half extents are along
+    // (cos(angle), sin(angle)) and the perpendicular axis.
+    void overlap_obb(glm::vec2 const& center, glm::vec2 const& half_extents, float const angle,
+                     std::vector<std::shared_ptr<Collider2D>>& result, ColliderFilter const& filter = nullptr) const;
+
+    // Returns the collider with the center closest to the point, or nullptr if there is none.
+    std::shared_ptr<Collider2D> query_nearest(glm::vec2 const& point, ColliderFilter const& filter = nullptr) const;
 
 private:
-    void update_physics() const;
-    void solve_collisions() const;
+    void update_physics();
+
+    // Every overlapping pair is resolved once per step, in the broadphase's pair order. It used to be visited in both
+    // orders, so on_collision_enter() and on_collision_exit() now run once per step for each collider of the pair,
+    // not twice. Trigger overlaps are recorded for both colliders from the single visit, trigger events are the same.
+    void solve_collisions();
+
+    // Second push of a collider out of a static one, what the visit of the pair in the other order used to do.
+    // Circle-circle MTVs are half of the penetration, so circles still move by three quarters of it each step.
+    void push_out_of_static(u32 const collider, u32 const static_collider);
+
+    // Refreshes bounds of the colliders whose transform version changed or whose shape is dirty, only their proxies
+    // are moved in the tree
+    void update_tree();
+
+    // Resolves the contacts of rigidbodies gathered by solve_collisions() and moves every awake rigidbody,
+    // with a single transform write for each.
+    void solve_contacts();
 
-    static bool test_collision_rectangle_rectangle(Collider2D const& obb1, Collider2D const& obb2, glm::vec2& mtv);
-    static bool test_collision_circle_circle(Collider2D const& obb1, Collider2D const& obb2, glm::vec2& mtv);
-    static bool test_collision_circle_rectangle(Collider2D const& circle_collider, Collider2D const& rect_collider, glm::vec2& mtv);
+    // Moves a continuous circle by its velocity, see sweep_continuous()
+    void integrate_continuous(Collider2D& collider);
 
-    static bool compute_penetration_circle_segment(glm::vec2 const& center, float const radius, glm::vec2 const& p1, glm::vec2 const& p2,
-                                                   glm::vec2& mtv);
+    // Returns how far a circle gets when moving by displacement, stopping at the first impact and sliding along the hit
+    // surface with the rest of the movement. Colliders it already overlaps are ignored, the narrowphase resolves those.
+    glm::vec2 sweep_continuous(Collider2D const& collider, glm::vec2 const& displacement);
+    [[nodiscard]] static bool is_swept(Collider2D const& collider);
 
-    static bool is_point_inside_obb(glm::vec2 const& point, std::array<glm::vec2, 4> const& rectangle_corners);
+    // Velocity of the Rigidbody2D if there is one, the collider's otherwise
+    [[nodiscard]] static glm::vec2 get_body_velocity(Collider2D const& collider);
+
+    // Earliest impact of the circle moving by displacement, time is the fraction of the displacement
+    bool find_time_of_impact(Collider2D const& collider, glm::vec2 const& center, glm::vec2 const& displacement, float& time,
+                             glm::vec2& normal);
+
+    static bool time_of_impact_circle_circle(glm::vec2 const& center, float const radius, glm::vec2 const& displacement,
+                                             glm::vec2 const& other_center, float const other_radius, float& time, glm::vec2& normal);
+    static bool time_of_impact_circle_obb(glm::vec2 const& center, float const radius, glm::vec2 const& displacement,
+                                          Collider2D const& rectangle, float& time, glm::vec2& normal);
+
+    // Snaps poses of colliders moved outside of the physics step, so they aren't interpolated from their old position
+    void snap_moved_poses();
+    void record_poses();
+
+    // Wakes up asleep colliders that were moved, resized or given velocity since the end of the last step
+    void wake_moved_colliders();
+
+    // Counts steps every collider stayed still and puts islands of touching colliders to sleep, or wakes them up
+    void update_sleep();
+
+    // Trigger pair of two asleep colliders is skipped, so it keeps the state from the previous step
+    void keep_sleeping_trigger_pair(Collider2D const& first, Collider2D const& second);
+
+    u32 find_island(u32 index);
+
+    // Sends trigger enter and exit events by diffing the trigger pairs of this step with the previous one
+    void dispatch_trigger_events();
+
+    ColliderHandle acquire_handle(std::shared_ptr<Collider2D> const& collider);
+    void release_handle(ColliderHandle const handle);
+    [[nodiscard]] std::shared_ptr<Collider2D> resolve_handle(ColliderHandle const handle) const;
+
+    // Rewrites the store row of the collider, with its live center. Used when it moved during the narrowphase.
+    void refresh_store_row(u32 const index);
+    [[nodiscard]] bool is_store_row_stale(u32 const index) const;
+
+    static constexpr std::array<u32, collision_layer_count> make_filled_layer_matrix()
+    {
+        std::array<u32, collision_layer_count> matrix = {};
+        matrix.fill(all_collision_layers);
+        return matrix;
+    }
+
+    static glm::vec2 get_closest_point_on_obb(glm::vec2 const& point, glm::vec2 const& center, std::array<glm::vec2, 2> const& axes,
+                                              glm::vec2 const& half_extents);
+    static bool raycast_collider(Collider2D const& collider, glm::vec2 const& origin, glm::vec2 const& direction, float const max_distance,
+                                 RaycastHit2D& hit);
+
+    struct ColliderSlot
+    {
+        std::weak_ptr<Collider2D> collider = {};
+        u32 generation = 0;
+        bool is_registered = false;
+        bool is_released = false;
+    };
+
+    // Unordered pair of overlapping colliders where at least one is a trigger. First always has the smaller slot.
+    struct TriggerPair
+    {
+        ColliderHandle first = {};
+        ColliderHandle second = {};
+
+        auto operator<=>(TriggerPair const&) const = default;
+    };
 
     std::vector<std::shared_ptr<Collider2D>> colliders = {};
 
+    std::vector<ColliderSlot> m_collider_slots = {};
+    std::vector<u32> m_free_slots = {};
+
+    // Slots are recycled only after the next diff, so exits of removed colliders can still be resolved
+    std::vector<u32> m_released_slots = {};
+    std::vector<u32> m_slots_to_recycle = {};
+
+    // Both sorted, swapped every step so they don't allocate once warmed up
+    std::vector<TriggerPair> m_trigger_pairs = {};
+    std::vector<TriggerPair> m_previous_trigger_pairs = {};
+
+    // Row per layer, bit per layer it collides with
+    std::array<u32, collision_layer_count> m_layer_collision_matrix = make_filled_layer_matrix();
+
+    Broadphase m_broadphase = {};
+    DynamicAABBTree m_tree = {};
+    std::vector<BroadphaseProxy> m_proxies = {};
+    std::vector<ColliderPair> m_pairs = {};
+
+    ContactSolver m_solver = {};
+    std::vector<SolverBody> m_solver_bodies = {};
+
+    ColliderStore m_store = {};
+    CollisionKernels m_kernels = {};
+    std::vector<NarrowphaseResult> m_narrowphase_results = {};
+
+    bool m_is_narrowphase_multithreaded = !PHYSICS_SINGLE_THREADED;
+
+    // Pairs of non-static colliders that touched this step or were skipped asleep, they link islands
+    std::vector<ColliderPair> m_island_pairs = {};
+    std::vector<u32> m_island_parents = {};
+    std::vector<u32> m_island_still_steps = {};
+
+    // Set when colliders are added or removed, which shifts indices of the pairs that are being resolved
+    bool m_colliders_changed = false;
+
+    // Set while the pairs are resolved by index. Callbacks can add colliders but must not remove any, entities are only
+    // destroyed at the end of the frame and are skipped once they are queued.
+    bool m_is_resolving_pairs = false;
+
+    PhysicsStats m_stats = {};
+
     double m_accumulated_delta = 0.0;
+    u32 m_max_substeps = 8;
+    bool m_should_carry_leftover_time = false;
+    u32 m_max_carried_steps = 8;
+    u32 m_dropped_steps = 0;
+
+    bool m_is_interpolation_enabled = true;
+    std::vector<u32> m_interpolated_colliders = {};
 
     inline static std::shared_ptr<PhysicsEngine> m_instance;
 };
@@ -12,7 +12,7 @@
 
 std::shared_ptr<PointLight> PointLight::create()
 {
-    auto point_light = std::make_shared<PointLight>(AK::Badge<PointLight> {});
+    auto point_light = AK::make_pooled<PointLight>(AK::Badge<PointLight> {});
 
     if (RENDER_POINT_SHADOW_MAPS)
     {
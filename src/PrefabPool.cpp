@@ -0,0 +1,237 @@
+#include "PrefabPool.h"
+
+#include "Entity.h"
+#include "SceneSerializer.h"
+
+#include <algorithm>
+
+void PrefabPool::set_capacity(std::string const& prefab_name, u32 const capacity)
+{
+    Pool& pool = m_pools[prefab_name];
+    pool.capacity = capacity;
+
+    while (pool.parked.size() > capacity)
+    {
+        auto const entity = std::move(pool.parked.back());
+        pool.parked.pop_back();
+
+        entity->m_prefab_instance = nullptr;
+        entity->destroy();
+    }
+}
+
+u32 PrefabPool::get_capacity(std::string const& prefab_name) const
+{
+    auto const it = m_pools.find(prefab_name);
+    return it != m_pools.end() ? it->second.capacity : 0;
+}
+
+std::shared_ptr<Entity> PrefabPool::acquire(std::string const& prefab_name)
+{
+    Pool& pool = m_pools[prefab_name];
+
+    while (!pool.parked.empty())
+    {
+        auto const entity = std::move(pool.parked.back());
+        pool.parked.pop_back();
+
+        if (unpark(*entity->m_prefab_instance))
+        {
+            pool.hits += 1;
+            return entity;
+        }
+
+        // Destroyed while parked or the prefab has changed since
+        entity->m_prefab_instance = nullptr;
+
+        if (!entity->m_is_being_destroyed)
+            entity->destroy();
+    }
+
+    pool.misses += 1;
+
+    if (pool.capacity == 0)
+        return SceneSerializer::load_prefab(prefab_name);
+
+    auto instance = std::make_shared<PrefabInstance>();
+    instance->prefab_name = prefab_name;
+
+    auto const entity = SceneSerializer::load_prefab_instance(prefab_name, instance.get());
+
+    // Not instantiated from the prefab cache, there is nothing to reset it with
+    if (entity == nullptr || instance->guids.empty())
+        return entity;
+
+    for (auto const& instance_entity : instance->entities)
+    {
+        for (auto const& component : instance_entity.lock()->components)
+        {
+            instance->enabled_components.emplace_back(component->enabled());
+        }
+    }
+
+    for (auto const& child : find_foreign_children(*instance))
+    {
+        instance->created_children.emplace_back(child);
+    }
+
+    entity->m_prefab_instance = std::move(instance);
+
+    return entity;
+}
+
+bool PrefabPool::release(std::shared_ptr<Entity> const& entity)
+{
+    auto const instance = entity->m_prefab_instance;
+
+    if (instance == nullptr)
+        return false;
+
+    if (instance->is_parked)
+        return true;
+
+    Pool& pool = m_pools[instance->prefab_name];
+    pool.releases += 1;
+
+    if (pool.parked.size() >= pool.capacity || !can_reuse(*instance))
+    {
+        pool.discards += 1;
+        return false;
+    }
+
+    park(*instance);
+    pool.parked.emplace_back(entity);
+
+    return true;
+}
+
+void PrefabPool::clear()
+{
+    for (auto& [name, pool] : m_pools)
+    {
+        pool.parked.clear();
+    }
+}
+
+std::vector<PrefabPoolStats> PrefabPool::get_stats() const
+{
+    std::vector<PrefabPoolStats> stats = {};
+    stats.reserve(m_pools.size());
+
+    for (auto const& [name, pool] : m_pools)
+    {
+        PrefabPoolStats pool_stats = {};
+        pool_stats.name = name;
+        pool_stats.capacity = pool.capacity;
+        pool_stats.parked = static_cast<u32>(pool.parked.size());
+        pool_stats.hits = pool.hits;
+        pool_stats.misses = pool.misses;
+        pool_stats.releases = pool.releases;
+        pool_stats.discards = pool.discards;
+        stats.emplace_back(pool_stats);
+    }
+
+    std::ranges::sort(stats, {}, &PrefabPoolStats::name);
+
+    return stats;
+}
+
+bool PrefabPool::can_reuse(PrefabInstance const& instance)
+{
+    u32 component_count = 0;
+
+    for (auto const& instance_entity : instance.entities)
+    {
+        auto const entity = instance_entity.lock();
+
+        if (entity == nullptr || entity->m_is_being_destroyed || entity->m_is_queued_for_destruction)
+            return false;
+
+        component_count += static_cast<u32>(entity->components.size());
+    }
+
+    return component_count == instance.enabled_components.size();
+}
+
+std::vector<std::shared_ptr<Entity>> PrefabPool::find_foreign_children(PrefabInstance const& instance)
+{
+    auto const contains = [](std::vector<std::weak_ptr<Entity>> const& entities, std::shared_ptr<Entity> const& entity) {
+        return std::ranges::any_of(entities, [&](std::weak_ptr<Entity> const& other) { return other.lock() == entity; });
+    };
+
+    std::vector<std::shared_ptr<Entity>> foreign_children = {};
+
+    for (auto const& instance_entity : instance.entities)
+    {
+        for (auto const& child : instance_entity.lock()->transform->children)
+        {
+            auto const child_entity = child->entity.lock();
+
+            if (child_entity == nullptr || contains(instance.entities, child_entity) || contains(instance.created_children, child_entity))
+                continue;
+
+            foreign_children.emplace_back(child_entity);
+        }
+    }
+
+    return foreign_children;
+}
+
+void PrefabPool::park(PrefabInstance& instance)
+{
+    instance.is_parked = true;
+
+    auto const root = instance.entities.front().lock();
+
+    if (!root->transform->parent.expired())
+        root->transform->set_parent(nullptr);
+
+    // Children attached after the instance was created, like particles simulated in local space, are not parked with it
+    for (auto const& child : find_foreign_children(instance))
+    {
+        child->destroy();
+    }
+
+    for (auto const& instance_entity : instance.entities)
+    {
+        auto const entity = instance_entity.lock();
+        entity->is_serialized = false;
+        entity->m_is_parked = true;
+
+        // Registering them again is what makes respawning expensive, the renderer and physics skip them instead
+        for (auto const& component : entity->components)
+        {
+            ComponentType const type = component->get_type();
+
+            if (is_component_type_of(type, ComponentType::Drawable) || is_component_type_of(type, ComponentType::Collider2D))
+                continue;
+
+            component->set_enabled(false);
+        }
+    }
+}
+
+bool PrefabPool::unpark(PrefabInstance& instance)
+{
+    if (!can_reuse(instance) || !SceneSerializer::reset_prefab_instance(instance))
+        return false;
+
+    u32 component_index = 0;
+
+    for (auto const& instance_entity : instance.entities)
+    {
+        auto const entity = instance_entity.lock();
+        entity->is_serialized = true;
+        entity->m_is_parked = false;
+
+        for (auto const& component : entity->components)
+        {
+            component->set_enabled(instance.enabled_components[component_index]);
+            component_index += 1;
+        }
+    }
+
+    instance.is_parked = false;
+
+    return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "AK/Types.h"
+
+class Entity;
+
+struct PrefabPoolStats
+{
+    std::string name = {};
+    u32 capacity = 0;
+    u32 parked = 0;
+    u32 hits = 0;
+    u32 misses = 0;
+    u32 releases = 0;
+
+    // Releases that destroyed the instance, because the pool was full or a part of the instance was destroyed
+    u32 discards = 0;
+};
+
+// Instance of a pooled prefab, kept by its root entity. Entities are in the order of the prefab file.
+struct PrefabInstance
+{
+    std::string prefab_name = {};
+    std::vector<std::string> guids = {};
+    std::vector<std::weak_ptr<Entity>> entities = {};
+
+    // Children the components created for themselves, like debug drawings, they stay with the instance when it's parked
+    std::vector<std::weak_ptr<Entity>> created_children = {};
+
+    // Whether every component of the entities, in order, was enabled once the instance was created
+    std::vector<bool> enabled_components = {};
+
+    bool is_parked = false;
+};
+
+// Released instances of short lived prefabs are parked in the scene instead of being destroyed. Their entities are
+// inactive, drawables and colliders stay registered and are skipped, the other components are disabled.
+// acquire() assigns a parked instance the prefab's values again and activates it, without creating anything.
+// Only prefabs given a capacity are pooled.
+// NOTE: A parked instance is still alive, anything holding a reference to it has to drop it when releasing it.
+//       Components keeping state besides their serialized fields have to reset it in reprepare().
+class PrefabPool
+{
+public:
+    PrefabPool() = default;
+
+    PrefabPool(PrefabPool const&) = delete;
+    void operator=(PrefabPool const&) = delete;
+
+    // Number of parked instances kept for the prefab, 0 doesn't pool it
+    void set_capacity(std::string const& prefab_name, u32 const capacity);
+    [[nodiscard]] u32 get_capacity(std::string const& prefab_name) const;
+
+    // Parked instance of the prefab, or a new one when there is none
+    std::shared_ptr<Entity> acquire(std::string const& prefab_name);
+
+    // Called by Entity::destroy() and destroy_immediate() for the root of a pooled instance.
+    // Returns false when the instance can't be parked and has to be destroyed.
+    bool release(std::shared_ptr<Entity> const& entity);
+
+    // Forgets the parked instances, they are destroyed with the scene
+    void clear();
+
+    // Sorted by prefab name
+    [[nodiscard]] std::vector<PrefabPoolStats> get_stats() const;
+
+private:
+    struct Pool
+    {
+        u32 capacity = 0;
+        std::vector<std::shared_ptr<Entity>> parked = {};
+
+        u32 hits = 0;
+        u32 misses = 0;
+        u32 releases = 0;
+        u32 discards = 0;
+    };
+
+    [[nodiscard]] static bool can_reuse(PrefabInstance const& instance);
+
+    // Children of the instance's entities that are neither part of the prefab nor created together with it
+    [[nodiscard]] static std::vector<std::shared_ptr<Entity>> find_foreign_children(PrefabInstance const& instance);
+
+    static void park(PrefabInstance& instance);
+    [[nodiscard]] static bool unpark(PrefabInstance& instance);
+
+    std::unordered_map<std::string, Pool> m_pools = {};
+};
@@ -1,11 +1,13 @@
 #include "Renderer.h"
 
+#include <algorithm>
 #include <array>
 #include <format>
 #include <glad/glad.h>
 #include <glm/gtx/rotate_vector.hpp>
 #include <glm/gtx/string_cast.hpp>
 #include <iostream>
+#include <iterator>
 
 #include "AK/AK.h"
 #include "Camera.h"
@@ -55,14 +57,17 @@ void Renderer::unregister_shader(std::shared_ptr<Shader> const& shader)
 
 bool Renderer::is_drawable_registered(std::shared_ptr<Drawable> const& drawable) const
 {
-    return std::ranges::find(drawable->material->drawables.begin(), drawable->material->drawables.end(), drawable)
-        != drawable->material->drawables.end();
+    auto const& drawables = drawable->material->drawables;
+    u32 const slot = drawable->m_material_slot;
+
+    return slot < drawables.size() && drawables[slot] == drawable;
 }
 
 void Renderer::register_drawable(std::shared_ptr<Drawable> const& drawable)
 {
     bool const should_register_material = drawable->material->drawables.size() == 0;
 
+    drawable->m_material_slot = static_cast<u32>(drawable->material->drawables.size());
     drawable->material->drawables.emplace_back(drawable);
 
     if (should_register_material)
@@ -73,9 +78,24 @@ void Renderer::register_drawable(std::shared_ptr<Drawable> const& drawable)
 
 void Renderer::unregister_drawable(std::shared_ptr<Drawable> const& drawable)
 {
-    AK::swap_and_erase(drawable->material->drawables, drawable);
+    auto& drawables = drawable->material->drawables;
+
+    if (is_drawable_registered(drawable))
+    {
+        u32 const slot = drawable->m_material_slot;
+
+        // NOTE: Swap with last and pop to avoid shifting other elements.
+        if (slot != drawables.size() - 1)
+        {
+            drawables[slot] = std::move(drawables.back());
+            drawables[slot]->m_material_slot = slot;
+        }
+
+        drawables.pop_back();
+        drawable->m_material_slot = std::numeric_limits<u32>::max();
+    }
 
-    if (drawable->material->drawables.size() == 0)
+    if (drawables.size() == 0)
     {
         unregister_material(drawable->material);
     }
@@ -156,50 +176,49 @@ void Renderer::unregister_material(std::shared_ptr<Material> const& material)
 
 bool Renderer::is_light_registered(std::shared_ptr<Light> const& light) const
 {
-    if (auto const potential_point_light = std::dynamic_pointer_cast<PointLight>(light))
+    switch (light->get_type())
     {
-        return std::ranges::find(m_point_lights.begin(), m_point_lights.end(), potential_point_light) != m_point_lights.end();
-    }
+    case ComponentType::PointLight:
+        return std::ranges::find(m_point_lights, std::static_pointer_cast<PointLight>(light)) != m_point_lights.end();
 
-    if (auto const potential_spot_light = std::dynamic_pointer_cast<SpotLight>(light))
-    {
-        return std::ranges::find(m_spot_lights.begin(), m_spot_lights.end(), potential_spot_light) != m_spot_lights.end();
-    }
+    case ComponentType::SpotLight:
+        return std::ranges::find(m_spot_lights, std::static_pointer_cast<SpotLight>(light)) != m_spot_lights.end();
 
-    if (auto const potential_directional_light = std::dynamic_pointer_cast<DirectionalLight>(light))
-    {
-        return m_directional_light == potential_directional_light;
-    }
+    case ComponentType::DirectionalLight:
+        return m_directional_light == std::static_pointer_cast<DirectionalLight>(light);
 
-    std::unreachable();
+    default:
+        std::unreachable();
+    }
 }
 
 void Renderer::register_light(std::shared_ptr<Light> const& light)
 {
-    if (auto const potential_point_light = std::dynamic_pointer_cast<PointLight>(light))
+    switch (light->get_type())
     {
+    case ComponentType::PointLight:
         if (m_point_lights.size() >= MAX_POINT_LIGHTS)
         {
             Debug::log("You've reached the limit of point lights!", DebugType::Error);
         }
         else
         {
-            m_point_lights.emplace_back(potential_point_light);
+            m_point_lights.emplace_back(std::static_pointer_cast<PointLight>(light));
         }
-    }
-    else if (auto const potential_spot_light = std::dynamic_pointer_cast<SpotLight>(light))
-    {
+        break;
+
+    case ComponentType::SpotLight:
         if (m_spot_lights.size() >= MAX_SPOT_LIGHTS)
         {
             Debug::log("You've reached the limit of spot lights!", DebugType::Error);
         }
         else
         {
-            m_spot_lights.emplace_back(potential_spot_light);
+            m_spot_lights.emplace_back(std::static_pointer_cast<SpotLight>(light));
         }
-    }
-    else if (auto const potential_directional_light = std::dynamic_pointer_cast<DirectionalLight>(light))
-    {
+        break;
+
+    case ComponentType::DirectionalLight:
         if (m_directional_light != nullptr)
         {
             Debug::log("You've just added a second directional light to the scene. You need to remove this one, remove the original, and "
@@ -207,7 +226,11 @@ void Renderer::register_light(std::shared_ptr<Light> const& light)
                        DebugType::Error);
         }
 
-        m_directional_light = potential_directional_light;
+        m_directional_light = std::static_pointer_cast<DirectionalLight>(light);
+        break;
+
+    default:
+        break;
     }
 
     m_lights.emplace_back(light);
@@ -215,17 +238,22 @@ void Renderer::register_light(std::shared_ptr<Light> const& light)
 
 void Renderer::unregister_light(std::shared_ptr<Light> const& light)
 {
-    if (auto const potential_point_light = std::dynamic_pointer_cast<PointLight>(light))
-    {
-        AK::swap_and_erase(m_point_lights, potential_point_light);
-    }
-    else if (auto const potential_spot_light = std::dynamic_pointer_cast<SpotLight>(light))
-    {
-        AK::swap_and_erase(m_spot_lights, potential_spot_light);
-    }
-    else if (auto const potential_directional_light = std::dynamic_pointer_cast<DirectionalLight>(light))
+    switch (light->get_type())
     {
+    case ComponentType::PointLight:
+        AK::swap_and_erase(m_point_lights, std::static_pointer_cast<PointLight>(light));
+        break;
+
+    case ComponentType::SpotLight:
+        AK::swap_and_erase(m_spot_lights, std::static_pointer_cast<SpotLight>(light));
+        break;
+
+    case ComponentType::DirectionalLight:
         m_directional_light = nullptr;
+        break;
+
+    default:
+        break;
     }
 }
 
@@ -457,6 +485,9 @@ void Renderer::draw(std::shared_ptr<Material> const& material, glm::mat4 const&
 
     for (auto const& drawable : material->drawables)
     {
+        if (!drawable->entity->is_active())
+            continue;
+
         update_object(drawable, material, projection_view);
 
         if (material->is_billboard)
@@ -522,7 +553,8 @@ void Renderer::draw_transparent(glm::mat4 const& projection_view, glm::mat4 cons
 
     for (auto const& material : m_transparent_materials)
     {
-        transparent_drawables.insert(transparent_drawables.end(), material->drawables.begin(), material->drawables.end());
+        std::ranges::copy_if(material->drawables, std::back_inserter(transparent_drawables),
+                             [](std::shared_ptr<Drawable> const& drawable) { return drawable->entity->is_active(); });
     }
 
     std::shared_ptr<Camera> const camera = Camera::get_main_camera();
@@ -229,7 +229,7 @@ void RendererGL::perform_frustum_culling(std::shared_ptr<Material> const& materi
     // TODO: Pass visible instances directly to the shader by a shared SSBO. Might not actually be beneficial?
     for (u32 i = 0; i < material->drawables.size(); ++i)
     {
-        if (visible_instances[i] == 1)
+        if (visible_instances[i] == 1 && material->drawables[i]->entity->is_active())
         {
             material->model_matrices.emplace_back(material->drawables[i]->entity->transform->get_model_matrix());
         }
@@ -0,0 +1,94 @@
+#include "Rigidbody2D.h"
+
+#include "Collider2D.h"
+#include "Entity.h"
+
+#if EDITOR
+#include "imgui_extensions.h"
+#endif
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include <algorithm>
+
+std::shared_ptr<Rigidbody2D> Rigidbody2D::create()
+{
+    return AK::make_pooled<Rigidbody2D>(AK::Badge<Rigidbody2D> {});
+}
+
+Rigidbody2D::Rigidbody2D(AK::Badge<Rigidbody2D>)
+{
+}
+
+#if EDITOR
+void Rigidbody2D::draw_editor()
+{
+    Component::draw_editor();
+
+    ImGuiEx::InputFloat("Mass", &mass);
+    mass = std::max(mass, 0.0f);
+
+    ImGui::SliderFloat("Restitution", &restitution, 0.0f, 1.0f);
+    ImGuiEx::InputFloat("Drag", &drag);
+    ImGuiEx::InputFloat2("Velocity", glm::value_ptr(velocity));
+
+    if (get_collider() == nullptr)
+    {
+        ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Needs a Collider2D on the same entity.");
+    }
+}
+#endif
+
+void Rigidbody2D::initialize()
+{
+    Component::initialize();
+
+    // Collider added earlier didn't find this body in its initialize()
+    if (auto const collider = get_collider(); collider != nullptr)
+    {
+        collider->m_rigidbody = this;
+    }
+}
+
+void Rigidbody2D::uninitialize()
+{
+    Component::uninitialize();
+
+    if (auto const collider = get_collider(); collider != nullptr && collider->m_rigidbody == this)
+    {
+        collider->m_rigidbody = nullptr;
+    }
+}
+
+void Rigidbody2D::add_impulse(glm::vec2 const impulse)
+{
+    velocity += impulse * get_inverse_mass();
+
+    if (auto const collider = get_collider(); collider != nullptr)
+    {
+        collider->wake_up();
+    }
+}
+
+void Rigidbody2D::add_force(glm::vec2 const force)
+{
+    m_force += force;
+
+    if (auto const collider = get_collider(); collider != nullptr)
+    {
+        collider->wake_up();
+    }
+}
+
+float Rigidbody2D::get_inverse_mass() const
+{
+    return mass > 0.0f ? 1.0f / mass : 0.0f;
+}
+
+std::shared_ptr<Collider2D> Rigidbody2D::get_collider() const
+{
+    if (entity == nullptr)
+        return nullptr;
+
+    return entity->get_component<Collider2D>();
+}
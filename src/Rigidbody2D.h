@@ -0,0 +1,49 @@
+#pragma once
+
+#include "AK/Badge.h"
+#include "Component.h"
+
+#include <glm/vec2.hpp>
+
+class Collider2D;
+
+// Dynamic body of the Collider2D on the same entity. Its contacts are resolved by the PhysicsEngine's impulse solver,
+// which moves it once per step. Colliders without a Rigidbody2D are still pushed out by their MTV.
+class Rigidbody2D final : public Component
+{
+public:
+    static std::shared_ptr<Rigidbody2D> create();
+
+    explicit Rigidbody2D(AK::Badge<Rigidbody2D>);
+
+#if EDITOR
+    virtual void draw_editor() override;
+#endif
+
+    virtual void initialize() override;
+    virtual void uninitialize() override;
+
+    // Changes the velocity right away, scaled by the inverse mass
+    void add_impulse(glm::vec2 const impulse);
+
+    // Accelerates the body during the next fixed step
+    void add_force(glm::vec2 const force);
+
+    // Zero for bodies with no mass, which the solver doesn't move
+    [[nodiscard]] float get_inverse_mass() const;
+
+    float mass = 1.0f;
+
+    // 0 stops the body at the contact, 1 bounces it off with the same speed
+    float restitution = 0.0f;
+
+    float drag = 0.01f;
+    glm::vec2 velocity = {};
+
+private:
+    [[nodiscard]] std::shared_ptr<Collider2D> get_collider() const;
+
+    glm::vec2 m_force = {};
+
+    friend class PhysicsEngine;
+};
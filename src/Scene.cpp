@@ -1,13 +1,37 @@
 #include "Scene.h"
 
 #include "AK/AK.h"
+#include "Engine.h"
 #include "Entity.h"
 #include "ResourceManager.h"
 
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+
+class BenchmarkCounter final : public Component
+{
+public:
+    u32 count = 0;
+};
+
+class BenchmarkAccumulator final : public Component
+{
+public:
+    float value = 0.0f;
+};
+
+}
+
 void Scene::unload()
 {
     // TODO: We should probably cache top level entities somewhere or maybe assign them to dummy root entity
     //       (I don't really like either of these).
+    m_prefab_pool.clear();
+    m_level_streamer.clear();
+
     std::vector<std::shared_ptr<Entity>> top_level_entities = {};
     for (auto const& entity : entities)
     {
@@ -15,10 +39,8 @@ void Scene::unload()
             top_level_entities.emplace_back(entity);
     }
 
-    for (auto const& entity : top_level_entities)
-    {
-        entity->destroy_immediate();
-    }
+    destroy_entities(top_level_entities);
+    m_entities_to_destroy.clear();
 
     ResourceManager::get_instance().reset_state();
 }
@@ -26,6 +48,9 @@ void Scene::unload()
 void Scene::add_child(std::shared_ptr<Entity> const& entity)
 {
     entities.emplace_back(entity);
+
+    if (m_is_component_set_index_enabled)
+        m_component_sets.add_entity(*entity);
 }
 
 void Scene::remove_child(std::shared_ptr<Entity> const& entity)
@@ -37,9 +62,119 @@ void Scene::remove_child(std::shared_ptr<Entity> const& entity)
     if (it == entities.end())
         return;
 
+    if (m_is_component_set_index_enabled)
+        m_component_sets.remove_entity(*entity);
+
     entities.erase(it);
 }
 
+void Scene::queue_destroy(std::shared_ptr<Entity> const& entity)
+{
+    m_entities_to_destroy.emplace_back(entity);
+}
+
+void Scene::destroy_queued_entities()
+{
+    // Entities destroyed by on_destroyed() calls are queued again, they are destroyed in the next round
+    while (!m_entities_to_destroy.empty())
+    {
+        auto const roots = std::move(m_entities_to_destroy);
+        m_entities_to_destroy.clear();
+
+        destroy_entities(roots);
+    }
+}
+
+void Scene::destroy_entities(std::span<std::shared_ptr<Entity> const> const roots)
+{
+    // Parents come before their kids. Local, on_destroyed() and the others can destroy entities immediately too.
+    std::vector<std::shared_ptr<Entity>> destroyed = {};
+
+    for (auto const& root : roots)
+    {
+        if (root->m_is_being_destroyed)
+            continue;
+
+        root->m_is_being_destroyed = true;
+        u32 const first = static_cast<u32>(destroyed.size());
+        destroyed.emplace_back(root);
+
+        for (u32 i = first; i < destroyed.size(); ++i)
+        {
+            for (auto const& child : destroyed[i]->transform->children)
+            {
+                auto const child_entity = child->entity.lock();
+
+                if (child_entity == nullptr || child_entity->m_is_being_destroyed)
+                    continue;
+
+                child_entity->m_is_being_destroyed = true;
+                destroyed.emplace_back(child_entity);
+            }
+        }
+    }
+
+    if (destroyed.empty())
+        return;
+
+    for (auto const& entity : destroyed)
+    {
+        for (u32 i = 0; i < entity->components.size(); ++i)
+        {
+            entity->components[i]->on_destroyed();
+        }
+    }
+
+    for (auto const& entity : destroyed)
+    {
+        if (m_is_component_set_index_enabled)
+            m_component_sets.remove_entity(*entity);
+    }
+
+    // Every list is filtered once, keeping the order of what remains
+    std::erase_if(entities, [](auto const& entity) { return entity->m_is_being_destroyed; });
+
+    auto const is_destroyed = [](auto const& component) {
+        return component->entity != nullptr && component->entity->m_is_being_destroyed;
+    };
+    std::erase_if(components_to_awake, is_destroyed);
+    std::erase_if(components_to_start, is_destroyed);
+
+    bool const is_game_running = Engine::is_game_running();
+
+    for (auto const& entity : destroyed)
+    {
+        for (u32 i = 0; i < entity->components.size(); ++i)
+        {
+            Component& component = *entity->components[i];
+            component.set_can_tick(false);
+
+            if (is_game_running)
+                component.set_enabled(false);
+
+            component.uninitialize();
+            component.entity = nullptr;
+        }
+    }
+
+    // Only the roots leave a parent that is still alive, the rest of the hierarchy is dropped as a whole
+    for (auto const& entity : destroyed)
+    {
+        auto const parent = entity->transform->parent.lock();
+        auto const parent_entity = parent != nullptr ? parent->entity.lock() : nullptr;
+
+        if (parent_entity != nullptr && !parent_entity->m_is_being_destroyed)
+            entity->transform->set_parent(nullptr);
+        else
+            entity->transform->parent.reset();
+    }
+
+    for (auto const& entity : destroyed)
+    {
+        entity->transform->children.clear();
+    }
+}
+
 void Scene::add_component_to_awake(std::shared_ptr<Component> const& component)
 {
     components_to_awake.emplace_back(component);
@@ -122,6 +257,9 @@ void Scene::run_frame()
         components_to_awake.shrink_to_fit();
     }
 
+    // Levels being streamed in create, prepare and awake their components within the frame budget
+    m_level_streamer.update();
+
     // Call Start on every component that hasn't been started yet
     auto const copy_components_to_start = this->components_to_start;
     for (auto const& component : copy_components_to_start)
@@ -135,28 +273,154 @@ void Scene::run_frame()
     // Call Update on every tickable component
 
     // Scene Entities vector might be modified by components, ex. when they create new entities
-    // TODO: Destroying entities is not handled properly. But we don't support any way of destroying an entity anyway, so...
 
-    // TODO: Don't make a copy of tickable components every frame, since they will most likely not change frequently, so we might
-    //       just manually manage the vector?
-    auto const components_copy = tickable_components;
-    for (auto const& component : components_copy)
+    // Components made tickable or not tickable by other components are added or removed once all of them are updated
+    tickable_components.update();
+}
+
+void Scene::run_physics_frame()
+{
+    tickable_components.for_all([this](std::span<Component* const> const components) { m_fixed_update_scheduler.run(components); });
+}
+
+void Scene::set_component_set_index_enabled(bool const value)
+{
+    if (m_is_component_set_index_enabled == value)
+        return;
+
+    m_is_component_set_index_enabled = value;
+
+    if (!value)
     {
-        if (component == nullptr || component->entity == nullptr || !component->enabled())
-            continue;
+        m_component_sets.clear();
+        return;
+    }
 
-        component->update();
+    for (auto const& entity : entities)
+    {
+        m_component_sets.add_entity(*entity);
     }
 }
 
-void Scene::run_physics_frame() const
+bool Scene::is_component_set_index_enabled() const
+{
+    return m_is_component_set_index_enabled;
+}
+
+ComponentSetIndex& Scene::get_component_set_index()
+{
+    return m_component_sets;
+}
+
+FixedUpdateScheduler& Scene::get_fixed_update_scheduler()
+{
+    return m_fixed_update_scheduler;
+}
+
+PrefabPool& Scene::get_prefab_pool()
+{
+    return m_prefab_pool;
+}
+
+LevelStreamer& Scene::get_level_streamer()
+{
+    return m_level_streamer;
+}
+
+void Scene::update_component_set(Entity& entity)
+{
+    if (m_is_component_set_index_enabled)
+        m_component_sets.update_entity(entity);
+}
+
+SceneQueryBenchmark Scene::benchmark_query(u32 const entity_count, u32 const iterations)
 {
-    auto const components_copy = tickable_components;
-    for (auto const& component : components_copy)
+    SceneQueryBenchmark benchmark = {};
+
+    std::vector<std::shared_ptr<Entity>> benchmark_entities = {};
+    benchmark_entities.reserve(entity_count);
+
+    // Interleaved, a third of the entities have both types
+    for (u32 i = 0; i < entity_count; ++i)
     {
-        if (component == nullptr || component->entity == nullptr || !component->enabled())
-            continue;
+        auto const entity = Entity::create_internal("Benchmark");
+
+        if (i % 3 != 2)
+            entity->add_component_internal(std::make_shared<BenchmarkCounter>());
+
+        if (i % 3 != 0)
+            entity->add_component_internal(std::make_shared<BenchmarkAccumulator>());
+
+        benchmark_entities.emplace_back(entity);
+    }
+
+    ComponentSetIndex index = {};
+
+    for (auto const& entity : benchmark_entities)
+    {
+        index.add_entity(*entity);
+    }
+
+    // Same lookup as the index, neither of the types is known to EngineHeaderTool
+    auto const find_component = [](Entity const& entity, std::type_info const& type) -> Component* {
+        for (auto const& component : entity.components)
+        {
+            if (typeid(*component) == type)
+                return component.get();
+        }
+
+        return nullptr;
+    };
+
+    auto const visit = [&benchmark](Entity&, BenchmarkCounter& counter, BenchmarkAccumulator& accumulator) {
+        accumulator.value = accumulator.value * 0.5f + static_cast<float>(counter.count);
+        counter.count += 1;
+        benchmark.matches += 1;
+    };
 
-        component->fixed_update();
+    auto const scan = [&] {
+        for (auto const& entity : benchmark_entities)
+        {
+            auto const counter = find_component(*entity, typeid(BenchmarkCounter));
+            auto const accumulator = find_component(*entity, typeid(BenchmarkAccumulator));
+
+            if (counter != nullptr && accumulator != nullptr)
+                visit(*entity, *static_cast<BenchmarkCounter*>(counter), *static_cast<BenchmarkAccumulator*>(accumulator));
+        }
+    };
+
+    benchmark.entities = entity_count;
+    benchmark.component_sets = index.get_set_count();
+    benchmark.iterations = std::max(iterations, 1u);
+
+    // Warm up, the first passes touch every entity for the first time
+    scan();
+    index.for_each<BenchmarkCounter, BenchmarkAccumulator>(visit);
+
+    // Alternating, so both of them run with the same state of the caches and clocks
+    for (u32 i = 0; i < benchmark.iterations; ++i)
+    {
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        scan();
+
+        auto const middle = std::chrono::high_resolution_clock::now();
+
+        index.for_each<BenchmarkCounter, BenchmarkAccumulator>(visit);
+
+        auto const end = std::chrono::high_resolution_clock::now();
+
+        benchmark.scan_seconds += std::chrono::duration<double>(middle - start).count();
+        benchmark.index_seconds += std::chrono::duration<double>(end - middle).count();
     }
+
+    benchmark.scan_seconds /= benchmark.iterations;
+    benchmark.index_seconds /= benchmark.iterations;
+
+    // Of a single pass
+    benchmark.matches /= (benchmark.iterations + 1) * 2;
+
+    index.clear();
+
+    return benchmark;
 }
@@ -1,11 +1,28 @@
 #pragma once
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "Component.h"
+#include "ComponentSetIndex.h"
+#include "FixedUpdateScheduler.h"
+#include "LevelStreamer.h"
+#include "PrefabPool.h"
 
 class Entity;
 
+struct SceneQueryBenchmark
+{
+    u32 entities = 0;
+    u32 matches = 0;
+    u32 component_sets = 0;
+    u32 iterations = 0;
+
+    // Average of a single pass over the matching entities
+    double scan_seconds = 0.0;
+    double index_seconds = 0.0;
+};
+
 class Scene
 {
 public:
@@ -16,6 +33,16 @@ public:
     void add_child(std::shared_ptr<Entity> const& entity);
     void remove_child(std::shared_ptr<Entity> const& entity);
 
+    // Use Entity::destroy() instead
+    void queue_destroy(std::shared_ptr<Entity> const& entity);
+
+    // Destroys the entities queued by Entity::destroy(), called once at the end of every frame
+    void destroy_queued_entities();
+
+    // Destroys the entities and all of their children in one pass over every registry, instead of one pass per entity.
+    // Entities destroyed already are skipped.
+    void destroy_entities(std::span<std::shared_ptr<Entity> const> const roots);
+
     void add_component_to_awake(std::shared_ptr<Component> const& component);
     void remove_component_to_awake(std::shared_ptr<Component> const& component);
 
@@ -26,16 +53,47 @@ public:
     [[nodiscard]] std::shared_ptr<Component> get_component_by_guid(std::string const& guid) const;
 
     void run_frame();
-    void run_physics_frame() const;
+    void run_physics_frame();
+
+    // Keeps the entities grouped by the types of their components, for queries over the entities with some types.
+    // Doesn't change how or in which order components are updated.
+    void set_component_set_index_enabled(bool const value);
+    [[nodiscard]] bool is_component_set_index_enabled() const;
+    [[nodiscard]] ComponentSetIndex& get_component_set_index();
+
+    [[nodiscard]] FixedUpdateScheduler& get_fixed_update_scheduler();
+
+    [[nodiscard]] PrefabPool& get_prefab_pool();
+
+    [[nodiscard]] LevelStreamer& get_level_streamer();
+
+    // Called whenever the components of the entity change
+    void update_component_set(Entity& entity);
+
+    // Visits the entities with two types of components by looking at the components of every entity and through a
+    // component set index, iterations times each after a warm up.
+    // Scene independent, components and entities are created only for the benchmark.
+    static SceneQueryBenchmark benchmark_query(u32 const entity_count, u32 const iterations);
 
     bool is_running = false;
 
     std::vector<std::shared_ptr<Entity>> entities = {};
-    std::vector<std::shared_ptr<Component>> tickable_components = {};
+    TickList tickable_components = {};
 
 private:
     std::vector<std::shared_ptr<Component>> components_to_awake = {};
     std::vector<std::shared_ptr<Component>> components_to_start = {};
 
+    std::vector<std::shared_ptr<Entity>> m_entities_to_destroy = {};
+
+    ComponentSetIndex m_component_sets = {};
+    bool m_is_component_set_index_enabled = false;
+
+    FixedUpdateScheduler m_fixed_update_scheduler = {};
+
+    PrefabPool m_prefab_pool = {};
+
+    LevelStreamer m_level_streamer = {};
+
     friend class SceneSerializer;
 };
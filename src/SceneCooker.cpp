@@ -0,0 +1,1188 @@
+#include "SceneCooker.h"
+
+#include "AK/MappedFile.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+#include <yaml-cpp/yaml.h>
+
+namespace
+{
+
+// Serialized fields of every component in the order of their field blocks and their C++ types, generated by EngineHeaderTool
+constexpr auto component_fields = std::to_array<std::tuple<ComponentType, std::string_view, std::string_view>>({
+    // # Auto cooked fields start
+    {ComponentType::Camera, "width", "float"},
+    {ComponentType::Camera, "height", "float"},
+    {ComponentType::Camera, "fov", "float"},
+    {ComponentType::Camera, "near_plane", "float"},
+    {ComponentType::Camera, "far_plane", "float"},
+    {ComponentType::Collider2D, "offset", "glm::vec2"},
+    {ComponentType::Collider2D, "is_trigger", "bool"},
+    {ComponentType::Collider2D, "is_static", "bool"},
+    {ComponentType::Collider2D, "is_continuous", "bool"},
+    {ComponentType::Collider2D, "collision_layer", "u32"},
+    {ComponentType::Collider2D, "collision_mask", "u32"},
+    {ComponentType::Collider2D, "collider_type", "ColliderType2D"},
+    {ComponentType::Collider2D, "width", "float"},
+    {ComponentType::Collider2D, "height", "float"},
+    {ComponentType::Collider2D, "radius", "float"},
+    {ComponentType::Collider2D, "vertices", "std::vector<glm::vec2>"},
+    {ComponentType::Collider2D, "drag", "float"},
+    {ComponentType::Collider2D, "velocity", "glm::vec2"},
+    {ComponentType::Curve, "points", "std::vector<glm::vec2>"},
+    {ComponentType::Path, "points", "std::vector<glm::vec2>"},
+    {ComponentType::DebugInputController, "gamma", "float"},
+    {ComponentType::DebugInputController, "exposure", "float"},
+    {ComponentType::DialoguePromptController, "interp_speed", "float"},
+    {ComponentType::DialoguePromptController, "dialogue_panel", "std::weak_ptr<Button>"},
+    {ComponentType::DialoguePromptController, "panel_parent", "std::weak_ptr<Entity>"},
+    {ComponentType::DialoguePromptController, "keeper_sprite", "std::weak_ptr<Entity>"},
+    {ComponentType::DialoguePromptController, "upper_text", "std::weak_ptr<ScreenText>"},
+    {ComponentType::DialoguePromptController, "middle_text", "std::weak_ptr<ScreenText>"},
+    {ComponentType::DialoguePromptController, "lower_text", "std::weak_ptr<ScreenText>"},
+    {ComponentType::DialoguePromptController, "dialogue_objects", "std::vector<DialogueObject>"},
+    {ComponentType::Button, "path_default", "std::string"},
+    {ComponentType::Button, "path_hovered", "std::string"},
+    {ComponentType::Button, "path_pressed", "std::string"},
+    {ComponentType::Button, "top_left_corner", "glm::vec2"},
+    {ComponentType::Button, "top_right_corner", "glm::vec2"},
+    {ComponentType::Button, "bottom_left_corner", "glm::vec2"},
+    {ComponentType::Button, "bottom_right_corner", "glm::vec2"},
+    {ComponentType::Button, "material", "std::shared_ptr<Material>"},
+    {ComponentType::Model, "model_path", "std::string"},
+    {ComponentType::Model, "material", "std::shared_ptr<Material>"},
+    {ComponentType::Cube, "diffuse_texture_path", "std::string"},
+    {ComponentType::Cube, "specular_texture_path", "std::string"},
+    {ComponentType::Cube, "model_path", "std::string"},
+    {ComponentType::Cube, "material", "std::shared_ptr<Material>"},
+    {ComponentType::Sphere, "sector_count", "u32"},
+    {ComponentType::Sphere, "stack_count", "u32"},
+    {ComponentType::Sphere, "texture_path", "std::string"},
+    {ComponentType::Sphere, "radius", "float"},
+    {ComponentType::Sphere, "model_path", "std::string"},
+    {ComponentType::Sphere, "material", "std::shared_ptr<Material>"},
+    {ComponentType::Sprite, "diffuse_texture_path", "std::string"},
+    {ComponentType::Sprite, "model_path", "std::string"},
+    {ComponentType::Sprite, "material", "std::shared_ptr<Material>"},
+    {ComponentType::Water, "waves", "std::vector<DXWave>"},
+    {ComponentType::Water, "m_ps_buffer", "ConstantBufferWater"},
+    {ComponentType::Water, "tesselation_level", "u32"},
+    {ComponentType::Water, "model_path", "std::string"},
+    {ComponentType::Water, "material", "std::shared_ptr<Material>"},
+    {ComponentType::Panel, "background_path", "std::string"},
+    {ComponentType::Panel, "material", "std::shared_ptr<Material>"},
+    {ComponentType::ScreenText, "text", "std::string"},
+    {ComponentType::ScreenText, "position", "glm::vec2"},
+    {ComponentType::ScreenText, "font_size", "float"},
+    {ComponentType::ScreenText, "color", "u32"},
+    {ComponentType::ScreenText, "flags", "u16"},
+    {ComponentType::ScreenText, "font_name", "std::string"},
+    {ComponentType::ScreenText, "bold", "bool"},
+    {ComponentType::ScreenText, "button_ref", "std::weak_ptr<Button>"},
+    {ComponentType::ScreenText, "material", "std::shared_ptr<Material>"},
+    {ComponentType::ExampleUIBar, "value", "float"},
+    {ComponentType::Floater, "sink", "float"},
+    {ComponentType::Floater, "side_floaters_offset", "float"},
+    {ComponentType::Floater, "side_roation_strength", "float"},
+    {ComponentType::Floater, "forward_rotation_strength", "float"},
+    {ComponentType::Floater, "forward_floaters_offest", "float"},
+    {ComponentType::Floater, "water", "std::weak_ptr<Water>"},
+    {ComponentType::FloatersManager, "big_boat_settings", "FloaterSettings"},
+    {ComponentType::FloatersManager, "small_boat_settings", "FloaterSettings"},
+    {ComponentType::FloatersManager, "medium_boat_settings", "FloaterSettings"},
+    {ComponentType::FloatersManager, "tool_boat_settings", "FloaterSettings"},
+    {ComponentType::FloatersManager, "pirate_boat_settings", "FloaterSettings"},
+    {ComponentType::FloatersManager, "water", "std::weak_ptr<Water>"},
+    {ComponentType::FloeButton, "floe_button_type", "FloeButtonType"},
+    {ComponentType::DirectionalLight, "ambient", "glm::vec3"},
+    {ComponentType::DirectionalLight, "diffuse", "glm::vec3"},
+    {ComponentType::DirectionalLight, "specular", "glm::vec3"},
+    {ComponentType::DirectionalLight, "m_near_plane", "float"},
+    {ComponentType::DirectionalLight, "m_far_plane", "float"},
+    {ComponentType::DirectionalLight, "m_blocker_search_num_samples", "u32"},
+    {ComponentType::DirectionalLight, "m_pcf_num_samples", "u32"},
+    {ComponentType::DirectionalLight, "m_light_world_size", "float"},
+    {ComponentType::DirectionalLight, "m_light_frustum_width", "float"},
+    {ComponentType::PointLight, "constant", "float"},
+    {ComponentType::PointLight, "linear", "float"},
+    {ComponentType::PointLight, "quadratic", "float"},
+    {ComponentType::PointLight, "ambient", "glm::vec3"},
+    {ComponentType::PointLight, "diffuse", "glm::vec3"},
+    {ComponentType::PointLight, "specular", "glm::vec3"},
+    {ComponentType::PointLight, "m_near_plane", "float"},
+    {ComponentType::PointLight, "m_far_plane", "float"},
+    {ComponentType::PointLight, "m_blocker_search_num_samples", "u32"},
+    {ComponentType::PointLight, "m_pcf_num_samples", "u32"},
+    {ComponentType::PointLight, "m_light_world_size", "float"},
+    {ComponentType::PointLight, "m_light_frustum_width", "float"},
+    {ComponentType::SpotLight, "constant", "float"},
+    {ComponentType::SpotLight, "linear", "float"},
+    {ComponentType::SpotLight, "quadratic", "float"},
+    {ComponentType::SpotLight, "scattering_factor", "float"},
+    {ComponentType::SpotLight, "cut_off", "float"},
+    {ComponentType::SpotLight, "outer_cut_off", "float"},
+    {ComponentType::SpotLight, "ambient", "glm::vec3"},
+    {ComponentType::SpotLight, "diffuse", "glm::vec3"},
+    {ComponentType::SpotLight, "specular", "glm::vec3"},
+    {ComponentType::SpotLight, "m_near_plane", "float"},
+    {ComponentType::SpotLight, "m_far_plane", "float"},
+    {ComponentType::SpotLight, "m_blocker_search_num_samples", "u32"},
+    {ComponentType::SpotLight, "m_pcf_num_samples", "u32"},
+    {ComponentType::SpotLight, "m_light_world_size", "float"},
+    {ComponentType::SpotLight, "m_light_frustum_width", "float"},
+    {ComponentType::ParticleSystem, "particle_type", "ParticleType"},
+    {ComponentType::ParticleSystem, "play_once", "bool"},
+    {ComponentType::ParticleSystem, "rotate_particles", "bool"},
+    {ComponentType::ParticleSystem, "spawn_instantly", "bool"},
+    {ComponentType::ParticleSystem, "sprite_path", "std::string"},
+    {ComponentType::ParticleSystem, "min_spawn_interval", "float"},
+    {ComponentType::ParticleSystem, "max_spawn_interval", "float"},
+    {ComponentType::ParticleSystem, "start_velocity_1", "glm::vec3"},
+    {ComponentType::ParticleSystem, "start_velocity_2", "glm::vec3"},
+    {ComponentType::ParticleSystem, "min_spawn_alpha", "float"},
+    {ComponentType::ParticleSystem, "max_spawn_alpha", "float"},
+    {ComponentType::ParticleSystem, "start_min_particle_size", "glm::vec3"},
+    {ComponentType::ParticleSystem, "start_max_particle_size", "glm::vec3"},
+    {ComponentType::ParticleSystem, "emitter_bounds", "float"},
+    {ComponentType::ParticleSystem, "min_spawn_count", "i32"},
+    {ComponentType::ParticleSystem, "max_spawn_count", "i32"},
+    {ComponentType::ParticleSystem, "start_color_1", "glm::vec4"},
+    {ComponentType::ParticleSystem, "end_color_1", "glm::vec4"},
+    {ComponentType::ParticleSystem, "lifetime_1", "float"},
+    {ComponentType::ParticleSystem, "lifetime_2", "float"},
+    {ComponentType::ParticleSystem, "m_simulate_in_world_space", "bool"},
+    {ComponentType::Rigidbody2D, "mass", "float"},
+    {ComponentType::Rigidbody2D, "restitution", "float"},
+    {ComponentType::Rigidbody2D, "drag", "float"},
+    {ComponentType::Rigidbody2D, "velocity", "glm::vec2"},
+    {ComponentType::Sound, "path", "std::string"},
+    {ComponentType::Sound, "volume", "float"},
+    {ComponentType::Sound, "play_on_awake", "bool"},
+    {ComponentType::Sound, "is_positional", "bool"},
+    {ComponentType::Credits, "back_to_menu_button", "std::weak_ptr<Button>"},
+    {ComponentType::Customer, "collider", "std::weak_ptr<Collider2D>"},
+    {ComponentType::Customer, "left_hand", "std::weak_ptr<Entity>"},
+    {ComponentType::Customer, "right_hand", "std::weak_ptr<Entity>"},
+    {ComponentType::CustomerManager, "destinations_after_feeding", "std::vector<std::weak_ptr<Entity>>"},
+    {ComponentType::CustomerManager, "destination_curve", "std::weak_ptr<Curve>"},
+    {ComponentType::CustomerManager, "customer_prefab", "std::string"},
+    {ComponentType::Factory, "type", "FactoryType"},
+    {ComponentType::Factory, "lights", "std::vector<std::weak_ptr<PointLight>>"},
+    {ComponentType::Factory, "factory_light", "std::weak_ptr<PointLight>"},
+    {ComponentType::GameController, "current_scene", "std::weak_ptr<Entity>"},
+    {ComponentType::GameController, "next_scene", "std::weak_ptr<Entity>"},
+    {ComponentType::GameController, "dialog_manager", "std::weak_ptr<DialoguePromptController>"},
+    {ComponentType::LevelController, "map_time", "float"},
+    {ComponentType::LevelController, "map_food", "u32"},
+    {ComponentType::LevelController, "maximum_lighthouse_level", "i32"},
+    {ComponentType::LevelController, "factories", "std::vector<std::weak_ptr<Factory>>"},
+    {ComponentType::LevelController, "port", "std::weak_ptr<Port>"},
+    {ComponentType::LevelController, "lighthouse", "std::weak_ptr<Lighthouse>"},
+    {ComponentType::LevelController, "customer_manager", "std::weak_ptr<CustomerManager>"},
+    {ComponentType::LevelController, "playfield_width", "float"},
+    {ComponentType::LevelController, "playfield_additional_width", "float"},
+    {ComponentType::LevelController, "playfield_height", "float"},
+    {ComponentType::LevelController, "playfield_y_shift", "float"},
+    {ComponentType::LevelController, "ships_limit_curve", "std::weak_ptr<Curve>"},
+    {ComponentType::LevelController, "ships_limit", "u32"},
+    {ComponentType::LevelController, "ships_speed_curve", "std::weak_ptr<Curve>"},
+    {ComponentType::LevelController, "ships_speed", "float"},
+    {ComponentType::LevelController, "ships_range_curve", "std::weak_ptr<Curve>"},
+    {ComponentType::LevelController, "ships_turn_curve", "std::weak_ptr<Curve>"},
+    {ComponentType::LevelController, "ships_additional_speed_curve", "std::weak_ptr<Curve>"},
+    {ComponentType::LevelController, "pirates_in_control_curve", "std::weak_ptr<Curve>"},
+    {ComponentType::LevelController, "is_tutorial", "bool"},
+    {ComponentType::LevelController, "starting_packages", "u32"},
+    {ComponentType::LevelController, "tutorial_level", "u32"},
+    {ComponentType::Lighthouse, "light", "std::weak_ptr<LighthouseLight>"},
+    {ComponentType::Lighthouse, "water", "std::weak_ptr<Water>"},
+    {ComponentType::Lighthouse, "spawn_position", "std::weak_ptr<Entity>"},
+    {ComponentType::LighthouseKeeper, "maximum_speed", "float"},
+    {ComponentType::LighthouseKeeper, "acceleration", "float"},
+    {ComponentType::LighthouseKeeper, "deceleration", "float"},
+    {ComponentType::LighthouseKeeper, "lighthouse", "std::weak_ptr<Lighthouse>"},
+    {ComponentType::LighthouseKeeper, "port", "std::weak_ptr<Port>"},
+    {ComponentType::LighthouseKeeper, "keeper_dust", "std::weak_ptr<ParticleSystem>"},
+    {ComponentType::LighthouseKeeper, "keeper_splash", "std::weak_ptr<ParticleSystem>"},
+    {ComponentType::LighthouseKeeper, "packages", "std::vector<std::weak_ptr<Entity>>"},
+    {ComponentType::LighthouseLight, "spotlight", "std::weak_ptr<SpotLight>"},
+    {ComponentType::LighthouseLight, "spotlight_beam_width", "float"},
+    {ComponentType::Player, "packages_text", "std::weak_ptr<ScreenText>"},
+    {ComponentType::Player, "flashes_text", "std::weak_ptr<ScreenText>"},
+    {ComponentType::Player, "level_text", "std::weak_ptr<ScreenText>"},
+    {ComponentType::Player, "clock_text", "std::weak_ptr<ScreenText>"},
+    {ComponentType::EndScreen, "is_failed", "bool"},
+    {ComponentType::EndScreen, "number_of_stars", "u32"},
+    {ComponentType::EndScreen, "stars", "std::vector<std::weak_ptr<Entity>>"},
+    {ComponentType::EndScreen, "star_scale", "glm::vec2"},
+    {ComponentType::EndScreen, "next_level_button", "std::weak_ptr<Button>"},
+    {ComponentType::EndScreen, "restart_button", "std::weak_ptr<Button>"},
+    {ComponentType::EndScreen, "menu_button", "std::weak_ptr<Button>"},
+    {ComponentType::Port, "lights", "std::vector<std::weak_ptr<Entity>>"},
+    {ComponentType::Ship, "type", "ShipType"},
+    {ComponentType::Ship, "light", "std::weak_ptr<LighthouseLight>"},
+    {ComponentType::Ship, "spawner", "std::weak_ptr<ShipSpawner>"},
+    {ComponentType::Ship, "eyes", "std::weak_ptr<ShipEyes>"},
+    {ComponentType::Ship, "my_light", "std::weak_ptr<PointLight>"},
+    {ComponentType::ShipSpawner, "paths", "std::vector<std::weak_ptr<Path>>"},
+    {ComponentType::ShipSpawner, "floaters_manager", "std::weak_ptr<FloatersManager>"},
+    {ComponentType::ShipSpawner, "light", "std::weak_ptr<LighthouseLight>"},
+    {ComponentType::ShipSpawner, "last_chance_food_threshold", "u32"},
+    {ComponentType::ShipSpawner, "last_chance_time_threshold", "float"},
+    {ComponentType::ShipSpawner, "main_event_spawn", "std::vector<SpawnEvent>"},
+    {ComponentType::ShipSpawner, "backup_spawn", "std::vector<SpawnEvent>"},
+    {ComponentType::Thanks, "back_to_menu_button", "std::weak_ptr<Button>"},
+    {ComponentType::PlayerInput, "player_speed", "float"},
+    {ComponentType::PlayerInput, "camera_speed", "float"},
+    // # Put new cooked field here
+});
+
+// Enums yaml-cpp-extensions.h serializes as integers
+constexpr auto integer_enums = std::to_array<std::string_view>({
+    "ColliderType2D",
+    "FactoryType",
+    "FloeButtonType",
+    "ParticleType",
+    "ShipType",
+    "SpawnType",
+});
+
+struct StructMember
+{
+    std::string_view key = {};
+    std::string_view type = {};
+    bool is_optional = false;
+};
+
+// Structs yaml-cpp-extensions.h serializes, cooked as their members in this order for read_cooked() to read them back.
+// Members without a key are found by their position.
+std::unordered_map<std::string_view, std::vector<StructMember>> const& get_structs()
+{
+    static std::unordered_map<std::string_view, std::vector<StructMember>> const structs = {
+        {"std::shared_ptr<Material>",
+         {{"Shader", "std::shared_ptr<Shader>"},
+          {"Color", "glm::vec4"},
+          {"RenderOrder", "i32"},
+          {"NeedsForward", "bool"},
+          {"CastsShadows", "bool"},
+          {"IsBillboard", "bool", true}}},
+        {"std::shared_ptr<Shader>", {{"VertexPath", "std::string"}, {"FragmentPath", "std::string"}, {"GeometryPath", "std::string"}}},
+        {"DXWave", {{"", "glm::vec2"}, {"", "glm::vec2"}, {"", "float"}, {"", "float"}, {"", "float"}, {"", "float"}}},
+        {"ConstantBufferWater",
+         {{"", "glm::vec4"}, {"", "glm::vec4"}, {"", "float"}, {"", "float"}, {"", "float"}, {"", "float"}, {"", "float"}, {"", "float"}}},
+        {"SpawnEvent", {{"", "std::vector<ShipType>"}, {"", "SpawnType"}}},
+        {"FloaterSettings", {{"", "float"}, {"", "float"}, {"", "float"}, {"", "float"}, {"", "float"}}},
+        {"DialogueObject", {{"", "bool"}, {"", "std::string"}, {"", "std::string"}, {"", "std::string"}, {"", "std::string"}}},
+    };
+
+    return structs;
+}
+
+// Component types by their serialized names, and the fields of every type
+struct Schema
+{
+    std::unordered_map<std::string, ComponentType> types = {};
+    std::array<std::vector<std::pair<std::string, std::string_view>>, component_type_count + 1> fields = {};
+};
+
+Schema const& get_schema()
+{
+    static Schema const schema = [] {
+        Schema schema = {};
+
+        for (u16 i = 0; i < component_type_count; ++i)
+        {
+            schema.types.emplace(std::string(component_type_names[i]) + "Component", static_cast<ComponentType>(i));
+        }
+
+        for (auto const& [type, field, field_type] : component_fields)
+        {
+            schema.fields[static_cast<u16>(type)].emplace_back(field, field_type);
+        }
+
+        return schema;
+    }();
+
+    return schema;
+}
+
+// Type of the elements or the referenced object when the type is the template, empty otherwise
+std::string_view get_template_argument(std::string_view const type, std::string_view const template_name)
+{
+    if (!type.starts_with(template_name) || !type.ends_with('>') || type.size() <= template_name.size() + 1
+        || type[template_name.size()] != '<')
+    {
+        return {};
+    }
+
+    return type.substr(template_name.size() + 1, type.size() - template_name.size() - 2);
+}
+
+// NOTE: Scalars are converted like yaml-cpp converts them, anything else fails cooking and the scene is parsed instead.
+std::optional<float> parse_float(std::string_view text)
+{
+    if (text == ".inf" || text == ".Inf" || text == ".INF" || text == "+.inf" || text == "+.Inf" || text == "+.INF")
+        return std::numeric_limits<float>::infinity();
+
+    if (text == "-.inf" || text == "-.Inf" || text == "-.INF")
+        return -std::numeric_limits<float>::infinity();
+
+    if (text == ".nan" || text == ".NaN" || text == ".NAN")
+        return std::numeric_limits<float>::quiet_NaN();
+
+    if (text.starts_with('+'))
+        text.remove_prefix(1);
+
+    float value = 0.0f;
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+    if (text.empty() || error != std::errc() || end != text.data() + text.size())
+        return std::nullopt;
+
+    return value;
+}
+
+template<typename T>
+std::optional<T> parse_integer(std::string_view text)
+{
+    if (text.starts_with('+'))
+        text.remove_prefix(1);
+
+    T value = 0;
+    auto const [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+
+    if (text.empty() || error != std::errc() || end != text.data() + text.size())
+        return std::nullopt;
+
+    return value;
+}
+
+std::optional<bool> parse_bool(std::string_view const text)
+{
+    constexpr auto true_texts =
+        std::to_array<std::string_view>({"y", "Y", "yes", "Yes", "YES", "true", "True", "TRUE", "on", "On", "ON"});
+    constexpr auto false_texts =
+        std::to_array<std::string_view>({"n", "N", "no", "No", "NO", "false", "False", "FALSE", "off", "Off", "OFF"});
+
+    if (std::ranges::find(true_texts, text) != true_texts.end())
+        return true;
+
+    if (std::ranges::find(false_texts, text) != false_texts.end())
+        return false;
+
+    return std::nullopt;
+}
+
+template<typename T>
+void append(std::vector<u8>& bytes, T const* values, size_t const count)
+{
+    auto const* data = reinterpret_cast<u8 const*>(values);
+    bytes.insert(bytes.end(), data, data + count * sizeof(T));
+}
+
+}
+
+struct SceneCooker::Builder
+{
+    std::vector<Guid> guids = {};
+    std::vector<String> strings = {};
+    std::string string_data = {};
+    std::vector<u32> values = {};
+
+    std::unordered_map<std::string, u32> texts = {};
+
+    u32 add_text(std::string const& text)
+    {
+        auto const [it, is_new] = texts.emplace(text, 0);
+
+        if (!is_new)
+            return it->second;
+
+        if (auto const guid = parse_guid(text))
+        {
+            it->second = static_cast<u32>(guids.size()) | m_guid_text;
+            guids.emplace_back(guid.value());
+        }
+        else
+        {
+            it->second = static_cast<u32>(strings.size());
+            strings.emplace_back(static_cast<u32>(string_data.size()), static_cast<u32>(text.size()));
+            string_data += text;
+        }
+
+        return it->second;
+    }
+
+    // Text of a scalar, m_no_value when the node isn't one
+    u32 add_scalar(YAML::Node const& node)
+    {
+        if (!node.IsScalar())
+            return m_no_value;
+
+        return add_text(node.Scalar());
+    }
+};
+
+std::unique_ptr<CookedFile> SceneCooker::map(std::string const& file_path, std::string const& file_data)
+{
+    auto file = AK::MappedFile::map(get_cooked_path(file_path));
+
+    if (file == nullptr)
+        return nullptr;
+
+    auto const view = get_view(file->get_data(), hash(file_data));
+
+    if (!view.has_value())
+        return nullptr;
+
+    return std::unique_ptr<CookedFile>(new CookedFile(std::move(file), view.value()));
+}
+
+CookResult SceneCooker::cook_all()
+{
+    CookResult result = {};
+
+    // NOTE: Prefabs are parsed once into templates and instantiated from those, only scenes are cooked.
+    std::string const directory = "./res/scenes/";
+
+    if (!std::filesystem::exists(directory))
+        return result;
+
+    for (auto const& entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.path().extension() != ".txt")
+            continue;
+
+        std::string const file_path = directory + entry.path().filename().string();
+        std::ifstream file(file_path);
+
+        if (!file.is_open())
+        {
+            result.failed.emplace_back(file_path);
+            continue;
+        }
+
+        std::stringstream stream;
+        stream << file.rdbuf();
+        file.close();
+
+        std::string const file_data = stream.str();
+
+        if (map(file_path, file_data) != nullptr)
+        {
+            result.up_to_date += 1;
+            continue;
+        }
+
+        auto const cooked = cook(YAML::Load(file_data), hash(file_data));
+
+        if (!cooked.has_value())
+        {
+            result.failed.emplace_back(file_path);
+            continue;
+        }
+
+        write(get_cooked_path(file_path), cooked.value());
+        result.cooked += 1;
+    }
+
+    return result;
+}
+
+std::string SceneCooker::get_cooked_path(std::string const& file_path)
+{
+    return m_cooked_path + std::filesystem::path(file_path).stem().string() + ".cooked";
+}
+
+std::vector<CookedLoadBenchmark> SceneCooker::benchmark(u32 const load_count)
+{
+    std::vector<CookedLoadBenchmark> benchmarks = {};
+
+    (void)cook_all();
+
+    std::string const directory = "./res/scenes/";
+
+    if (!std::filesystem::exists(directory))
+        return benchmarks;
+
+    for (auto const& entry : std::filesystem::directory_iterator(directory))
+    {
+        if (entry.path().extension() != ".txt")
+            continue;
+
+        std::string const file_path = directory + entry.path().filename().string();
+        std::ifstream file(file_path);
+
+        if (!file.is_open())
+            continue;
+
+        std::stringstream stream;
+        stream << file.rdbuf();
+        file.close();
+
+        std::string const file_data = stream.str();
+
+        CookedLoadBenchmark benchmark = {};
+        benchmark.name = entry.path().stem().string();
+        benchmark.loads = load_count;
+        benchmark.source_size = file_data.size();
+
+        std::error_code error = {};
+        benchmark.cooked_size = std::filesystem::file_size(get_cooked_path(file_path), error);
+
+        if (error)
+            benchmark.cooked_size = 0;
+
+        auto start = std::chrono::high_resolution_clock::now();
+
+        for (u32 i = 0; i < load_count; ++i)
+        {
+            (void)YAML::Load(file_data);
+        }
+
+        std::chrono::duration<double> time = std::chrono::high_resolution_clock::now() - start;
+        benchmark.parse_seconds = time.count();
+
+        start = std::chrono::high_resolution_clock::now();
+
+        // Everything deserializing the scene reads, but the types of the values are only known to the generated code
+        for (u32 i = 0; i < load_count; ++i)
+        {
+            auto const cooked_file = map(file_path, file_data);
+
+            if (cooked_file == nullptr)
+                break;
+
+            for (u32 entity_index = 0; entity_index < cooked_file->get_entity_count(); ++entity_index)
+            {
+                auto const entity = cooked_file->get_entity(entity_index);
+
+                for (u32 component_index = 0; component_index < entity.component_count; ++component_index)
+                {
+                    auto const component = cooked_file->get_component(entity.first_component + component_index);
+
+                    for (u32 field = 0; field < component.fields.size(); ++field)
+                    {
+                        if (auto value = cooked_file->get_field(component, field))
+                            (void)value->read_word();
+                    }
+                }
+            }
+        }
+
+        time = std::chrono::high_resolution_clock::now() - start;
+        benchmark.cooked_seconds = time.count();
+
+        benchmarks.emplace_back(benchmark);
+    }
+
+    return benchmarks;
+}
+
+std::optional<std::vector<u8>> SceneCooker::cook(YAML::Node const& data, u64 const source_hash)
+{
+    Builder builder = {};
+
+    std::vector<EntityRecord> entities = {};
+    std::vector<ComponentRecord> components = {};
+    std::vector<FieldBlock> blocks = {};
+    std::vector<std::vector<u32>> block_fields = {};
+
+    std::array<u32, component_type_count + 1> block_indices = {};
+    block_indices.fill(m_no_value);
+
+    auto const read_vector = [](YAML::Node const& node, float (&values)[3]) {
+        if (!node.IsSequence() || node.size() != 3)
+            return false;
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            if (!node[i].IsScalar())
+                return false;
+
+            auto const value = parse_float(node[i].Scalar());
+
+            if (!value.has_value())
+                return false;
+
+            values[i] = value.value();
+        }
+
+        return true;
+    };
+
+    Header header = {};
+    header.scene_name = builder.add_scalar(data["Scene"]);
+
+    // Broken scenes are left to the deserializer to report, it gets the text
+    if (header.scene_name == m_no_value)
+        return std::nullopt;
+
+    YAML::Node const entity_nodes = data["Entities"];
+
+    if (entity_nodes && !entity_nodes.IsSequence())
+        return std::nullopt;
+
+    for (auto const& entity : entity_nodes)
+    {
+        YAML::Node const transform = entity["TransformComponent"];
+
+        if (!transform.IsMap() || !transform["Parent"].IsMap())
+            return std::nullopt;
+
+        EntityRecord record = {};
+        record.guid = builder.add_scalar(entity["guid"]);
+        record.name = builder.add_scalar(entity["Name"]);
+        record.parent_guid = builder.add_scalar(transform["Parent"]["guid"]);
+        record.first_component = static_cast<u32>(components.size());
+
+        if (record.guid == m_no_value || record.name == m_no_value || record.parent_guid == m_no_value
+            || !read_vector(transform["Translation"], record.translation) || !read_vector(transform["Rotation"], record.rotation)
+            || !read_vector(transform["Scale"], record.scale))
+        {
+            return std::nullopt;
+        }
+
+        YAML::Node const component_nodes = entity["Components"];
+
+        if (component_nodes && !component_nodes.IsSequence())
+            return std::nullopt;
+
+        for (auto const& component : component_nodes)
+        {
+            ComponentRecord component_record = {};
+            component_record.name = builder.add_scalar(component["ComponentName"]);
+            component_record.guid = builder.add_scalar(component["guid"]);
+            component_record.custom_name = builder.add_scalar(component["custom_name"]);
+
+            if (component_record.name == m_no_value || component_record.guid == m_no_value || component_record.custom_name == m_no_value)
+                return std::nullopt;
+
+            auto const type_it = get_schema().types.find(component["ComponentName"].Scalar());
+            ComponentType const type = type_it != get_schema().types.end() ? type_it->second : ComponentType::Unknown;
+            auto const& fields = get_schema().fields[static_cast<u16>(type)];
+
+            if (block_indices[static_cast<u16>(type)] == m_no_value)
+            {
+                block_indices[static_cast<u16>(type)] = static_cast<u32>(blocks.size());
+
+                FieldBlock block = {};
+                block.type = type;
+                block.fields_per_record = static_cast<u32>(fields.size());
+                blocks.emplace_back(block);
+                block_fields.emplace_back();
+            }
+
+            component_record.block = block_indices[static_cast<u16>(type)];
+            component_record.record = blocks[component_record.block].record_count++;
+
+            for (auto const& [field, field_type] : fields)
+            {
+                YAML::Node const value = component[field];
+
+                if (!value.IsDefined())
+                {
+                    block_fields[component_record.block].emplace_back(m_no_value);
+                    continue;
+                }
+
+                block_fields[component_record.block].emplace_back(static_cast<u32>(builder.values.size()));
+
+                if (!encode(value, field_type, builder))
+                    return std::nullopt;
+            }
+
+            components.emplace_back(component_record);
+        }
+
+        record.component_count = static_cast<u32>(components.size()) - record.first_component;
+        entities.emplace_back(record);
+    }
+
+    std::vector<u32> fields = {};
+
+    for (u32 i = 0; i < blocks.size(); ++i)
+    {
+        blocks[i].first_field = static_cast<u32>(fields.size());
+        fields.insert(fields.end(), block_fields[i].begin(), block_fields[i].end());
+    }
+
+    header.magic = m_magic;
+    header.version = m_version;
+    header.source_hash = source_hash;
+    header.schema_hash = get_schema_hash();
+    header.guid_count = static_cast<u32>(builder.guids.size());
+    header.string_count = static_cast<u32>(builder.strings.size());
+    header.entity_count = static_cast<u32>(entities.size());
+    header.component_count = static_cast<u32>(components.size());
+    header.block_count = static_cast<u32>(blocks.size());
+    header.field_count = static_cast<u32>(fields.size());
+    header.value_count = static_cast<u32>(builder.values.size());
+    header.string_data_size = static_cast<u32>(builder.string_data.size());
+
+    std::vector<u8> cooked = {};
+    cooked.reserve(sizeof(Header) + builder.guids.size() * sizeof(Guid) + builder.strings.size() * sizeof(String)
+                   + entities.size() * sizeof(EntityRecord) + components.size() * sizeof(ComponentRecord)
+                   + blocks.size() * sizeof(FieldBlock) + (fields.size() + builder.values.size()) * sizeof(u32)
+                   + builder.string_data.size());
+
+    append(cooked, &header, 1);
+    append(cooked, builder.guids.data(), builder.guids.size());
+    append(cooked, builder.strings.data(), builder.strings.size());
+    append(cooked, entities.data(), entities.size());
+    append(cooked, components.data(), components.size());
+    append(cooked, blocks.data(), blocks.size());
+    append(cooked, fields.data(), fields.size());
+    append(cooked, builder.values.data(), builder.values.size());
+    append(cooked, builder.string_data.data(), builder.string_data.size());
+
+    return cooked;
+}
+
+bool SceneCooker::encode(YAML::Node const& node, std::string_view const type, Builder& builder)
+{
+    auto& values = builder.values;
+
+    if (auto const members = get_structs().find(type); members != get_structs().end())
+    {
+        bool const is_keyed = !members->second.front().key.empty();
+
+        if (is_keyed ? !node.IsMap() : !node.IsSequence() || node.size() != members->second.size())
+            return false;
+
+        u32 member_count = 0;
+
+        for (u32 i = 0; i < members->second.size(); ++i)
+        {
+            auto const& [key, member_type, is_optional] = members->second[i];
+            YAML::Node const member = is_keyed ? node[std::string(key)] : node[i];
+
+            if (is_optional)
+                values.emplace_back(member.IsDefined() ? 1 : 0);
+
+            if (is_optional && !member.IsDefined())
+                continue;
+
+            if (!encode(member, member_type, builder))
+                return false;
+
+            member_count += 1;
+        }
+
+        // Maps with keys the struct doesn't have are rejected by yaml-cpp-extensions.h too
+        return member_count == node.size();
+    }
+
+    if (auto const element_type = get_template_argument(type, "std::vector"); !element_type.empty())
+    {
+        if (!node.IsSequence())
+            return false;
+
+        values.emplace_back(static_cast<u32>(node.size()));
+
+        for (auto const& element : node)
+        {
+            if (!encode(element, element_type, builder))
+                return false;
+        }
+
+        return true;
+    }
+
+    // References to components and entities, the rest of the shared pointers are structs
+    if (!get_template_argument(type, "std::weak_ptr").empty() || !get_template_argument(type, "std::shared_ptr").empty())
+    {
+        if (!node.IsMap() || node.size() != 1 || !node["guid"].IsScalar())
+            return false;
+
+        values.emplace_back(builder.add_text(node["guid"].Scalar()));
+        return true;
+    }
+
+    if (type == "glm::vec2" || type == "glm::vec3" || type == "glm::vec4")
+    {
+        u32 const size = type.back() - '0';
+
+        if (!node.IsSequence() || node.size() != size)
+            return false;
+
+        for (u32 i = 0; i < size; ++i)
+        {
+            if (!encode(node[i], "float", builder))
+                return false;
+        }
+
+        return true;
+    }
+
+    if (!node.IsScalar())
+        return false;
+
+    std::string const& scalar = node.Scalar();
+    std::optional<u32> word = std::nullopt;
+
+    if (type == "float")
+    {
+        if (auto const value = parse_float(scalar))
+            word = std::bit_cast<u32>(value.value());
+    }
+    else if (type == "bool")
+    {
+        if (auto const value = parse_bool(scalar))
+            word = value.value() ? 1 : 0;
+    }
+    else if (type == "i32" || type == "int" || std::ranges::find(integer_enums, type) != integer_enums.end())
+    {
+        if (auto const value = parse_integer<i32>(scalar))
+            word = static_cast<u32>(value.value());
+    }
+    else if (type == "u32")
+    {
+        word = parse_integer<u32>(scalar);
+    }
+    else if (type == "u16")
+    {
+        if (auto const value = parse_integer<u16>(scalar))
+            word = value.value();
+    }
+    else if (type == "std::string")
+    {
+        word = builder.add_text(scalar);
+    }
+
+    if (!word.has_value())
+        return false;
+
+    values.emplace_back(word.value());
+    return true;
+}
+
+std::optional<SceneCooker::View> SceneCooker::get_view(std::span<u8 const> const cooked, u64 const source_hash)
+{
+    if (cooked.size() < sizeof(Header))
+        return std::nullopt;
+
+    Header header = {};
+    std::memcpy(&header, cooked.data(), sizeof(Header));
+
+    if (header.magic != m_magic || header.version != m_version || header.source_hash != source_hash
+        || header.schema_hash != get_schema_hash())
+    {
+        return std::nullopt;
+    }
+
+    u64 const guids_offset = sizeof(Header);
+    u64 const strings_offset = guids_offset + static_cast<u64>(header.guid_count) * sizeof(Guid);
+    u64 const entities_offset = strings_offset + static_cast<u64>(header.string_count) * sizeof(String);
+    u64 const components_offset = entities_offset + static_cast<u64>(header.entity_count) * sizeof(EntityRecord);
+    u64 const blocks_offset = components_offset + static_cast<u64>(header.component_count) * sizeof(ComponentRecord);
+    u64 const fields_offset = blocks_offset + static_cast<u64>(header.block_count) * sizeof(FieldBlock);
+    u64 const values_offset = fields_offset + static_cast<u64>(header.field_count) * sizeof(u32);
+    u64 const string_data_offset = values_offset + static_cast<u64>(header.value_count) * sizeof(u32);
+
+    if (string_data_offset + header.string_data_size != cooked.size())
+        return std::nullopt;
+
+    // NOTE: Sections start at multiples of their alignment, the mapping itself is page aligned.
+    View const view = {
+        header.scene_name,
+        {reinterpret_cast<Guid const*>(cooked.data() + guids_offset), header.guid_count},
+        {reinterpret_cast<String const*>(cooked.data() + strings_offset), header.string_count},
+        {reinterpret_cast<EntityRecord const*>(cooked.data() + entities_offset), header.entity_count},
+        {reinterpret_cast<ComponentRecord const*>(cooked.data() + components_offset), header.component_count},
+        {reinterpret_cast<FieldBlock const*>(cooked.data() + blocks_offset), header.block_count},
+        {reinterpret_cast<u32 const*>(cooked.data() + fields_offset), header.field_count},
+        {reinterpret_cast<u32 const*>(cooked.data() + values_offset), header.value_count},
+        {reinterpret_cast<char const*>(cooked.data() + string_data_offset), header.string_data_size},
+    };
+
+    if (!validate(view))
+        return std::nullopt;
+
+    return view;
+}
+
+bool SceneCooker::validate(View const& view)
+{
+    auto const is_text = [&](u32 const text) {
+        return (text & m_guid_text) != 0 ? (text & ~m_guid_text) < view.guids.size() : text < view.strings.size();
+    };
+
+    if (!is_text(view.scene_name))
+        return false;
+
+    for (auto const& string : view.strings)
+    {
+        if (static_cast<u64>(string.offset) + string.size > view.string_data.size())
+            return false;
+    }
+
+    for (auto const& entity : view.entities)
+    {
+        if (!is_text(entity.guid) || !is_text(entity.name) || !is_text(entity.parent_guid)
+            || static_cast<u64>(entity.first_component) + entity.component_count > view.components.size())
+        {
+            return false;
+        }
+    }
+
+    for (auto const& block : view.blocks)
+    {
+        if (static_cast<u16>(block.type) > component_type_count
+            || block.fields_per_record != get_schema().fields[static_cast<u16>(block.type)].size()
+            || block.first_field + static_cast<u64>(block.record_count) * block.fields_per_record > view.fields.size())
+        {
+            return false;
+        }
+    }
+
+    for (auto const& component : view.components)
+    {
+        if (component.block >= view.blocks.size() || component.record >= view.blocks[component.block].record_count
+            || !is_text(component.name) || !is_text(component.guid) || !is_text(component.custom_name))
+        {
+            return false;
+        }
+    }
+
+    for (u32 const field : view.fields)
+    {
+        if (field != m_no_value && field >= view.values.size())
+            return false;
+    }
+
+    return true;
+}
+
+std::string SceneCooker::get_text(View const& view, u32 const text)
+{
+    if (text == m_no_value)
+        return {};
+
+    if ((text & m_guid_text) != 0)
+    {
+        u32 const index = text & ~m_guid_text;
+        return index < view.guids.size() ? format_guid(view.guids[index]) : std::string();
+    }
+
+    if (text >= view.strings.size())
+        return {};
+
+    auto const& string = view.strings[text];
+    return std::string(view.string_data.substr(string.offset, string.size));
+}
+
+void SceneCooker::write(std::string const& cooked_path, std::vector<u8> const& cooked)
+{
+    std::error_code error = {};
+    std::filesystem::create_directories(std::filesystem::path(cooked_path).parent_path(), error);
+
+    // Written next to it first, the game could be reading it
+    std::string const temporary_path = cooked_path + "." + std::to_string(std::hash<std::thread::id> {}(std::this_thread::get_id()));
+
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+
+        if (!file.is_open())
+            return;
+
+        file.write(reinterpret_cast<char const*>(cooked.data()), static_cast<std::streamsize>(cooked.size()));
+    }
+
+    std::filesystem::rename(temporary_path, cooked_path, error);
+
+    if (error)
+        std::filesystem::remove(temporary_path, error);
+}
+
+u64 SceneCooker::hash(std::string_view const data)
+{
+    // FNV-1a
+    u64 hash = 0xcbf2'9ce4'8422'2325;
+
+    for (char const character : data)
+    {
+        hash ^= static_cast<u8>(character);
+        hash *= 0x0000'0100'0000'01b3;
+    }
+
+    return hash;
+}
+
+u64 SceneCooker::get_schema_hash()
+{
+    static u64 const schema_hash = [] {
+        std::string schema = {};
+
+        // Field blocks are laid out by the component type ids and the order of their fields, values by their types
+        for (auto const& [type, field, field_type] : component_fields)
+        {
+            schema += std::to_string(static_cast<u16>(type)) + " " + std::string(field) + " " + std::string(field_type) + "\n";
+        }
+
+        for (auto const& type : integer_enums)
+        {
+            schema += std::string(type) + "\n";
+        }
+
+        // NOTE: Sorted, the order of an unordered map isn't the same everywhere.
+        std::vector<std::string> structs = {};
+
+        for (auto const& [type, members] : get_structs())
+        {
+            std::string layout = std::string(type) + ":";
+
+            for (auto const& [key, member_type, is_optional] : members)
+            {
+                layout += " " + std::string(key) + " " + std::string(member_type) + (is_optional ? "?" : "");
+            }
+
+            structs.emplace_back(layout + "\n");
+        }
+
+        std::ranges::sort(structs);
+
+        for (auto const& layout : structs)
+        {
+            schema += layout;
+        }
+
+        return hash(schema);
+    }();
+
+    return schema_hash;
+}
+
+std::optional<SceneCooker::Guid> SceneCooker::parse_guid(std::string const& text)
+{
+    // Only what format_guid() gives back unchanged
+    if (text.size() != sizeof(Guid) * 2)
+        return std::nullopt;
+
+    Guid guid = {};
+
+    for (u32 i = 0; i < text.size(); ++i)
+    {
+        char const character = text[i];
+        u64 digit = 0;
+
+        if (character >= '0' && character <= '9')
+            digit = character - '0';
+        else if (character >= 'a' && character <= 'f')
+            digit = character - 'a' + 10;
+        else
+            return std::nullopt;
+
+        guid.parts[i / 16] = (guid.parts[i / 16] << 4) | digit;
+    }
+
+    return guid;
+}
+
+std::string SceneCooker::format_guid(Guid const& guid)
+{
+    constexpr char digits[] = "0123456789abcdef";
+
+    std::string text(sizeof(Guid) * 2, '0');
+
+    for (u32 i = 0; i < text.size(); ++i)
+    {
+        u32 const shift = (15 - i % 16) * 4;
+        text[i] = digits[(guid.parts[i / 16] >> shift) & 0xf];
+    }
+
+    return text;
+}
+
+CookedValue::CookedValue(SceneCooker::View const& view, u32 const offset) : m_view(view), m_offset(offset)
+{
+}
+
+u32 CookedValue::read_word()
+{
+    if (m_offset >= m_view.values.size())
+        return 0;
+
+    return m_view.values[m_offset++];
+}
+
+float CookedValue::read_float()
+{
+    return std::bit_cast<float>(read_word());
+}
+
+std::string CookedValue::read_text()
+{
+    return SceneCooker::get_text(m_view, read_word());
+}
+
+u32 CookedValue::get_remaining_words() const
+{
+    return m_offset < m_view.values.size() ? static_cast<u32>(m_view.values.size()) - m_offset : 0;
+}
+
+CookedFile::CookedFile(std::unique_ptr<AK::MappedFile> file, SceneCooker::View const& view) : m_file(std::move(file)), m_view(view)
+{
+}
+
+std::string CookedFile::get_scene_name() const
+{
+    return SceneCooker::get_text(m_view, m_view.scene_name);
+}
+
+u32 CookedFile::get_entity_count() const
+{
+    return static_cast<u32>(m_view.entities.size());
+}
+
+CookedEntity CookedFile::get_entity(u32 const index) const
+{
+    auto const& record = m_view.entities[index];
+
+    CookedEntity entity = {};
+    entity.guid = SceneCooker::get_text(m_view, record.guid);
+    entity.name = SceneCooker::get_text(m_view, record.name);
+    entity.parent_guid = SceneCooker::get_text(m_view, record.parent_guid);
+    entity.translation = {record.translation[0], record.translation[1], record.translation[2]};
+    entity.rotation = {record.rotation[0], record.rotation[1], record.rotation[2]};
+    entity.scale = {record.scale[0], record.scale[1], record.scale[2]};
+    entity.first_component = record.first_component;
+    entity.component_count = record.component_count;
+    return entity;
+}
+
+CookedComponent CookedFile::get_component(u32 const index) const
+{
+    auto const& record = m_view.components[index];
+    auto const& block = m_view.blocks[record.block];
+
+    CookedComponent component = {};
+    component.type = block.type;
+    component.name = SceneCooker::get_text(m_view, record.name);
+    component.guid = SceneCooker::get_text(m_view, record.guid);
+    component.custom_name = SceneCooker::get_text(m_view, record.custom_name);
+    component.fields = m_view.fields.subspan(block.first_field + record.record * block.fields_per_record, block.fields_per_record);
+    return component;
+}
+
+std::optional<CookedValue> CookedFile::get_field(CookedComponent const& component, u32 const field) const
+{
+    if (field >= component.fields.size() || component.fields[field] == SceneCooker::m_no_value)
+        return std::nullopt;
+
+    return CookedValue(m_view, component.fields[field]);
+}
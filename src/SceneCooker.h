@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "AK/MappedFile.h"
+#include "AK/Types.h"
+#include "ComponentType.h"
+
+namespace YAML
+{
+class Node;
+}
+
+struct CookedLoadBenchmark
+{
+    std::string name = {};
+    u32 loads = 0;
+    u64 source_size = 0;
+    u64 cooked_size = 0;
+    double parse_seconds = 0.0;
+    double cooked_seconds = 0.0;
+};
+
+struct CookResult
+{
+    u32 cooked = 0;
+    u32 up_to_date = 0;
+    std::vector<std::string> failed = {};
+};
+
+struct CookedEntity
+{
+    std::string guid = {};
+    std::string name = {};
+    std::string parent_guid = {};
+    glm::vec3 translation = {};
+    glm::vec3 rotation = {};
+    glm::vec3 scale = {};
+    u32 first_component = 0;
+    u32 component_count = 0;
+};
+
+struct CookedComponent
+{
+    ComponentType type = ComponentType::Unknown;
+    std::string name = {};
+    std::string guid = {};
+    std::string custom_name = {};
+
+    // Record of the component in the field block of its type
+    std::span<u32 const> fields = {};
+};
+
+class CookedFile;
+
+// Scene files stay YAML, cook_all() writes a binary copy of each of them to m_cooked_path. Nothing is cooked at runtime,
+// scenes without an up to date cooked copy are parsed from their text. Cooked copies are stale when the hash of their
+// source file or the serialized fields and their types change.
+//
+// Cooked file layout, every section is a packed array:
+// - Header
+// - Guids: 64 character hex guids as 256-bit integers
+// - Strings: offsets and sizes into the string data
+// - Entities: guid, name and parent texts, the transform as floats and the range of their components
+// - Components: field block and record of every component, in the order of their entities
+// - Field blocks: one for every component type in the file. Each record is the offset of the value of every serialized
+//   field of the type, in the order EngineHeaderTool lists them, so the fields are found without looking at any keys.
+// - Values: 32-bit words of the field values, already in the types of their fields
+// - String data
+//
+// Texts are a guid index with m_guid_text set or a string index. Values are encoded by the C++ type of their field:
+// - float, integers, enums and bool: one word
+// - std::string: one text
+// - glm vectors: a float for every component
+// - References to components and entities: the text of the guid
+// - std::vector: the size, then every element
+// - Structs listed in SceneCooker.cpp: their members in order, optional ones after a bool telling if they're there
+class SceneCooker
+{
+public:
+    // Cooked copy of the scene, file_data is its text. nullptr when there is no up to date one.
+    // Doesn't log or write anything.
+    [[nodiscard]] static std::unique_ptr<CookedFile> map(std::string const& file_path, std::string const& file_data);
+
+    // Cooks every scene that doesn't have an up to date cooked copy. Run by the editor and by the Cook target, which
+    // starts the game with --cook.
+    static CookResult cook_all();
+
+    [[nodiscard]] static std::string get_cooked_path(std::string const& file_path);
+
+    // Cooks every scene, then loads each of them by parsing its text and by reading every record and value of its
+    // cooked copy
+    static std::vector<CookedLoadBenchmark> benchmark(u32 const load_count);
+
+    static constexpr u32 m_no_value = 0xffff'ffff;
+
+private:
+    static constexpr u32 m_magic = 0x4b43'4b41; // "AKCK"
+    static constexpr u32 m_version = 3;
+    static constexpr u32 m_guid_text = 0x8000'0000;
+
+    struct Header
+    {
+        u32 magic = 0;
+        u32 version = 0;
+        u64 source_hash = 0;
+        u64 schema_hash = 0;
+        u32 scene_name = m_no_value;
+        u32 guid_count = 0;
+        u32 string_count = 0;
+        u32 entity_count = 0;
+        u32 component_count = 0;
+        u32 block_count = 0;
+        u32 field_count = 0;
+        u32 value_count = 0;
+        u32 string_data_size = 0;
+        u32 padding = 0;
+    };
+
+    struct String
+    {
+        u32 offset = 0;
+        u32 size = 0;
+    };
+
+    struct Guid
+    {
+        u64 parts[4] = {};
+    };
+
+    struct EntityRecord
+    {
+        u32 guid = m_no_value;
+        u32 name = m_no_value;
+        u32 parent_guid = m_no_value;
+        u32 first_component = 0;
+        u32 component_count = 0;
+        float translation[3] = {};
+        float rotation[3] = {};
+        float scale[3] = {};
+    };
+
+    struct ComponentRecord
+    {
+        u32 block = 0;
+        u32 record = 0;
+        u32 name = m_no_value;
+        u32 guid = m_no_value;
+        u32 custom_name = m_no_value;
+    };
+
+    struct FieldBlock
+    {
+        ComponentType type = ComponentType::Unknown;
+        u8 padding[2] = {};
+        u32 fields_per_record = 0;
+        u32 record_count = 0;
+        u32 first_field = 0;
+    };
+
+    // Sections of a cooked file
+    struct View
+    {
+        u32 scene_name = m_no_value;
+        std::span<Guid const> guids = {};
+        std::span<String const> strings = {};
+        std::span<EntityRecord const> entities = {};
+        std::span<ComponentRecord const> components = {};
+        std::span<FieldBlock const> blocks = {};
+        std::span<u32 const> fields = {};
+        std::span<u32 const> values = {};
+        std::string_view string_data = {};
+    };
+
+    // Sections of a file being cooked
+    struct Builder;
+
+    [[nodiscard]] static std::optional<std::vector<u8>> cook(YAML::Node const& data, u64 const source_hash);
+
+    // Appends the value of a field of the C++ type to the builder's values, false when the node doesn't hold one
+    [[nodiscard]] static bool encode(YAML::Node const& node, std::string_view const type, Builder& builder);
+
+    // Sections of the cooked file, nullopt when it's stale or broken. Every index in the file is checked, values are
+    // checked when they are read.
+    [[nodiscard]] static std::optional<View> get_view(std::span<u8 const> const cooked, u64 const source_hash);
+    [[nodiscard]] static bool validate(View const& view);
+
+    // Empty for m_no_value and texts that aren't in the file
+    [[nodiscard]] static std::string get_text(View const& view, u32 const text);
+
+    static void write(std::string const& cooked_path, std::vector<u8> const& cooked);
+
+    [[nodiscard]] static u64 hash(std::string_view const data);
+    [[nodiscard]] static u64 get_schema_hash();
+
+    [[nodiscard]] static std::optional<Guid> parse_guid(std::string const& text);
+    [[nodiscard]] static std::string format_guid(Guid const& guid);
+
+    inline static std::string m_cooked_path = "./res/cooked/";
+
+    friend class CookedFile;
+    friend class CookedValue;
+};
+
+// Value of a field, read in the order it was cooked in. Reading past its end gives zeroes.
+class CookedValue
+{
+public:
+    template<typename T>
+    [[nodiscard]] T read()
+    {
+        T value = {};
+        read_cooked(*this, value);
+        return value;
+    }
+
+    [[nodiscard]] u32 read_word();
+    [[nodiscard]] float read_float();
+    [[nodiscard]] std::string read_text();
+
+    [[nodiscard]] u32 get_remaining_words() const;
+
+private:
+    CookedValue(SceneCooker::View const& view, u32 const offset);
+
+    SceneCooker::View const& m_view;
+    u32 m_offset = 0;
+
+    friend class CookedFile;
+};
+
+inline void read_cooked(CookedValue& value, float& out)
+{
+    out = value.read_float();
+}
+
+inline void read_cooked(CookedValue& value, bool& out)
+{
+    out = value.read_word() != 0;
+}
+
+template<typename T>
+requires std::is_integral_v<T> || std::is_enum_v<T>
+void read_cooked(CookedValue& value, T& out)
+{
+    out = static_cast<T>(value.read_word());
+}
+
+inline void read_cooked(CookedValue& value, std::string& out)
+{
+    out = value.read_text();
+}
+
+inline void read_cooked(CookedValue& value, glm::vec2& out)
+{
+    out.x = value.read_float();
+    out.y = value.read_float();
+}
+
+inline void read_cooked(CookedValue& value, glm::vec3& out)
+{
+    out.x = value.read_float();
+    out.y = value.read_float();
+    out.z = value.read_float();
+}
+
+inline void read_cooked(CookedValue& value, glm::vec4& out)
+{
+    out.x = value.read_float();
+    out.y = value.read_float();
+    out.z = value.read_float();
+    out.w = value.read_float();
+}
+
+template<typename T>
+void read_cooked(CookedValue& value, std::vector<T>& out)
+{
+    // NOTE: Every element takes at least a word, a broken size can't allocate more than the file holds.
+    u32 const size = std::min(value.read_word(), value.get_remaining_words());
+
+    out.clear();
+    out.reserve(size);
+
+    for (u32 i = 0; i < size; ++i)
+    {
+        out.emplace_back(value.read<T>());
+    }
+}
+
+// Cooked copy of a scene, read in place from the mapped file
+class CookedFile
+{
+public:
+    [[nodiscard]] std::string get_scene_name() const;
+
+    [[nodiscard]] u32 get_entity_count() const;
+    [[nodiscard]] CookedEntity get_entity(u32 const index) const;
+    [[nodiscard]] CookedComponent get_component(u32 const index) const;
+
+    // Value of a field of the component, fields are numbered in the order EngineHeaderTool lists them for its type.
+    // nullopt when the component doesn't have it.
+    [[nodiscard]] std::optional<CookedValue> get_field(CookedComponent const& component, u32 const field) const;
+
+private:
+    CookedFile(std::unique_ptr<AK::MappedFile> file, SceneCooker::View const& view);
+
+    std::unique_ptr<AK::MappedFile> m_file = {};
+    SceneCooker::View m_view = {};
+
+    friend class SceneCooker;
+};
@@ -2,7 +2,9 @@
 
 #include "AssetPreloader.h"
 
+#include <chrono>
 #include <filesystem>
+#include <format>
 #include <fstream>
 #include <iostream>
 #include <unordered_set>
@@ -56,6 +58,9 @@
 #include "Particle.h"
 #include "ParticleSystem.h"
 #include "PointLight.h"
+#include "PrefabPool.h"
+#include "Rigidbody2D.h"
+#include "SceneCooker.h"
 #include "ScreenText.h"
 #include "ShaderFactory.h"
 #include "Sound.h"
@@ -64,9 +69,86 @@
 #include "SpotLight.h"
 #include "Sprite.h"
 #include "Water.h"
+#include "cooked-extensions.h"
 #include "yaml-cpp-extensions.h"
 // # Put new header here
 
+namespace
+{
+
+// Text of the file, preloaded or read from the disk
+std::optional<std::string> read_text_asset(std::string const& file_path)
+{
+    if (auto text = Engine::asset_preloader->get_text_asset(file_path))
+        return text;
+
+    std::ifstream file(file_path);
+
+    if (!file.is_open())
+        return std::nullopt;
+
+    std::stringstream stream;
+    stream << file.rdbuf();
+    file.close();
+
+    return stream.str();
+}
+
+// Values of every "guid" key, these are the entities' and components' own guids and the references to them
+void find_guid_nodes(YAML::Node const& node, std::vector<YAML::Node>& guid_nodes)
+{
+    if (node.IsMap())
+    {
+        for (auto const& pair : node)
+        {
+            if (pair.second.IsScalar() && pair.first.Scalar() == "guid")
+                guid_nodes.emplace_back(pair.second);
+            else
+                find_guid_nodes(pair.second, guid_nodes);
+        }
+    }
+    else if (node.IsSequence())
+    {
+        for (auto const& child : node)
+        {
+            find_guid_nodes(child, guid_nodes);
+        }
+    }
+}
+
+// Binary tree of entities with a path each, guids are their indices
+YAML::Node create_synthetic_prefab(u32 const entity_count)
+{
+    auto const get_guid = [](u32 const index) { return std::format("{:064x}", index); };
+
+    YAML::Node data = {};
+    data["Scene"] = "Synthetic";
+
+    for (u32 i = 0; i < entity_count; ++i)
+    {
+        YAML::Node entity = {};
+        entity["Entity"] = "Synthetic";
+        entity["guid"] = get_guid(i * 2);
+        entity["Name"] = "Synthetic";
+        entity["TransformComponent"]["Translation"] = glm::vec3(0.0f);
+        entity["TransformComponent"]["Rotation"] = glm::vec3(0.0f);
+        entity["TransformComponent"]["Scale"] = glm::vec3(1.0f);
+        entity["TransformComponent"]["Parent"]["guid"] = i == 0 ? std::string() : get_guid((i - 1) / 2 * 2);
+
+        YAML::Node component = {};
+        component["ComponentName"] = "PathComponent";
+        component["guid"] = get_guid(i * 2 + 1);
+        component["custom_name"] = "";
+        entity["Components"].push_back(component);
+
+        data["Entities"].push_back(entity);
+    }
+
+    return data;
+}
+
+}
+
 SceneSerializer::SceneSerializer(std::shared_ptr<Scene> const& scene) : m_scene(scene)
 {
 }
@@ -83,45 +165,73 @@ void SceneSerializer::set_instance(std::shared_ptr<SceneSerializer> const& insta
 
 std::shared_ptr<Component> SceneSerializer::get_from_pool(std::string const& guid) const
 {
-    for (auto const& obj : deserialized_pool)
-    {
-        if (obj->guid == guid)
-            return obj;
-    }
+    if (auto component = find_deserialized_component(guid))
+        return component;
 
-    if (m_deserialization_mode == DeserializationMode::Normal)
+    if (m_deserialization_mode == DeserializationMode::Normal || m_deserialization_mode == DeserializationMode::Plan)
         return nullptr;
 
-    for (auto const& entity : MainScene::get_instance()->entities)
+    index_scene();
+
+    auto const it = m_context.scene_components.find(guid);
+    return it != m_context.scene_components.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<Entity> SceneSerializer::get_entity_from_pool(std::string const& guid) const
+{
+    if (auto entity = find_deserialized_entity(guid))
+        return entity;
+
+    if (m_deserialization_mode == DeserializationMode::Normal || m_deserialization_mode == DeserializationMode::Plan)
+        return nullptr;
+
+    index_scene();
+
+    auto const it = m_context.scene_entities.find(guid);
+    return it != m_context.scene_entities.end() ? it->second : nullptr;
+}
+
+std::shared_ptr<Component> SceneSerializer::find_deserialized_component(std::string const& guid) const
+{
+    // NOTE: emplace() keeps the first one with a guid, like searching the pool from the front did.
+    for (; m_context.indexed_components < deserialized_pool.size(); ++m_context.indexed_components)
     {
-        for (auto const& component : entity->components)
-        {
-            if (component->guid == guid)
-                return component;
-        }
+        auto const& component = deserialized_pool[m_context.indexed_components];
+        m_context.components.emplace(component->guid, component);
     }
 
-    return nullptr;
+    auto const it = m_context.components.find(guid);
+    return it != m_context.components.end() ? it->second : nullptr;
 }
 
-std::shared_ptr<Entity> SceneSerializer::get_entity_from_pool(std::string const& guid) const
+std::shared_ptr<Entity> SceneSerializer::find_deserialized_entity(std::string const& guid) const
 {
-    for (auto const& obj : deserialized_entities_pool)
+    for (; m_context.indexed_entities < deserialized_entities_pool.size(); ++m_context.indexed_entities)
     {
-        if (obj->guid == guid)
-            return obj;
+        auto const& entity = deserialized_entities_pool[m_context.indexed_entities];
+        m_context.entities.emplace(entity->guid, entity);
     }
 
-    if (m_deserialization_mode == DeserializationMode::Normal)
-        return nullptr;
+    auto const it = m_context.entities.find(guid);
+    return it != m_context.entities.end() ? it->second : nullptr;
+}
+
+void SceneSerializer::index_scene() const
+{
+    if (m_context.is_scene_indexed)
+        return;
+
+    m_context.is_scene_indexed = true;
 
     for (auto const& entity : MainScene::get_instance()->entities)
     {
-        if (entity->guid == guid)
-            return entity;
-    }
+        m_context.scene_entities.emplace(entity->guid, entity);
 
-    return nullptr;
+        for (auto const& component : entity->components)
+        {
+            m_context.scene_components.emplace(component->guid, component);
+        }
+    }
 }
 
 void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_ptr<Component> const& component)
@@ -149,10 +259,14 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         out << YAML::Key << "offset" << YAML::Value << collider2d->offset;
         out << YAML::Key << "is_trigger" << YAML::Value << collider2d->is_trigger;
         out << YAML::Key << "is_static" << YAML::Value << collider2d->is_static;
+        out << YAML::Key << "is_continuous" << YAML::Value << collider2d->is_continuous;
+        out << YAML::Key << "collision_layer" << YAML::Value << collider2d->collision_layer;
+        out << YAML::Key << "collision_mask" << YAML::Value << collider2d->collision_mask;
         out << YAML::Key << "collider_type" << YAML::Value << collider2d->collider_type;
         out << YAML::Key << "width" << YAML::Value << collider2d->width;
         out << YAML::Key << "height" << YAML::Value << collider2d->height;
         out << YAML::Key << "radius" << YAML::Value << collider2d->radius;
+        out << YAML::Key << "vertices" << YAML::Value << collider2d->vertices;
         out << YAML::Key << "drag" << YAML::Value << collider2d->drag;
         out << YAML::Key << "velocity" << YAML::Value << collider2d->velocity;
         out << YAML::EndMap;
@@ -435,6 +549,18 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         out << YAML::Key << "m_simulate_in_world_space" << YAML::Value << particlesystem->m_simulate_in_world_space;
         out << YAML::EndMap;
     }
+    else if (auto const rigidbody2d = std::dynamic_pointer_cast<class Rigidbody2D>(component); rigidbody2d != nullptr)
+    {
+        out << YAML::BeginMap;
+        out << YAML::Key << "ComponentName" << YAML::Value << "Rigidbody2DComponent";
+        out << YAML::Key << "guid" << YAML::Value << rigidbody2d->guid;
+        out << YAML::Key << "custom_name" << YAML::Value << rigidbody2d->custom_name;
+        out << YAML::Key << "mass" << YAML::Value << rigidbody2d->mass;
+        out << YAML::Key << "restitution" << YAML::Value << rigidbody2d->restitution;
+        out << YAML::Key << "drag" << YAML::Value << rigidbody2d->drag;
+        out << YAML::Key << "velocity" << YAML::Value << rigidbody2d->velocity;
+        out << YAML::EndMap;
+    }
     else if (auto const sound = std::dynamic_pointer_cast<class Sound>(component); sound != nullptr)
     {
         out << YAML::BeginMap;
@@ -817,8 +943,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->far_plane = component["far_plane"].as<float>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "Collider2DComponent")
@@ -846,6 +971,18 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->is_static = component["is_static"].as<bool>();
             }
+            if (component["is_continuous"].IsDefined())
+            {
+                deserialized_component->is_continuous = component["is_continuous"].as<bool>();
+            }
+            if (component["collision_layer"].IsDefined())
+            {
+                deserialized_component->collision_layer = component["collision_layer"].as<u32>();
+            }
+            if (component["collision_mask"].IsDefined())
+            {
+                deserialized_component->collision_mask = component["collision_mask"].as<u32>();
+            }
             if (component["collider_type"].IsDefined())
             {
                 deserialized_component->collider_type = component["collider_type"].as<ColliderType2D>();
@@ -862,6 +999,10 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->radius = component["radius"].as<float>();
             }
+            if (component["vertices"].IsDefined())
+            {
+                deserialized_component->vertices = component["vertices"].as<std::vector<glm::vec2>>();
+            }
             if (component["drag"].IsDefined())
             {
                 deserialized_component->drag = component["drag"].as<float>();
@@ -870,8 +1011,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->velocity = component["velocity"].as<glm::vec2>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "CurveComponent")
@@ -890,8 +1030,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->points = component["points"].as<std::vector<glm::vec2>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "PathComponent")
@@ -910,8 +1049,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->points = component["points"].as<std::vector<glm::vec2>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "DebugInputControllerComponent")
@@ -935,8 +1073,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->exposure = component["exposure"].as<float>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "DialoguePromptControllerComponent")
@@ -984,8 +1121,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->dialogue_objects = component["dialogue_objects"].as<std::vector<DialogueObject>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ButtonComponent")
@@ -1032,8 +1168,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ModelComponent")
@@ -1056,8 +1191,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "CubeComponent")
@@ -1088,8 +1222,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "SphereComponent")
@@ -1128,8 +1261,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "SpriteComponent")
@@ -1156,8 +1288,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "WaterComponent")
@@ -1192,8 +1323,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "PanelComponent")
@@ -1216,8 +1346,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ScreenTextComponent")
@@ -1269,8 +1398,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ExampleDynamicTextComponent")
@@ -1286,8 +1414,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
         {
             auto const deserialized_component =
                 std::dynamic_pointer_cast<class ExampleDynamicText>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ExampleUIBarComponent")
@@ -1307,8 +1434,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->value = component["value"].as<float>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "FloaterComponent")
@@ -1348,8 +1474,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->water = component["water"].as<std::weak_ptr<Water>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "FloatersManagerComponent")
@@ -1389,8 +1514,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->water = component["water"].as<std::weak_ptr<Water>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "FloeButtonComponent")
@@ -1410,8 +1534,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->floe_button_type = component["floe_button_type"].as<FloeButtonType>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "DirectionalLightComponent")
@@ -1463,8 +1586,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "PointLightComponent")
@@ -1528,8 +1650,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "SpotLightComponent")
@@ -1605,8 +1726,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "NowPromptTriggerComponent")
@@ -1622,8 +1742,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
         {
             auto const deserialized_component =
                 std::dynamic_pointer_cast<class NowPromptTrigger>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ParticleSystemComponent")
@@ -1723,8 +1842,39 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->m_simulate_in_world_space = component["m_simulate_in_world_space"].as<bool>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
+        }
+    }
+    else if (component_name == "Rigidbody2DComponent")
+    {
+        if (first_pass)
+        {
+            auto const deserialized_component = Rigidbody2D::create();
+            deserialized_component->guid = component["guid"].as<std::string>();
+            deserialized_component->custom_name = component["custom_name"].as<std::string>();
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component =
+                std::dynamic_pointer_cast<class Rigidbody2D>(get_from_pool(component["guid"].as<std::string>()));
+            if (component["mass"].IsDefined())
+            {
+                deserialized_component->mass = component["mass"].as<float>();
+            }
+            if (component["restitution"].IsDefined())
+            {
+                deserialized_component->restitution = component["restitution"].as<float>();
+            }
+            if (component["drag"].IsDefined())
+            {
+                deserialized_component->drag = component["drag"].as<float>();
+            }
+            if (component["velocity"].IsDefined())
+            {
+                deserialized_component->velocity = component["velocity"].as<glm::vec2>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "SoundComponent")
@@ -1755,8 +1905,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->is_positional = component["is_positional"].as<bool>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "SoundListenerComponent")
@@ -1772,8 +1921,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
         {
             auto const deserialized_component =
                 std::dynamic_pointer_cast<class SoundListener>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ClockComponent")
@@ -1788,8 +1936,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
         else
         {
             auto const deserialized_component = std::dynamic_pointer_cast<class Clock>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "CreditsComponent")
@@ -1809,8 +1956,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->back_to_menu_button = component["back_to_menu_button"].as<std::weak_ptr<Button>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "CustomerComponent")
@@ -1838,8 +1984,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->right_hand = component["right_hand"].as<std::weak_ptr<Entity>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "CustomerManagerComponent")
@@ -1868,8 +2013,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->customer_prefab = component["customer_prefab"].as<std::string>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "FactoryComponent")
@@ -1897,8 +2041,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->factory_light = component["factory_light"].as<std::weak_ptr<PointLight>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "GameControllerComponent")
@@ -1926,8 +2069,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->dialog_manager = component["dialog_manager"].as<std::weak_ptr<DialoguePromptController>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "HovercraftWithoutKeeperComponent")
@@ -1943,8 +2085,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
         {
             auto const deserialized_component =
                 std::dynamic_pointer_cast<class HovercraftWithoutKeeper>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "IceBoundComponent")
@@ -1960,8 +2101,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
         {
             auto const deserialized_component =
                 std::dynamic_pointer_cast<class IceBound>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "LevelControllerComponent")
@@ -2065,8 +2205,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->tutorial_level = component["tutorial_level"].as<u32>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "LighthouseComponent")
@@ -2094,8 +2233,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->spawn_position = component["spawn_position"].as<std::weak_ptr<Entity>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "LighthouseKeeperComponent")
@@ -2143,8 +2281,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->packages = component["packages"].as<std::vector<std::weak_ptr<Entity>>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "LighthouseLightComponent")
@@ -2168,8 +2305,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->spotlight_beam_width = component["spotlight_beam_width"].as<float>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "PlayerComponent")
@@ -2200,8 +2336,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->clock_text = component["clock_text"].as<std::weak_ptr<ScreenText>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "PopupComponent")
@@ -2216,8 +2351,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
         else
         {
             auto const deserialized_component = std::dynamic_pointer_cast<class Popup>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "EndScreenComponent")
@@ -2261,8 +2395,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->menu_button = component["menu_button"].as<std::weak_ptr<Button>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "PortComponent")
@@ -2281,8 +2414,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->lights = component["lights"].as<std::vector<std::weak_ptr<Entity>>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ShipComponent")
@@ -2317,8 +2449,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->my_light = component["my_light"].as<std::weak_ptr<PointLight>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ShipEyesComponent")
@@ -2334,8 +2465,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
         {
             auto const deserialized_component =
                 std::dynamic_pointer_cast<class ShipEyes>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ShipSpawnerComponent")
@@ -2379,8 +2509,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->backup_spawn = component["backup_spawn"].as<std::vector<SpawnEvent>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "ThanksComponent")
@@ -2399,8 +2528,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->back_to_menu_button = component["back_to_menu_button"].as<std::weak_ptr<Button>>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else if (component_name == "PlayerInputComponent")
@@ -2424,8 +2552,7 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
             {
                 deserialized_component->camera_speed = component["camera_speed"].as<float>();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            attach_component(deserialized_entity, deserialized_component);
         }
     }
     else
@@ -2436,286 +2563,1956 @@ void SceneSerializer::auto_deserialize_component(YAML::Node const& component, st
     // # Put new deserialization here
 }
 
-void SceneSerializer::deserialize_components(YAML::Node const& entity_node, std::shared_ptr<Entity> const& deserialized_entity,
-                                             bool const first_pass)
+void SceneSerializer::auto_deserialize_cooked_component(CookedFile const& file, CookedComponent const& component,
+                                                        std::shared_ptr<Entity> const& deserialized_entity, bool const first_pass)
 {
-    auto const components = entity_node["Components"];
-
-    for (auto it = components.begin(); it != components.end(); ++it)
+    // # Auto cooked deserialization start
+    switch (component.type)
     {
-        YAML::Node const& component = *it;
-        auto component_name = component["ComponentName"].as<std::string>();
-        if (false)
+    case ComponentType::Camera:
+        if (first_pass)
         {
-            // Custom deserialization here
+            auto const deserialized_component = Camera::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
         }
         else
         {
-            auto_deserialize_component(component, deserialized_entity, first_pass);
-        }
-    }
-}
-
-std::shared_ptr<Entity> SceneSerializer::deserialize_entity_first_pass(YAML::Node const& entity)
-{
-    auto const entity_node = entity["guid"];
-    if (!entity_node)
-    {
-        std::cout << "Deserialization of a scene failed. Broken entity. No guid present."
-                  << "\n";
-        return nullptr;
-    }
-    auto const guid = entity_node.as<std::string>();
-
-    auto const name_node = entity["Name"];
-    if (!name_node)
-    {
-        std::cout << "Deserialization of a scene failed. Broken entity. No name present."
-                  << "\n";
-        return nullptr;
-    }
-    auto const name = name_node.as<std::string>();
-
-    std::shared_ptr<Entity> deserialized_entity = Entity::create(guid, name);
-    deserialized_entity->m_is_being_deserialized = true;
-
-    auto const transform = entity["TransformComponent"];
-    if (!transform)
-    {
-        std::cout << "Deserialization of a scene failed. Broken entity. No transform present."
-                  << "\n";
-        return nullptr;
-    }
-
-    deserialized_entity->transform->set_local_position(transform["Translation"].as<glm::vec3>());
-    deserialized_entity->transform->set_euler_angles(transform["Rotation"].as<glm::vec3>());
-    deserialized_entity->transform->set_local_scale(transform["Scale"].as<glm::vec3>());
-    deserialized_entity->m_parent_guid = transform["Parent"]["guid"].as<std::string>();
-
-    deserialize_components(entity, deserialized_entity, true);
-
-    return deserialized_entity;
-}
-
-void SceneSerializer::deserialize_entity_second_pass(YAML::Node const& entity, std::shared_ptr<Entity> const& deserialized_entity)
-{
-    deserialize_components(entity, deserialized_entity, false);
-
-    deserialized_entity->m_is_being_deserialized = false;
-}
-
-// Serialize one entity (including its children) to a file.
-void SceneSerializer::serialize_this_entity(std::shared_ptr<Entity> const& entity, std::string const& file_path) const
-{
-    YAML::Emitter out;
-    out << YAML::BeginMap;
-    out << YAML::Key << "Scene" << YAML::Value << "Untitled";
-    out << YAML::Key << "Entities";
-    out << YAML::Value << YAML::BeginSeq;
-
-    serialize_entity_recursively(out, entity);
-
-    out << YAML::EndSeq;
-    out << YAML::EndMap;
-
-    std::filesystem::path const path = file_path;
-
-    if (!path.has_parent_path())
-    {
-        Debug::log("Path to serialize an entity doesn't have a directory. Aborting.", DebugType::Error);
-        return;
-    }
-
-    if (!std::filesystem::exists(path.parent_path()))
-    {
-        create_directory(path.parent_path());
-    }
-
-    std::ofstream scene_file(file_path);
-
-    if (!scene_file.is_open())
-    {
-        std::cout << "Could not serialize an entity to a file: " << file_path << "\n";
-        return;
-    }
-
-    scene_file << out.c_str();
-    scene_file.close();
-}
-
-// Deserialize entity (might include its children) from a file.
-// Replaces all guids that are not present in the scene with newly generated ones.
-std::shared_ptr<Entity> SceneSerializer::deserialize_this_entity(std::string const& file_path)
-{
-    std::optional<std::string> scene_data = Engine::asset_preloader->get_text_asset(file_path);
-
-    std::stringstream stream;
-
-    if (!scene_data.has_value())
-    {
-        Debug::log("Preloading failed " + file_path);
-        std::ifstream scene_file(file_path);
-
-        if (!scene_file.is_open())
-        {
-            Debug::log("Could not open a scene file: " + file_path + "\n", DebugType::Error);
-            return {};
+            auto const deserialized_component = std::dynamic_pointer_cast<class Camera>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->width = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->height = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->fov = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->near_plane = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->far_plane = field->read<float>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
         }
+        break;
 
-        stream << scene_file.rdbuf();
-        scene_file.close();
-
-        scene_data = stream.str();
-    }
-    else
-    {
-        Debug::log("Preloading succ " + file_path);
-        stream = std::stringstream(scene_data.value());
-    }
-
-    std::unordered_set<std::string> included_guids = {};
-    std::string line = {};
-    bool next_line_new_guid = false;
-    while (std::getline(stream, line))
-    {
-        size_t component_search = line.find("ComponentName:");
-        size_t entity_search = line.find("Entity:");
-
-        if (component_search != std::string::npos || entity_search != std::string::npos)
+    case ComponentType::Collider2D:
+        if (first_pass)
         {
-            next_line_new_guid = true;
-            continue;
+            auto const deserialized_component = Collider2D::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
         }
-
-        if (next_line_new_guid)
+        else
         {
-            size_t guid_search = line.find("guid:");
-            if (guid_search == std::string::npos)
+            auto const deserialized_component = std::dynamic_pointer_cast<class Collider2D>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
             {
-                Debug::log("Copied entity might be corrupted, missing guid after component or entity?", DebugType::Error);
-                next_line_new_guid = false;
-                continue;
+                deserialized_component->offset = field->read<glm::vec2>();
             }
-
-            size_t first_guid_char_offset = guid_search + 6;
-            std::string guid = line.substr(first_guid_char_offset);
-            included_guids.emplace(guid);
-
-            next_line_new_guid = false;
-        }
-    }
-
-    stream.clear();
-    stream.seekg(0);
-
-    std::stringstream output = {};
-    while (std::getline(stream, line))
-    {
-        size_t guid_search = line.find("guid:");
-
-        if (guid_search == std::string::npos)
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->is_trigger = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->is_static = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->is_continuous = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->collision_layer = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->collision_mask = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->collider_type = field->read<ColliderType2D>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->width = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 8))
+            {
+                deserialized_component->height = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 9))
+            {
+                deserialized_component->radius = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 10))
+            {
+                deserialized_component->vertices = field->read<std::vector<glm::vec2>>();
+            }
+            if (auto field = file.get_field(component, 11))
+            {
+                deserialized_component->drag = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 12))
+            {
+                deserialized_component->velocity = field->read<glm::vec2>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Curve:
+        if (first_pass)
+        {
+            auto const deserialized_component = Curve::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Curve>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->points = field->read<std::vector<glm::vec2>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Path:
+        if (first_pass)
+        {
+            auto const deserialized_component = Path::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Path>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->points = field->read<std::vector<glm::vec2>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::DebugInputController:
+        if (first_pass)
+        {
+            auto const deserialized_component = DebugInputController::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class DebugInputController>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->gamma = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->exposure = field->read<float>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::DialoguePromptController:
+        if (first_pass)
+        {
+            auto const deserialized_component = DialoguePromptController::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class DialoguePromptController>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->interp_speed = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->dialogue_panel = field->read<std::weak_ptr<Button>>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->panel_parent = field->read<std::weak_ptr<Entity>>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->keeper_sprite = field->read<std::weak_ptr<Entity>>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->upper_text = field->read<std::weak_ptr<ScreenText>>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->middle_text = field->read<std::weak_ptr<ScreenText>>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->lower_text = field->read<std::weak_ptr<ScreenText>>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->dialogue_objects = field->read<std::vector<DialogueObject>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Button:
+        if (first_pass)
+        {
+            auto const deserialized_component = Button::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Button>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->path_default = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->path_hovered = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->path_pressed = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->top_left_corner = field->read<glm::vec2>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->top_right_corner = field->read<glm::vec2>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->bottom_left_corner = field->read<glm::vec2>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->bottom_right_corner = field->read<glm::vec2>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->material = field->read<std::shared_ptr<Material>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Model:
+        if (first_pass)
+        {
+            auto const deserialized_component = Model::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Model>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->model_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->material = field->read<std::shared_ptr<Material>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Cube:
+        if (first_pass)
+        {
+            auto const deserialized_component = Cube::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Cube>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->diffuse_texture_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->specular_texture_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->model_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->material = field->read<std::shared_ptr<Material>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Sphere:
+        if (first_pass)
+        {
+            auto const deserialized_component = Sphere::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Sphere>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->sector_count = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->stack_count = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->texture_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->radius = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->model_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->material = field->read<std::shared_ptr<Material>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Sprite:
+        if (first_pass)
+        {
+            auto const deserialized_component = Sprite::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Sprite>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->diffuse_texture_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->model_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->material = field->read<std::shared_ptr<Material>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Water:
+        if (first_pass)
+        {
+            auto const deserialized_component = Water::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Water>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->waves = field->read<std::vector<DXWave>>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->m_ps_buffer = field->read<ConstantBufferWater>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->tesselation_level = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->model_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->material = field->read<std::shared_ptr<Material>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Panel:
+        if (first_pass)
+        {
+            auto const deserialized_component = Panel::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Panel>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->background_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->material = field->read<std::shared_ptr<Material>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::ScreenText:
+        if (first_pass)
+        {
+            auto const deserialized_component = ScreenText::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class ScreenText>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->text = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->position = field->read<glm::vec2>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->font_size = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->color = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->flags = field->read<u16>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->font_name = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->bold = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->button_ref = field->read<std::weak_ptr<Button>>();
+            }
+            if (auto field = file.get_field(component, 8))
+            {
+                deserialized_component->material = field->read<std::shared_ptr<Material>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::ExampleDynamicText:
+        if (first_pass)
+        {
+            auto const deserialized_component = ExampleDynamicText::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class ExampleDynamicText>(get_from_pool(component.guid));
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::ExampleUIBar:
+        if (first_pass)
+        {
+            auto const deserialized_component = ExampleUIBar::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class ExampleUIBar>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->value = field->read<float>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Floater:
+        if (first_pass)
+        {
+            auto const deserialized_component = Floater::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Floater>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->sink = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->side_floaters_offset = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->side_roation_strength = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->forward_rotation_strength = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->forward_floaters_offest = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->water = field->read<std::weak_ptr<Water>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::FloatersManager:
+        if (first_pass)
+        {
+            auto const deserialized_component = FloatersManager::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class FloatersManager>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->big_boat_settings = field->read<FloaterSettings>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->small_boat_settings = field->read<FloaterSettings>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->medium_boat_settings = field->read<FloaterSettings>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->tool_boat_settings = field->read<FloaterSettings>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->pirate_boat_settings = field->read<FloaterSettings>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->water = field->read<std::weak_ptr<Water>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::FloeButton:
+        if (first_pass)
+        {
+            auto const deserialized_component = FloeButton::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class FloeButton>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->floe_button_type = field->read<FloeButtonType>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::DirectionalLight:
+        if (first_pass)
+        {
+            auto const deserialized_component = DirectionalLight::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class DirectionalLight>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->ambient = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->diffuse = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->specular = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->m_near_plane = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->m_far_plane = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->m_blocker_search_num_samples = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->m_pcf_num_samples = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->m_light_world_size = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 8))
+            {
+                deserialized_component->m_light_frustum_width = field->read<float>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::PointLight:
+        if (first_pass)
+        {
+            auto const deserialized_component = PointLight::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class PointLight>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->constant = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->linear = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->quadratic = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->ambient = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->diffuse = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->specular = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->m_near_plane = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->m_far_plane = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 8))
+            {
+                deserialized_component->m_blocker_search_num_samples = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 9))
+            {
+                deserialized_component->m_pcf_num_samples = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 10))
+            {
+                deserialized_component->m_light_world_size = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 11))
+            {
+                deserialized_component->m_light_frustum_width = field->read<float>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::SpotLight:
+        if (first_pass)
+        {
+            auto const deserialized_component = SpotLight::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class SpotLight>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->constant = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->linear = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->quadratic = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->scattering_factor = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->cut_off = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->outer_cut_off = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->ambient = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->diffuse = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 8))
+            {
+                deserialized_component->specular = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 9))
+            {
+                deserialized_component->m_near_plane = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 10))
+            {
+                deserialized_component->m_far_plane = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 11))
+            {
+                deserialized_component->m_blocker_search_num_samples = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 12))
+            {
+                deserialized_component->m_pcf_num_samples = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 13))
+            {
+                deserialized_component->m_light_world_size = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 14))
+            {
+                deserialized_component->m_light_frustum_width = field->read<float>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::NowPromptTrigger:
+        if (first_pass)
+        {
+            auto const deserialized_component = NowPromptTrigger::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class NowPromptTrigger>(get_from_pool(component.guid));
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::ParticleSystem:
+        if (first_pass)
+        {
+            auto const deserialized_component = ParticleSystem::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class ParticleSystem>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->particle_type = field->read<ParticleType>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->play_once = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->rotate_particles = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->spawn_instantly = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->sprite_path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->min_spawn_interval = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->max_spawn_interval = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->start_velocity_1 = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 8))
+            {
+                deserialized_component->start_velocity_2 = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 9))
+            {
+                deserialized_component->min_spawn_alpha = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 10))
+            {
+                deserialized_component->max_spawn_alpha = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 11))
+            {
+                deserialized_component->start_min_particle_size = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 12))
+            {
+                deserialized_component->start_max_particle_size = field->read<glm::vec3>();
+            }
+            if (auto field = file.get_field(component, 13))
+            {
+                deserialized_component->emitter_bounds = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 14))
+            {
+                deserialized_component->min_spawn_count = field->read<i32>();
+            }
+            if (auto field = file.get_field(component, 15))
+            {
+                deserialized_component->max_spawn_count = field->read<i32>();
+            }
+            if (auto field = file.get_field(component, 16))
+            {
+                deserialized_component->start_color_1 = field->read<glm::vec4>();
+            }
+            if (auto field = file.get_field(component, 17))
+            {
+                deserialized_component->end_color_1 = field->read<glm::vec4>();
+            }
+            if (auto field = file.get_field(component, 18))
+            {
+                deserialized_component->lifetime_1 = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 19))
+            {
+                deserialized_component->lifetime_2 = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 20))
+            {
+                deserialized_component->m_simulate_in_world_space = field->read<bool>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Rigidbody2D:
+        if (first_pass)
+        {
+            auto const deserialized_component = Rigidbody2D::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Rigidbody2D>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->mass = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->restitution = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->drag = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->velocity = field->read<glm::vec2>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Sound:
+        if (first_pass)
+        {
+            auto const deserialized_component = Sound::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Sound>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->path = field->read<std::string>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->volume = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->play_on_awake = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->is_positional = field->read<bool>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::SoundListener:
+        if (first_pass)
+        {
+            auto const deserialized_component = SoundListener::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class SoundListener>(get_from_pool(component.guid));
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Clock:
+        if (first_pass)
+        {
+            auto const deserialized_component = Clock::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Clock>(get_from_pool(component.guid));
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Credits:
+        if (first_pass)
+        {
+            auto const deserialized_component = Credits::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Credits>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->back_to_menu_button = field->read<std::weak_ptr<Button>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Customer:
+        if (first_pass)
+        {
+            auto const deserialized_component = Customer::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Customer>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->collider = field->read<std::weak_ptr<Collider2D>>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->left_hand = field->read<std::weak_ptr<Entity>>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->right_hand = field->read<std::weak_ptr<Entity>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::CustomerManager:
+        if (first_pass)
+        {
+            auto const deserialized_component = CustomerManager::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class CustomerManager>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->destinations_after_feeding = field->read<std::vector<std::weak_ptr<Entity>>>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->destination_curve = field->read<std::weak_ptr<Curve>>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->customer_prefab = field->read<std::string>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Factory:
+        if (first_pass)
+        {
+            auto const deserialized_component = Factory::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Factory>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->type = field->read<FactoryType>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->lights = field->read<std::vector<std::weak_ptr<PointLight>>>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->factory_light = field->read<std::weak_ptr<PointLight>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::GameController:
+        if (first_pass)
+        {
+            auto const deserialized_component = GameController::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class GameController>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->current_scene = field->read<std::weak_ptr<Entity>>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->next_scene = field->read<std::weak_ptr<Entity>>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->dialog_manager = field->read<std::weak_ptr<DialoguePromptController>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::HovercraftWithoutKeeper:
+        if (first_pass)
+        {
+            auto const deserialized_component = HovercraftWithoutKeeper::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class HovercraftWithoutKeeper>(get_from_pool(component.guid));
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::IceBound:
+        if (first_pass)
+        {
+            auto const deserialized_component = IceBound::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class IceBound>(get_from_pool(component.guid));
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::LevelController:
+        if (first_pass)
+        {
+            auto const deserialized_component = LevelController::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class LevelController>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->map_time = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->map_food = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->maximum_lighthouse_level = field->read<i32>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->factories = field->read<std::vector<std::weak_ptr<Factory>>>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->port = field->read<std::weak_ptr<Port>>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->lighthouse = field->read<std::weak_ptr<Lighthouse>>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->customer_manager = field->read<std::weak_ptr<CustomerManager>>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->playfield_width = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 8))
+            {
+                deserialized_component->playfield_additional_width = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 9))
+            {
+                deserialized_component->playfield_height = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 10))
+            {
+                deserialized_component->playfield_y_shift = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 11))
+            {
+                deserialized_component->ships_limit_curve = field->read<std::weak_ptr<Curve>>();
+            }
+            if (auto field = file.get_field(component, 12))
+            {
+                deserialized_component->ships_limit = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 13))
+            {
+                deserialized_component->ships_speed_curve = field->read<std::weak_ptr<Curve>>();
+            }
+            if (auto field = file.get_field(component, 14))
+            {
+                deserialized_component->ships_speed = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 15))
+            {
+                deserialized_component->ships_range_curve = field->read<std::weak_ptr<Curve>>();
+            }
+            if (auto field = file.get_field(component, 16))
+            {
+                deserialized_component->ships_turn_curve = field->read<std::weak_ptr<Curve>>();
+            }
+            if (auto field = file.get_field(component, 17))
+            {
+                deserialized_component->ships_additional_speed_curve = field->read<std::weak_ptr<Curve>>();
+            }
+            if (auto field = file.get_field(component, 18))
+            {
+                deserialized_component->pirates_in_control_curve = field->read<std::weak_ptr<Curve>>();
+            }
+            if (auto field = file.get_field(component, 19))
+            {
+                deserialized_component->is_tutorial = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 20))
+            {
+                deserialized_component->starting_packages = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 21))
+            {
+                deserialized_component->tutorial_level = field->read<u32>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Lighthouse:
+        if (first_pass)
+        {
+            auto const deserialized_component = Lighthouse::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Lighthouse>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->light = field->read<std::weak_ptr<LighthouseLight>>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->water = field->read<std::weak_ptr<Water>>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->spawn_position = field->read<std::weak_ptr<Entity>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::LighthouseKeeper:
+        if (first_pass)
+        {
+            auto const deserialized_component = LighthouseKeeper::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class LighthouseKeeper>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->maximum_speed = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->acceleration = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->deceleration = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->lighthouse = field->read<std::weak_ptr<Lighthouse>>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->port = field->read<std::weak_ptr<Port>>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->keeper_dust = field->read<std::weak_ptr<ParticleSystem>>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->keeper_splash = field->read<std::weak_ptr<ParticleSystem>>();
+            }
+            if (auto field = file.get_field(component, 7))
+            {
+                deserialized_component->packages = field->read<std::vector<std::weak_ptr<Entity>>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::LighthouseLight:
+        if (first_pass)
+        {
+            auto const deserialized_component = LighthouseLight::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class LighthouseLight>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->spotlight = field->read<std::weak_ptr<SpotLight>>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->spotlight_beam_width = field->read<float>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Player:
+        if (first_pass)
+        {
+            auto const deserialized_component = Player::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Player>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->packages_text = field->read<std::weak_ptr<ScreenText>>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->flashes_text = field->read<std::weak_ptr<ScreenText>>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->level_text = field->read<std::weak_ptr<ScreenText>>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->clock_text = field->read<std::weak_ptr<ScreenText>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Popup:
+        if (first_pass)
+        {
+            auto const deserialized_component = Popup::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Popup>(get_from_pool(component.guid));
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::EndScreen:
+        if (first_pass)
+        {
+            auto const deserialized_component = EndScreen::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class EndScreen>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->is_failed = field->read<bool>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->number_of_stars = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->stars = field->read<std::vector<std::weak_ptr<Entity>>>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->star_scale = field->read<glm::vec2>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->next_level_button = field->read<std::weak_ptr<Button>>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->restart_button = field->read<std::weak_ptr<Button>>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->menu_button = field->read<std::weak_ptr<Button>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Port:
+        if (first_pass)
+        {
+            auto const deserialized_component = Port::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Port>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->lights = field->read<std::vector<std::weak_ptr<Entity>>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::Ship:
+        if (first_pass)
+        {
+            auto const deserialized_component = Ship::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Ship>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->type = field->read<ShipType>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->light = field->read<std::weak_ptr<LighthouseLight>>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->spawner = field->read<std::weak_ptr<ShipSpawner>>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->eyes = field->read<std::weak_ptr<ShipEyes>>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->my_light = field->read<std::weak_ptr<PointLight>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    case ComponentType::ShipEyes:
+        if (first_pass)
         {
-            output << line << "\n";
-            continue;
+            auto const deserialized_component = ShipEyes::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
         }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class ShipEyes>(get_from_pool(component.guid));
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
 
-        // Replace guid
-        size_t first_guid_char_offset = guid_search + 6;
-        std::string guid = line.substr(first_guid_char_offset);
+    case ComponentType::ShipSpawner:
+        if (first_pass)
+        {
+            auto const deserialized_component = ShipSpawner::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class ShipSpawner>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->paths = field->read<std::vector<std::weak_ptr<Path>>>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->floaters_manager = field->read<std::weak_ptr<FloatersManager>>();
+            }
+            if (auto field = file.get_field(component, 2))
+            {
+                deserialized_component->light = field->read<std::weak_ptr<LighthouseLight>>();
+            }
+            if (auto field = file.get_field(component, 3))
+            {
+                deserialized_component->last_chance_food_threshold = field->read<u32>();
+            }
+            if (auto field = file.get_field(component, 4))
+            {
+                deserialized_component->last_chance_time_threshold = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 5))
+            {
+                deserialized_component->main_event_spawn = field->read<std::vector<SpawnEvent>>();
+            }
+            if (auto field = file.get_field(component, 6))
+            {
+                deserialized_component->backup_spawn = field->read<std::vector<SpawnEvent>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
 
-        if (guid == "\"\"")
+    case ComponentType::Thanks:
+        if (first_pass)
         {
-            output << line << "\n";
-            continue;
+            auto const deserialized_component = Thanks::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
+        }
+        else
+        {
+            auto const deserialized_component = std::dynamic_pointer_cast<class Thanks>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->back_to_menu_button = field->read<std::weak_ptr<Button>>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
         }
+        break;
 
-        if (m_replaced_guids_map.contains(guid))
+    case ComponentType::PlayerInput:
+        if (first_pass)
         {
-            line.replace(first_guid_char_offset, guid.size(), m_replaced_guids_map.at(guid));
+            auto const deserialized_component = PlayerInput::create();
+            deserialized_component->guid = component.guid;
+            deserialized_component->custom_name = component.custom_name;
+            deserialized_pool.emplace_back(deserialized_component);
         }
-        else if (included_guids.contains(guid))
+        else
         {
-            std::string new_guid = AK::generate_guid();
-            m_replaced_guids_map.emplace(guid, new_guid);
-            line.replace(first_guid_char_offset, guid.size(), new_guid);
+            auto const deserialized_component = std::dynamic_pointer_cast<class PlayerInput>(get_from_pool(component.guid));
+            if (auto field = file.get_field(component, 0))
+            {
+                deserialized_component->player_speed = field->read<float>();
+            }
+            if (auto field = file.get_field(component, 1))
+            {
+                deserialized_component->camera_speed = field->read<float>();
+            }
+            attach_component(deserialized_entity, deserialized_component);
+        }
+        break;
+
+    default:
+        std::cout << "Error. Deserialization of component " << component.name << " failed."
+                  << "\n";
+        break;
+    }
+    // # Put new cooked deserialization here
+}
+
+void SceneSerializer::deserialize_components(YAML::Node const& entity_node, std::shared_ptr<Entity> const& deserialized_entity,
+                                             bool const first_pass)
+{
+    auto const components = entity_node["Components"];
+
+    for (auto it = components.begin(); it != components.end(); ++it)
+    {
+        YAML::Node const& component = *it;
+        auto component_name = component["ComponentName"].as<std::string>();
+        if (false)
+        {
+            // Custom deserialization here
+        }
+        else
+        {
+            auto_deserialize_component(component, deserialized_entity, first_pass);
+        }
+    }
+}
+
+std::shared_ptr<Entity> SceneSerializer::deserialize_entity_first_pass(YAML::Node const& entity)
+{
+    auto const entity_node = entity["guid"];
+    if (!entity_node)
+    {
+        std::cout << "Deserialization of a scene failed. Broken entity. No guid present."
+                  << "\n";
+        return nullptr;
+    }
+    auto const guid = entity_node.as<std::string>();
+
+    auto const name_node = entity["Name"];
+    if (!name_node)
+    {
+        std::cout << "Deserialization of a scene failed. Broken entity. No name present."
+                  << "\n";
+        return nullptr;
+    }
+    auto const name = name_node.as<std::string>();
+
+    // Entities of a plan aren't in any scene
+    std::shared_ptr<Entity> deserialized_entity =
+        m_deserialization_mode == DeserializationMode::Plan ? Entity::allocate(guid, name) : Entity::create(guid, name);
+    deserialized_entity->m_is_being_deserialized = true;
+
+    auto const transform = entity["TransformComponent"];
+    if (!transform)
+    {
+        std::cout << "Deserialization of a scene failed. Broken entity. No transform present."
+                  << "\n";
+        return nullptr;
+    }
+
+    deserialized_entity->transform->set_local_position(transform["Translation"].as<glm::vec3>());
+    deserialized_entity->transform->set_euler_angles(transform["Rotation"].as<glm::vec3>());
+    deserialized_entity->transform->set_local_scale(transform["Scale"].as<glm::vec3>());
+    deserialized_entity->m_parent_guid = transform["Parent"]["guid"].as<std::string>();
+
+    deserialize_components(entity, deserialized_entity, true);
+
+    return deserialized_entity;
+}
+
+void SceneSerializer::deserialize_entity_second_pass(YAML::Node const& entity, std::shared_ptr<Entity> const& deserialized_entity)
+{
+    deserialize_components(entity, deserialized_entity, false);
+
+    deserialized_entity->m_is_being_deserialized = false;
+}
+
+// Serialize one entity (including its children) to a file.
+void SceneSerializer::serialize_this_entity(std::shared_ptr<Entity> const& entity, std::string const& file_path) const
+{
+    std::filesystem::path const path = file_path;
+
+    if (!path.has_parent_path())
+    {
+        Debug::log("Path to serialize an entity doesn't have a directory. Aborting.", DebugType::Error);
+        return;
+    }
+
+    if (!std::filesystem::exists(path.parent_path()))
+    {
+        create_directory(path.parent_path());
+    }
+
+    std::ofstream scene_file(file_path);
+
+    if (!scene_file.is_open())
+    {
+        std::cout << "Could not serialize an entity to a file: " << file_path << "\n";
+        return;
+    }
+
+    scene_file << serialize_this_entity_to_text(entity);
+    scene_file.close();
+}
+
+std::string SceneSerializer::serialize_this_entity_to_text(std::shared_ptr<Entity> const& entity)
+{
+    YAML::Emitter out;
+    out << YAML::BeginMap;
+    out << YAML::Key << "Scene" << YAML::Value << "Untitled";
+    out << YAML::Key << "Entities";
+    out << YAML::Value << YAML::BeginSeq;
+
+    serialize_entity_recursively(out, entity);
+
+    out << YAML::EndSeq;
+    out << YAML::EndMap;
+
+    return out.c_str();
+}
+
+// Deserialize entity (might include its children) from a file.
+// Replaces all guids of the file's own entities and components with newly generated ones.
+std::shared_ptr<Entity> SceneSerializer::deserialize_this_entity(std::string const& file_path)
+{
+    std::optional<std::string> scene_data = Engine::asset_preloader->get_text_asset(file_path);
+
+    if (!scene_data.has_value())
+    {
+        Debug::log("Preloading failed " + file_path);
+        std::ifstream scene_file(file_path);
+
+        if (!scene_file.is_open())
+        {
+            Debug::log("Could not open a scene file: " + file_path + "\n", DebugType::Error);
+            return {};
         }
 
-        output << line << "\n";
+        std::stringstream stream;
+        stream << scene_file.rdbuf();
+        scene_file.close();
+
+        scene_data = stream.str();
+    }
+    else
+    {
+        Debug::log("Preloading succ " + file_path);
+    }
+
+    YAML::Node const data = YAML::Load(scene_data.value());
+    replace_guids(data);
+
+    return deserialize_injected_entities(data);
+}
+
+std::shared_ptr<Entity> SceneSerializer::deserialize_this_entity_from_text(std::string const& entity_data)
+{
+    YAML::Node const data = YAML::Load(entity_data);
+    replace_guids(data);
+
+    return deserialize_injected_entities(data);
+}
+
+void SceneSerializer::replace_guids(YAML::Node const& data)
+{
+    std::unordered_set<std::string> included_guids = {};
+
+    for (auto const entity : data["Entities"])
+    {
+        if (entity["guid"])
+            included_guids.emplace(entity["guid"].Scalar());
+
+        for (auto const component : entity["Components"])
+        {
+            if (component["guid"])
+                included_guids.emplace(component["guid"].Scalar());
+        }
     }
 
-    YAML::Node data = YAML::Load(output.str());
+    std::vector<YAML::Node> guid_nodes = {};
+    find_guid_nodes(data, guid_nodes);
+
+    // NOTE: Nodes share their data, assigning to them writes into the document.
+    for (auto& node : guid_nodes)
+    {
+        std::string const guid = node.Scalar();
+
+        if (guid.empty())
+            continue;
+
+        if (auto const it = m_replaced_guids_map.find(guid); it != m_replaced_guids_map.end())
+        {
+            node = it->second;
+        }
+        else if (included_guids.contains(guid))
+        {
+            std::string const new_guid = AK::generate_guid();
+            m_replaced_guids_map.emplace(guid, new_guid);
+            node = new_guid;
+        }
+    }
+}
 
+std::shared_ptr<Entity> SceneSerializer::deserialize_injected_entities(YAML::Node const& data)
+{
     if (!data["Scene"])
         return {};
 
     DeserializationMode const previous_mode = m_deserialization_mode;
     m_deserialization_mode = DeserializationMode::InjectFromFile;
 
-    auto const scene_name = data["Scene"].as<std::string>();
+    auto const first_entity = create_injected_entities(data);
+
+    if (first_entity != nullptr && MainScene::get_instance()->is_running)
+    {
+        for (auto const& component : deserialized_pool)
+        {
+            component->awake();
+            component->has_been_awaken = true;
+
+            if (component->enabled())
+            {
+                component->on_enabled();
+            }
+        }
+    }
+
+    m_deserialization_mode = previous_mode;
+
+    return first_entity;
+}
+
+std::shared_ptr<Entity> SceneSerializer::create_injected_entities(YAML::Node const& data)
+{
+    auto const scene_name = data["Scene"].as<std::string>();
+
+    std::shared_ptr<Entity> first_entity = {};
+
+    if (auto const entities = data["Entities"])
+    {
+        size_t const first_entity_index = deserialized_entities_pool.size();
+
+        if (!deserialize_entities(entities))
+            return {};
+
+        if (deserialized_entities_pool.size() > first_entity_index)
+            first_entity = deserialized_entities_pool[first_entity_index];
+    }
+
+    return first_entity;
+}
+
+bool SceneSerializer::deserialize_entities(YAML::Node const& entities)
+{
+    std::vector<std::pair<std::shared_ptr<Entity>, YAML::Node>> deserialized_entities = {};
+    deserialized_entities.reserve(entities.size());
+
+    // First pass. Create all entities and components.
+    for (auto const entity : entities)
+    {
+        auto const deserialized_entity = deserialize_entity_first_pass(entity);
+        if (deserialized_entity == nullptr)
+            return false;
+
+        deserialized_entities_pool.emplace_back(deserialized_entity);
+        deserialized_entities.emplace_back(deserialized_entity, entity);
+    }
+
+    // Second pass. Assign components' values including references to other components.
+    // Assign appropriate parent for each entity.
+    for (auto const& [entity, node] : deserialized_entities)
+    {
+        deserialize_entity_second_pass(node, entity);
+
+        if (entity->m_parent_guid.empty())
+            continue;
+
+        if (auto const parent = find_deserialized_entity(entity->m_parent_guid))
+            entity->transform->set_parent(parent->transform);
+    }
+
+    return true;
+}
 
-    std::shared_ptr<Entity> first_entity = {};
+void SceneSerializer::deserialize_cooked_entities(CookedFile const& file)
+{
+    std::vector<std::pair<std::shared_ptr<Entity>, CookedEntity>> deserialized_entities = {};
+    deserialized_entities.reserve(file.get_entity_count());
 
-    if (auto const entities = data["Entities"])
+    // First pass. Create all entities and components.
+    for (u32 i = 0; i < file.get_entity_count(); ++i)
     {
-        std::vector<std::pair<std::shared_ptr<Entity>, YAML::Node>> deserialized_entities = {};
-        deserialized_entities.reserve(entities.size());
-
-        // First pass. Create all entities and components.
-        for (auto const entity : entities)
-        {
-            auto const deserialized_entity = deserialize_entity_first_pass(entity);
-            if (deserialized_entity == nullptr)
-            {
-                m_deserialization_mode = previous_mode;
-                return {};
-            }
+        auto const entity = file.get_entity(i);
 
-            if (first_entity == nullptr)
-            {
-                first_entity = deserialized_entity;
-            }
+        // Entities of a plan aren't in any scene
+        std::shared_ptr<Entity> deserialized_entity = m_deserialization_mode == DeserializationMode::Plan
+                                                        ? Entity::allocate(entity.guid, entity.name)
+                                                        : Entity::create(entity.guid, entity.name);
+        deserialized_entity->m_is_being_deserialized = true;
 
-            deserialized_entities_pool.emplace_back(deserialized_entity);
-            deserialized_entities.emplace_back(deserialized_entity, entity);
-        }
+        deserialized_entity->transform->set_local_position(entity.translation);
+        deserialized_entity->transform->set_euler_angles(entity.rotation);
+        deserialized_entity->transform->set_local_scale(entity.scale);
+        deserialized_entity->m_parent_guid = entity.parent_guid;
 
-        // Second pass. Assign components' values including references to other components.
-        // Assign appropriate parent for each entity.
-        for (auto const& [entity, node] : deserialized_entities)
+        for (u32 component = 0; component < entity.component_count; ++component)
         {
-            deserialize_entity_second_pass(node, entity);
-
-            if (entity->m_parent_guid.empty())
-                continue;
-
-            for (auto const& [other_entity, other_node] : deserialized_entities)
-            {
-                if (entity->m_parent_guid == other_entity->guid)
-                {
-                    entity->transform->set_parent(other_entity->transform);
-                    break;
-                }
-            }
+            auto_deserialize_cooked_component(file, file.get_component(entity.first_component + component), deserialized_entity, true);
         }
 
-        if (MainScene::get_instance()->is_running)
-        {
-            for (auto const& component : deserialized_pool)
-            {
-                component->awake();
-                component->has_been_awaken = true;
+        deserialized_entities_pool.emplace_back(deserialized_entity);
+        deserialized_entities.emplace_back(deserialized_entity, entity);
+    }
 
-                if (component->enabled())
-                {
-                    component->on_enabled();
-                }
-            }
+    // Second pass. Assign components' values including references to other components.
+    // Assign appropriate parent for each entity.
+    for (auto const& [deserialized_entity, entity] : deserialized_entities)
+    {
+        for (u32 component = 0; component < entity.component_count; ++component)
+        {
+            auto_deserialize_cooked_component(file, file.get_component(entity.first_component + component), deserialized_entity, false);
         }
-    }
 
-    m_deserialization_mode = previous_mode;
+        deserialized_entity->m_is_being_deserialized = false;
 
-    return first_entity;
+        if (deserialized_entity->m_parent_guid.empty())
+            continue;
+
+        if (auto const parent = find_deserialized_entity(deserialized_entity->m_parent_guid))
+            deserialized_entity->transform->set_parent(parent->transform);
+    }
 }
 
 void SceneSerializer::serialize(std::string const& file_path) const
@@ -2772,60 +4569,42 @@ bool SceneSerializer::deserialize(std::string const& file_path)
         scene_data = stream.str();
     }
 
-    YAML::Node data = YAML::Load(scene_data.value());
-
-    if (!data["Scene"])
-        return false;
-
-    auto const scene_name = data["Scene"].as<std::string>();
-    std::cout << "Deserializing scene " << scene_name << "\n";
+    // Cooked copies are only written by SceneCooker::cook_all(), without one the text is parsed
+    if (auto const cooked_file = SceneCooker::map(file_path, scene_data.value()))
+    {
+        std::cout << "Deserializing scene " << cooked_file->get_scene_name() << "\n";
 
-    if (auto const entities = data["Entities"])
+        deserialize_cooked_entities(*cooked_file);
+    }
+    else
     {
-        std::vector<std::pair<std::shared_ptr<Entity>, YAML::Node>> deserialized_entities = {};
-        deserialized_entities.reserve(entities.size());
+        YAML::Node data = YAML::Load(scene_data.value());
 
-        // First pass. Create all entities and components.
-        for (auto const entity : entities)
-        {
-            auto const deserialized_entity = deserialize_entity_first_pass(entity);
-            if (deserialized_entity == nullptr)
-                return false;
+        if (!data["Scene"])
+            return false;
 
-            deserialized_entities_pool.emplace_back(deserialized_entity);
-            deserialized_entities.emplace_back(deserialized_entity, entity);
-        }
+        auto const scene_name = data["Scene"].as<std::string>();
+        std::cout << "Deserializing scene " << scene_name << "\n";
 
-        // Second pass. Assign components' values including references to other components.
-        // Assign appropriate parent for each entity.
-        for (auto const& [entity, node] : deserialized_entities)
-        {
-            deserialize_entity_second_pass(node, entity);
+        auto const entities = data["Entities"];
 
-            if (entity->m_parent_guid.empty())
-                continue;
+        if (!entities)
+            return true;
 
-            for (auto const& [other_entity, other_node] : deserialized_entities)
-            {
-                if (entity->m_parent_guid == other_entity->guid)
-                {
-                    entity->transform->set_parent(other_entity->transform);
-                    break;
-                }
-            }
-        }
+        if (!deserialize_entities(entities))
+            return false;
+    }
 
-        if (MainScene::get_instance()->is_running)
+    if (MainScene::get_instance()->is_running)
+    {
+        for (auto const& component : deserialized_pool)
         {
-            for (auto const& component : deserialized_pool)
-            {
-                component->awake();
-                component->has_been_awaken = true;
+            component->awake();
+            component->has_been_awaken = true;
 
-                if (component->enabled())
-                {
-                    component->on_enabled();
-                }
+            if (component->enabled())
+            {
+                component->on_enabled();
             }
         }
     }
@@ -2840,17 +4619,413 @@ void SceneSerializer::save_prefab(std::shared_ptr<Entity> const& entity, std::st
     ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
 
     scene_serializer->serialize_this_entity(entity, m_prefab_path + prefab_name + ".txt");
+    m_prefab_templates.erase(prefab_name);
 }
 
-// FIXME: We should probably cache entities that are prefabs and are referenced in the scene, just like Unity.
-//        So we won't need to read the .txt files here.
 std::shared_ptr<Entity> SceneSerializer::load_prefab(std::string const& prefab_name)
 {
+    return load_prefab_instance(prefab_name, nullptr);
+}
+
+std::shared_ptr<Entity> SceneSerializer::load_prefab_instance(std::string const& prefab_name, PrefabInstance* const instance)
+{
+    auto it = m_prefab_templates.find(prefab_name);
+
+    if (it == m_prefab_templates.end())
+    {
+        auto prefab = create_prefab_template(m_prefab_path + prefab_name + ".txt");
+
+        if (prefab == nullptr)
+            return {};
+
+        it = m_prefab_templates.emplace(prefab_name, std::move(prefab)).first;
+    }
+
+    // NOTE: Keeping the template alive, a component could clear the cache while it is being instantiated.
+    auto const prefab = it->second;
+
+    if (!prefab->plan.entities.empty())
+        return instantiate_prefab_plan(*prefab, instance);
+
+    // Slots of the template are in use, the nested instance gets its own copy of the file
+    if (prefab->is_being_instantiated)
+        return load_prefab_uncached(prefab_name);
+
+    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    scene_serializer->set_instance(scene_serializer);
+    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
+
+    return scene_serializer->instantiate_prefab(*prefab, instance);
+}
+
+bool SceneSerializer::reset_prefab_instance(PrefabInstance const& instance)
+{
+    auto it = m_prefab_templates.find(instance.prefab_name);
+
+    if (it == m_prefab_templates.end())
+    {
+        auto prefab = create_prefab_template(m_prefab_path + instance.prefab_name + ".txt");
+
+        if (prefab == nullptr)
+            return false;
+
+        it = m_prefab_templates.emplace(instance.prefab_name, std::move(prefab)).first;
+    }
+
+    auto const prefab = it->second;
+
+    if (prefab->is_being_instantiated || prefab->guid_count != instance.guids.size())
+        return false;
+
+    YAML::Node const& data = prefab->data;
+    auto const entity_nodes = data["Entities"];
+
+    if (entity_nodes.size() != instance.entities.size())
+        return false;
+
+    std::vector<std::shared_ptr<Entity>> entities = {};
+    entities.reserve(instance.entities.size());
+
+    for (u32 i = 0; i < instance.entities.size(); ++i)
+    {
+        auto entity = instance.entities[i].lock();
+
+        if (entity == nullptr || entity->components.size() != entity_nodes[i]["Components"].size())
+            return false;
+
+        entities.emplace_back(std::move(entity));
+    }
+
+    for (u32 i = 0; i < prefab->guid_slots.size(); ++i)
+    {
+        prefab->guid_slots[i] = instance.guids[prefab->slot_guid_indices[i]];
+    }
+
+    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    scene_serializer->set_instance(scene_serializer);
+    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
+
+    scene_serializer->m_deserialization_mode = DeserializationMode::ResetToPrefab;
+
+    for (auto const& entity : entities)
+    {
+        scene_serializer->deserialized_entities_pool.emplace_back(entity);
+        scene_serializer->deserialized_pool.insert(scene_serializer->deserialized_pool.end(), entity->components.begin(),
+                                                   entity->components.end());
+    }
+
+    prefab->is_being_instantiated = true;
+    ScopeGuard reset_instantiation = [&] { prefab->is_being_instantiated = false; };
+
+    for (u32 i = 0; i < entities.size(); ++i)
+    {
+        auto const transform = entity_nodes[i]["TransformComponent"];
+        entities[i]->transform->set_local_position(transform["Translation"].as<glm::vec3>());
+        entities[i]->transform->set_euler_angles(transform["Rotation"].as<glm::vec3>());
+        entities[i]->transform->set_local_scale(transform["Scale"].as<glm::vec3>());
+
+        scene_serializer->deserialize_components(entity_nodes[i], entities[i], false);
+    }
+
+    return true;
+}
+
+void SceneSerializer::attach_component(std::shared_ptr<Entity> const& entity, std::shared_ptr<Component> const& component)
+{
+    if (m_deserialization_mode == DeserializationMode::Plan)
+    {
+        m_plan_components[entity.get()].emplace_back(component);
+        return;
+    }
+
+    if (m_deserialization_mode == DeserializationMode::StreamFromPrefab)
+    {
+        entity->add_component(component);
+
+        // Started once LevelStreamer has awaken it
+        if (m_scene->is_running)
+            m_scene->remove_component_to_start(component);
+
+        return;
+    }
+
+    if (m_deserialization_mode != DeserializationMode::ResetToPrefab)
+        entity->add_component(component);
+
+    component->reprepare();
+}
+
+void SceneSerializer::clear_prefab_cache()
+{
+    m_prefab_templates.clear();
+}
+
+std::vector<PrefabBenchmark> SceneSerializer::benchmark_prefabs(u32 const instance_count)
+{
+    std::vector<PrefabBenchmark> benchmarks = {};
+
+    if (!std::filesystem::exists(m_prefab_path))
+        return benchmarks;
+
+    // Scene of its own, the open one is left alone
+    auto const previous_scene = MainScene::get_instance();
+    auto const scene = std::make_shared<Scene>();
+    MainScene::set_instance(scene);
+
+    auto const instantiate_and_destroy = [&](std::string const& prefab_name, bool const is_cached) {
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        for (u32 i = 0; i < instance_count; ++i)
+        {
+            if (is_cached)
+                (void)load_prefab(prefab_name);
+            else
+                (void)load_prefab_uncached(prefab_name);
+        }
+
+        for (auto const& entity : scene->entities)
+        {
+            entity->destroy();
+        }
+
+        scene->destroy_queued_entities();
+
+        std::chrono::duration<double> const time = std::chrono::high_resolution_clock::now() - start;
+        return time.count();
+    };
+
+    for (auto const& entry : std::filesystem::directory_iterator(m_prefab_path))
+    {
+        if (entry.path().extension() != ".txt")
+            continue;
+
+        PrefabBenchmark benchmark = {};
+        benchmark.name = entry.path().stem().string();
+        benchmark.instances = instance_count;
+
+        // Parsing the template isn't part of the cached timing, it only happens for the first instance
+        m_prefab_templates.erase(benchmark.name);
+        (void)instantiate_and_destroy(benchmark.name, true);
+
+        benchmark.uncached_seconds = instantiate_and_destroy(benchmark.name, false);
+        benchmark.cached_seconds = instantiate_and_destroy(benchmark.name, true);
+
+        benchmarks.emplace_back(benchmark);
+    }
+
+    MainScene::set_instance(previous_scene);
+
+    return benchmarks;
+}
+
+std::vector<DeserializationBenchmark> SceneSerializer::benchmark_deserialization()
+{
+    std::vector<DeserializationBenchmark> benchmarks = {};
+
+    // Scene of its own, the open one is left alone
+    auto const previous_scene = MainScene::get_instance();
+    auto const scene = std::make_shared<Scene>();
+    MainScene::set_instance(scene);
+
+    for (u32 const entity_count : {100u, 1000u, 5000u, 20000u})
+    {
+        YAML::Node const data = create_synthetic_prefab(entity_count);
+
+        auto const scene_serializer = std::make_shared<SceneSerializer>(scene);
+        scene_serializer->set_instance(scene_serializer);
+
+        auto const start = std::chrono::high_resolution_clock::now();
+
+        scene_serializer->replace_guids(data);
+        (void)scene_serializer->deserialize_injected_entities(data);
+
+        std::chrono::duration<double> const time = std::chrono::high_resolution_clock::now() - start;
+
+        scene_serializer->set_instance(nullptr);
+
+        for (auto const& entity : scene->entities)
+        {
+            entity->destroy();
+        }
+
+        scene->destroy_queued_entities();
+
+        benchmarks.emplace_back(entity_count, time.count());
+    }
+
+    MainScene::set_instance(previous_scene);
+
+    return benchmarks;
+}
+
+std::shared_ptr<SceneSerializer::PrefabTemplate> SceneSerializer::create_prefab_template(std::string const& file_path)
+{
+    std::optional<std::string> const prefab_data = read_text_asset(file_path);
+
+    if (!prefab_data.has_value())
+    {
+        Debug::log("Could not open a prefab file: " + file_path + "\n", DebugType::Error);
+        return {};
+    }
+
+    auto prefab = parse_prefab_template(prefab_data.value());
+
+    if (prefab != nullptr)
+        create_prefab_plan(*prefab);
+
+    return prefab;
+}
+
+void SceneSerializer::create_prefab_plan(PrefabTemplate& prefab)
+{
+    if (prefab.has_outside_references)
+        return;
+
+    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    scene_serializer->set_instance(scene_serializer);
+    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
+
+    scene_serializer->m_deserialization_mode = DeserializationMode::Plan;
+
+    if (!scene_serializer->deserialize_entities(prefab.data["Entities"]))
+        return;
+
+    ClonePrototype plan = {};
+    u32 component_count = 0;
+    u32 deserialized_component_count = 0;
+
+    for (auto const& entity : scene_serializer->deserialized_entities_pool)
+    {
+        plan.entities.emplace_back(entity);
+        plan.components.emplace_back(std::move(scene_serializer->m_plan_components[entity.get()]));
+        deserialized_component_count += static_cast<u32>(plan.components.back().size());
+    }
+
+    for (auto const entity : prefab.data["Entities"])
+    {
+        component_count += static_cast<u32>(entity["Components"].size());
+    }
+
+    // Instances are given the guids in the order of the template's guid indices, every entity followed by its components.
+    // A component that failed to deserialize would shift them.
+    if (deserialized_component_count != component_count || plan.entities.size() + component_count != prefab.guid_count)
+        return;
+
+    prefab.plan = std::move(plan);
+}
+
+std::shared_ptr<SceneSerializer::PrefabTemplate> SceneSerializer::parse_prefab_template(std::string const& prefab_data)
+{
+    auto prefab = std::make_shared<PrefabTemplate>();
+    prefab->data = YAML::Load(prefab_data);
+
+    if (!prefab->data["Scene"])
+        return {};
+
+    // Guids of the prefab's own entities and components, references to anything else are kept as they are
+    std::unordered_map<std::string, u32> guid_indices = {};
+
+    for (auto const entity : prefab->data["Entities"])
+    {
+        if (entity["guid"])
+            guid_indices.emplace(entity["guid"].Scalar(), static_cast<u32>(guid_indices.size()));
+
+        for (auto const component : entity["Components"])
+        {
+            if (component["guid"])
+                guid_indices.emplace(component["guid"].Scalar(), static_cast<u32>(guid_indices.size()));
+        }
+    }
+
+    prefab->guid_count = static_cast<u32>(guid_indices.size());
+
+    std::vector<YAML::Node> guid_nodes = {};
+    find_guid_nodes(prefab->data, guid_nodes);
+
+    for (auto const& node : guid_nodes)
+    {
+        if (auto const guid_index = guid_indices.find(node.Scalar()); guid_index != guid_indices.end())
+        {
+            prefab->guid_slots.emplace_back(node);
+            prefab->slot_guid_indices.emplace_back(guid_index->second);
+        }
+        else if (!node.Scalar().empty() && node.Scalar() != "nullptr")
+        {
+            prefab->has_outside_references = true;
+        }
+    }
+
+    return prefab;
+}
+
+std::shared_ptr<Entity> SceneSerializer::load_prefab_uncached(std::string const& prefab_name)
+{
+    std::string const file_path = m_prefab_path + prefab_name + ".txt";
+    std::optional<std::string> const prefab_data = read_text_asset(file_path);
+
+    if (!prefab_data.has_value())
+    {
+        Debug::log("Could not open a prefab file: " + file_path + "\n", DebugType::Error);
+        return {};
+    }
+
     auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
     scene_serializer->set_instance(scene_serializer);
     ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
 
-    std::shared_ptr<Entity> entity = scene_serializer->deserialize_this_entity(m_prefab_path + prefab_name + ".txt");
+    YAML::Node const data = YAML::Load(prefab_data.value());
+    scene_serializer->replace_guids(data);
+
+    return scene_serializer->deserialize_injected_entities(data);
+}
+
+std::shared_ptr<Entity> SceneSerializer::instantiate_prefab(PrefabTemplate& prefab, PrefabInstance* const instance)
+{
+    std::vector<std::string> guids = {};
+    guids.reserve(prefab.guid_count);
+
+    for (u32 i = 0; i < prefab.guid_count; ++i)
+    {
+        guids.emplace_back(AK::generate_guid());
+    }
+
+    // NOTE: Nodes share their data, this writes into the template itself
+    for (u32 i = 0; i < prefab.guid_slots.size(); ++i)
+    {
+        prefab.guid_slots[i] = guids[prefab.slot_guid_indices[i]];
+    }
+
+    prefab.is_being_instantiated = true;
+    ScopeGuard reset_instantiation = [&] { prefab.is_being_instantiated = false; };
+
+    auto entity = deserialize_injected_entities(prefab.data);
+
+    if (instance != nullptr && entity != nullptr)
+    {
+        instance->guids = std::move(guids);
+        instance->entities.assign(deserialized_entities_pool.begin(), deserialized_entities_pool.end());
+    }
 
     return entity;
 }
+
+std::shared_ptr<Entity> SceneSerializer::instantiate_prefab_plan(PrefabTemplate const& prefab, PrefabInstance* const instance)
+{
+    std::vector<std::string> guids = {};
+    guids.reserve(prefab.guid_count);
+
+    for (u32 i = 0; i < prefab.guid_count; ++i)
+    {
+        guids.emplace_back(AK::generate_guid());
+    }
+
+    auto const entities = EntityCloner::instantiate(prefab.plan, guids);
+
+    if (instance != nullptr)
+    {
+        instance->guids = std::move(guids);
+        instance->entities.assign(entities.begin(), entities.end());
+    }
+
+    return entities.front();
+}
@@ -2,8 +2,10 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
 #include <yaml-cpp/node/node.h>
 
+#include "EntityCloner.h"
 #include "Material.h"
 #include "Scene.h"
 
@@ -12,10 +14,31 @@ namespace YAML
 class Emitter;
 }
 
+class CookedFile;
+struct CookedComponent;
+struct PrefabInstance;
+
 enum class DeserializationMode
 {
     Normal,
-    InjectFromFile, // Tries to deserialize entities from a file into an existing scene. All guids are replaced with new ones.
+    InjectFromFile,   // Tries to deserialize entities from a file into an existing scene. All guids are replaced with new ones.
+    ResetToPrefab,    // Assigns the values of a prefab to the components of an existing instance of it.
+    StreamFromPrefab, // Like InjectFromFile, but LevelStreamer prepares and awakes the components later, a few every frame.
+    Plan,             // Deserializes a prefab into the detached entities and components of its instantiation plan.
+};
+
+struct PrefabBenchmark
+{
+    std::string name = {};
+    u32 instances = 0;
+    double uncached_seconds = 0.0;
+    double cached_seconds = 0.0;
+};
+
+struct DeserializationBenchmark
+{
+    u32 entities = 0;
+    double seconds = 0.0;
 };
 
 class SceneSerializer
@@ -32,33 +55,138 @@ public:
     void serialize_this_entity(std::shared_ptr<Entity> const& entity, std::string const& file_path) const;
     std::shared_ptr<Entity> deserialize_this_entity(std::string const& file_path);
 
+    // Same as above without a file, the text is always parsed
+    [[nodiscard]] static std::string serialize_this_entity_to_text(std::shared_ptr<Entity> const& entity);
+    std::shared_ptr<Entity> deserialize_this_entity_from_text(std::string const& entity_data);
+
     void serialize(std::string const& file_path) const;
     bool deserialize(std::string const& file_path);
 
     static void save_prefab(std::shared_ptr<Entity> const& entity, std::string const& prefab_name);
     static std::shared_ptr<Entity> load_prefab(std::string const& prefab_name);
 
+    // Prefabs are parsed once and instantiated from the cache afterwards, this makes them read their files again
+    static void clear_prefab_cache();
+
+    // Instantiates every prefab in the prefab directory, first parsing the text of its file every time, then from
+    // the cache. Uses a scene of its own.
+    static std::vector<PrefabBenchmark> benchmark_prefabs(u32 const instance_count);
+
+    // Deserializes generated prefabs of 100 to 20000 entities into a scene of its own, every entity with a parent and
+    // a component. Replacing the guids is part of the timing, parsing isn't.
+    static std::vector<DeserializationBenchmark> benchmark_deserialization();
+
 private:
+    // Prefab file parsed once. Every guid field referring to an entity or a component of the prefab itself is a slot,
+    // slots are given new guids before every instantiation.
+    struct PrefabTemplate
+    {
+        YAML::Node data = {};
+        std::vector<YAML::Node> guid_slots = {};
+
+        // Index of the slot's guid, slots with the same guid get the same new one
+        std::vector<u32> slot_guid_indices = {};
+        u32 guid_count = 0;
+
+        // Instantiation plan, the prefab deserialized once. Instances are copies of it made by EntityCloner, without
+        // looking at the YAML again. Empty when the prefab refers to anything outside of itself, those references are
+        // looked up in the scene for every instance.
+        ClonePrototype plan = {};
+        bool has_outside_references = false;
+
+        bool is_being_instantiated = false;
+    };
+
+    // Parses the prefab and creates its instantiation plan, only on the main thread
+    [[nodiscard]] static std::shared_ptr<PrefabTemplate> create_prefab_template(std::string const& file_path);
+    static void create_prefab_plan(PrefabTemplate& prefab);
+
+    // Doesn't touch anything but its arguments, LevelStreamer parses prefabs on workers
+    [[nodiscard]] static std::shared_ptr<PrefabTemplate> parse_prefab_template(std::string const& prefab_data);
+
+    [[nodiscard]] static std::shared_ptr<Entity> load_prefab_uncached(std::string const& prefab_name);
+    [[nodiscard]] std::shared_ptr<Entity> instantiate_prefab(PrefabTemplate& prefab, PrefabInstance* const instance);
+    [[nodiscard]] static std::shared_ptr<Entity> instantiate_prefab_plan(PrefabTemplate const& prefab, PrefabInstance* const instance);
+
+    // Same as load_prefab(), also fills the guids and entities of the instance when it comes from the cache
+    [[nodiscard]] static std::shared_ptr<Entity> load_prefab_instance(std::string const& prefab_name, PrefabInstance* const instance);
+
+    // Assigns the prefab's values to the entities and components of the instance again.
+    // Returns false when the prefab doesn't match the instance anymore.
+    [[nodiscard]] static bool reset_prefab_instance(PrefabInstance const& instance);
+
+    // Without looking into the scene
+    [[nodiscard]] std::shared_ptr<Component> find_deserialized_component(std::string const& guid) const;
+    [[nodiscard]] std::shared_ptr<Entity> find_deserialized_entity(std::string const& guid) const;
+    void index_scene() const;
+
+    // Adds the second pass' component to its entity, unless it's already there, and prepares it
+    void attach_component(std::shared_ptr<Entity> const& entity, std::shared_ptr<Component> const& component);
+
+    // Gives the entities and components of data, and every reference to them, new guids. Guids an earlier call replaced
+    // get the same new ones.
+    void replace_guids(YAML::Node const& data);
+
+    // Two pass deserialization of the entities in data into the main scene, returns the first one
+    std::shared_ptr<Entity> deserialize_injected_entities(YAML::Node const& data);
+
+    // Both passes of deserialize_injected_entities(), without awaking the components
+    std::shared_ptr<Entity> create_injected_entities(YAML::Node const& data);
+
+    // Both passes over the entities, then parents them. Returns false when an entity is broken.
+    bool deserialize_entities(YAML::Node const& entities);
+
+    // deserialize_entities() reading the records and field blocks of a cooked scene instead of its node tree.
+    // Cooking already rejected broken entities.
+    void deserialize_cooked_entities(CookedFile const& file);
+
     static void serialize_entity(YAML::Emitter& out, std::shared_ptr<Entity> const& entity);
     static void serialize_entity_recursively(YAML::Emitter& out, std::shared_ptr<Entity> const& entity);
     static void auto_serialize_component(YAML::Emitter& out, std::shared_ptr<Component> const& component);
     void auto_deserialize_component(YAML::Node const& component, std::shared_ptr<Entity> const& deserialized_entity, bool const first_pass);
+    void auto_deserialize_cooked_component(CookedFile const& file, CookedComponent const& component,
+                                           std::shared_ptr<Entity> const& deserialized_entity, bool const first_pass);
 
     void deserialize_components(YAML::Node const& entity_node, std::shared_ptr<Entity> const& deserialized_entity, bool const first_pass);
 
     [[nodiscard]] std::shared_ptr<Entity> deserialize_entity_first_pass(YAML::Node const& entity);
     void deserialize_entity_second_pass(YAML::Node const& entity, std::shared_ptr<Entity> const& deserialized_entity);
 
+    // Guid indexes of everything a deserialization can refer to
+    struct DeserializationContext
+    {
+        // Catch up with the pools on every lookup, the pools are only ever appended to
+        std::unordered_map<std::string, std::shared_ptr<Component>> components = {};
+        std::unordered_map<std::string, std::shared_ptr<Entity>> entities = {};
+        u32 indexed_components = 0;
+        u32 indexed_entities = 0;
+
+        // Whole scene, indexed on the first lookup the pools can't answer when deserializing into an existing scene
+        std::unordered_map<std::string, std::shared_ptr<Component>> scene_components = {};
+        std::unordered_map<std::string, std::shared_ptr<Entity>> scene_entities = {};
+        bool is_scene_indexed = false;
+    };
+
     std::vector<std::shared_ptr<Component>> deserialized_pool = {};
     std::vector<std::shared_ptr<Entity>> deserialized_entities_pool = {};
     std::shared_ptr<Scene> m_scene;
 
+    mutable DeserializationContext m_context = {};
+
     std::unordered_map<std::string, std::string> m_replaced_guids_map = {};
 
+    // Components deserialized in Plan mode, they aren't added to their entities
+    std::unordered_map<Entity const*, std::vector<std::shared_ptr<Component>>> m_plan_components = {};
+
     DeserializationMode m_deserialization_mode = DeserializationMode::Normal;
 
     // FIXME: Duplication of paths here and in Editor
     inline static std::string m_prefab_path = "./res/prefabs/";
 
+    inline static std::unordered_map<std::string, std::shared_ptr<PrefabTemplate>> m_prefab_templates = {};
+
     inline static std::shared_ptr<SceneSerializer> m_instance;
+
+    friend class PrefabPool;
+    friend class LevelStreamer;
 };
@@ -21,7 +21,7 @@ std::shared_ptr<ScreenText> ScreenText::create()
     auto const ui_material = Material::create(ui_shader, Renderer::ui_render_order + 3);
     ui_material->casts_shadows = false;
 
-    auto text = std::make_shared<ScreenText>(AK::Badge<ScreenText> {}, ui_material, "Example text", glm::vec2(0, 0), 40, 0xff0099ff,
+    auto text = AK::make_pooled<ScreenText>(AK::Badge<ScreenText> {}, ui_material, "Example text", glm::vec2(0, 0), 40, 0xff0099ff,
                                              FW1_RESTORESTATE | FW1_CENTER | FW1_VCENTER);
 
     return text;
@@ -30,7 +30,7 @@ std::shared_ptr<ScreenText> ScreenText::create()
 std::shared_ptr<ScreenText> ScreenText::create(std::shared_ptr<Material> const& material, std::string const& content,
                                                glm::vec2 const& position, float const font_size, u32 const color, u16 const flags)
 {
-    auto text = std::make_shared<ScreenText>(AK::Badge<ScreenText> {}, material, content, position, font_size, color, flags);
+    auto text = AK::make_pooled<ScreenText>(AK::Badge<ScreenText> {}, material, content, position, font_size, color, flags);
     return text;
 }
 
@@ -9,7 +9,7 @@ std::shared_ptr<Skybox> SkyboxFactory::create(std::shared_ptr<Material> const& m
 {
     if (Renderer::renderer_api == Renderer::RendererApi::OpenGL)
     {
-        return std::make_shared<SkyboxGL>(AK::Badge<SkyboxFactory> {}, material, face_paths);
+        return AK::make_pooled<SkyboxGL>(AK::Badge<SkyboxFactory> {}, material, face_paths);
     }
 
     std::unreachable();
@@ -19,7 +19,7 @@ std::shared_ptr<Skybox> SkyboxFactory::create(std::shared_ptr<Material> const& m
 {
     if (Renderer::renderer_api == Renderer::RendererApi::DirectX11)
     {
-        return std::make_shared<SkyboxDX11>(AK::Badge<SkyboxFactory> {}, material, path);
+        return AK::make_pooled<SkyboxDX11>(AK::Badge<SkyboxFactory> {}, material, path);
     }
 
     std::unreachable();
@@ -31,7 +31,7 @@ std::shared_ptr<Skybox> SkyboxFactory::create()
     {
         auto const skybox_shader = ResourceManager::get_instance().load_shader("./res/shaders/skybox.hlsl", "./res/shaders/skybox.hlsl");
         auto const skybox_material = Material::create(skybox_shader);
-        auto skybox = std::make_shared<SkyboxDX11>(AK::Badge<SkyboxFactory> {}, skybox_material, "./res/textures/skybox/skybox.dds");
+        auto skybox = AK::make_pooled<SkyboxDX11>(AK::Badge<SkyboxFactory> {}, skybox_material, "./res/textures/skybox/skybox.dds");
         return skybox;
     }
 
@@ -11,7 +11,7 @@
 
 std::shared_ptr<Sound> Sound::create()
 {
-    auto sound = std::make_shared<Sound>(AK::Badge<Sound> {});
+    auto sound = AK::make_pooled<Sound>(AK::Badge<Sound> {});
 
     sound->set_can_tick(true);
 
@@ -20,7 +20,7 @@ std::shared_ptr<Sound> Sound::create()
 
 std::shared_ptr<Sound> Sound::create(std::string const& path)
 {
-    std::shared_ptr<Sound> sound = std::make_shared<Sound>(AK::Badge<Sound> {});
+    std::shared_ptr<Sound> sound = AK::make_pooled<Sound>(AK::Badge<Sound> {});
     ma_sound_init_from_file(&Engine::audio_engine, path.c_str(), 0, nullptr, nullptr, &sound->m_internal_sound);
 
     sound->set_can_tick(true);
@@ -31,7 +31,7 @@ std::shared_ptr<Sound> Sound::create(std::string const& path)
 std::shared_ptr<Sound> Sound::create(std::string const& path, glm::vec3 const direction, float const rolloff,
                                      ma_attenuation_model const attenuation)
 {
-    std::shared_ptr<Sound> sound = std::make_shared<Sound>(AK::Badge<Sound> {});
+    std::shared_ptr<Sound> sound = AK::make_pooled<Sound>(AK::Badge<Sound> {});
     ma_sound_init_from_file(&Engine::audio_engine, path.c_str(), 0, nullptr, nullptr, &sound->m_internal_sound);
 
     ma_sound_set_attenuation_model(&sound->m_internal_sound, attenuation);
@@ -179,6 +179,6 @@ void Sound::update()
     {
         ma_sound_uninit(&m_internal_sound);
 
-        entity->destroy_immediate();
+        entity->destroy();
     }
 }
@@ -7,7 +7,7 @@
 
 std::shared_ptr<SoundListener> SoundListener::create()
 {
-    auto sound_listener = std::make_shared<SoundListener>(AK::Badge<SoundListener> {});
+    auto sound_listener = AK::make_pooled<SoundListener>(AK::Badge<SoundListener> {});
 
     if (instance != nullptr)
     {
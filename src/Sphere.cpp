@@ -13,7 +13,7 @@
 
 std::shared_ptr<Sphere> Sphere::create()
 {
-    auto sphere = std::make_shared<Sphere>(AK::Badge<Sphere> {}, default_material);
+    auto sphere = AK::make_pooled<Sphere>(AK::Badge<Sphere> {}, default_material);
 
     return sphere;
 }
@@ -21,7 +21,7 @@ std::shared_ptr<Sphere> Sphere::create()
 std::shared_ptr<Sphere> Sphere::create(float radius, u32 sectors, u32 stacks, std::string const& texture_path,
                                        std::shared_ptr<Material> const& material)
 {
-    auto sphere = std::make_shared<Sphere>(AK::Badge<Sphere> {}, radius, sectors, stacks, texture_path, material);
+    auto sphere = AK::make_pooled<Sphere>(AK::Badge<Sphere> {}, radius, sectors, stacks, texture_path, material);
 
     return sphere;
 }
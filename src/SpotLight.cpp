@@ -12,7 +12,7 @@
 
 std::shared_ptr<SpotLight> SpotLight::create()
 {
-    auto spot_light = std::make_shared<SpotLight>(AK::Badge<SpotLight> {});
+    auto spot_light = AK::make_pooled<SpotLight>(AK::Badge<SpotLight> {});
     spot_light->set_up_shadow_mapping();
     return spot_light;
 }
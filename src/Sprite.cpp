@@ -7,7 +7,7 @@
 
 std::shared_ptr<Sprite> Sprite::create()
 {
-    auto sprite = std::make_shared<Sprite>(AK::Badge<Sprite> {}, default_material);
+    auto sprite = AK::make_pooled<Sprite>(AK::Badge<Sprite> {}, default_material);
     sprite->prepare();
 
     return sprite;
@@ -15,7 +15,7 @@ std::shared_ptr<Sprite> Sprite::create()
 
 std::shared_ptr<Sprite> Sprite::create(std::shared_ptr<Material> const& material)
 {
-    auto sprite = std::make_shared<Sprite>(AK::Badge<Sprite> {}, material);
+    auto sprite = AK::make_pooled<Sprite>(AK::Badge<Sprite> {}, material);
     sprite->prepare();
 
     return sprite;
@@ -23,7 +23,7 @@ std::shared_ptr<Sprite> Sprite::create(std::shared_ptr<Material> const& material
 
 std::shared_ptr<Sprite> Sprite::create(std::shared_ptr<Material> const& material, std::string const& diffuse_texture_path)
 {
-    auto sprite = std::make_shared<Sprite>(AK::Badge<Sprite> {}, material, diffuse_texture_path);
+    auto sprite = AK::make_pooled<Sprite>(AK::Badge<Sprite> {}, material, diffuse_texture_path);
     sprite->prepare();
 
     return sprite;
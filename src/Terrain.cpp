@@ -8,7 +8,7 @@
 
 std::shared_ptr<Terrain> Terrain::create(std::shared_ptr<Material> const& material, bool const use_gpu, std::string const& height_map_path)
 {
-    auto terrain = std::make_shared<Terrain>(AK::Badge<Terrain> {}, material, use_gpu, height_map_path);
+    auto terrain = AK::make_pooled<Terrain>(AK::Badge<Terrain> {}, material, use_gpu, height_map_path);
 
     terrain->prepare();
 
@@ -1,6 +1,9 @@
 #include "TextureLoader.h"
 
 #include <cassert>
+#include <fstream>
+#include <iterator>
+#include <stb_image.h>
 
 std::shared_ptr<Texture> TextureLoader::load_texture(std::string const& path, TextureType const type, TextureSettings const& settings)
 {
@@ -28,3 +31,49 @@ std::shared_ptr<Texture> TextureLoader::load_cubemap(std::string const& path, Te
     return std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view, image_sampler_state,
                                      path);
 }
+
+void TextureLoader::preload_file(std::string const& path)
+{
+    {
+        std::scoped_lock const lock(m_preloaded_files_mutex);
+
+        if (m_preloaded_files.contains(path))
+            return;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file.is_open())
+        return;
+
+    std::vector<u8> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::scoped_lock const lock(m_preloaded_files_mutex);
+    m_preloaded_files.emplace(path, std::move(bytes));
+}
+
+void TextureLoader::discard_preloaded_file(std::string const& path)
+{
+    std::scoped_lock const lock(m_preloaded_files_mutex);
+    m_preloaded_files.erase(path);
+}
+
+u8* TextureLoader::load_image(std::string const& path, i32* width, i32* height, i32* channels, i32 const desired_channels)
+{
+    std::vector<u8> bytes = {};
+
+    {
+        std::scoped_lock const lock(m_preloaded_files_mutex);
+
+        if (auto const it = m_preloaded_files.find(path); it != m_preloaded_files.end())
+        {
+            bytes = std::move(it->second);
+            m_preloaded_files.erase(it);
+        }
+    }
+
+    if (bytes.empty())
+        return stbi_load(path.c_str(), width, height, channels, desired_channels);
+
+    return stbi_load_from_memory(bytes.data(), static_cast<i32>(bytes.size()), width, height, channels, desired_channels);
+}
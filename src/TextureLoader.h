@@ -1,7 +1,9 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "Texture.h"
@@ -29,15 +31,28 @@ public:
         return m_instance;
     }
 
+    // Reads the image file into memory, so loading the texture doesn't wait for the disk. Can be called from any thread.
+    // NOTE: Decoding stays on the main thread, stb_image flips images depending on a global flag.
+    static void preload_file(std::string const& path);
+
+    // Drops the file if no texture was loaded from it, ex. because ResourceManager had the texture already
+    static void discard_preloaded_file(std::string const& path);
+
 protected:
     static void set_instance(std::shared_ptr<TextureLoader> const& texture_loader)
     {
         m_instance = texture_loader;
     }
 
+    // stbi_load() of the preloaded file if there is one, the file is dropped afterwards
+    [[nodiscard]] static u8* load_image(std::string const& path, i32* width, i32* height, i32* channels, i32 const desired_channels);
+
 private:
     inline static std::shared_ptr<TextureLoader> m_instance;
 
+    inline static std::mutex m_preloaded_files_mutex = {};
+    inline static std::unordered_map<std::string, std::vector<u8>> m_preloaded_files = {};
+
     [[nodiscard]] std::shared_ptr<Texture> load_texture(std::string const& path, TextureType const type,
                                                         TextureSettings const& settings = {});
     [[nodiscard]] std::shared_ptr<Texture> load_cubemap(std::vector<std::string> const& paths, TextureType const type,
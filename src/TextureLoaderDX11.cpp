@@ -23,7 +23,7 @@ TextureData TextureLoaderDX11::texture_from_file(std::string const& path, Textur
     i32 image_height;
     i32 image_channels;
     i32 constexpr image_desired_channels = 4;
-    u8* image_data = stbi_load(path.c_str(), &image_width, &image_height, &image_channels, image_desired_channels);
+    u8* image_data = load_image(path, &image_width, &image_height, &image_channels, image_desired_channels);
 
     assert(image_data);
 
@@ -18,7 +18,7 @@ TextureData TextureLoaderGL::texture_from_file(std::string const& path, TextureS
     stbi_set_flip_vertically_on_load(settings.flip_vertically);
 
     i32 width, height, number_of_components;
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &number_of_components, 0);
+    unsigned char* data = load_image(path, &width, &height, &number_of_components, 0);
 
     if (data == nullptr)
     {
@@ -0,0 +1,165 @@
+#include "TickList.h"
+
+#include "Component.h"
+#include "Entity.h"
+
+#include <algorithm>
+
+void TickList::add(std::shared_ptr<Component> const& component)
+{
+    if (m_is_iterating)
+    {
+        m_pending.emplace_back(component);
+        return;
+    }
+
+    insert(component);
+}
+
+void TickList::remove(Component& component)
+{
+    if (m_is_iterating)
+    {
+        m_pending.emplace_back(component.shared_from_this());
+        return;
+    }
+
+    erase(component);
+}
+
+void TickList::update()
+{
+    assert(!m_is_iterating);
+
+    m_is_iterating = true;
+
+    auto const first_late_batch =
+        std::ranges::find_if(m_batches, [](auto const& batch) { return batch->order >= 0; }) - m_batches.begin();
+
+    for (i64 i = 0; i < first_late_batch; ++i)
+    {
+        m_batches[i]->update_all();
+    }
+
+    for (auto const& component : m_components)
+    {
+        if (component->entity == nullptr || !component->enabled() || !component->entity->is_active())
+            continue;
+
+        component->update();
+    }
+
+    for (i64 i = first_late_batch; i < static_cast<i64>(m_batches.size()); ++i)
+    {
+        m_batches[i]->update_all();
+    }
+
+    m_is_iterating = false;
+
+    flush_pending();
+}
+
+u32 TickList::size() const
+{
+    u32 size = static_cast<u32>(m_components.size());
+
+    for (auto const& batch : m_batches)
+    {
+        size += static_cast<u32>(batch->components.size());
+    }
+
+    return size;
+}
+
+void TickList::add_batch(std::unique_ptr<TickBatch> batch)
+{
+    assert(!m_is_iterating);
+    assert(std::ranges::none_of(m_batches, [&](auto const& other) { return other->type == batch->type; }));
+
+    // After the batches with the same order, so they run in the order they were registered
+    auto const position = std::ranges::upper_bound(m_batches, batch->order, {}, [](auto const& other) { return other->order; });
+    ComponentType const type = batch->type;
+    m_batches.insert(position, std::move(batch));
+
+    // Components that are already tickable move to the new batch
+    std::vector<std::shared_ptr<Component>> moved_components = {};
+
+    for (auto const& component : m_components)
+    {
+        if (component->get_type() == type)
+            moved_components.emplace_back(component);
+    }
+
+    for (auto const& component : moved_components)
+    {
+        erase(*component);
+    }
+
+    for (auto const& component : moved_components)
+    {
+        insert(component);
+    }
+}
+
+std::vector<std::shared_ptr<Component>>& TickList::get_list(Component const& component)
+{
+    if (m_batches.empty())
+        return m_components;
+
+    ComponentType const type = component.get_type();
+
+    for (auto const& batch : m_batches)
+    {
+        if (batch->type == type)
+            return batch->components;
+    }
+
+    return m_components;
+}
+
+void TickList::insert(std::shared_ptr<Component> const& component)
+{
+    auto& list = get_list(*component);
+    u32 const slot = component->m_tick_slot;
+
+    // Slot might belong to the list of another scene
+    if (slot < list.size() && list[slot] == component)
+        return;
+
+    component->m_tick_slot = static_cast<u32>(list.size());
+    list.emplace_back(component);
+}
+
+void TickList::erase(Component& component)
+{
+    auto& list = get_list(component);
+    u32 const slot = component.m_tick_slot;
+
+    if (slot >= list.size() || list[slot].get() != &component)
+        return;
+
+    // NOTE: Swap with last and pop to avoid shifting other elements.
+    if (slot != list.size() - 1)
+    {
+        list[slot] = std::move(list.back());
+        list[slot]->m_tick_slot = slot;
+    }
+
+    list.pop_back();
+    component.m_tick_slot = invalid_slot;
+}
+
+void TickList::flush_pending()
+{
+    // Only the last request of every component matters, and that is what get_can_tick() returns now
+    auto const pending = std::move(m_pending);
+    m_pending.clear();
+
+    for (auto const& component : pending)
+    {
+        if (component->get_can_tick())
+            insert(component);
+        else
+            erase(*component);
+    }
+}
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <cassert>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "AK/Types.h"
+#include "ComponentType.h"
+
+class Component;
+
+// Tickable components of one type updated with a single call to the type's update_all()
+class TickBatch
+{
+public:
+    virtual ~TickBatch() = default;
+
+    virtual void update_all() = 0;
+
+    ComponentType type = ComponentType::Unknown;
+    i32 order = 0;
+    std::vector<std::shared_ptr<Component>> components = {};
+};
+
+template<typename T>
+class TypedTickBatch final : public TickBatch
+{
+public:
+    virtual void update_all() override
+    {
+        m_active_components.clear();
+
+        for (auto const& component : components)
+        {
+            auto const typed_component = static_cast<T*>(component.get());
+
+            if (typed_component->entity != nullptr && typed_component->enabled() && typed_component->entity->is_active())
+                m_active_components.emplace_back(typed_component);
+        }
+
+        T::update_all(std::span<T* const>(m_active_components));
+    }
+
+private:
+    std::vector<T*> m_active_components = {};
+};
+
+// Components in the order they became tickable. Removing one swaps the last component into its slot.
+// Adding or removing components while iterating is applied once the iteration is over, so the iteration sees the list
+// as it was when it started.
+class TickList
+{
+public:
+    static constexpr u32 invalid_slot = std::numeric_limits<u32>::max();
+
+    TickList() = default;
+
+    TickList(TickList const&) = delete;
+    void operator=(TickList const&) = delete;
+
+    void add(std::shared_ptr<Component> const& component);
+    void remove(Component& component);
+
+    // Components of exactly this type are updated by T::update_all(std::span<T* const>) instead of their update().
+    // Batches with a negative order run before the other components, the rest after them, lower orders first.
+    // A component can disable or destroy ones later in the span, update_all() has to check their entity.
+    template<typename T>
+    void register_batch(i32 const order = 0)
+    {
+        static_assert(component_type_of<T> != ComponentType::Unknown, "Batched components need a type from EngineHeaderTool");
+
+        auto batch = std::make_unique<TypedTickBatch<T>>();
+        batch->type = component_type_of<T>;
+        batch->order = order;
+        add_batch(std::move(batch));
+    }
+
+    // Calls update() on the enabled components of active entities and update_all() for batches
+    void update();
+
+    template<typename Function>
+    void for_each(Function const& function)
+    {
+        assert(!m_is_iterating);
+
+        m_is_iterating = true;
+
+        // Nothing is added or removed until the iteration is over
+        for (auto const& component : m_components)
+        {
+            function(*component);
+        }
+
+        for (auto const& batch : m_batches)
+        {
+            for (auto const& component : batch->components)
+            {
+                function(*component);
+            }
+        }
+
+        m_is_iterating = false;
+
+        flush_pending();
+    }
+
+    // Calls function once with every component, in the order for_each visits them. Same as for_each, nothing is added
+    // or removed until it returns.
+    template<typename Function>
+    void for_all(Function const& function)
+    {
+        assert(!m_is_iterating);
+
+        m_is_iterating = true;
+
+        m_all_components.clear();
+
+        for (auto const& component : m_components)
+        {
+            m_all_components.emplace_back(component.get());
+        }
+
+        for (auto const& batch : m_batches)
+        {
+            for (auto const& component : batch->components)
+            {
+                m_all_components.emplace_back(component.get());
+            }
+        }
+
+        function(std::span<Component* const>(m_all_components));
+
+        m_is_iterating = false;
+
+        flush_pending();
+    }
+
+    [[nodiscard]] u32 size() const;
+
+private:
+    void add_batch(std::unique_ptr<TickBatch> batch);
+
+    // Batch of the component's type or the unbatched components
+    [[nodiscard]] std::vector<std::shared_ptr<Component>>& get_list(Component const& component);
+
+    void insert(std::shared_ptr<Component> const& component);
+    void erase(Component& component);
+    void flush_pending();
+
+    // Unbatched components
+    std::vector<std::shared_ptr<Component>> m_components = {};
+
+    // Sorted by order
+    std::vector<std::unique_ptr<TickBatch>> m_batches = {};
+
+    bool m_is_iterating = false;
+
+    // Components that became tickable or stopped being tickable during the iteration, in order
+    std::vector<std::shared_ptr<Component>> m_pending = {};
+
+    // Kept between for_all() calls, so it doesn't allocate every frame
+    std::vector<Component*> m_all_components = {};
+};
@@ -7,6 +7,7 @@
 
 #include "AK/AK.h"
 #include "Entity.h"
+#include "FixedUpdateScheduler.h"
 
 Transform::Transform(std::shared_ptr<Entity> const& entity) : entity(entity)
 {
@@ -314,6 +315,10 @@ void Transform::remove_child(std::shared_ptr<Transform> const& transform)
 
 void Transform::set_dirty()
 {
+#if _DEBUG
+    FixedUpdateScheduler::validate_transform_write(*this);
+#endif
+
     if (!m_local_dirty)
     {
         for (auto const& child : children)
@@ -324,6 +329,7 @@ void Transform::set_dirty()
 
     m_local_dirty = true;
     needs_bounding_box_adjusting = true;
+    m_version += 1;
 }
 
 void Transform::set_parent_dirty()
@@ -338,10 +344,20 @@ void Transform::set_parent_dirty()
 
     m_parent_dirty = true;
     needs_bounding_box_adjusting = true;
+    m_version += 1;
+}
+
+u32 Transform::get_version() const
+{
+    return m_version;
 }
 
 void Transform::set_parent(std::shared_ptr<Transform> const& new_parent)
 {
+#if _DEBUG
+    FixedUpdateScheduler::validate_structural_change("reparents a transform");
+#endif
+
     if (new_parent == nullptr)
     {
         if (parent.expired())
@@ -350,6 +366,7 @@ void Transform::set_parent(std::shared_ptr<Transform> const& new_parent)
         parent.lock()->remove_child(shared_from_this());
         m_local_dirty = true;
         needs_bounding_box_adjusting = true;
+        m_version += 1;
         return;
     }
 
@@ -361,4 +378,5 @@ void Transform::set_parent(std::shared_ptr<Transform> const& new_parent)
     new_parent->add_child(shared_from_this());
     m_local_dirty = true;
     needs_bounding_box_adjusting = true;
+    m_version += 1;
 }
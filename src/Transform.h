@@ -7,6 +7,8 @@
 #include <memory>
 #include <vector>
 
+#include "AK/Types.h"
+
 class Entity;
 
 // TODO: Make transform a component
@@ -52,6 +54,9 @@ public:
 
     void set_parent(std::shared_ptr<Transform> const& new_parent);
 
+    // Incremented every time the world transform might have changed, including changes of any of the parents.
+    [[nodiscard]] u32 get_version() const;
+
     std::vector<std::shared_ptr<Transform>> children;
     std::weak_ptr<Transform> parent = {};
     std::weak_ptr<Entity> entity = {};
@@ -79,6 +84,7 @@ protected:
     glm::mat4 m_local_model_matrix = glm::mat4(1.0f);
     bool m_local_dirty = true;
     bool m_parent_dirty = false;
+    u32 m_version = 0;
 
     [[nodiscard]] glm::mat4 get_local_model_matrix();
 
@@ -9,6 +9,8 @@
 #include "TextureLoader.h"
 
 #include <GLFW/glfw3.h>
+#include <algorithm>
+#include <cassert>
 
 #if EDITOR
 #include <imgui.h>
@@ -22,7 +24,7 @@ std::shared_ptr<Water> Water::create()
     material->casts_shadows = false;
     material->needs_skybox = true;
     material->needs_forward_rendering = true;
-    auto water = std::make_shared<Water>(AK::Badge<Water> {}, material);
+    auto water = AK::make_pooled<Water>(AK::Badge<Water> {}, material);
     water->add_wave();
 
     water->m_ps_buffer.top_color = glm::vec4(0.1f, 0.1f, 0.5f, 1.0f);
@@ -44,7 +46,7 @@ std::shared_ptr<Water> Water::create()
 
 std::shared_ptr<Water> Water::create(u32 tesselation_level, std::shared_ptr<Material> const& material)
 {
-    auto water = std::make_shared<Water>(AK::Badge<Water> {}, tesselation_level, material);
+    auto water = AK::make_pooled<Water>(AK::Badge<Water> {}, tesselation_level, material);
     water->add_wave();
     return water;
 }
@@ -285,6 +287,48 @@ float Water::get_wave_height(glm::vec2 const& position) const
     return height;
 }
 
+void Water::get_wave_heights(std::span<glm::vec2 const> const positions, std::span<float> const heights) const
+{
+    assert(positions.size() == heights.size());
+
+    float const gravity = 9.8f;
+    float constexpr PI = 3.14159265359f;
+    u32 constexpr iterations = 5;
+    float time = glfwGetTime();
+
+    std::ranges::fill(heights, 0.0f);
+
+    for (auto const& wave : waves)
+    {
+        if (wave.wave_length < 3.5f)
+            continue;
+
+        float frequency = sqrt(gravity * 2.0f * PI / wave.wave_length);
+        float steepness = wave.steepness / (frequency * wave.amplitude * waves.size());
+        float phi = wave.speed * 2.0f / wave.wave_length;
+        glm::vec2 const wave_vector = frequency * wave.direction;
+        float const phase = phi * time;
+        float const offset_scale = steepness * wave.amplitude * wave.direction.x;
+
+        // Positions don't depend on each other, so this loop can be vectorized
+        for (u32 j = 0; j < positions.size(); ++j)
+        {
+            glm::vec2 new_position = positions[j];
+            float per_wave_height = 0.0f;
+            for (i32 i = 0; i < iterations; i++)
+            {
+                float const angle = glm::dot(wave_vector, new_position) + phase;
+                glm::vec2 offset = {};
+                offset.x = offset_scale * cos(angle);
+                offset.y = offset_scale * cos(angle);
+                per_wave_height = wave.amplitude * sin(angle);
+                new_position = positions[j] - offset;
+            }
+            heights[j] += per_wave_height;
+        }
+    }
+}
+
 void Water::create_constant_buffer_wave()
 {
     auto const renderer = RendererDX11::get_instance_dx11();
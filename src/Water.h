@@ -4,6 +4,7 @@
 #include "Model.h"
 
 #include <d3d11.h>
+#include <span>
 
 class Water final : public Model
 {
@@ -25,6 +26,9 @@ public:
     void add_wave();
     void remove_wave(u32 const index);
     float get_wave_height(glm::vec2 const& position) const;
+
+    // Same as get_wave_height() for every position, with the per wave terms computed once for all of them
+    void get_wave_heights(std::span<glm::vec2 const> const positions, std::span<float> const heights) const;
     std::vector<DXWave> waves = {};
     ConstantBufferWater m_ps_buffer = {};
 
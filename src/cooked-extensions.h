@@ -0,0 +1,140 @@
+#pragma once
+
+#include "ConstantBufferTypes.h"
+#include "ResourceManager.h"
+
+#include "DialogueObject.h"
+#include "FloatersManager.h"
+#include "SceneCooker.h"
+#include "SceneSerializer.h"
+#include <Game/ShipSpawner.h>
+
+// Readers of the values SceneCooker cooks for the types yaml-cpp-extensions.h converts.
+// NOTE: Members are read in the order of the struct table in SceneCooker.cpp, change both together.
+
+template<typename T>
+requires std::is_base_of_v<Component, T>
+void read_cooked(CookedValue& value, std::shared_ptr<T>& out)
+{
+    out = std::dynamic_pointer_cast<T>(SceneSerializer::get_instance()->get_from_pool(value.read_text()));
+}
+
+template<typename T>
+requires std::is_base_of_v<Component, T>
+void read_cooked(CookedValue& value, std::weak_ptr<T>& out)
+{
+    auto const guid = value.read_text();
+
+    if (guid == "nullptr")
+    {
+        out.reset();
+        return;
+    }
+
+    out = std::dynamic_pointer_cast<T>(SceneSerializer::get_instance()->get_from_pool(guid));
+}
+
+template<typename T>
+requires std::is_base_of_v<Entity, T>
+void read_cooked(CookedValue& value, std::shared_ptr<T>& out)
+{
+    out = std::dynamic_pointer_cast<T>(SceneSerializer::get_instance()->get_entity_from_pool(value.read_text()));
+}
+
+template<typename T>
+requires std::is_base_of_v<Entity, T>
+void read_cooked(CookedValue& value, std::weak_ptr<T>& out)
+{
+    auto const guid = value.read_text();
+
+    if (guid == "nullptr")
+    {
+        out.reset();
+        return;
+    }
+
+    out = std::dynamic_pointer_cast<T>(SceneSerializer::get_instance()->get_entity_from_pool(guid));
+}
+
+inline void read_cooked(CookedValue& value, std::shared_ptr<Shader>& out)
+{
+    auto const vertex_path = value.read_text();
+    auto const fragment_path = value.read_text();
+    auto const geometry_path = value.read_text();
+
+    if (geometry_path.empty())
+    {
+        out = ResourceManager::get_instance().load_shader(vertex_path, fragment_path);
+    }
+    else
+    {
+        out = ResourceManager::get_instance().load_shader(vertex_path, fragment_path, geometry_path);
+    }
+}
+
+inline void read_cooked(CookedValue& value, std::shared_ptr<Material>& out)
+{
+    auto const shader = value.read<std::shared_ptr<Shader>>();
+    auto const color = value.read<glm::vec4>();
+    auto const render_order = value.read<i32>();
+    auto const forward_rendered = value.read<bool>();
+    auto const casts_shadows = value.read<bool>();
+
+    bool is_billboard = false;
+    if (value.read<bool>())
+    {
+        is_billboard = value.read<bool>();
+    }
+
+    out = Material::create(shader, render_order);
+    out->color = color;
+    out->needs_forward_rendering = forward_rendered;
+    out->casts_shadows = casts_shadows;
+    out->is_billboard = is_billboard;
+}
+
+inline void read_cooked(CookedValue& value, DXWave& out)
+{
+    out.direction = value.read<glm::vec2>();
+    out.padding = value.read<glm::vec2>();
+    out.speed = value.read_float();
+    out.steepness = value.read_float();
+    out.wave_length = value.read_float();
+    out.amplitude = value.read_float();
+}
+
+inline void read_cooked(CookedValue& value, ConstantBufferWater& out)
+{
+    out.top_color = value.read<glm::vec4>();
+    out.bottom_color = value.read<glm::vec4>();
+    out.normalmap_scroll_speed_0 = value.read_float();
+    out.normalmap_scroll_speed_1 = value.read_float();
+    out.normalmap_scale0 = value.read_float();
+    out.normalmap_scale1 = value.read_float();
+    out.combined_amplitude = value.read_float();
+    out.phong_contribution = value.read_float();
+}
+
+inline void read_cooked(CookedValue& value, SpawnEvent& out)
+{
+    out.spawn_list = value.read<std::vector<ShipType>>();
+    out.spawn_type = value.read<SpawnType>();
+}
+
+inline void read_cooked(CookedValue& value, FloaterSettings& out)
+{
+    out.sink_rate = value.read_float();
+    out.side_rotation_strength = value.read_float();
+    out.forward_rotation_strength = value.read_float();
+    out.side_floaters_offset = value.read_float();
+    out.forward_floaters_offset = value.read_float();
+}
+
+inline void read_cooked(CookedValue& value, DialogueObject& out)
+{
+    out.auto_end = value.read<bool>();
+    out.upper_line = value.read_text();
+    out.middle_line = value.read_text();
+    out.lower_line = value.read_text();
+    out.sound_path = value.read_text();
+}
@@ -73,6 +73,42 @@ inline void InputFloat3(char const* label, float v[3])
     ImGui::InputFloat3(label, v, "%.3f", ImGuiInputTextFlags_CharsDecimal);
 }
 
+// One checkbox per bit of a 32 bit layer mask, folded under a tree node
+inline bool InputLayerMask(char const* label, u32* mask)
+{
+    bool changed = false;
+
+    if (!ImGui::TreeNode(label))
+        return changed;
+
+    for (u32 layer = 0; layer < 32; ++layer)
+    {
+        if (layer % 8 != 0)
+            ImGui::SameLine();
+
+        ImGui::PushID(static_cast<i32>(layer));
+        changed |= ImGui::CheckboxFlags(std::to_string(layer).c_str(), mask, 1u << layer);
+        ImGui::PopID();
+    }
+
+    if (ImGui::SmallButton("All"))
+    {
+        *mask = 0xFFFFFFFF;
+        changed = true;
+    }
+
+    ImGui::SameLine();
+
+    if (ImGui::SmallButton("None"))
+    {
+        *mask = 0;
+        changed = true;
+    }
+
+    ImGui::TreePop();
+    return changed;
+}
+
 }
 
 #endif
@@ -1,5 +1,18 @@
 #include "Engine.h"
 
+#include "AK/JobSystem.h"
+#include "Broadphase.h"
+#include "CollisionKernels.h"
+#include "Entity.h"
+#include "Scene.h"
+#include "SceneCooker.h"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <string_view>
+#include <utility>
+
 #define FORCE_DEDICATED_GPU 1
 
 #define MINIAUDIO_IMPLEMENTATION
@@ -17,8 +30,150 @@ extern "C"
 }
 #endif
 
-i32 main(i32, char**)
+// Runs the job system's stress test and scaling benchmark without creating a window
+static i32 benchmark_jobs()
+{
+    u32 const hardware_threads = std::max(std::thread::hardware_concurrency(), 1u);
+
+    for (u32 const worker_count : {0u, 1u, hardware_threads - 1})
+    {
+        auto const [jobs, failures, seconds] = AK::JobSystem::run_stress_test(worker_count, 100);
+        std::cout << "Stress test, " << worker_count << " workers: " << jobs << " jobs, " << failures << " failures, " << seconds
+                  << " s\n";
+
+        if (failures != 0)
+            return 1;
+    }
+
+    for (auto const& [threads, seconds, speedup] : AK::JobSystem::benchmark_scaling(hardware_threads, 1 << 20))
+    {
+        std::cout << "Parallel for, " << threads << " threads: " << seconds << " s, " << speedup << "x\n";
+    }
+
+    return 0;
+}
+
+// Spawns and destroys entities with and without the pools
+static i32 benchmark_entities()
+{
+    auto const [entities, heap_seconds, pooled_seconds] = Entity::benchmark_allocation(100000);
+    std::cout << "Spawned and destroyed " << entities << " entities, heap: " << heap_seconds << " s, pools: " << pooled_seconds
+              << " s\n";
+
+    return 0;
+}
+
+// Visits the entities with two types of components by looking at every entity and through the component set index
+static i32 benchmark_component_sets()
+{
+    for (u32 const entity_count : {1000u, 10000u, 100000u})
+    {
+        auto const benchmark = Scene::benchmark_query(entity_count, 200);
+        std::cout << entity_count << " entities in " << benchmark.component_sets << " component sets, " << benchmark.matches
+                  << " matching, average of " << benchmark.iterations << " queries, every entity: " << benchmark.scan_seconds * 1000.0
+                  << " ms, component sets: " << benchmark.index_seconds * 1000.0 << " ms\n";
+    }
+
+    return 0;
+}
+
+// Finds the overlapping pairs of generated colliders with every broadphase backend
+static i32 benchmark_broadphase()
+{
+    std::array const broadphase_types = {"Brute force", "Uniform grid", "Sweep and prune", "Dynamic tree"};
+
+    for (u32 const proxy_count : {500u, 2000u, 10000u})
+    {
+        for (auto const& benchmark : Broadphase::benchmark(proxy_count, 100))
+        {
+            std::cout << broadphase_types[static_cast<u32>(benchmark.type)] << ", " << benchmark.proxies << " colliders: "
+                      << benchmark.pairs << " pairs, average of " << benchmark.iterations << " steps: " << benchmark.seconds * 1000.0
+                      << " ms\n";
+        }
+    }
+
+    return 0;
+}
+
+// Tests the pairs of generated circles and rectangles with the SIMD narrowphase kernels and with their scalar versions
+static i32 benchmark_narrowphase()
+{
+    for (u32 const collider_count : {1000u, 10000u, 50000u})
+    {
+        auto const benchmark = CollisionKernels::benchmark_simd(collider_count, 100);
+        std::cout << benchmark.colliders << " colliders, " << benchmark.pairs << " pairs, " << benchmark.overlapping_pairs
+                  << " overlapping, average of " << benchmark.iterations << " steps, " << benchmark.simd_width
+                  << " wide: " << benchmark.simd_seconds * 1000.0 << " ms, scalar: " << benchmark.scalar_seconds * 1000.0 << " ms, "
+                  << benchmark.mismatched_pairs << " mismatched pairs\n";
+
+        if (benchmark.mismatched_pairs != 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+// Finds the overlapping pairs of generated circles and rectangles by testing every ordered pair and with every broadphase
+static i32 benchmark_collisions()
+{
+    std::array const broadphase_types = {"Brute force", "Uniform grid", "Sweep and prune", "Dynamic tree"};
+
+    // Fewer steps for more colliders, every ordered pair of 10000 colliders is a hundred million tests
+    for (auto const [collider_count, iterations] : {std::pair {100u, 1000u}, std::pair {1000u, 100u}, std::pair {10000u, 5u}})
+    {
+        for (auto const& benchmark : CollisionKernels::benchmark_collisions(collider_count, iterations))
+        {
+            std::cout << (benchmark.broadphase.has_value() ? broadphase_types[static_cast<u32>(benchmark.broadphase.value())]
+                                                           : "Every ordered pair")
+                      << ", " << benchmark.colliders << " colliders: " << benchmark.pairs << " pairs tested, "
+                      << benchmark.overlapping_pairs << " overlapping, average of " << benchmark.iterations
+                      << " steps: " << benchmark.seconds * 1000.0 << " ms\n";
+        }
+    }
+
+    return 0;
+}
+
+// Writes the cooked copies of scenes that are loaded instead of their text, the Cook target runs it
+static i32 cook()
 {
+    auto const [cooked, up_to_date, failed] = SceneCooker::cook_all();
+    std::cout << "Cooked " << cooked << " files, " << up_to_date << " up to date, " << failed.size() << " failed\n";
+
+    for (auto const& file_path : failed)
+    {
+        std::cout << "Could not cook " << file_path << "\n";
+    }
+
+    return failed.empty() ? 0 : 1;
+}
+
+i32 main(i32 argc, char** argv)
+{
+    for (i32 i = 1; i < argc; ++i)
+    {
+        if (std::string_view(argv[i]) == "--cook")
+            return cook();
+
+        if (std::string_view(argv[i]) == "--benchmark-jobs")
+            return benchmark_jobs();
+
+        if (std::string_view(argv[i]) == "--benchmark-entities")
+            return benchmark_entities();
+
+        if (std::string_view(argv[i]) == "--benchmark-component-sets")
+            return benchmark_component_sets();
+
+        if (std::string_view(argv[i]) == "--benchmark-broadphase")
+            return benchmark_broadphase();
+
+        if (std::string_view(argv[i]) == "--benchmark-collisions")
+            return benchmark_collisions();
+
+        if (std::string_view(argv[i]) == "--benchmark-narrowphase")
+            return benchmark_narrowphase();
+    }
+
     if (auto const result = Engine::initialize(); result != 0)
         return result;
 